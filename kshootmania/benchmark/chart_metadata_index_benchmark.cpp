@@ -0,0 +1,366 @@
+﻿// 選曲画面の譜面メタデータのインデックス(SelectChartMetadataIndex)のベンチマーク
+// 合成した譜面ファイルを一時ディレクトリに生成し、インデックスを使用しない場合・使用する場合のフォルダを開く処理の所要時間を計測する
+// (Siv3D・ksonに依存しないよう、ファイル操作はstd::filesystem、譜面ファイルの読み込みはヘッダ部分の行の読み込みで代用している)
+//
+// 使い方: chart_metadata_index_benchmark [譜面数(デフォルト10000)] [試行回数(デフォルト5)]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "scene/select/select_chart_metadata_index_prune.hpp"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	namespace fs = std::filesystem;
+
+	// 1曲あたりの譜面数
+	constexpr std::size_t kNumChartsPerSong = 4U;
+
+	// 削除された譜面ファイルの割合の逆数
+	constexpr std::size_t kDeletedChartInterval = 100U;
+
+	constexpr std::string_view kIndexFileHeader = "#kshootmania-chart-metadata-index 2";
+
+	struct Metadata
+	{
+		std::string title;
+
+		std::string artist;
+
+		std::string level;
+
+		std::string bpm;
+
+		// 並べ替え用の数値のBPM(インデックスには表示用の文字列とは別の列として保存する)
+		double minBPM = 0.0;
+
+		double maxBPM = 0.0;
+	};
+
+	struct Entry
+	{
+		std::uintmax_t fileSize = 0U;
+
+		fs::file_time_type writeTime;
+
+		Metadata metadata;
+
+		std::uint64_t visitedScanId = 0U;
+	};
+
+	using EntryMap = std::unordered_map<std::string, Entry>;
+
+	std::vector<std::string> MakeSyntheticLibrary(const fs::path& folderPath, std::size_t numCharts)
+	{
+		constexpr const char* kDifficultyNames[kNumChartsPerSong] = { "light", "challenge", "extended", "infinite" };
+
+		std::vector<std::string> chartFilePaths;
+		chartFilePaths.reserve(numCharts);
+		for (std::size_t chartIdx = 0U; chartIdx < numCharts; ++chartIdx)
+		{
+			const std::size_t songIdx = chartIdx / kNumChartsPerSong;
+			const fs::path songDirectory = folderPath / ("song" + std::to_string(songIdx));
+			if (chartIdx % kNumChartsPerSong == 0U)
+			{
+				fs::create_directories(songDirectory);
+			}
+
+			// ヘッダに続けて譜面本体を想定した小節を書き込む
+			const fs::path chartFilePath = songDirectory / (std::string{ kDifficultyNames[chartIdx % kNumChartsPerSong] } + ".ksh");
+			std::ofstream ofs(chartFilePath, std::ios::binary);
+			ofs << "title=Song " << songIdx << "\r\n"
+				<< "artist=Artist " << songIdx % 300U << "\r\n"
+				<< "effect=Effector\r\njacket=jacket.png\r\nillustrator=Illustrator\r\n"
+				<< "difficulty=" << kDifficultyNames[chartIdx % kNumChartsPerSong] << "\r\n"
+				<< "level=" << 1U + chartIdx % 20U << "\r\n"
+				<< "t=" << 120U + songIdx % 100U << "\r\n"
+				<< "m=song.ogg\r\nmvol=75\r\no=0\r\nbg=desert\r\nlayer=arrow\r\npo=30000\r\nplength=15000\r\nver=171\r\n--\r\n";
+			for (int measureIdx = 0; measureIdx < 100; ++measureIdx)
+			{
+				ofs << "beat=4/4\r\n0000|00|--\r\n1000|00|0-\r\n0100|00|:-\r\n0010|00|-0\r\n--\r\n";
+			}
+			chartFilePaths.push_back(chartFilePath.string());
+		}
+		return chartFilePaths;
+	}
+
+	// 譜面ファイルのヘッダ部分を読み込む(インデックスにない場合の処理に相当)
+	Metadata LoadMetadata(const std::string& chartFilePath)
+	{
+		Metadata metadata;
+		std::ifstream ifs(chartFilePath, std::ios::binary);
+		std::string line;
+		while (std::getline(ifs, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.pop_back();
+			}
+			if (line == "--")
+			{
+				break;
+			}
+
+			const std::size_t eqPos = line.find('=');
+			if (eqPos == std::string::npos)
+			{
+				continue;
+			}
+			const std::string_view key = std::string_view{ line }.substr(0U, eqPos);
+			std::string value = line.substr(eqPos + 1U);
+			if (key == "title")
+			{
+				metadata.title = std::move(value);
+			}
+			else if (key == "artist")
+			{
+				metadata.artist = std::move(value);
+			}
+			else if (key == "level")
+			{
+				metadata.level = std::move(value);
+			}
+			else if (key == "t")
+			{
+				// "120-240"のような範囲の場合がある
+				const std::size_t hyphenPos = value.find('-');
+				metadata.minBPM = std::strtod(value.c_str(), nullptr);
+				metadata.maxBPM = hyphenPos == std::string::npos ? metadata.minBPM : std::strtod(value.c_str() + hyphenPos + 1U, nullptr);
+				metadata.bpm = std::move(value);
+			}
+		}
+		return metadata;
+	}
+
+	// 譜面のメタデータを取得する(SelectChartMetadataIndex::Getに相当)
+	// 戻り値は譜面ファイルを読み込んだかどうか
+	bool Get(EntryMap& entries, const std::string& chartFilePath, std::uint64_t scanId)
+	{
+		std::error_code ec;
+		const std::uintmax_t fileSize = fs::file_size(chartFilePath, ec);
+		const fs::file_time_type writeTime = fs::last_write_time(chartFilePath, ec);
+		if (const auto itr = entries.find(chartFilePath); itr != entries.end())
+		{
+			Entry& entry = itr->second;
+			if (entry.fileSize == fileSize && entry.writeTime == writeTime)
+			{
+				entry.visitedScanId = scanId;
+				return false;
+			}
+		}
+
+		entries[chartFilePath] = Entry{
+			.fileSize = fileSize,
+			.writeTime = writeTime,
+			.metadata = LoadMetadata(chartFilePath),
+			.visitedScanId = scanId,
+		};
+		return true;
+	}
+
+	void SaveIndex(const EntryMap& entries, const fs::path& indexFilePath)
+	{
+		std::ofstream ofs(indexFilePath, std::ios::binary);
+		ofs << kIndexFileHeader << '\n';
+		for (const auto& [chartFilePath, entry] : entries)
+		{
+			ofs << chartFilePath << '\t' << entry.fileSize << '\t' << entry.writeTime.time_since_epoch().count() << '\t'
+				<< entry.metadata.title << '\t' << entry.metadata.artist << '\t' << entry.metadata.level << '\t' << entry.metadata.bpm << '\t'
+				<< entry.metadata.minBPM << '\t' << entry.metadata.maxBPM << '\n';
+		}
+	}
+
+	EntryMap LoadIndex(const fs::path& indexFilePath)
+	{
+		EntryMap entries;
+		std::ifstream ifs(indexFilePath, std::ios::binary);
+		std::string line;
+		if (!std::getline(ifs, line) || line != kIndexFileHeader)
+		{
+			return entries;
+		}
+
+		std::vector<std::string> columns;
+		while (std::getline(ifs, line))
+		{
+			columns.clear();
+			std::size_t pos = 0U;
+			while (true)
+			{
+				const std::size_t tabPos = line.find('\t', pos);
+				columns.push_back(line.substr(pos, tabPos - pos));
+				if (tabPos == std::string::npos)
+				{
+					break;
+				}
+				pos = tabPos + 1U;
+			}
+			if (columns.size() != 9U)
+			{
+				continue;
+			}
+
+			entries[std::move(columns[0])] = Entry{
+				.fileSize = std::stoull(columns[1]),
+				.writeTime = fs::file_time_type{ fs::file_time_type::duration{ std::stoll(columns[2]) } },
+				.metadata = {
+					.title = std::move(columns[3]),
+					.artist = std::move(columns[4]),
+					.level = std::move(columns[5]),
+					.bpm = std::move(columns[6]),
+					.minBPM = std::stod(columns[7]),
+					.maxBPM = std::stod(columns[8]),
+				},
+			};
+		}
+		return entries;
+	}
+
+	// funcをnumIterations回実行し、1回あたりの平均・最大の所要時間(ミリ秒)を計測する
+	std::pair<double, double> Measure(int numIterations, const std::function<void()>& func)
+	{
+		double sumMs = 0.0;
+		double maxMs = 0.0;
+		for (int i = 0; i < numIterations; ++i)
+		{
+			const auto startTime = Clock::now();
+			func();
+			const double ms = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+			sumMs += ms;
+			maxMs = std::max(maxMs, ms);
+		}
+		return { sumMs / numIterations, maxMs };
+	}
+
+	void PrintResult(const char* name, std::size_t numResults, const std::pair<double, double>& result)
+	{
+		std::printf("%-32s %8zu %10.3f %10.3f\n", name, numResults, result.first, result.second);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const int numChartsArg = argc >= 2 ? std::atoi(argv[1]) : 10000;
+	const int numIterations = argc >= 3 ? std::atoi(argv[2]) : 5;
+	if (numChartsArg <= 0 || numIterations <= 0)
+	{
+		std::fprintf(stderr, "Usage: %s [number of charts] [iterations]\n", argv[0]);
+		return 1;
+	}
+	const auto numCharts = static_cast<std::size_t>(numChartsArg);
+
+	const fs::path rootPath = fs::temp_directory_path() / "kshootmania_chart_metadata_index_benchmark";
+	fs::remove_all(rootPath);
+	const fs::path folderPath = rootPath / "songs";
+	const fs::path indexFilePath = rootPath / "chart_metadata_index.tsv";
+	const std::vector<std::string> chartFilePaths = MakeSyntheticLibrary(folderPath, numCharts);
+
+	// 譜面ファイルのパスはフォルダのパスとの前方一致で判定するため、末尾にスラッシュを付ける
+	const std::string folderPathPrefix = (folderPath / "").string();
+
+	std::printf("charts: %zu\n\n", chartFilePaths.size());
+	std::printf("%-32s %8s %10s %10s\n", "", "loaded", "mean(ms)", "max(ms)");
+
+	// インデックスなし(全譜面ファイルを読み込む)
+	EntryMap entries;
+	{
+		std::size_t numLoaded = 0U;
+		const auto result = Measure(numIterations, [&]
+			{
+				entries.clear();
+				numLoaded = 0U;
+				for (const auto& chartFilePath : chartFilePaths)
+				{
+					numLoaded += Get(entries, chartFilePath, 1U) ? 1U : 0U;
+				}
+			});
+		PrintResult("scan without index", numLoaded, result);
+	}
+
+	// インデックスファイルの書き込み・読み込み
+	{
+		const auto result = Measure(numIterations, [&] { SaveIndex(entries, indexFilePath); });
+		PrintResult("save index", entries.size(), result);
+	}
+	{
+		std::size_t numEntries = 0U;
+		const auto result = Measure(numIterations, [&] { numEntries = LoadIndex(indexFilePath).size(); });
+		PrintResult("load index", numEntries, result);
+	}
+
+	// インデックスあり(変更のない譜面ファイルは読み込まない)
+	{
+		std::size_t numLoaded = 0U;
+		std::uint64_t scanId = 1U;
+		const auto result = Measure(numIterations, [&]
+			{
+				++scanId;
+				numLoaded = 0U;
+				for (const auto& chartFilePath : chartFilePaths)
+				{
+					numLoaded += Get(entries, chartFilePath, scanId) ? 1U : 0U;
+				}
+			});
+		PrintResult("scan with index", numLoaded, result);
+	}
+
+	// 一部の譜面ファイルを削除した状態で、削除された譜面の項目をインデックスから取り除く
+	std::vector<std::string> remainingChartFilePaths;
+	for (std::size_t chartIdx = 0U; chartIdx < chartFilePaths.size(); ++chartIdx)
+	{
+		if (chartIdx % kDeletedChartInterval == 0U)
+		{
+			fs::remove(chartFilePaths[chartIdx]);
+		}
+		else
+		{
+			remainingChartFilePaths.push_back(chartFilePaths[chartIdx]);
+		}
+	}
+	const EntryMap entriesBeforePrune = entries;
+
+	// 全項目の存在確認(メインスレッドで全項目のファイルの存在確認を行っていた以前の方式)
+	{
+		std::size_t numErased = 0U;
+		const auto result = Measure(numIterations, [&]
+			{
+				EntryMap prunedEntries = entriesBeforePrune;
+				const auto startSize = prunedEntries.size();
+				std::erase_if(prunedEntries, [](const auto& pair) { return !fs::is_regular_file(pair.first); });
+				numErased = startSize - prunedEntries.size();
+			});
+		PrintResult("prune by stat (erased)", numErased, result);
+	}
+
+	// 走査中に参照されなかった項目を削除(ファイルの存在確認は行わない)
+	{
+		std::size_t numErased = 0U;
+		std::uint64_t scanId = 1000U;
+		EntryMap prunedEntries;
+		const auto result = Measure(numIterations, [&]
+			{
+				prunedEntries = entriesBeforePrune;
+				++scanId;
+				for (const auto& chartFilePath : remainingChartFilePaths)
+				{
+					prunedEntries.at(chartFilePath).visitedScanId = scanId;
+				}
+				numErased = SelectChartMetadataIndex::EraseUnvisitedEntries(prunedEntries, std::string_view{ folderPathPrefix }, scanId);
+			});
+		PrintResult("prune unvisited (erased)", numErased, result);
+	}
+
+	fs::remove_all(rootPath);
+
+	return 0;
+}
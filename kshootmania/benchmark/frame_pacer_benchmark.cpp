@@ -0,0 +1,144 @@
+﻿// フレームレート制限(FramePacer)のベンチマーク
+// 描画なしでFramePacer::wait()を繰り返し呼び、フレーム間隔のばらつきと待機中のCPU使用率を計測する
+// (途中で一定間隔ごとに処理落ちを模した長いフレームを挟み、その後にスピンウェイトの時間が縮むことも確認する)
+//
+// 使い方: frame_pacer_benchmark [1つの目標フレームレートあたりの計測時間(秒、デフォルト3)]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "common/frame_pacer.hpp"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int kTargetFPSList[] = { 60, 120, 144, 240, 300 };
+
+	// 1フレームあたりの疑似的な処理時間
+	constexpr auto kWorkDuration = std::chrono::microseconds{ 500 };
+
+	// 処理落ちを模した長いフレームの間隔(秒)と処理時間
+	constexpr double kSpikeIntervalSec = 1.0;
+	constexpr auto kSpikeDuration = std::chrono::milliseconds{ 20 };
+
+	struct BenchmarkResult
+	{
+		double meanIntervalMs;
+
+		double stdDevIntervalMs;
+
+		double p99IntervalMs;
+
+		double cpuUsageRate;
+
+		double spinMarginMs;
+
+		std::int64_t numLateFrames;
+	};
+
+	void BusyWork(Clock::duration duration)
+	{
+		const Clock::time_point end = Clock::now() + duration;
+		while (Clock::now() < end)
+		{
+		}
+	}
+
+	BenchmarkResult Run(int targetFPS, double seconds)
+	{
+		FramePacer framePacer(targetFPS);
+		std::vector<double> intervalsMs;
+		intervalsMs.reserve(static_cast<std::size_t>(seconds * targetFPS) + 1U);
+
+		const Clock::time_point startTime = Clock::now();
+		const std::clock_t startCPUTime = std::clock();
+		Clock::time_point prevFrameTime = startTime;
+		Clock::time_point nextSpikeTime = startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(kSpikeIntervalSec));
+		while (true)
+		{
+			framePacer.wait();
+
+			const Clock::time_point frameTime = Clock::now();
+			intervalsMs.push_back(std::chrono::duration<double, std::milli>(frameTime - prevFrameTime).count());
+			prevFrameTime = frameTime;
+			if (frameTime - startTime >= std::chrono::duration<double>(seconds))
+			{
+				break;
+			}
+
+			if (frameTime >= nextSpikeTime)
+			{
+				BusyWork(kSpikeDuration);
+				nextSpikeTime += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(kSpikeIntervalSec));
+			}
+			else
+			{
+				BusyWork(kWorkDuration);
+			}
+		}
+		const double elapsedSec = std::chrono::duration<double>(Clock::now() - startTime).count();
+		const double cpuSec = static_cast<double>(std::clock() - startCPUTime) / CLOCKS_PER_SEC;
+
+		// 初回は計測開始からの時間なので除外
+		intervalsMs.erase(intervalsMs.begin());
+
+		double sum = 0.0;
+		for (const double intervalMs : intervalsMs)
+		{
+			sum += intervalMs;
+		}
+		const double mean = sum / static_cast<double>(intervalsMs.size());
+		double variance = 0.0;
+		for (const double intervalMs : intervalsMs)
+		{
+			variance += (intervalMs - mean) * (intervalMs - mean);
+		}
+		variance /= static_cast<double>(intervalsMs.size());
+
+		std::vector<double> sortedIntervalsMs = intervalsMs;
+		std::sort(sortedIntervalsMs.begin(), sortedIntervalsMs.end());
+		const std::size_t p99Idx = std::min(sortedIntervalsMs.size() - 1U, static_cast<std::size_t>(static_cast<double>(sortedIntervalsMs.size()) * 0.99));
+
+		const FramePacingStats stats = framePacer.stats();
+		return {
+			.meanIntervalMs = mean,
+			.stdDevIntervalMs = std::sqrt(variance),
+			.p99IntervalMs = sortedIntervalsMs[p99Idx],
+			.cpuUsageRate = elapsedSec > 0.0 ? cpuSec / elapsedSec : 0.0,
+			.spinMarginMs = stats.spinMarginMs,
+			.numLateFrames = stats.numLateFrames,
+		};
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const double seconds = argc >= 2 ? std::atof(argv[1]) : 3.0;
+	if (seconds <= 0.0)
+	{
+		std::fprintf(stderr, "Usage: %s [seconds per target fps]\n", argv[0]);
+		return 1;
+	}
+
+	std::printf("%6s %10s %10s %10s %10s %8s %12s %6s\n", "fps", "target", "mean", "stddev", "p99", "cpu", "spinMargin", "late");
+	for (const int targetFPS : kTargetFPSList)
+	{
+		const BenchmarkResult result = Run(targetFPS, seconds);
+		std::printf("%6d %8.3fms %8.3fms %8.3fms %8.3fms %7.1f%% %10.3fms %6lld\n",
+			targetFPS,
+			1000.0 / targetFPS,
+			result.meanIntervalMs,
+			result.stdDevIntervalMs,
+			result.p99IntervalMs,
+			result.cpuUsageRate * 100.0,
+			result.spinMarginMs,
+			static_cast<long long>(result.numLateFrames));
+	}
+
+	return 0;
+}
@@ -0,0 +1,196 @@
+﻿// 選曲画面の全曲インデックス(SelectLibraryIndex)のベンチマーク
+// 合成した曲名・アーティスト名・譜面の属性でインデックスを作成し、絞り込み・並べ替え・インクリメンタルサーチの所要時間を計測する
+//
+// 使い方: library_index_benchmark [曲数(デフォルト10000)] [試行回数(デフォルト20)]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+#include "scene/select/select_library_index.hpp"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// 1フレームの時間の目安(60FPS)
+	constexpr double kFrameTimeMs = 1000.0 / 60.0;
+
+	constexpr const char* kSortTypeNames[] = { "title", "artist", "level", "bpm", "score", "medal" };
+
+	// インクリメンタルサーチで1文字ずつ入力する検索文字列
+	constexpr std::u32string_view kIncrementalSearchText = U"Song Ka";
+
+	class Random
+	{
+	private:
+		std::uint32_t m_state;
+
+	public:
+		explicit Random(std::uint32_t seed)
+			: m_state(seed)
+		{
+		}
+
+		std::uint32_t next(std::uint32_t max)
+		{
+			m_state = m_state * 1664525U + 1013904223U;
+			return (m_state >> 8) % max;
+		}
+	};
+
+	std::u32string MakeWord(Random& random)
+	{
+		// 英字と日本語が混ざった曲名を想定し、ローマ字とかなを混ぜる
+		constexpr std::u32string_view kSyllables[] = { U"ka", U"ri", U"Su", U"to", U"Ne", U"mi", U"ra", U"Yo", U"さ", U"く", U"ら", U"ノ", U"ト", U"☆" };
+		std::u32string word;
+		const std::uint32_t numSyllables = 2U + random.next(4U);
+		for (std::uint32_t i = 0U; i < numSyllables; ++i)
+		{
+			word += kSyllables[random.next(std::size(kSyllables))];
+		}
+		return word;
+	}
+
+	SelectLibraryIndex MakeSyntheticIndex(std::size_t numSongs)
+	{
+		Random random(12345U);
+		SelectLibraryIndex index;
+		for (std::size_t i = 0U; i < numSongs; ++i)
+		{
+			const std::u32string title = U"Song " + MakeWord(random) + U" " + MakeWord(random);
+			const std::u32string artist = MakeWord(random) + U" feat. " + MakeWord(random);
+			const std::uint32_t songIdx = index.addSong(title, artist);
+
+			// 1曲あたり1～4譜面で、難易度が上がるほどレベルも上がるようにする
+			const std::int32_t baseLevel = 1 + static_cast<std::int32_t>(random.next(8U));
+			const float bpm = 80.0f + static_cast<float>(random.next(2000U)) / 10.0f;
+			for (std::int32_t difficultyIdx = 0; difficultyIdx < SelectLibraryIndex::kNumDifficulties; ++difficultyIdx)
+			{
+				if (difficultyIdx != SelectLibraryIndex::kNumDifficulties - 1 && random.next(5U) == 0U)
+				{
+					continue;
+				}
+				const std::int32_t level = std::min(baseLevel + difficultyIdx * 3 + static_cast<std::int32_t>(random.next(3U)), 20);
+				const std::int32_t score = random.next(3U) == 0U ? 0 : 8000000 + static_cast<std::int32_t>(random.next(2000001U));
+				const std::int32_t medal = score == 0 ? 0 : 1 + static_cast<std::int32_t>(random.next(7U));
+				index.addChart(songIdx, difficultyIdx, level, bpm, score, medal);
+			}
+		}
+		return index;
+	}
+
+	// funcをnumIterations回実行し、1回あたりの平均・最大の所要時間(ミリ秒)を計測する
+	std::pair<double, double> Measure(int numIterations, const std::function<void()>& func)
+	{
+		double sumMs = 0.0;
+		double maxMs = 0.0;
+		for (int i = 0; i < numIterations; ++i)
+		{
+			const auto startTime = Clock::now();
+			func();
+			const double ms = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+			sumMs += ms;
+			maxMs = std::max(maxMs, ms);
+		}
+		return { sumMs / numIterations, maxMs };
+	}
+
+	void PrintResult(const std::string& name, std::size_t numResults, const std::pair<double, double>& result)
+	{
+		std::printf("%-28s %8zu %10.3f %10.3f %9.1f%%\n", name.c_str(), numResults, result.first, result.second, result.second / kFrameTimeMs * 100.0);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const int numSongsArg = argc >= 2 ? std::atoi(argv[1]) : 10000;
+	const int numIterations = argc >= 3 ? std::atoi(argv[2]) : 20;
+	if (numSongsArg <= 0 || numIterations <= 0)
+	{
+		std::fprintf(stderr, "Usage: %s [number of songs] [iterations]\n", argv[0]);
+		return 1;
+	}
+	const auto numSongs = static_cast<std::size_t>(numSongsArg);
+
+	// インデックスの作成(起動時・全曲の走査後に一度だけ行う処理)
+	const auto buildStartTime = Clock::now();
+	SelectLibraryIndex index = MakeSyntheticIndex(numSongs);
+	index.finalize();
+	const double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStartTime).count();
+	std::printf("songs: %zu, charts: %zu, build: %.3fms\n\n", index.numSongs(), index.numCharts(), buildMs);
+
+	std::printf("%-28s %8s %10s %10s %10s\n", "", "results", "mean(ms)", "max(ms)", "max/frame");
+
+	// 全曲の並べ替え
+	for (std::int32_t sortType = 0; sortType < static_cast<std::int32_t>(SelectLibrarySortType::kNumSortTypes); ++sortType)
+	{
+		const SelectLibraryQuery query{
+			.sortType = static_cast<SelectLibrarySortType>(sortType),
+			.difficultyIdx = 2,
+			.level = std::nullopt,
+			.searchText = U"",
+		};
+		std::size_t numResults = 0U;
+		const auto result = Measure(numIterations, [&] { numResults = index.query(query).size(); });
+		PrintResult(std::string{ "sort " } + kSortTypeNames[sortType], numResults, result);
+	}
+
+	// レベルでの絞り込み(レベルフォルダ)
+	{
+		const SelectLibraryQuery query{
+			.sortType = SelectLibrarySortType::kTitle,
+			.difficultyIdx = 3,
+			.level = 15,
+			.searchText = U"",
+		};
+		std::size_t numResults = 0U;
+		const auto result = Measure(numIterations, [&] { numResults = index.query(query).size(); });
+		PrintResult("filter level 15", numResults, result);
+	}
+
+	// 検索文字列での絞り込みと並べ替え
+	{
+		const SelectLibraryQuery query{
+			.sortType = SelectLibrarySortType::kScore,
+			.difficultyIdx = 3,
+			.level = std::nullopt,
+			.searchText = U"karI",
+		};
+		std::size_t numResults = 0U;
+		const auto result = Measure(numIterations, [&] { numResults = index.query(query).size(); });
+		PrintResult("search + sort score", numResults, result);
+	}
+
+	// インクリメンタルサーチ(1文字入力するごとに前回の結果を絞り込む)
+	const std::vector<std::uint32_t> allSongIdxs = index.query(SelectLibraryQuery{});
+	for (std::size_t length = 1U; length <= kIncrementalSearchText.size(); ++length)
+	{
+		const std::u32string_view searchText = kIncrementalSearchText.substr(0U, length);
+		const std::vector<std::uint32_t> prevSongIdxs = index.search(kIncrementalSearchText.substr(0U, length - 1U), allSongIdxs);
+		std::size_t numResults = 0U;
+		const auto result = Measure(numIterations, [&] { numResults = index.search(searchText, prevSongIdxs).size(); });
+		PrintResult("incremental search len " + std::to_string(length), numResults, result);
+	}
+
+	// 1曲を更新した後の並べ替え用の順位の再計算と、レベルフォルダの一覧の取得
+	// (選曲画面で開いたフォルダの走査結果をライブラリに反映した後、次にAllフォルダ・レベルフォルダを開く際に行う処理)
+	{
+		const auto result = Measure(numIterations, [&]
+			{
+				index.replaceSong(0U, U"Song updated", U"Artist updated");
+				index.addChart(0U, 3, 18, 180.0f, 9900000, 3);
+				index.finalize();
+			});
+		PrintResult("update 1 song + finalize", index.numSongs(), result);
+	}
+	{
+		std::size_t numLevels = 0U;
+		const auto result = Measure(numIterations, [&] { numLevels = index.levels().size(); });
+		PrintResult("levels", numLevels, result);
+	}
+
+	return 0;
+}
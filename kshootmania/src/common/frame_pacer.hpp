@@ -0,0 +1,185 @@
+﻿#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+/// @brief フレーム間隔の統計情報
+struct FramePacingStats
+{
+	/// @brief フレーム間隔の平均(ミリ秒)
+	double meanIntervalMs = 0.0;
+
+	/// @brief フレーム間隔の標準偏差(ミリ秒)
+	double stdDevIntervalMs = 0.0;
+
+	/// @brief sleepの超過時間の平均(ミリ秒)
+	double meanSleepOvershootMs = 0.0;
+
+	/// @brief 現在のスピンウェイトの時間(ミリ秒)
+	double spinMarginMs = 0.0;
+
+	/// @brief 待機開始時点で既に目標時刻を過ぎていたフレーム数
+	std::int64_t numLateFrames = 0;
+};
+
+/// @brief sleepとスピンウェイトを組み合わせて一定間隔でフレームを進めるためのクラス
+/// @note sleep_untilはOSのスケジューラの都合で最大数ミリ秒程度遅れて戻るため、目標時刻の少し手前までsleepし、残りはスピンウェイトで待つ
+/// @note スピンウェイトの時間は実測したsleepの超過時間に合わせて自動的に調整する(フレーム間隔の一定割合を上限とし、sleepしなかったフレームでは縮める)
+/// @note Siv3Dに依存しないので、描画なしでも動作を計測できる
+class FramePacer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+private:
+	// 目標フレームレートに届かなかった場合に目標時刻を遅らせずに許容する遅れ
+	// (これ以上遅れた場合は目標時刻を現在時刻に合わせ直し、遅れを取り戻すための連続フレームが発生しないようにする)
+	static constexpr Clock::duration kMaxDrift = std::chrono::milliseconds{ 10 };
+
+	static constexpr Clock::duration kMinSpinMargin = std::chrono::microseconds{ 200 };
+	static constexpr Clock::duration kMaxSpinMargin = std::chrono::milliseconds{ 4 };
+	static constexpr Clock::duration kInitialSpinMargin = std::chrono::milliseconds{ 1 };
+
+	// フレーム間隔に対するスピンウェイトの時間の上限の割合
+	// (高フレームレート時に一度大きく超過しただけで、フレーム間隔のほぼ全体がスピンウェイトになることを防ぐため)
+	static constexpr double kMaxSpinMarginRate = 0.5;
+
+	// 統計情報の指数移動平均の係数
+	static constexpr double kStatsSmoothing = 0.02;
+
+	// sleepの超過時間の指数移動平均の係数
+	static constexpr double kOvershootSmoothing = 0.1;
+
+	Clock::duration m_interval;
+
+	Clock::time_point m_deadline;
+
+	Clock::duration m_spinMargin;
+
+	double m_meanSleepOvershootSec = 0.0;
+
+	Clock::time_point m_prevFrameTime;
+
+	bool m_hasPrevFrameTime = false;
+
+	double m_meanIntervalSec = 0.0;
+
+	double m_varianceIntervalSec = 0.0;
+
+	std::int64_t m_numLateFrames = 0;
+
+	static Clock::duration IntervalFromFPS(int targetFPS)
+	{
+		return std::chrono::duration_cast<Clock::duration>(std::chrono::seconds{ 1 }) / std::max(targetFPS, 1);
+	}
+
+	static double ToSec(Clock::duration duration)
+	{
+		return std::chrono::duration<double>(duration).count();
+	}
+
+	void updateSpinMargin(Clock::duration overshoot)
+	{
+		const double overshootSec = ToSec(std::max(overshoot, Clock::duration::zero()));
+		m_meanSleepOvershootSec += (overshootSec - m_meanSleepOvershootSec) * kOvershootSmoothing;
+
+		// 平均の1.5倍を基本とし、直近の超過がそれを上回った場合は即座に広げる
+		Clock::duration spinMargin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_meanSleepOvershootSec * 1.5));
+		if (overshoot > spinMargin)
+		{
+			spinMargin = overshoot + overshoot / 2;
+		}
+		m_spinMargin = std::clamp(spinMargin, kMinSpinMargin, maxSpinMargin());
+	}
+
+	Clock::duration maxSpinMargin() const
+	{
+		const auto maxByInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(ToSec(m_interval) * kMaxSpinMarginRate));
+		return std::clamp(maxByInterval, kMinSpinMargin, kMaxSpinMargin);
+	}
+
+	void updateIntervalStats(Clock::time_point frameTime)
+	{
+		if (m_hasPrevFrameTime)
+		{
+			const double intervalSec = ToSec(frameTime - m_prevFrameTime);
+			const double diff = intervalSec - m_meanIntervalSec;
+			m_meanIntervalSec += diff * kStatsSmoothing;
+			m_varianceIntervalSec = (1.0 - kStatsSmoothing) * (m_varianceIntervalSec + kStatsSmoothing * diff * diff);
+		}
+		else
+		{
+			m_meanIntervalSec = ToSec(m_interval);
+			m_hasPrevFrameTime = true;
+		}
+		m_prevFrameTime = frameTime;
+	}
+
+public:
+	explicit FramePacer(int targetFPS)
+		: m_interval(IntervalFromFPS(targetFPS))
+		, m_deadline(Clock::now())
+		, m_spinMargin(std::min(kInitialSpinMargin, maxSpinMargin()))
+	{
+	}
+
+	/// @brief 次のフレームの目標時刻まで待機する
+	void wait()
+	{
+		m_deadline += m_interval;
+
+		const Clock::time_point now = Clock::now();
+		if (m_deadline < now)
+		{
+			++m_numLateFrames;
+			if (m_deadline < now - kMaxDrift)
+			{
+				m_deadline = now;
+			}
+		}
+
+		// 目標時刻のスピンウェイト時間だけ手前までsleep
+		const Clock::time_point sleepUntil = m_deadline - m_spinMargin;
+		if (now < sleepUntil)
+		{
+			std::this_thread::sleep_until(sleepUntil);
+			updateSpinMargin(Clock::now() - sleepUntil);
+		}
+		else
+		{
+			// sleepしなかった場合は超過時間0として扱い、スピンウェイトの時間を徐々に縮める
+			// (一度の大きな超過でスピンウェイトの時間が広がったまま戻らなくなることを防ぐため)
+			updateSpinMargin(Clock::duration::zero());
+		}
+
+		// 残りはスピンウェイト
+		// (同じコアの他のスレッドに実行を譲りつつ待つ)
+		Clock::time_point frameTime = Clock::now();
+		while (frameTime < m_deadline)
+		{
+			std::this_thread::yield();
+			frameTime = Clock::now();
+		}
+
+		updateIntervalStats(frameTime);
+	}
+
+	void setTargetFPS(int targetFPS)
+	{
+		m_interval = IntervalFromFPS(targetFPS);
+		m_spinMargin = std::min(m_spinMargin, maxSpinMargin());
+	}
+
+	FramePacingStats stats() const
+	{
+		return {
+			.meanIntervalMs = m_meanIntervalSec * 1000.0,
+			.stdDevIntervalMs = std::sqrt(m_varianceIntervalSec) * 1000.0,
+			.meanSleepOvershootMs = m_meanSleepOvershootSec * 1000.0,
+			.spinMarginMs = ToSec(m_spinMargin) * 1000.0,
+			.numLateFrames = m_numLateFrames,
+		};
+	}
+};
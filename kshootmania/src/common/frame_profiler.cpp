@@ -0,0 +1,171 @@
+﻿#include "frame_profiler.hpp"
+
+namespace FrameProfiler
+{
+	namespace
+	{
+		constexpr std::size_t kSectionEnumCountSZ = static_cast<std::size_t>(Section::kSectionEnumCount);
+
+		// パーセンタイル値の計算およびCSV書き出しの対象とするフレーム数
+		constexpr std::size_t kNumFrameSamples = 1200;
+
+		// パーセンタイル値を更新する間隔(フレーム数)
+		constexpr std::size_t kStatsUpdateIntervalFrames = 30;
+
+		constexpr std::array<StringView, kSectionEnumCountSZ> kSectionNames = {
+			U"GameUpdate",
+			U"Judgment",
+			U"AudioEffect",
+			U"Camera",
+			U"HighwayRT",
+			U"NoteDraw",
+			U"HUD",
+			U"LimiterSleep",
+		};
+
+		bool s_enabled = false;
+
+		bool s_isRecording = false;
+
+		// 現在のフレームでの各区間の所要時間の合計
+		std::array<Clock::duration, kSectionEnumCountSZ> s_currentFrameTimes{};
+
+		// 直近のフレームでの各区間の所要時間(ミリ秒、リングバッファ)
+		std::array<std::array<float, kNumFrameSamples>, kSectionEnumCountSZ> s_frameSamplesMs{};
+
+		// リングバッファの次の書き込み位置
+		std::size_t s_sampleCursor = 0U;
+
+		// リングバッファに書き込み済みのフレーム数
+		std::size_t s_numFilledSamples = 0U;
+
+		// 前回パーセンタイル値を更新してからのフレーム数
+		std::size_t s_framesSinceStatsUpdate = 0U;
+
+		std::array<Stats, kSectionEnumCountSZ> s_stats{};
+
+		double Percentile(Array<float>& sortBuffer, double rate)
+		{
+			if (sortBuffer.empty())
+			{
+				return 0.0;
+			}
+			const std::size_t idx = Min(static_cast<std::size_t>(rate * sortBuffer.size()), sortBuffer.size() - 1U);
+			std::nth_element(sortBuffer.begin(), sortBuffer.begin() + idx, sortBuffer.end());
+			return sortBuffer[idx];
+		}
+
+		void UpdateStats()
+		{
+			Array<float> sortBuffer(Arg::reserve = s_numFilledSamples);
+			for (std::size_t i = 0U; i < kSectionEnumCountSZ; ++i)
+			{
+				sortBuffer.assign(s_frameSamplesMs[i].begin(), s_frameSamplesMs[i].begin() + s_numFilledSamples);
+				s_stats[i] = {
+					.p50Ms = Percentile(sortBuffer, 0.5),
+					.p99Ms = Percentile(sortBuffer, 0.99),
+				};
+			}
+		}
+	}
+
+	void SetEnabled(bool enabled)
+	{
+		s_enabled = enabled;
+	}
+
+	bool IsEnabled()
+	{
+		return s_enabled;
+	}
+
+	void AddTime(Section section, Clock::duration duration)
+	{
+		s_currentFrameTimes[static_cast<std::size_t>(section)] += duration;
+	}
+
+	void StartRecording()
+	{
+		s_currentFrameTimes.fill(Clock::duration::zero());
+		s_sampleCursor = 0U;
+		s_numFilledSamples = 0U;
+		s_framesSinceStatsUpdate = 0U;
+		s_stats.fill(Stats{});
+		s_isRecording = true;
+	}
+
+	void StopRecording()
+	{
+		s_isRecording = false;
+	}
+
+	void EndFrame()
+	{
+		if (!s_enabled)
+		{
+			return;
+		}
+
+		if (!s_isRecording)
+		{
+			s_currentFrameTimes.fill(Clock::duration::zero());
+			return;
+		}
+
+		for (std::size_t i = 0U; i < kSectionEnumCountSZ; ++i)
+		{
+			s_frameSamplesMs[i][s_sampleCursor] = std::chrono::duration<float, std::milli>(s_currentFrameTimes[i]).count();
+			s_currentFrameTimes[i] = Clock::duration::zero();
+		}
+		s_sampleCursor = (s_sampleCursor + 1U) % kNumFrameSamples;
+		s_numFilledSamples = Min(s_numFilledSamples + 1U, kNumFrameSamples);
+
+		if (++s_framesSinceStatsUpdate >= kStatsUpdateIntervalFrames)
+		{
+			UpdateStats();
+			s_framesSinceStatsUpdate = 0U;
+		}
+	}
+
+	Stats SectionStats(Section section)
+	{
+		return s_stats[static_cast<std::size_t>(section)];
+	}
+
+	StringView SectionName(Section section)
+	{
+		return kSectionNames[static_cast<std::size_t>(section)];
+	}
+
+	bool DumpCSV(FilePathView filePath)
+	{
+		TextWriter writer(filePath);
+		if (!writer)
+		{
+			return false;
+		}
+
+		// ヘッダ行
+		String header = U"frame";
+		for (const StringView sectionName : kSectionNames)
+		{
+			header += U",{}_ms"_fmt(sectionName);
+		}
+		writer.writeln(header);
+
+		// 古いフレームから順番に書き出す
+		const std::size_t oldestIdx = (s_sampleCursor + kNumFrameSamples - s_numFilledSamples) % kNumFrameSamples;
+		for (std::size_t frame = 0U; frame < s_numFilledSamples; ++frame)
+		{
+			const std::size_t sampleIdx = (oldestIdx + frame) % kNumFrameSamples;
+			String line = Format(frame);
+			for (std::size_t i = 0U; i < kSectionEnumCountSZ; ++i)
+			{
+				line += U",{:.4f}"_fmt(s_frameSamplesMs[i][sampleIdx]);
+			}
+			writer.writeln(line);
+		}
+
+		return true;
+	}
+}
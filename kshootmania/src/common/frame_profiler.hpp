@@ -0,0 +1,99 @@
+﻿#pragma once
+#include <chrono>
+
+/// @brief フレーム内の各処理の所要時間の計測
+/// @note メインスレッドからのみ使用すること
+/// @note 無効時はScopedTimerが時刻を取得しないので、計測箇所を残したままでもほぼコストはかからない
+namespace FrameProfiler
+{
+	using Clock = std::chrono::steady_clock;
+
+	enum class Section : int32
+	{
+		kGameUpdate = 0, // GameMain::update全体
+		kJudgment, // 判定の更新
+		kAudioEffect, // AudioEffectMain::update
+		kCamera, // 視点変更・傾きの更新
+		kHighwayRenderTexture, // Highwayのレンダーテクスチャへの描画全体(ノーツの描画を含む)
+		kNoteDraw, // ノーツの描画
+		kHUD, // HUDの描画
+		kFrameLimiterSleep, // フレームレート制限の待機
+
+		kSectionEnumCount,
+	};
+
+	/// @brief 区間ごとのパーセンタイル値
+	struct Stats
+	{
+		double p50Ms = 0.0;
+		double p99Ms = 0.0;
+	};
+
+	void SetEnabled(bool enabled);
+
+	bool IsEnabled();
+
+	/// @brief 区間の所要時間を現在のフレームに加算する
+	/// @param section 区間
+	/// @param duration 所要時間
+	void AddTime(Section section, Clock::duration duration);
+
+	/// @brief 計測結果を破棄して記録を開始する
+	/// @note プレー画面の開始時に呼ぶ(他の画面での計測結果が混ざらないよう、記録はプレー画面の間のみ行う)
+	void StartRecording();
+
+	/// @brief 記録を終了する(計測結果は次のStartRecording()まで保持する)
+	void StopRecording();
+
+	/// @brief 現在のフレームの計測結果を確定させる(1フレームに1回呼ぶ)
+	/// @note 記録中でなければ計測結果を破棄する
+	void EndFrame();
+
+	/// @brief 直近の一定フレーム数における区間の所要時間のパーセンタイル値を返す
+	/// @param section 区間
+	/// @return パーセンタイル値
+	/// @note 毎フレーム計算すると重いので、一定フレームごとに更新された値を返す
+	Stats SectionStats(Section section);
+
+	/// @brief 区間名を返す
+	/// @param section 区間
+	/// @return 区間名
+	StringView SectionName(Section section);
+
+	/// @brief 直近の一定フレーム数の計測結果をCSVとして書き出す
+	/// @param filePath 書き出し先のファイルパス
+	/// @return 書き出しに成功した場合はtrue
+	bool DumpCSV(FilePathView filePath);
+
+	/// @brief スコープを抜けるまでの所要時間を計測する
+	class ScopedTimer
+	{
+	private:
+		const Section m_section;
+		const bool m_enabled;
+		Clock::time_point m_startTime;
+
+	public:
+		explicit ScopedTimer(Section section)
+			: m_section(section)
+			, m_enabled(IsEnabled())
+		{
+			if (m_enabled)
+			{
+				m_startTime = Clock::now();
+			}
+		}
+
+		~ScopedTimer()
+		{
+			if (m_enabled)
+			{
+				AddTime(m_section, Clock::now() - m_startTime);
+			}
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+	};
+}
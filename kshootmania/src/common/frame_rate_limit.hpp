@@ -1,11 +1,10 @@
 ﻿#pragma once
+#include "frame_pacer.hpp"
 
 class FrameRateLimit : public IAddon
 {
 private:
-	int32 m_targetFPS;
-
-	std::chrono::time_point<std::chrono::steady_clock> m_sleepUntil;
+	FramePacer m_framePacer;
 
 public:
 	explicit FrameRateLimit(int32 targetFPS);
@@ -13,4 +12,8 @@ public:
 	virtual void postPresent() override;
 
 	void setTargetFPS(int32 targetFPS);
+
+	/// @brief フレーム間隔の統計情報を返す
+	/// @return 統計情報
+	FramePacingStats pacingStats() const;
 };
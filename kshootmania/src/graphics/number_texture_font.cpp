@@ -24,8 +24,28 @@ void NumberTextureFont::draw(const TextureFontTextLayout& textLayout, const Vec2
 	// 下の桁から順番に描画
 	for (int32 i = 0; i < numDigitsToDraw; ++i)
 	{
-		const RectF rect = grid.fromBack(i);
-		m_tiledTexture(number % 10).resized(rect.size).draw(rect.pos);
+		const Glyph glyph = digitGlyph(grid, i, number % 10);
+		glyph.textureRegion.draw(glyph.position);
+		number /= 10;
+	}
+}
+
+void NumberTextureFont::buildGlyphs(Array<Glyph>& glyphs, const TextureFontTextLayout& textLayout, const Vec2& position, int32 number, ZeroPaddingYN zeroPadding) const
+{
+	// 桁数
+	const int32 numDigits = MathUtils::NumDigits(number);
+
+	// グリッド取得
+	const auto grid = textLayout.grid(position, numDigits);
+
+	// 描画すべき桁数
+	const int32 numDigitsToDraw = zeroPadding ? grid.numLettersAfterPadding() : numDigits;
+
+	// 下の桁から順番に作成
+	glyphs.reserve(glyphs.size() + numDigitsToDraw);
+	for (int32 i = 0; i < numDigitsToDraw; ++i)
+	{
+		glyphs.push_back(digitGlyph(grid, i, number % 10));
 		number /= 10;
 	}
 }
@@ -44,6 +64,15 @@ void NumberTextureFont::draw(const TextureFontTextLayout::Grid& grid, int32 offs
 	}
 }
 
+NumberTextureFont::Glyph NumberTextureFont::digitGlyph(const TextureFontTextLayout::Grid& grid, int32 indexFromBack, int32 digit) const
+{
+	const RectF rect = grid.fromBack(indexFromBack);
+	return {
+		.textureRegion = m_tiledTexture(digit).resized(rect.size),
+		.position = rect.pos,
+	};
+}
+
 void NumberTextureFont::drawHalfGrid(const TextureFontTextLayout::Grid& halfGrid, int32 doubledOffsetIndexFromBack, int32 number) const
 {
 	// 描画すべき桁数
@@ -16,6 +16,13 @@ public:
 		Right,
 	};
 
+	/// @brief 1桁分の描画内容
+	struct Glyph
+	{
+		TextureRegion textureRegion;
+		Vec2 position;
+	};
+
 	explicit NumberTextureFont(StringView textureAssetKey, const Size& sourceSize = TiledTextureSizeInfo::kAutoDetectSize, const Point& sourceOffset = Point::Zero());
 
 	/// @brief 描画
@@ -25,6 +32,15 @@ public:
 	/// @param zeroPadding ゼロパディング(0埋め)するかどうか
 	void draw(const TextureFontTextLayout& textLayout, const Vec2& position, int32 number, ZeroPaddingYN zeroPadding) const;
 
+	/// @brief 描画内容を各桁ごとに作成(描画はしない)
+	/// @param glyphs 作成した描画内容の追加先
+	/// @param textLayout レイアウト
+	/// @param position 描画先のアンカー座標
+	/// @param number 描画する数字
+	/// @param zeroPadding ゼロパディング(0埋め)するかどうか
+	/// @remarks 毎フレーム同じ数字を描画する場合はNumberTextureFontCacheを使用して描画内容を使い回す
+	void buildGlyphs(Array<Glyph>& glyphs, const TextureFontTextLayout& textLayout, const Vec2& position, int32 number, ZeroPaddingYN zeroPadding) const;
+
 	/// @brief 描画
 	/// @param grid グリッド
 	/// @param offsetIndexFromBack 起点インデックス(末尾を起点とした先頭方向へのインデックスで指定)
@@ -39,4 +55,12 @@ public:
 	/// @param number 描画する数字
 	/// @remarks こちらの関数はグリッド内の一部のみに数字を描画、かつ小数点を含む場合に使う。ゼロパディング使用不可
 	void drawHalfGrid(const TextureFontTextLayout::Grid& halfGrid, int32 doubledOffsetIndexFromBack, int32 number) const;
+
+private:
+	/// @brief 1桁分の描画内容を作成
+	/// @param grid グリッド
+	/// @param indexFromBack 描画先のインデックス(末尾を起点とした先頭方向へのインデックスで指定)
+	/// @param digit 描画する数字(0～9)
+	/// @return 描画内容
+	Glyph digitGlyph(const TextureFontTextLayout::Grid& grid, int32 indexFromBack, int32 digit) const;
 };
@@ -0,0 +1,25 @@
+﻿#include "number_texture_font_cache.hpp"
+
+void NumberTextureFontCache::draw(const NumberTextureFont& font, const TextureFontTextLayout& textLayout, const Vec2& position, int32 number, ZeroPaddingYN zeroPadding) const
+{
+	const Key key{
+		.pFont = &font,
+		.position = position,
+		.number = number,
+		.zeroPadding = zeroPadding.getBool(),
+	};
+
+	// 表示内容が変化した場合のみ各桁の描画内容を作り直す
+	if (key != m_key)
+	{
+		m_glyphs.clear();
+		font.buildGlyphs(m_glyphs, textLayout, position, number, zeroPadding);
+		m_key = key;
+	}
+
+	// 同じテクスチャの描画を連続して行うので、Siv3D側で1回の描画呼び出しにまとめられる
+	for (const auto& glyph : m_glyphs)
+	{
+		glyph.textureRegion.draw(glyph.position);
+	}
+}
@@ -0,0 +1,34 @@
+﻿#pragma once
+#include "number_texture_font.hpp"
+
+/// @brief NumberTextureFontで描画する数字の各桁の描画内容をキャッシュするクラス
+/// @note 表示する数字・座標が前回から変化していなければ桁の分解と座標計算を省略し、前回の結果をそのまま描画する
+/// @note 1つのインスタンスは常に同じTextureFontTextLayoutで使用すること(レイアウトはキャッシュのキーに含まれない)
+class NumberTextureFontCache
+{
+private:
+	struct Key
+	{
+		const NumberTextureFont* pFont = nullptr;
+		Vec2 position = Vec2::Zero();
+		int32 number = 0;
+		bool zeroPadding = false;
+
+		bool operator==(const Key&) const = default;
+	};
+
+	// 描画処理から更新されるキャッシュなのでmutableにしている
+	mutable Optional<Key> m_key = none;
+	mutable Array<NumberTextureFont::Glyph> m_glyphs;
+
+public:
+	NumberTextureFontCache() = default;
+
+	/// @brief 描画
+	/// @param font 数字のテクスチャフォント
+	/// @param textLayout レイアウト
+	/// @param position 描画先のアンカー座標
+	/// @param number 描画する数字
+	/// @param zeroPadding ゼロパディング(0埋め)するかどうか
+	void draw(const NumberTextureFont& font, const TextureFontTextLayout& textLayout, const Vec2& position, int32 number, ZeroPaddingYN zeroPadding) const;
+};
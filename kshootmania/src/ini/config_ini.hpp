@@ -53,6 +53,7 @@ namespace ConfigIni
 		constexpr StringView kSelectSongIndex = U"currentitem";
 		constexpr StringView kSelectDifficulty = U"currentlevel";
 		constexpr StringView kSelectSortType = U"mselview";
+		constexpr StringView kSelectAllFolderSortType = U"allfolder_sort";
 		constexpr StringView kHispeed = U"hispeed";
 		constexpr StringView kEffRateType = U"effratetype";
 		constexpr StringView kShowFastSlow = U"viewtiming";
@@ -68,6 +69,8 @@ namespace ConfigIni
 		constexpr StringView kVisualOffset = U"visual_offset";
 		constexpr StringView kAutoPlaySE = U"auto_play_se";
 
+		constexpr StringView kFrameProfiler = U"frame_profiler";
+
 		constexpr StringView kMuteAudioInInactiveWindow = U"automaticmute";
 
 		constexpr StringView kExportPNG = U"output";
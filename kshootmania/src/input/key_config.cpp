@@ -191,32 +191,6 @@ bool KeyConfig::Pressed(Button button)
 	return false;
 }
 
-Optional<KeyConfig::Button> KeyConfig::LastPressedLaserButton(Button button1, Button button2)
-{
-	assert(button1 == kLeftLaserL || button1 == kLeftLaserR || button1 == kRightLaserL || button1 == kRightLaserR);
-	assert(button2 == kLeftLaserL || button2 == kLeftLaserR || button2 == kRightLaserL || button2 == kRightLaserR);
-
-	Optional<Button> lastButton = none;
-	Duration minDuration = Duration::zero();
-	for (const auto& configSet : s_configSetArray)
-	{
-		for (Button button : { button1, button2 })
-		{
-			if (configSet[button].pressed())
-			{
-				const Duration duration = configSet[button].pressedDuration();
-				if (!lastButton.has_value() || duration < minDuration)
-				{
-					minDuration = duration;
-					lastButton = button;
-				}
-			}
-		}
-	}
-
-	return lastButton;
-}
-
 bool KeyConfig::Down(Button button)
 {
 	if (button == KeyConfig::kUnspecifiedButton)
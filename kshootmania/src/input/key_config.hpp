@@ -90,8 +90,6 @@ namespace KeyConfig
 
 	bool Pressed(Button button);
 
-	Optional<KeyConfig::Button> LastPressedLaserButton(Button button1, Button button2);
-
 	bool Down(Button button);
 
 	void ClearInput(Button button);
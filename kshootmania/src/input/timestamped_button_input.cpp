@@ -0,0 +1,220 @@
+﻿#include "timestamped_button_input.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+namespace
+{
+	constexpr std::chrono::microseconds kThreadPollingInterval = 1ms;
+
+	// 入力スレッドでポーリングするデバイスかどうか
+	bool IsPolledByThread([[maybe_unused]] const Input& input)
+	{
+#ifdef _WIN32
+		// Siv3DのキーボードのInputのコードは仮想キーコードと同一
+		return input.deviceType() == InputDeviceType::Keyboard;
+#else
+		return false;
+#endif
+	}
+}
+
+void TimestampedButtonInput::threadMain([[maybe_unused]] std::stop_token stopToken)
+{
+#ifdef _WIN32
+	// Sleepの分解能を上げる
+	timeBeginPeriod(1);
+
+	ButtonMask prevPressedMask = 0U;
+	while (!stopToken.stop_requested())
+	{
+		ButtonMask pressedMask = 0U;
+		if (m_isWindowFocused.load(std::memory_order_relaxed))
+		{
+			for (std::size_t i = 0U; i < kNumButtons; ++i)
+			{
+				for (const uint8 keyCode : m_threadKeyCodes[i])
+				{
+					if (GetAsyncKeyState(keyCode) & 0x8000)
+					{
+						pressedMask |= ButtonMask{ 1U } << i;
+						break;
+					}
+				}
+			}
+		}
+
+		if (pressedMask != prevPressedMask)
+		{
+			m_latestThreadPressedMask.store(pressedMask, std::memory_order_release);
+			if (!m_threadEventQueue.push({ .pressedMask = pressedMask, .time = Clock::now() }))
+			{
+				m_isThreadEventQueueOverflowed.store(true, std::memory_order_release);
+			}
+			prevPressedMask = pressedMask;
+		}
+
+		std::this_thread::sleep_for(kThreadPollingInterval);
+	}
+
+	timeEndPeriod(1);
+#endif
+}
+
+void TimestampedButtonInput::applyPressedMask(Clock::time_point time)
+{
+	const ButtonMask pressedMask = m_threadPressedMask | m_framePressedMask;
+	const ButtonMask changedMask = pressedMask ^ m_pressedMask;
+	if (changedMask == 0U)
+	{
+		return;
+	}
+
+	for (std::size_t i = 0U; i < kNumButtons; ++i)
+	{
+		const ButtonMask bit = ButtonMask{ 1U } << i;
+		if (changedMask & bit)
+		{
+			m_events.push_back({
+				.button = static_cast<KeyConfig::Button>(i),
+				.pressed = (pressedMask & bit) != 0U,
+				.time = time,
+			});
+		}
+	}
+	m_pressedMask = pressedMask;
+}
+
+TimestampedButtonInput::TimestampedButtonInput()
+{
+	for (std::size_t i = 0U; i < kNumButtons; ++i)
+	{
+		const auto button = static_cast<KeyConfig::ConfigurableButton>(i);
+
+		// FXの場合はLR両押しキーも対象にする
+		Array<KeyConfig::ConfigurableButton> configButtons = { button };
+		if (button == KeyConfig::kFX_L || button == KeyConfig::kFX_R)
+		{
+			configButtons.push_back(KeyConfig::kFX_LR);
+		}
+
+		for (int32 configSetIdx = 0; configSetIdx < KeyConfig::kConfigSetEnumCount; ++configSetIdx)
+		{
+			for (const auto configButton : configButtons)
+			{
+				const Input& input = KeyConfig::GetConfigValue(static_cast<KeyConfig::ConfigSet>(configSetIdx), configButton);
+				if (input.deviceType() == InputDeviceType::Undefined)
+				{
+					continue;
+				}
+
+				if (IsPolledByThread(input))
+				{
+					m_threadKeyCodes[i].push_back(input.code());
+				}
+				else
+				{
+					m_frameInputs[i].push_back(input);
+				}
+			}
+		}
+	}
+
+#ifdef _WIN32
+	m_thread = std::jthread([this](std::stop_token stopToken) { threadMain(stopToken); });
+#endif
+}
+
+void TimestampedButtonInput::pollFrameInputs(Clock::time_point frameTime)
+{
+	// 入力スレッドの対象外のデバイスはフレーム毎の入力状態を取得し、変化があればフレームの開始時刻のイベントとして記録
+	// (入力状態は前回のpollFrameInputs()以降のどこかで変化しているため、その範囲の先頭の時刻で記録する。
+	//  フレームの時刻で記録するとそのフレームの最後のティックまで反映されず、1フレーム遅れて判定されてしまう)
+	const Clock::time_point frameStartTime = m_prevFramePollTime.value_or(frameTime);
+	m_prevFramePollTime = frameTime;
+
+	ButtonMask framePressedMask = 0U;
+	for (std::size_t i = 0U; i < kNumButtons; ++i)
+	{
+		for (const Input& input : m_frameInputs[i])
+		{
+			if (input.pressed())
+			{
+				framePressedMask |= ButtonMask{ 1U } << i;
+				break;
+			}
+		}
+	}
+	if (framePressedMask != m_polledFramePressedMask)
+	{
+		m_pendingFrameEvents.push_back({ .pressedMask = framePressedMask, .time = frameStartTime });
+		m_polledFramePressedMask = framePressedMask;
+	}
+}
+
+void TimestampedButtonInput::update(Clock::time_point sampleTime)
+{
+	m_events.clear();
+
+	// ウィンドウ非アクティブ時はキー入力を受け付けない
+	m_isWindowFocused.store(Window::GetState().focused, std::memory_order_relaxed);
+
+	// 入力スレッドのイベントを受け取る
+	PressedMaskEvent threadEvent;
+	while (m_threadEventQueue.pop(threadEvent))
+	{
+		m_pendingThreadEvents.push_back(threadEvent);
+	}
+	if (m_isThreadEventQueueOverflowed.exchange(false, std::memory_order_acq_rel))
+	{
+		// キューが溢れた場合は途中の変化を諦め、最新の押下状態に合わせる
+		m_pendingThreadEvents.clear();
+		m_pendingThreadEvents.push_back({ .pressedMask = m_latestThreadPressedMask.load(std::memory_order_acquire), .time = sampleTime });
+	}
+
+	// sampleTime以前に発生したイベントを、入力スレッドとフレーム毎のポーリングのものを合わせて発生順に反映
+	std::size_t numAppliedThreadEvents = 0U;
+	std::size_t numAppliedFrameEvents = 0U;
+	while (true)
+	{
+		const PressedMaskEvent* pThreadEvent = numAppliedThreadEvents < m_pendingThreadEvents.size() ? &m_pendingThreadEvents[numAppliedThreadEvents] : nullptr;
+		const PressedMaskEvent* pFrameEvent = numAppliedFrameEvents < m_pendingFrameEvents.size() ? &m_pendingFrameEvents[numAppliedFrameEvents] : nullptr;
+		const bool isThreadEventNext = pThreadEvent != nullptr && (pFrameEvent == nullptr || pThreadEvent->time <= pFrameEvent->time);
+		const PressedMaskEvent* pNextEvent = isThreadEventNext ? pThreadEvent : pFrameEvent;
+		if (pNextEvent == nullptr || pNextEvent->time > sampleTime)
+		{
+			break;
+		}
+
+		if (isThreadEventNext)
+		{
+			m_threadPressedMask = pNextEvent->pressedMask;
+			++numAppliedThreadEvents;
+		}
+		else
+		{
+			m_framePressedMask = pNextEvent->pressedMask;
+			++numAppliedFrameEvents;
+		}
+		applyPressedMask(pNextEvent->time);
+	}
+	m_pendingThreadEvents.erase(m_pendingThreadEvents.begin(), m_pendingThreadEvents.begin() + numAppliedThreadEvents);
+	m_pendingFrameEvents.erase(m_pendingFrameEvents.begin(), m_pendingFrameEvents.begin() + numAppliedFrameEvents);
+}
+
+const Array<TimestampedButtonInput::Event>& TimestampedButtonInput::events() const
+{
+	return m_events;
+}
+
+bool TimestampedButtonInput::pressed(KeyConfig::Button button) const
+{
+	if (button < 0 || static_cast<std::size_t>(button) >= kNumButtons)
+	{
+		return false;
+	}
+	return (m_pressedMask & (ButtonMask{ 1U } << button)) != 0U;
+}
@@ -0,0 +1,109 @@
+﻿#pragma once
+#include <thread>
+#include "key_config.hpp"
+#include "ksmaudio/audio_effect/detail/spsc_queue.hpp"
+
+/// @brief BT/FX/LASERボタンの押下・離上を発生時刻付きで記録する
+/// @note Windowsではキーボード入力を専用スレッドでフレームとは非同期にポーリングし、フレームレートに依存しない時刻で記録する。
+///       ゲームパッド入力、およびWindows以外の環境でのキーボード入力は、pollFrameInputs()呼び出し時のSiv3Dの入力状態を、そのフレームの開始時刻(前回のpollFrameInputs()の時刻)で記録する。
+///       そのため、これらの入力は当該フレームの最初のティックで反映され、実際の発生時刻より最大1フレーム早い時刻で判定される
+class TimestampedButtonInput
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/// @brief ボタン入力イベント
+	struct Event
+	{
+		KeyConfig::Button button = KeyConfig::kUnspecifiedButton;
+
+		// true:押した, false:離した
+		bool pressed = false;
+
+		Clock::time_point time;
+	};
+
+	/// @brief 記録対象のボタン数(kBT_A～kRightLaserR)
+	static constexpr std::size_t kNumButtons = static_cast<std::size_t>(KeyConfig::kRightLaserR) + 1U;
+
+private:
+	using ButtonMask = uint32;
+
+	static_assert(kNumButtons <= sizeof(ButtonMask) * 8U);
+
+	/// @brief 押下状態の変化(入力スレッド・フレーム毎のポーリングで共通)
+	struct PressedMaskEvent
+	{
+		ButtonMask pressedMask = 0U;
+
+		Clock::time_point time;
+	};
+
+	// 入力スレッドでポーリングするキーコード(ボタン毎)
+	// (構築後は変更しないため、入力スレッドから参照してよい)
+	std::array<Array<uint8>, kNumButtons> m_threadKeyCodes;
+
+	// pollFrameInputs()でSiv3Dの入力状態を参照する入力(ボタン毎)
+	std::array<Array<Input>, kNumButtons> m_frameInputs;
+
+	ksmaudio::AudioEffect::detail::SPSCQueue<PressedMaskEvent, 1024U> m_threadEventQueue;
+
+	// 入力スレッドでの最新の押下状態(キューが溢れた場合の復帰用)
+	std::atomic<ButtonMask> m_latestThreadPressedMask = 0U;
+
+	std::atomic<bool> m_isThreadEventQueueOverflowed = false;
+
+	std::atomic<bool> m_isWindowFocused = true;
+
+	// 入力スレッドから受け取ったものの、まだupdate()の時刻に達していないイベント
+	Array<PressedMaskEvent> m_pendingThreadEvents;
+
+	// pollFrameInputs()で検出したものの、まだupdate()の時刻に達していないイベント
+	Array<PressedMaskEvent> m_pendingFrameEvents;
+
+	ButtonMask m_threadPressedMask = 0U;
+
+	ButtonMask m_framePressedMask = 0U;
+
+	// 直前のpollFrameInputs()での押下状態
+	ButtonMask m_polledFramePressedMask = 0U;
+
+	// 直前のpollFrameInputs()の時刻(今回のフレームの開始時刻として使用する。初回はnone)
+	Optional<Clock::time_point> m_prevFramePollTime = none;
+
+	ButtonMask m_pressedMask = 0U;
+
+	Array<Event> m_events;
+
+	// Note: デストラクタで最初に停止・joinされるよう、メンバ変数の最後に置く必要がある
+	std::jthread m_thread;
+
+	void threadMain(std::stop_token stopToken);
+
+	void applyPressedMask(Clock::time_point time);
+
+public:
+	TimestampedButtonInput();
+
+	TimestampedButtonInput(const TimestampedButtonInput&) = delete;
+
+	TimestampedButtonInput& operator=(const TimestampedButtonInput&) = delete;
+
+	/// @brief 入力スレッドの対象外のデバイスの入力状態を取得する
+	/// @param frameTime フレームの時刻(入力状態の変化は前回の呼び出し時のframeTime、つまりこのフレームの開始時刻で記録される)
+	/// @note 描画フレーム毎に、そのフレームのupdate()より前に呼ぶ
+	void pollFrameInputs(Clock::time_point frameTime);
+
+	/// @brief イベントを取り出す
+	/// @param sampleTime この時刻以前に発生したイベントを取り出す
+	void update(Clock::time_point sampleTime);
+
+	/// @brief 直前のupdate()で取り出したイベントを発生順に返す
+	/// @return イベントの配列
+	const Array<Event>& events() const;
+
+	/// @brief 直前のupdate()の時刻時点でボタンを押しているかどうか
+	/// @param button ボタン
+	/// @return 押している場合はtrue
+	bool pressed(KeyConfig::Button button) const;
+};
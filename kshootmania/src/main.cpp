@@ -1,6 +1,7 @@
 ﻿#include <Siv3D.hpp>
 #include <CoTaskLib.hpp>
 #include "common/frame_rate_limit.hpp"
+#include "common/frame_profiler.hpp"
 #include "common/ime_utils.hpp"
 #include "addon/auto_mute_addon.hpp"
 #include "ksmaudio/ksmaudio.hpp"
@@ -61,6 +62,9 @@ void Main()
 	// アセット一覧を登録
 	AssetManagement::RegisterAssets();
 
+	// フレーム内の各処理の所要時間の計測(有効時のみプレー画面に表示)
+	FrameProfiler::SetEnabled(ConfigIni::GetBool(ConfigIni::Key::kFrameProfiler, false));
+
 	// フレームレート制限
 	Graphics::SetVSyncEnabled(false);
 	Addon::Register(U"FrameRateLimit", std::make_unique<FrameRateLimit>(300), -100);
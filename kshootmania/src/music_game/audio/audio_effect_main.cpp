@@ -34,6 +34,9 @@ namespace MusicGame::Audio
 		void RegisterAudioEffects(BGM& bgm, const kson::ChartData& chartData, const kson::TimingCache& timingCache)
 		{
 			using AudioEffectUtils::PrecalculateUpdateTriggerTiming;
+			using AudioEffectUtils::MaxWaveLengthSec;
+			using AudioEffectUtils::MaxFlangerDelaySec;
+			using AudioEffectUtils::MaxAudioEffectDurationSec;
 
 			const std::int64_t totalMeasures =
 				kson::SecToMeasureIdx(bgm.duration().count(), chartData.beat, timingCache)
@@ -93,6 +96,26 @@ namespace MusicGame::Audio
 					: std::unordered_map<std::string, std::map<float, std::string>>{};
 
 				bgm.emplaceAudioEffectFX(name, def, paramChanges, updateTriggerTiming);
+
+				if (def.type == kson::AudioEffectType::Retrigger || def.type == kson::AudioEffectType::Echo)
+				{
+					const float maxWaveLengthSec = paramChangeDict.contains(name)
+						? MaxWaveLengthSec(name, def, paramChangeDict.at(name), chartData, true)
+						: MaxWaveLengthSec(name, def, {}, chartData, true);
+					bgm.reserveAudioEffectDelayTimeFX(name, maxWaveLengthSec);
+				}
+				else if (def.type == kson::AudioEffectType::Flanger)
+				{
+					const float maxDelaySec = paramChangeDict.contains(name)
+						? MaxFlangerDelaySec(name, def, paramChangeDict.at(name), chartData, true)
+						: MaxFlangerDelaySec(name, def, {}, chartData, true);
+					bgm.reserveAudioEffectDelayTimeFX(name, maxDelaySec);
+				}
+				else if (def.type == kson::AudioEffectType::Tapestop)
+				{
+					// テープストップ中のディレイタイムは有効になっている時間とほぼ同じだけ伸びるため、その分を確保する
+					bgm.reserveAudioEffectDelayTimeFX(name, MaxAudioEffectDurationSec(chartData, timingCache, true));
+				}
 			}
 
 			// Laser
@@ -114,6 +137,26 @@ namespace MusicGame::Audio
 					: std::unordered_map<std::string, std::map<float, std::string>>{};
 
 				bgm.emplaceAudioEffectLaser(name, def, paramChanges, updateTriggerTiming);
+
+				if (def.type == kson::AudioEffectType::Retrigger || def.type == kson::AudioEffectType::Echo)
+				{
+					const float maxWaveLengthSec = paramChangeDict.contains(name)
+						? MaxWaveLengthSec(name, def, paramChangeDict.at(name), chartData, false)
+						: MaxWaveLengthSec(name, def, {}, chartData, false);
+					bgm.reserveAudioEffectDelayTimeLaser(name, maxWaveLengthSec);
+				}
+				else if (def.type == kson::AudioEffectType::Flanger)
+				{
+					const float maxDelaySec = paramChangeDict.contains(name)
+						? MaxFlangerDelaySec(name, def, paramChangeDict.at(name), chartData, false)
+						: MaxFlangerDelaySec(name, def, {}, chartData, false);
+					bgm.reserveAudioEffectDelayTimeLaser(name, maxDelaySec);
+				}
+				else if (def.type == kson::AudioEffectType::Tapestop)
+				{
+					// テープストップ中のディレイタイムは有効になっている時間とほぼ同じだけ伸びるため、その分を確保する
+					bgm.reserveAudioEffectDelayTimeLaser(name, MaxAudioEffectDurationSec(chartData, timingCache, false));
+				}
 			}
 		}
 
@@ -292,10 +335,8 @@ namespace MusicGame::Audio
 	{
 	}
 
-	void AudioEffectMain::update(BGM& bgm, const kson::ChartData& chartData, const kson::TimingCache& timingCache, const AudioEffectInputStatus& inputStatus)
+	void AudioEffectMain::update(BGM& bgm, const kson::ChartData& chartData, const kson::TimingCache& timingCache, double currentTimeSec, const AudioEffectInputStatus& inputStatus)
 	{
-		// TODO: SecondsFに統一
-		const double currentTimeSec = bgm.posSec().count();
 		const double currentTimeSecForAudio = currentTimeSec + bgm.latency().count(); // Note: In BASS v2.4.13 and later, for unknown reasons, the effects are out of sync even after adding this latency.
 		const kson::Pulse currentPulseForAudio = kson::SecToPulse(currentTimeSecForAudio, chartData.beat, timingCache);
 		const double currentBPMForAudio = kson::TempoAt(currentPulseForAudio, chartData.beat);
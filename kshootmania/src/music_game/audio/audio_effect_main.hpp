@@ -46,6 +46,6 @@ namespace MusicGame::Audio
 	public:
 		AudioEffectMain(BGM& bgm, const kson::ChartData& chartData, const kson::TimingCache& timingCache);
 
-		void update(BGM& bgm, const kson::ChartData& chartData, const kson::TimingCache& timingCache, const AudioEffectInputStatus& inputStatus);
+		void update(BGM& bgm, const kson::ChartData& chartData, const kson::TimingCache& timingCache, double currentTimeSec, const AudioEffectInputStatus& inputStatus);
 	};
 }
@@ -10,6 +10,78 @@ namespace MusicGame::Audio::AudioEffectUtils
 
 		const std::string kUpdateTriggerKey = "update_trigger";
 
+		const std::string kWaveLengthKey = "wave_length";
+
+		const std::string kDelayKey = "delay";
+
+		const std::string kDepthKey = "depth";
+
+		// 音声エフェクトが有効になり得る時間に加える余裕(秒)
+		// (ロングFXノーツの自動再生やLASERの判定によるずれを考慮したもの)
+		constexpr float kAudioEffectDurationMarginSec = 0.5f;
+
+		float MaxLengthSec(const std::string& str, double minBPM)
+		{
+			const auto valueSet = ksmaudio::AudioEffect::StrToValueSet(ksmaudio::AudioEffect::Type::kLength, str);
+			float maxSec = 0.0f;
+			for (const float value : { valueSet.off, valueSet.onMin, valueSet.onMax })
+			{
+				// 正の値は小節単位、負の値は秒単位(ksmaudio::AudioEffect::GetValue()を参照)
+				const float sec = value > 0.0f ? static_cast<float>(value * 4 * 60 / minBPM) : -value;
+				maxSec = (std::max)(maxSec, sec);
+			}
+			return maxSec;
+		}
+
+		float MaxSamples(const std::string& str)
+		{
+			const auto valueSet = ksmaudio::AudioEffect::StrToValueSet(ksmaudio::AudioEffect::Type::kSample, str);
+			return (std::max)({ valueSet.off, valueSet.onMin, valueSet.onMax, 0.0f });
+		}
+
+		// エフェクト定義・パラメータ変更・ロングFXノーツ毎のパラメータ上書きで指定されるパラメータの値の文字列を列挙する
+		template <typename Func>
+		void ForEachParamValueStr(
+			const std::string& audioEffectName,
+			const std::string& paramName,
+			const kson::AudioEffectDef& def,
+			const kson::Dict<kson::ByPulse<std::string>>& paramChange,
+			const kson::ChartData& chartData,
+			bool isFX,
+			Func func)
+		{
+			// エフェクト定義
+			if (def.v.contains(paramName))
+			{
+				func(def.v.at(paramName));
+			}
+
+			// パラメータ変更
+			if (paramChange.contains(paramName))
+			{
+				for (const auto& [y, value] : paramChange.at(paramName))
+				{
+					func(value);
+				}
+			}
+
+			// ロングFXノーツ毎のパラメータ上書き
+			const auto& longEvent = chartData.audio.audioEffect.fx.longEvent;
+			if (isFX && longEvent.contains(audioEffectName))
+			{
+				for (const auto& lane : longEvent.at(audioEffectName))
+				{
+					for (const auto& [y, dict] : lane)
+					{
+						if (dict.contains(paramName))
+						{
+							func(dict.at(paramName));
+						}
+					}
+				}
+			}
+		}
+
 		kson::RelPulse UpdatePeriodDy(const std::string& str)
 		{
 			return static_cast<kson::RelPulse>(kson::kResolution4 * ksmaudio::AudioEffect::StrToValueSet(ksmaudio::AudioEffect::Type::kLength, str).onMin);
@@ -209,4 +281,93 @@ namespace MusicGame::Audio::AudioEffectUtils
 			return {};
 		}
 	}
+
+	float MaxWaveLengthSec(
+		const std::string& audioEffectName,
+		const kson::AudioEffectDef& def,
+		const kson::Dict<kson::ByPulse<std::string>>& paramChange,
+		const kson::ChartData& chartData,
+		bool isFX)
+	{
+		double minBPM = 0.0;
+		for (const auto& [y, bpm] : chartData.beat.bpm)
+		{
+			if (bpm > 0.0 && (minBPM == 0.0 || bpm < minBPM))
+			{
+				minBPM = bpm;
+			}
+		}
+		if (minBPM == 0.0)
+		{
+			return 0.0f;
+		}
+
+		float maxSec = 0.0f;
+		ForEachParamValueStr(audioEffectName, kWaveLengthKey, def, paramChange, chartData, isFX, [&maxSec, minBPM](const std::string& str)
+		{
+			maxSec = (std::max)(maxSec, MaxLengthSec(str, minBPM));
+		});
+		return maxSec;
+	}
+
+	float MaxFlangerDelaySec(
+		const std::string& audioEffectName,
+		const kson::AudioEffectDef& def,
+		const kson::Dict<kson::ByPulse<std::string>>& paramChange,
+		const kson::ChartData& chartData,
+		bool isFX)
+	{
+		float maxDelaySamples = 0.0f;
+		float maxDepthSamples = 0.0f;
+		ForEachParamValueStr(audioEffectName, kDelayKey, def, paramChange, chartData, isFX, [&maxDelaySamples](const std::string& str)
+		{
+			maxDelaySamples = (std::max)(maxDelaySamples, MaxSamples(str));
+		});
+		ForEachParamValueStr(audioEffectName, kDepthKey, def, paramChange, chartData, isFX, [&maxDepthSamples](const std::string& str)
+		{
+			maxDepthSamples = (std::max)(maxDepthSamples, MaxSamples(str));
+		});
+
+		// サンプル数は44.1kHz換算の値(ksmaudio::AudioEffect::FlangerDSPを参照)
+		return (maxDelaySamples + maxDepthSamples) / 44100.0f;
+	}
+
+	float MaxAudioEffectDurationSec(
+		const kson::ChartData& chartData,
+		const kson::TimingCache& timingCache,
+		bool isFX)
+	{
+		double maxSec = 0.0;
+		if (isFX)
+		{
+			for (const auto& lane : chartData.note.fx)
+			{
+				for (const auto& [y, note] : lane)
+				{
+					if (note.length > 0)
+					{
+						const double sec = kson::PulseToSec(y + note.length, chartData.beat, timingCache) - kson::PulseToSec(y, chartData.beat, timingCache);
+						maxSec = (std::max)(maxSec, sec);
+					}
+				}
+			}
+		}
+		else
+		{
+			for (const auto& lane : chartData.note.laser)
+			{
+				for (const auto& [y, section] : lane)
+				{
+					if (section.v.empty())
+					{
+						continue;
+					}
+					const kson::RelPulse sectionLength = section.v.rbegin()->first;
+					const double sec = kson::PulseToSec(y + sectionLength, chartData.beat, timingCache) - kson::PulseToSec(y, chartData.beat, timingCache);
+					maxSec = (std::max)(maxSec, sec);
+				}
+			}
+		}
+		return maxSec > 0.0 ? static_cast<float>(maxSec) + kAudioEffectDurationMarginSec : 0.0f;
+	}
 }
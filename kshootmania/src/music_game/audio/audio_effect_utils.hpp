@@ -17,4 +17,29 @@ namespace MusicGame::Audio::AudioEffectUtils
 		std::int64_t totalMeasures,
 		const kson::ChartData& chartData,
 		const kson::TimingCache& timingCache);
+
+	// 譜面中で指定されるwave_lengthの最大秒数を求める
+	// (Retrigger・Echoの遅延バッファを事前に確保するために使用。BPMは譜面中の最小値で換算する)
+	float MaxWaveLengthSec(
+		const std::string& audioEffectName,
+		const kson::AudioEffectDef& def,
+		const kson::Dict<kson::ByPulse<std::string>>& paramChange,
+		const kson::ChartData& chartData,
+		bool isFX);
+
+	// 譜面中で指定されるflangerのdelayとdepthの合計の最大秒数を求める
+	// (Flangerの遅延バッファを事前に確保するために使用)
+	float MaxFlangerDelaySec(
+		const std::string& audioEffectName,
+		const kson::AudioEffectDef& def,
+		const kson::Dict<kson::ByPulse<std::string>>& paramChange,
+		const kson::ChartData& chartData,
+		bool isFX);
+
+	// 音声エフェクトが連続して有効になり得る最大秒数(最長のロングFXノーツ、またはLASERセクションの長さに余裕を加えたもの)を求める
+	// (Tapestopの遅延バッファを事前に確保するために使用)
+	float MaxAudioEffectDurationSec(
+		const kson::ChartData& chartData,
+		const kson::TimingCache& timingCache,
+		bool isFX);
 }
@@ -73,8 +73,24 @@ namespace MusicGame::Audio
 		}
 	}
 
+	void BGM::reserveAudioEffectDelayTimeImpl(bool isFX, const std::string& name, float maxDelaySec)
+	{
+		if (m_stream.numChannels() == 0)
+		{
+			// ロード失敗時は音声エフェクトが追加されていない
+			return;
+		}
+
+		const auto pAudioEffectBus = isFX ? m_pAudioEffectBusFX : m_pAudioEffectBusLaser;
+		if (!pAudioEffectBus->audioEffectContainsName(name))
+		{
+			return;
+		}
+		pAudioEffectBus->reserveDelayTime(pAudioEffectBus->audioEffectNameToIdx(name), maxDelaySec);
+	}
+
 	BGM::BGM(FilePathView filePath, double volume, SecondsF offset)
-		: m_stream(filePath.narrow(), volume, true, true)
+		: m_stream(filePath.narrow(), volume, true, true, ksmaudio::AudioEffectDSPMode::kFused)
 		, m_duration(m_stream.duration())
 		, m_offset(offset)
 		, m_pAudioEffectBusFX(m_stream.emplaceAudioEffectBusFX())
@@ -82,6 +98,9 @@ namespace MusicGame::Audio
 		, m_stopwatch(StartImmediately::No)
 		, m_manualUpdateStopwatch(StartImmediately::Yes)
 	{
+		// 音声エフェクトのパラメータは譜面上の時間で更新されるため、ストリーム上の位置へ変換するためのオフセットを渡す
+		m_pAudioEffectBusFX->setStreamTimeOffset(m_offset.count());
+		m_pAudioEffectBusLaser->setStreamTimeOffset(m_offset.count());
 	}
 
 	void BGM::update()
@@ -212,6 +231,16 @@ namespace MusicGame::Audio
 		emplaceAudioEffectImpl(false, name, def, paramChanges, updateTriggerTiming);
 	}
 
+	void BGM::reserveAudioEffectDelayTimeFX(const std::string& name, float maxDelaySec)
+	{
+		reserveAudioEffectDelayTimeImpl(true, name, maxDelaySec);
+	}
+
+	void BGM::reserveAudioEffectDelayTimeLaser(const std::string& name, float maxDelaySec)
+	{
+		reserveAudioEffectDelayTimeImpl(false, name, maxDelaySec);
+	}
+
 	const ksmaudio::AudioEffect::AudioEffectBus& BGM::audioEffectBusFX() const
 	{
 		return *m_pAudioEffectBusFX;
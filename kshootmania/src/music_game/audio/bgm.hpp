@@ -25,6 +25,8 @@ namespace MusicGame::Audio
 			const std::unordered_map<std::string, std::map<float, std::string>>& paramChanges,
 			const std::set<float>& updateTriggerTiming);
 
+		void reserveAudioEffectDelayTimeImpl(bool isFX, const std::string& name, float maxDelaySec);
+
 	public:
 		BGM(FilePathView filePath, double volume, SecondsF offset);
 
@@ -59,6 +61,11 @@ namespace MusicGame::Audio
 			const std::unordered_map<std::string, std::map<float, std::string>>& paramChanges,
 			const std::set<float>& updateTriggerTiming = {});
 
+		// 譜面中で使用される最大のディレイタイム(秒)をもとに、音声エフェクトの遅延バッファを事前に確保する
+		void reserveAudioEffectDelayTimeFX(const std::string& name, float maxDelaySec);
+
+		void reserveAudioEffectDelayTimeLaser(const std::string& name, float maxDelaySec);
+
 		const ksmaudio::AudioEffect::AudioEffectBus& audioEffectBusFX() const;
 
 		const ksmaudio::AudioEffect::AudioEffectBus& audioEffectBusLaser() const;
@@ -6,6 +6,8 @@ namespace MusicGame
 {
 	namespace
 	{
+		constexpr FilePathView kFrameProfilerCSVFilePath = U"frame_profile.csv";
+
 		constexpr double kPlayFinishFadeOutStartSec = 2.4; // TODO: HARD落ちした場合は赤色表示を加えた上で4.8秒にする
 
 		bool ShouldStartFadeOut(const GameStatus& gameStatus)
@@ -20,41 +22,83 @@ namespace MusicGame
 		}
 	}
 
-	void GameMain::updateStatus()
+	void GameMain::setCurrentTime(double currentTimeSec, std::chrono::steady_clock::time_point currentTimeSampledAt)
 	{
-		// 曲の音声の更新
-		m_bgm.update();
-
-		// 再生時間と現在のBPMを取得
-		// TODO: SecondsFに統一
-		const double currentTimeSec = m_bgm.posSec().count();
 		const kson::Pulse currentPulse = kson::SecToPulse(currentTimeSec, m_chartData.beat, m_timingCache);
 		const double currentPulseDouble = kson::SecToPulseDouble(currentTimeSec, m_chartData.beat, m_timingCache);
 		const double currentBPM = kson::TempoAt(currentPulse, m_chartData.beat);
 		m_gameStatus.currentTimeSec = currentTimeSec;
+		m_gameStatus.currentTimeSampledAt = currentTimeSampledAt;
 		m_gameStatus.currentPulse = currentPulse;
 		m_gameStatus.currentPulseDouble = currentPulseDouble;
 		m_gameStatus.currentBPM = currentBPM;
+	}
 
-		// 視点変更を更新
-		// (CamStatusにノーツイベントによる値が相対的に反映されるので、判定の更新より先に実行する必要がある)
-		m_camSystem.update(m_chartData, m_gameStatus.currentPulse);
-		m_viewStatus.camStatus = m_camSystem.status();
-
-		// 傾きを更新
-		m_highwayTilt.update(m_chartData, m_gameStatus.currentPulse);
-		m_viewStatus.tiltRadians = m_highwayTilt.radians();
+	void GameMain::tickSimulation(double tickTimeSec, std::chrono::steady_clock::time_point tickTimeSampledAt)
+	{
+		setCurrentTime(tickTimeSec, tickTimeSampledAt);
 
 		// 判定の更新
-		m_judgmentMain.update(m_chartData, m_gameStatus, m_viewStatus);
+		{
+			const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kJudgment);
+			m_judgmentMain.update(m_chartData, m_gameStatus);
+		}
 		if (!m_gameStatus.playFinishStatus.has_value() && m_judgmentMain.isFinished())
 		{
 			m_gameStatus.playFinishStatus = PlayFinishStatus
 			{
-				.finishTimeSec = currentTimeSec,
+				.finishTimeSec = tickTimeSec,
 				.achievement = m_judgmentMain.playResult().achievement(),
 			};
 		}
+
+		// 効果音の更新
+		m_assistTick.update(m_chartData, m_timingCache, tickTimeSec);
+		m_laserSlamSE.update(m_chartData, m_gameStatus);
+	}
+
+	void GameMain::updateAudioEffect(double frameTimeSec)
+	{
+		// 音声エフェクトの更新
+		std::array<Optional<bool>, kson::kNumFXLanesSZ> longFXPressed;
+		for (std::size_t i = 0U; i < kson::kNumFXLanesSZ; ++i)
+		{
+			longFXPressed[i] = m_gameStatus.fxLaneStatus[i].longNotePressed;
+		}
+		std::array<bool, kson::kNumLaserLanesSZ> laserIsOnOrNone;
+		for (std::size_t i = 0U; i < kson::kNumLaserLanesSZ; ++i)
+		{
+			const auto& laneStatus = m_gameStatus.laserLaneStatus[i];
+			laserIsOnOrNone[i] = !laneStatus.noteCursorX.has_value() || laneStatus.isCursorInCriticalJudgmentRange();
+		}
+		{
+			const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kAudioEffect);
+			m_audioEffectMain.update(m_bgm, m_chartData, m_timingCache, frameTimeSec, {
+				.longFXPressed = longFXPressed,
+				.laserIsOnOrNone = laserIsOnOrNone,
+			});
+		}
+	}
+
+	void GameMain::updateStatus(double frameTimeSec, std::chrono::steady_clock::time_point frameTimeSampledAt)
+	{
+		// 描画用に時刻をフレームの時刻に合わせる
+		// (判定等の状態は直前のティック時点のものだが、スクロール位置等の時刻に連続的に依存する表示はフレームの時刻で描画する)
+		setCurrentTime(frameTimeSec, frameTimeSampledAt);
+
+		const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kCamera);
+
+		// 視点変更を更新
+		// (CamStatusに判定の状態による値が相対的に反映されるので、判定の状態の反映より先に実行する必要がある)
+		m_camSystem.update(m_chartData, m_gameStatus.currentPulse);
+		m_viewStatus.camStatus = m_camSystem.status();
+
+		// 傾きを更新
+		m_highwayTilt.update(m_chartData, m_gameStatus.currentPulse);
+		m_viewStatus.tiltRadians = m_highwayTilt.radians();
+
+		// 判定の状態をViewStatusに反映
+		m_judgmentMain.applyToViewStatus(m_gameStatus, m_viewStatus);
 	}
 
 	void GameMain::updateHighwayScroll()
@@ -76,7 +120,7 @@ namespace MusicGame
 		, m_chartData(kson::LoadKSHChartData(createInfo.chartFilePath.narrow()))
 		, m_timingCache(kson::CreateTimingCache(m_chartData.beat))
 		, m_judgmentMain(m_chartData, m_timingCache, createInfo.playOption)
-		, m_highwayScroll(m_chartData)
+		, m_highwayScroll(m_chartData, m_timingCache)
 		, m_bgm(FileSystem::PathAppend(m_parentPath, Unicode::FromUTF8(m_chartData.audio.bgm.filename)), m_chartData.audio.bgm.vol, SecondsF{ static_cast<double>(m_chartData.audio.bgm.offset) / 1000 })
 		, m_assistTick(createInfo.assistTickEnabled)
 		, m_laserSlamSE(m_chartData)
@@ -89,41 +133,47 @@ namespace MusicGame
 	{
 		m_bgm.seekPosSec(-TimeSecBeforeStart(false/* TODO: movie */));
 		m_bgm.play();
+
+		// 処理時間の計測結果はプレー中のもののみ記録する
+		FrameProfiler::StartRecording();
 	}
 
 	GameMain::StartFadeOutYN GameMain::update()
 	{
-		// 状態更新
-		updateStatus();
+		const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kGameUpdate);
 
-		// スクロールの更新
-		updateHighwayScroll();
+		// 曲の音声の更新
+		m_bgm.update();
+		const auto frameTimeSampledAt = std::chrono::steady_clock::now();
+
+		// 再生時間を取得
+		// TODO: SecondsFに統一
+		const double frameTimeSec = m_bgm.posSec().count();
+
+		// ゲームパッド等のフレーム毎に取得する入力はフレームの開始時刻で記録
+		// (このフレームの最初のティックから反映される)
+		m_judgmentMain.pollFrameInputs(frameTimeSampledAt);
+
+		// 判定・効果音を一定間隔のティックで更新
+		// (描画のフレームレートに依存せず同じ結果になるよう、描画とは切り離して更新する)
+		m_simulationTicker.advance(frameTimeSec, frameTimeSampledAt, [this](double tickTimeSec, std::chrono::steady_clock::time_point tickTimeSampledAt)
+			{
+				tickSimulation(tickTimeSec, tickTimeSampledAt);
+			});
 
 		// 音声エフェクトの更新
-		std::array<Optional<bool>, kson::kNumFXLanesSZ> longFXPressed;
-		for (std::size_t i = 0U; i < kson::kNumFXLanesSZ; ++i)
-		{
-			longFXPressed[i] = m_gameStatus.fxLaneStatus[i].longNotePressed;
-		}
-		std::array<bool, kson::kNumLaserLanesSZ> laserIsOnOrNone;
-		for (std::size_t i = 0U; i < kson::kNumLaserLanesSZ; ++i)
-		{
-			const auto& laneStatus = m_gameStatus.laserLaneStatus[i];
-			laserIsOnOrNone[i] = !laneStatus.noteCursorX.has_value() || laneStatus.isCursorInCriticalJudgmentRange();
-		}
-		m_audioEffectMain.update(m_bgm, m_chartData, m_timingCache, {
-			.longFXPressed = longFXPressed,
-			.laserIsOnOrNone = laserIsOnOrNone,
-		});
+		// (パラメータはDSP側でストリーム上の位置に合わせて適用されるため、ティック毎ではなくフレーム毎に更新する)
+		updateAudioEffect(frameTimeSec);
 
-		// 効果音の更新
-		// TODO: SecondsFに統一
-		const double currentTimeSec = m_bgm.posSec().count();
-		m_assistTick.update(m_chartData, m_timingCache, currentTimeSec);
-		m_laserSlamSE.update(m_chartData, m_gameStatus);
+		// 描画用の状態更新
+		updateStatus(frameTimeSec, frameTimeSampledAt);
+
+		// スクロールの更新
+		updateHighwayScroll();
 
 		// グラフィックの更新
-		m_graphicsMain.update(m_viewStatus);
+		const Scroll::HighwayScrollContext highwayScrollContext(&m_highwayScroll, &m_gameStatus);
+		m_graphicsMain.update(m_chartData, m_gameStatus, m_viewStatus, highwayScrollContext);
 
 		m_isFirstUpdate = false;
 
@@ -134,7 +184,7 @@ namespace MusicGame
 	{
 		// HighwayScrollのコンテキスト
 		// (HighwayScrollからの座標取得の引数を省略するためのもの)
-		const Scroll::HighwayScrollContext highwayScrollContext(&m_highwayScroll, &m_chartData.beat, &m_timingCache, &m_gameStatus);
+		const Scroll::HighwayScrollContext highwayScrollContext(&m_highwayScroll, &m_gameStatus);
 
 		// 描画実行
 		m_graphicsMain.draw(m_chartData, m_timingCache, m_gameStatus, m_viewStatus, highwayScrollContext);
@@ -148,6 +198,13 @@ namespace MusicGame
 	void GameMain::terminate()
 	{
 		m_hispeedSettingMenu.saveToConfigIni();
+
+		// 計測有効時はプレー終了時点の計測結果をオフライン解析用に書き出す
+		if (FrameProfiler::IsEnabled())
+		{
+			FrameProfiler::DumpCSV(kFrameProfilerCSVFilePath);
+		}
+		FrameProfiler::StopRecording();
 	}
 
 	FilePathView GameMain::chartFilePath() const
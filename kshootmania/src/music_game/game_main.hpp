@@ -2,6 +2,7 @@
 #include "game_status.hpp"
 #include "play_option.hpp"
 #include "play_result.hpp"
+#include "simulation_ticker.hpp"
 #include "judgment/judgment_main.hpp"
 #include "camera/highway_tilt.hpp"
 #include "scroll/hispeed_setting.hpp"
@@ -72,7 +73,16 @@ namespace MusicGame
 		ViewStatus m_viewStatus;
 		bool m_isFinishedPrev = false;
 
-		void updateStatus();
+		// 判定・効果音を一定間隔で更新するためのティック
+		SimulationTicker m_simulationTicker;
+
+		void setCurrentTime(double currentTimeSec, std::chrono::steady_clock::time_point currentTimeSampledAt);
+
+		void tickSimulation(double tickTimeSec, std::chrono::steady_clock::time_point tickTimeSampledAt);
+
+		void updateAudioEffect(double frameTimeSec);
+
+		void updateStatus(double frameTimeSec, std::chrono::steady_clock::time_point frameTimeSampledAt);
 
 		void updateHighwayScroll();
 
@@ -116,6 +116,11 @@ namespace MusicGame
 		// TODO: 描画に使用するものは完全にViewStatusへ移動する(エディタ上でのプレビュー時にViewStatusさえ構築すればプレビューできるようにする想定)
 
 		double currentTimeSec = 0.0;
+
+		// currentTimeSecを取得した時点の時刻
+		// (入力の発生時刻をBGMの再生位置に換算するために使用)
+		std::chrono::steady_clock::time_point currentTimeSampledAt;
+
 		kson::Pulse currentPulse = 0;
 		double currentPulseDouble = 0.0;
 		double currentBPM = 120.0;
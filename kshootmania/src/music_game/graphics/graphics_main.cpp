@@ -59,29 +59,29 @@ namespace MusicGame::Graphics
 			return filePath;
 		}
 
-		std::array<Array<RenderTexture>, 2> SplitLayerTexture(FilePathView layerFilePath)
+		/// @brief レイヤーアニメーションの指定フレームを切り出すUV座標を設定したビルボードのメッシュデータを返す
+		/// @param layerTextureSize レイヤーアニメーションのテクスチャ全体のサイズ
+		/// @param row 行(0: 通常, 1: ゲージが一定以上の場合)
+		/// @param frameIdx フレーム番号(列)
+		/// @return メッシュデータ
+		MeshData LayerFrameMeshData(const Size& layerTextureSize, int32 row, int32 frameIdx)
 		{
-			const TiledTexture tiledTexture(Texture(layerFilePath),
-				{
-					.row = TiledTextureSizeInfo::kAutoDetect,
-					.column = TiledTextureSizeInfo::kAutoDetect,
-					.sourceSize = kLayerFrameTextureSize,
-				});
-
-			std::array<Array<RenderTexture>, 2> renderTextures;
-			for (int32 i = 0; i < 2; ++i)
+			// 隣のフレームのピクセルを拾わないよう、UV座標は0.5ピクセル内側に寄せる
+			const Float2 uvOrigin = {
+				(static_cast<float>(kLayerFrameTextureSize.x * frameIdx) + 0.5f) / layerTextureSize.x,
+				(static_cast<float>(kLayerFrameTextureSize.y * row) + 0.5f) / layerTextureSize.y,
+			};
+			const Float2 uvSize = {
+				(static_cast<float>(kLayerFrameTextureSize.x) - 1.0f) / layerTextureSize.x,
+				(static_cast<float>(kLayerFrameTextureSize.y) - 1.0f) / layerTextureSize.y,
+			};
+
+			MeshData meshData = MeshData::Billboard();
+			for (auto& vertex : meshData.vertices)
 			{
-				renderTextures[i].reserve(tiledTexture.column());
-				for (int32 j = 0; j < tiledTexture.column(); ++j)
-				{
-					const RenderTexture renderTexture(kLayerFrameTextureSize, Palette::Black);
-					const ScopedRenderTarget2D renderTarget(renderTexture);
-					Shader::Copy(tiledTexture(i, j), renderTexture);
-					renderTextures[i].push_back(std::move(renderTexture));
-				}
+				vertex.tex = uvOrigin + vertex.tex * uvSize;
 			}
-
-			return renderTextures;
+			return meshData;
 		}
 	}
 
@@ -92,7 +92,26 @@ namespace MusicGame::Graphics
 		m_bgBillboardMesh.draw(m_bgTransform * TiltTransformMatrix(bgTiltRadians, kBGBillboardPosition), m_bgTexture);
 	}
 
-	void GraphicsMain::drawLayer(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus) const
+	void GraphicsMain::updateLayerMesh(const GameStatus& gameStatus)
+	{
+		if (m_numLayerFrames <= 0)
+		{
+			return;
+		}
+
+		// フレームが変化した場合のみメッシュのUV座標を更新
+		// TODO: Layer speed specified by KSH
+		// TODO: Use different layer texture row depending on gauge percentage
+		const int32 layerFrameIdx = MathUtils::WrappedMod(static_cast<int32>(gameStatus.currentPulse * 1000 / 35 / kson::kResolution4), m_numLayerFrames);
+		if (layerFrameIdx == m_layerMeshFrameIdx)
+		{
+			return;
+		}
+		m_layerMesh.fill(LayerFrameMeshData(m_layerTexture.size(), 0, layerFrameIdx));
+		m_layerMeshFrameIdx = layerFrameIdx;
+	}
+
+	void GraphicsMain::drawLayer(const kson::ChartData& chartData, const ViewStatus& viewStatus) const
 	{
 		const ScopedRenderStates3D samplerState(SamplerState::ClampNearest);
 		const ScopedRenderStates3D renderState(BlendState::Additive);
@@ -103,12 +122,9 @@ namespace MusicGame::Graphics
 			layerTiltRadians += viewStatus.tiltRadians * 0.8 + Math::ToRadians(viewStatus.camStatus.rotationZLayer);
 		}
 
-		// TODO: Layer speed specified by KSH
-		// TODO: Use different layer texture index depending on gauge percentage
-		if (!m_layerFrameTextures[0].empty())
+		if (m_layerMeshFrameIdx.has_value())
 		{
-			const int32 layerFrame = MathUtils::WrappedMod(static_cast<int32>(gameStatus.currentPulse * 1000 / 35 / kson::kResolution4), static_cast<int32>(m_layerFrameTextures[0].size()));
-			m_bgBillboardMesh.draw(m_layerTransform * TiltTransformMatrix(layerTiltRadians, kLayerBillboardPosition), m_layerFrameTextures[0].at(layerFrame));
+			m_layerMesh.draw(m_layerTransform * TiltTransformMatrix(layerTiltRadians, kLayerBillboardPosition), m_layerTexture);
 		}
 	}
 
@@ -117,37 +133,45 @@ namespace MusicGame::Graphics
 		, m_bgBillboardMesh(MeshData::Billboard())
 		, m_bgTexture(BGFilePath(chartData, parentPath))
 		, m_bgTransform(m_camera.billboard(kBGBillboardPosition, kBGBillboardSize))
-		, m_layerFrameTextures(SplitLayerTexture(LayerFilePath(chartData, parentPath)))
+		, m_layerTexture(LayerFilePath(chartData, parentPath))
+		, m_numLayerFrames(m_layerTexture.width() / kLayerFrameTextureSize.x)
+		, m_layerMesh(MeshData::Billboard())
 		, m_layerTransform(m_camera.billboard(kLayerBillboardPosition, kLayerBillboardSize))
+		, m_highway3DGraphics(chartData)
 		, m_jdgoverlay3DGraphics(m_camera)
 		, m_songInfoPanel(chartData, parentPath)
 		, m_gaugePanel(playOption.gaugeType)
 	{
 	}
 
-	void GraphicsMain::update(const ViewStatus& viewStatus)
+	void GraphicsMain::update(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext)
 	{
+		updateLayerMesh(gameStatus);
 		m_comboOverlay.update(viewStatus);
-		m_highway3DGraphics.update(viewStatus);
+		m_highway3DGraphics.update(chartData, gameStatus, viewStatus, highwayScrollContext);
 	}
 
 	void GraphicsMain::draw(const kson::ChartData& chartData, const kson::TimingCache& timingCache, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext) const
 	{
 		// 各レンダーテクスチャを用意
-		m_highway3DGraphics.draw2D(chartData, timingCache, gameStatus, viewStatus, highwayScrollContext);
+		{
+			const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kHighwayRenderTexture);
+			m_highway3DGraphics.draw2D(chartData, timingCache, gameStatus, viewStatus, highwayScrollContext);
+		}
 		m_jdgoverlay3DGraphics.draw2D(gameStatus, viewStatus);
 		Graphics2D::Flush();
 
 		// 3D空間を描画
 		Graphics3D::SetCameraTransform(m_camera);
 		drawBG(viewStatus);
-		drawLayer(chartData, gameStatus, viewStatus);
+		drawLayer(chartData, viewStatus);
 		m_highway3DGraphics.draw3D(gameStatus, viewStatus);
 		m_jdgline3DGraphics.draw3D(gameStatus, viewStatus);
 		m_jdgoverlay3DGraphics.draw3D(gameStatus, viewStatus);
 		m_laserCursor3DGraphics.draw3D(gameStatus, viewStatus, m_camera);
 
 		// 手前に表示する2DのHUDを描画
+		const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kHUD);
 		m_songInfoPanel.draw(gameStatus.currentBPM, highwayScrollContext);
 		m_scorePanel.draw(viewStatus.score);
 		m_gaugePanel.draw(viewStatus.gaugePercentage, gameStatus.currentPulse);
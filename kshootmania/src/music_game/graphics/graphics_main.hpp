@@ -26,7 +26,10 @@ namespace MusicGame::Graphics
 		const Mesh m_bgBillboardMesh;
 		Texture m_bgTexture;
 		const Mat4x4 m_bgTransform;
-		std::array<Array<RenderTexture>, 2> m_layerFrameTextures;
+		const Texture m_layerTexture; // 全フレームが横に並んだ1枚のテクスチャ(フレームごとに分割せず、UV座標で切り出して使用)
+		const int32 m_numLayerFrames;
+		DynamicMesh m_layerMesh;
+		Optional<int32> m_layerMeshFrameIdx = none; // m_layerMeshのUV座標に反映済みのフレーム番号
 		const Mat4x4 m_layerTransform;
 
 		Highway3DGraphics m_highway3DGraphics;
@@ -44,12 +47,14 @@ namespace MusicGame::Graphics
 
 		void drawBG(const ViewStatus& viewStatus) const;
 
-		void drawLayer(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus) const;
+		void updateLayerMesh(const GameStatus& gameStatus);
+
+		void drawLayer(const kson::ChartData& chartData, const ViewStatus& viewStatus) const;
 
 	public:
 		explicit GraphicsMain(const kson::ChartData& chartData, FilePathView parentPath, const PlayOption& playOption);
 
-		void update(const ViewStatus& viewStatus);
+		void update(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext);
 
 		void draw(const kson::ChartData& chartData, const kson::TimingCache& timingCache, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext) const;
 	};
@@ -10,16 +10,6 @@ namespace MusicGame::Graphics
 		constexpr StringView kShineEffectTextureFilename = U"lanelight.gif";
 		constexpr StringView kBarLineTextureFilename = U"bline.gif";
 
-		// カメラ座標と判定ラインを線で結んだ場合の垂直からの角度
-		// (値の根拠は不明だが、KSMv1でこの値が使用されていたためそのまま持ってきている)
-		constexpr double kCameraToJdglineRadians = -0.6125;
-
-		constexpr double kJdglineYFromBottom = 14;
-
-		constexpr double kPlaneHeight = kHighwayPlaneSize.y;
-		constexpr double kPlaneHeightBelowJdgline = kPlaneHeight * kJdglineYFromBottom / kHighwayTextureSize.y;
-		constexpr double kPlaneHeightAboveJdgline = kPlaneHeight - kPlaneHeightBelowJdgline;
-
 		// UV座標の縮め幅(端にテクスチャの折り返しピクセルが見える現象の対策)
 		constexpr float kUVShrinkX = 0.0075f;
 		constexpr float kUVShrinkY = 0.005f;
@@ -35,46 +25,53 @@ namespace MusicGame::Graphics
 		constexpr Vec2 kBarLinePositionOffset = { kHighwayTextureWideCenterX - kBarLineTextureHalfSize.x, -14 };
 		constexpr ColorF kBarLineColor = Color{ 110 };
 
-		constexpr double kHighwayRotationXByCamera = ToRadians(60.0);
+		// HighwayMeshMathはSiv3Dに依存しないよう値を別途定義しているため、ここで一致を確認する
+		static_assert(HighwayMeshMath::kHighwayTextureHeight == kHighwayTextureSize.y);
+		static_assert(HighwayMeshMath::kPlaneHeight == kHighwayPlaneSize.y);
 	}
 
-	Highway3DGraphics::Highway3DGraphics()
+	Highway3DGraphics::Highway3DGraphics(const kson::ChartData& chartData)
 		: m_shineEffectTexture(TextureAsset(kShineEffectTextureFilename))
 		, m_barLineTexture(TextureAsset(kBarLineTextureFilename))
+		, m_laserNoteGraphics(chartData)
 		, m_meshData(MeshData::Grid({ 0.0, 0.0, 0.0 }, kHighwayPlaneSizeWide, 1, 1, { 1.0f - kUVShrinkX, 1.0f - kUVShrinkY }, { kUVShrinkX / 2, kUVShrinkY / 2 }))
 		, m_mesh(m_meshData) // DynamicMesh::fill()で頂点データの配列サイズが動的に変更される訳ではないのでこの初期化は必須
 	{
 	}
 
-	void Highway3DGraphics::update(const ViewStatus& viewStatus)
+	void Highway3DGraphics::update(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext)
 	{
+		// ノーツの描画開始位置を更新
+		m_buttonNoteGraphics.update(chartData, gameStatus, highwayScrollContext);
+
 		// メッシュの頂点座標を更新
-		// HSP版の該当箇所: https://github.com/m4saka/kshootmania-v1-hsp/blob/d2811a09e2d75dad5cc152d7c4073897061addb7/src/scene/play/play_draw_frame.hsp#L779-L821
-
-		const auto& camStatus = viewStatus.camStatus;
-		const double zoom = Camera::ScaledCamZoomValue(camStatus.zoom);
-		const double rotationX = ToRadians(camStatus.rotationX * 360 / 2400);
-		const double sinRotationX = Sin(rotationX);
-		const double cosRotationX = Cos(rotationX);
-
-		m_meshData.vertices[0].pos.y = kPlaneHeightAboveJdgline * sinRotationX / 2.5; // 奥の辺 上方向
-		m_meshData.vertices[1].pos.y = m_meshData.vertices[0].pos.y;
-		m_meshData.vertices[2].pos.y = -zoom * 100 * Sin(kCameraToJdglineRadians) * kPlaneHeight / kPlaneHeightAboveJdgline - kPlaneHeightBelowJdgline * sinRotationX / 2.5; // 手前の辺 上方向
-		m_meshData.vertices[3].pos.y = m_meshData.vertices[2].pos.y;
-		m_meshData.vertices[0].pos.z = -kPlaneHeightAboveJdgline / 2 + kPlaneHeightAboveJdgline * cosRotationX; // 奥の辺 手前方向
-		m_meshData.vertices[1].pos.z = m_meshData.vertices[0].pos.z;
-		m_meshData.vertices[2].pos.z = -kPlaneHeightAboveJdgline / 2 - kPlaneHeightBelowJdgline / 2 * cosRotationX - zoom * 100 * Cos(kCameraToJdglineRadians) * kPlaneHeight / kPlaneHeightAboveJdgline; // 手前の辺 手前方向
-		m_meshData.vertices[3].pos.z = m_meshData.vertices[2].pos.z;
-
-		const double rotationXMod = MathUtils::WrappedFmod(rotationX, Math::TwoPi);
-		const bool shouldFlipTriangles = Math::Pi - kHighwayRotationXByCamera <= rotationXMod && rotationXMod < Math::TwoPi - kHighwayRotationXByCamera;
-		if (shouldFlipTriangles != m_trianglesFlipped)
+		// (頂点座標はzoomとrotationXのみに依存するので、前回から変化がなければGPUへの転送は不要)
+		const HighwayMeshMath::VertexInputs vertexInputs{
+			.scaledZoom = Camera::ScaledCamZoomValue(viewStatus.camStatus.zoom),
+			.rotationX = viewStatus.camStatus.rotationX,
+		};
+		if (vertexInputs != m_prevMeshVertexInputs)
 		{
-			m_meshData.flipTriangles();
-			m_trianglesFlipped = shouldFlipTriangles;
-		}
+			m_prevMeshVertexInputs = vertexInputs;
+
+			const HighwayMeshMath::VertexPositions vertexPositions = HighwayMeshMath::CalculateVertexPositions(vertexInputs);
+			m_meshData.vertices[0].pos.y = static_cast<float>(vertexPositions.farY);
+			m_meshData.vertices[1].pos.y = m_meshData.vertices[0].pos.y;
+			m_meshData.vertices[2].pos.y = static_cast<float>(vertexPositions.nearY);
+			m_meshData.vertices[3].pos.y = m_meshData.vertices[2].pos.y;
+			m_meshData.vertices[0].pos.z = static_cast<float>(vertexPositions.farZ);
+			m_meshData.vertices[1].pos.z = m_meshData.vertices[0].pos.z;
+			m_meshData.vertices[2].pos.z = static_cast<float>(vertexPositions.nearZ);
+			m_meshData.vertices[3].pos.z = m_meshData.vertices[2].pos.z;
+
+			if (vertexPositions.trianglesFlipped != m_trianglesFlipped)
+			{
+				m_meshData.flipTriangles();
+				m_trianglesFlipped = vertexPositions.trianglesFlipped;
+			}
 
-		m_mesh.fill(m_meshData);
+			m_mesh.fill(m_meshData);
+		}
 	}
 
 	void Highway3DGraphics::draw2D(const kson::ChartData& chartData, const kson::TimingCache& timingCache, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext) const
@@ -147,13 +144,19 @@ namespace MusicGame::Graphics
 		}
 
 		// BT/FXノーツの描画
-		m_buttonNoteGraphics.draw(chartData, gameStatus, viewStatus, highwayScrollContext, m_renderTexture);
+		{
+			const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kNoteDraw);
+			m_buttonNoteGraphics.draw(viewStatus, m_renderTexture);
+		}
 
 		// キービームの描画
 		m_keyBeamGraphics.draw(gameStatus, viewStatus, m_renderTexture);
 
 		// レーザーノーツの描画
-		m_laserNoteGraphics.draw(chartData, gameStatus, highwayScrollContext, m_renderTexture);
+		{
+			const FrameProfiler::ScopedTimer profilerTimer(FrameProfiler::Section::kNoteDraw);
+			m_laserNoteGraphics.draw(gameStatus, highwayScrollContext, m_renderTexture);
+		}
 	}
 
 	void Highway3DGraphics::draw3D(const GameStatus& gameStatus, const ViewStatus& viewStatus) const
@@ -3,6 +3,7 @@
 #include "music_game/view_status.hpp"
 #include "music_game/scroll/highway_scroll.hpp"
 #include "highway_render_texture.hpp"
+#include "highway_mesh_math.hpp"
 #include "key_beam_graphics.hpp"
 #include "note/button_note_graphics.hpp"
 #include "note/laser_note_graphics.hpp"
@@ -17,7 +18,7 @@ namespace MusicGame::Graphics
 
 		const HighwayRenderTexture m_renderTexture;
 
-		const ButtonNoteGraphics m_buttonNoteGraphics;
+		ButtonNoteGraphics m_buttonNoteGraphics;
 		const LaserNoteGraphics m_laserNoteGraphics;
 
 		const KeyBeamGraphics m_keyBeamGraphics;
@@ -26,10 +27,13 @@ namespace MusicGame::Graphics
 		DynamicMesh m_mesh;
 		bool m_trianglesFlipped = false;
 
+		/// @brief 前回メッシュの頂点座標を更新した時点のカメラの値(変化がなければ頂点データの転送を省略する)
+		Optional<HighwayMeshMath::VertexInputs> m_prevMeshVertexInputs = none;
+
 	public:
-		Highway3DGraphics();
+		explicit Highway3DGraphics(const kson::ChartData& chartData);
 
-		void update(const ViewStatus& viewStatus);
+		void update(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext);
 
 		void draw2D(const kson::ChartData& chartData, const kson::TimingCache& timingCache, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext) const;
 
@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <cmath>
+#include <numbers>
+
+// Highwayのメッシュの頂点座標の計算
+// Note: 描画なしでテストできるよう、Siv3D・graphics_defines.hppに依存しないようにしている
+//       (graphics_defines.hppの値との一致はhighway_3d_graphics.cppのstatic_assertで確認している)
+namespace MusicGame::Graphics::HighwayMeshMath
+{
+	// カメラ座標と判定ラインを線で結んだ場合の垂直からの角度
+	// (値の根拠は不明だが、KSMv1でこの値が使用されていたためそのまま持ってきている)
+	constexpr double kCameraToJdglineRadians = -0.6125;
+
+	constexpr double kJdglineYFromBottom = 14;
+
+	// kHighwayTextureSize.yと同じ値
+	constexpr double kHighwayTextureHeight = 1024;
+
+	// kHighwayPlaneSize.yと同じ値(floatで計算してからdoubleにする)
+	constexpr double kPlaneHeight = 936.0f * 13 / 20;
+	constexpr double kPlaneHeightBelowJdgline = kPlaneHeight * kJdglineYFromBottom / kHighwayTextureHeight;
+	constexpr double kPlaneHeightAboveJdgline = kPlaneHeight - kPlaneHeightBelowJdgline;
+
+	constexpr double kTwoPi = std::numbers::pi * 2;
+
+	/// @brief 度数法の角度を弧度法に変換する(Siv3DのToRadiansと同じ計算)
+	/// @param degrees 度数法の角度
+	/// @return 弧度法の角度
+	constexpr double DegreesToRadians(double degrees)
+	{
+		return degrees * (std::numbers::pi / 180);
+	}
+
+	constexpr double kHighwayRotationXByCamera = DegreesToRadians(60.0);
+
+	/// @brief Highwayのメッシュの頂点座標の計算に使用するカメラの値
+	struct VertexInputs
+	{
+		/// @brief Camera::ScaledCamZoomValue()で変換済みのzoomの値
+		double scaledZoom = 0.0;
+
+		double rotationX = 0.0;
+
+		bool operator==(const VertexInputs&) const = default;
+	};
+
+	/// @brief Highwayのメッシュの頂点座標(奥の辺・手前の辺のそれぞれのY座標・Z座標)
+	struct VertexPositions
+	{
+		double farY = 0.0;
+
+		double farZ = 0.0;
+
+		double nearY = 0.0;
+
+		double nearZ = 0.0;
+
+		/// @brief 三角形の向きを反転すべきかどうか(Highwayを裏側から見る角度の場合にtrue)
+		bool trianglesFlipped = false;
+	};
+
+	/// @brief カメラの値からHighwayのメッシュの頂点座標を求める
+	/// @param inputs カメラの値
+	/// @return 頂点座標
+	/// @note GPUへのアップロードとは独立しているので、描画なしで呼び出せる
+	/// @note HSP版の該当箇所: https://github.com/m4saka/kshootmania-v1-hsp/blob/d2811a09e2d75dad5cc152d7c4073897061addb7/src/scene/play/play_draw_frame.hsp#L779-L821
+	inline VertexPositions CalculateVertexPositions(const VertexInputs& inputs)
+	{
+		const double zoom = inputs.scaledZoom;
+		const double rotationX = DegreesToRadians(inputs.rotationX * 360 / 2400);
+		const double sinRotationX = std::sin(rotationX);
+		const double cosRotationX = std::cos(rotationX);
+
+		// rotationXを0～2πの範囲に変換
+		double rotationXMod = std::fmod(rotationX, kTwoPi);
+		if (rotationXMod < 0.0)
+		{
+			rotationXMod += kTwoPi;
+		}
+
+		return {
+			.farY = kPlaneHeightAboveJdgline * sinRotationX / 2.5, // 奥の辺 上方向
+			.farZ = -kPlaneHeightAboveJdgline / 2 + kPlaneHeightAboveJdgline * cosRotationX, // 奥の辺 手前方向
+			.nearY = -zoom * 100 * std::sin(kCameraToJdglineRadians) * kPlaneHeight / kPlaneHeightAboveJdgline - kPlaneHeightBelowJdgline * sinRotationX / 2.5, // 手前の辺 上方向
+			.nearZ = -kPlaneHeightAboveJdgline / 2 - kPlaneHeightBelowJdgline / 2 * cosRotationX - zoom * 100 * std::cos(kCameraToJdglineRadians) * kPlaneHeight / kPlaneHeightAboveJdgline, // 手前の辺 手前方向
+			.trianglesFlipped = std::numbers::pi - kHighwayRotationXByCamera <= rotationXMod && rotationXMod < kTwoPi - kHighwayRotationXByCamera,
+		};
+	}
+}
@@ -22,21 +22,49 @@ namespace MusicGame::Graphics
 		{
 			return (MathUtils::WrappedFmod(currentTimeSec, 0.1) < 0.05) ? kLongNoteSourceYPressed1 : kLongNoteSourceYPressed2;
 		}
+
+		/// @brief 描画開始位置のPulse値を画面外へ通過済みのノーツの分だけ進める
+		/// @param lane 対象レーンのノーツ
+		/// @param drawStartPulse 描画開始位置のPulse値
+		/// @param currentPulse 現在のPulse値
+		/// @param highwayScrollContext HighwayScrollのコンテキスト
+		/// @return 更新後の描画開始位置のPulse値
+		kson::Pulse AdvanceDrawStartPulse(const kson::ByPulse<kson::Interval>& lane, kson::Pulse drawStartPulse, kson::Pulse currentPulse, const Scroll::HighwayScrollContext& highwayScrollContext)
+		{
+			auto itr = lane.lower_bound(drawStartPulse);
+			while (itr != lane.end())
+			{
+				const auto& [y, note] = *itr;
+				const kson::Pulse endY = y + note.length;
+				if (endY >= currentPulse)
+				{
+					// 判定ラインをまだ通過していないノーツ以降は画面内に残っている可能性がある
+					break;
+				}
+				if (highwayScrollContext.getPositionY(endY) < kHighwayTextureSize.y)
+				{
+					// 判定ラインを通過済みでもHighwayの下端に達していなければ描画対象
+					break;
+				}
+				++itr;
+			}
+			return itr == lane.end() ? (lane.empty() ? drawStartPulse : lane.rbegin()->first + 1) : itr->first;
+		}
 	}
 
-	void ButtonNoteGraphics::drawChipNotesCommon(const kson::ChartData& chartData, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target, bool isBT) const
+	void ButtonNoteGraphics::updateChipNoteDrawItems(const kson::ChartData& chartData, const Scroll::HighwayScrollContext& highwayScrollContext, bool isBT)
 	{
-		const ScopedRenderTarget2D renderTarget(target.additiveTexture());
-		const ScopedRenderStates2D samplerState(SamplerState::ClampNearest);
+		Array<ChipNoteDrawItem>& drawItems = isBT ? m_chipBTDrawItems : m_chipFXDrawItems;
+		drawItems.clear();
 
 		const std::size_t numLanes = isBT ? kson::kNumBTLanesSZ : kson::kNumFXLanesSZ;
 		for (std::size_t laneIdx = 0; laneIdx < numLanes; ++laneIdx)
 		{
 			const auto& lane = isBT ? chartData.note.bt[laneIdx] : chartData.note.fx[laneIdx];
-			const double centerSplitShiftX = Camera::CenterSplitShiftX(viewStatus.camStatus.centerSplit) * ((laneIdx >= numLanes / 2) ? 1 : -1);
-			const Vec2 offsetPosition = kLanePositionOffset + (isBT ? kBTLanePositionDiff : kFXLanePositionDiff) * static_cast<double>(laneIdx);
-			for (const auto& [y, note] : lane)
+			const kson::Pulse drawStartPulse = isBT ? m_btDrawStartPulses[laneIdx] : m_fxDrawStartPulses[laneIdx];
+			for (auto itr = lane.lower_bound(drawStartPulse); itr != lane.end(); ++itr)
 			{
+				const auto& [y, note] = *itr;
 				const int32 positionStartY = highwayScrollContext.getPositionY(y);
 				if (positionStartY < 0)
 				{
@@ -55,37 +83,29 @@ namespace MusicGame::Graphics
 
 				const double yRate = static_cast<double>(kHighwayTextureSize.y - positionStartY) / kHighwayTextureSize.y;
 				const int32 height = NoteGraphicsUtils::ChipNoteHeight(yRate);
-				const TiledTexture& sourceTexture = isBT ? m_chipBTNoteTexture : m_chipFXNoteTexture;
-				const Vec2 position = offsetPosition + Vec2::Right(centerSplitShiftX) + Vec2::Down(positionStartY - height / 2);
-				sourceTexture() // TODO: Chip BT color
-					.resized(isBT ? 40 : 82, height)
-					.draw(position);
+				drawItems.push_back({
+					.laneIdx = static_cast<int32>(laneIdx),
+					.positionY = positionStartY - height / 2,
+					.height = height,
+				});
 			}
 		}
 	}
 
-	void ButtonNoteGraphics::drawChipBTNotes(const kson::ChartData& chartData, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const
+	void ButtonNoteGraphics::updateLongNoteDrawItems(const kson::ChartData& chartData, const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext, bool isBT)
 	{
-		drawChipNotesCommon(chartData, viewStatus, highwayScrollContext, target, true);
-	}
-
-	void ButtonNoteGraphics::drawChipFXNotes(const kson::ChartData& chartData, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const
-	{
-		drawChipNotesCommon(chartData, viewStatus, highwayScrollContext, target, false);
-	}
-
-	void ButtonNoteGraphics::drawLongNotesCommon(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target, bool isBT) const
-	{
-		const ScopedRenderStates2D samplerState(SamplerState::ClampNearest);
+		Array<LongNoteDrawItem>& drawItems = isBT ? m_longBTDrawItems : m_longFXDrawItems;
+		drawItems.clear();
 
 		const std::size_t numLanes = isBT ? kson::kNumBTLanesSZ : kson::kNumFXLanesSZ;
-		for (int32 laneIdx = 0; laneIdx < numLanes; ++laneIdx)
+		for (std::size_t laneIdx = 0; laneIdx < numLanes; ++laneIdx)
 		{
 			const auto& lane = isBT ? chartData.note.bt[laneIdx] : chartData.note.fx[laneIdx];
-			const double centerSplitShiftX = Camera::CenterSplitShiftX(viewStatus.camStatus.centerSplit) * ((laneIdx >= numLanes / 2) ? 1 : -1);
-			const Vec2 offsetPosition = kLanePositionOffset + (isBT ? kBTLanePositionDiff : kFXLanePositionDiff) * laneIdx;
-			for (const auto& [y, note] : lane)
+			const ButtonLaneStatus& laneStatus = isBT ? gameStatus.btLaneStatus[laneIdx] : gameStatus.fxLaneStatus[laneIdx];
+			const kson::Pulse drawStartPulse = isBT ? m_btDrawStartPulses[laneIdx] : m_fxDrawStartPulses[laneIdx];
+			for (auto itr = lane.lower_bound(drawStartPulse); itr != lane.end(); ++itr)
 			{
+				const auto& [y, note] = *itr;
 				const int32 positionStartY = highwayScrollContext.getPositionY(y);
 				if (positionStartY < 0)
 				{
@@ -111,48 +131,101 @@ namespace MusicGame::Graphics
 					continue;
 				}
 
-				const int32 numColumns = isBT ? kNumTextureColumnsMainSub : 1; // ロングBTノーツの場合はinvMultiply用のテクスチャ列が追加で存在する
-				for (int32 i = 0; i < numColumns; ++i)
+				double sourceY;
+				if (laneStatus.currentLongNotePulse == y)
+				{
+					// 現在判定対象の押下中のロングノーツ
+					sourceY = PressedLongNoteSourceY(gameStatus.currentTimeSec);
+				}
+				else if (y <= gameStatus.currentPulse && gameStatus.currentPulse < y + note.length)
+				{
+					// 現在判定対象だが押していないロングノーツ
+					sourceY = kLongNoteSourceYNotPressed;
+				}
+				else
 				{
-					const ScopedRenderTarget2D renderTarget((i == 0) ? target.additiveTexture() : target.invMultiplyTexture());
-					const ScopedRenderStates2D blendState((i == 0) ? (isBT ? BlendState::Additive : BlendState::Default2D) : BlendState::Subtractive);
-					const ButtonLaneStatus& laneStatus = isBT ? gameStatus.btLaneStatus[laneIdx] : gameStatus.fxLaneStatus[laneIdx];
-					double sourceY;
-					if (laneStatus.currentLongNotePulse == y)
-					{
-						// 現在判定対象の押下中のロングノーツ
-						sourceY = PressedLongNoteSourceY(gameStatus.currentTimeSec);
-					}
-					else if (y <= gameStatus.currentPulse && gameStatus.currentPulse < y + note.length)
-					{
-						// 現在判定対象だが押していないロングノーツ
-						sourceY = kLongNoteSourceYNotPressed;
-					}
-					else
-					{
-						// 現在判定対象でないロングノーツ
-						sourceY = kLongNoteSourceYDefault;
-					}
-					// TODO: 始点テクスチャの描画
-					const Texture& sourceTexture = isBT ? m_longBTNoteTexture : m_longFXNoteTexture;
-					const int32 width = isBT ? 40 : 82;
-					const Vec2 position = offsetPosition + Vec2::Right(centerSplitShiftX) + Vec2::Down(positionEndY);
-					sourceTexture(width * i, sourceY + kOnePixelTextureSourceOffset, width, kOnePixelTextureSourceSize)
-						.resized(width, height)
-						.draw(position);
+					// 現在判定対象でないロングノーツ
+					sourceY = kLongNoteSourceYDefault;
 				}
+
+				drawItems.push_back({
+					.laneIdx = static_cast<int32>(laneIdx),
+					.positionY = positionEndY,
+					.height = height,
+					.sourceY = sourceY,
+				});
 			}
 		}
 	}
 
-	void ButtonNoteGraphics::drawLongBTNotes(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const
+	void ButtonNoteGraphics::drawChipNotesCommon(const ViewStatus& viewStatus, const HighwayRenderTexture& target, bool isBT) const
 	{
-		drawLongNotesCommon(chartData, gameStatus, viewStatus, highwayScrollContext, target, true);
+		// 同じテクスチャ・描画ステートでの描画を連続させることで、Siv3D側で1回の描画呼び出しにまとめられるようにしている
+		const ScopedRenderTarget2D renderTarget(target.additiveTexture());
+		const ScopedRenderStates2D samplerState(SamplerState::ClampNearest);
+
+		const int32 numLanes = static_cast<int32>(isBT ? kson::kNumBTLanesSZ : kson::kNumFXLanesSZ);
+		const double centerSplitShiftX = Camera::CenterSplitShiftX(viewStatus.camStatus.centerSplit);
+		const TiledTexture& sourceTexture = isBT ? m_chipBTNoteTexture : m_chipFXNoteTexture;
+		const TextureRegion sourceTextureRegion = sourceTexture(); // TODO: Chip BT color
+		const int32 width = isBT ? 40 : 82;
+		for (const ChipNoteDrawItem& item : isBT ? m_chipBTDrawItems : m_chipFXDrawItems)
+		{
+			const Vec2 offsetPosition = kLanePositionOffset + (isBT ? kBTLanePositionDiff : kFXLanePositionDiff) * static_cast<double>(item.laneIdx);
+			const Vec2 position = offsetPosition + Vec2::Right(centerSplitShiftX * ((item.laneIdx >= numLanes / 2) ? 1 : -1)) + Vec2::Down(item.positionY);
+			sourceTextureRegion
+				.resized(width, item.height)
+				.draw(position);
+		}
 	}
 
-	void ButtonNoteGraphics::drawLongFXNotes(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const
+	void ButtonNoteGraphics::drawChipBTNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const
 	{
-		drawLongNotesCommon(chartData, gameStatus, viewStatus, highwayScrollContext, target, false);
+		drawChipNotesCommon(viewStatus, target, true);
+	}
+
+	void ButtonNoteGraphics::drawChipFXNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const
+	{
+		drawChipNotesCommon(viewStatus, target, false);
+	}
+
+	void ButtonNoteGraphics::drawLongNotesCommon(const ViewStatus& viewStatus, const HighwayRenderTexture& target, bool isBT) const
+	{
+		const ScopedRenderStates2D samplerState(SamplerState::ClampNearest);
+
+		const int32 numLanes = static_cast<int32>(isBT ? kson::kNumBTLanesSZ : kson::kNumFXLanesSZ);
+		const double centerSplitShiftX = Camera::CenterSplitShiftX(viewStatus.camStatus.centerSplit);
+		const Texture& sourceTexture = isBT ? m_longBTNoteTexture : m_longFXNoteTexture;
+		const int32 width = isBT ? 40 : 82;
+		const Array<LongNoteDrawItem>& drawItems = isBT ? m_longBTDrawItems : m_longFXDrawItems;
+
+		// 描画先・ブレンドステートの切り替えはテクスチャ列ごとに1回のみ行い、その中で全ノーツを連続して描画する
+		// (ノーツごとに切り替えるとSiv3D側で描画呼び出しがまとめられなくなるため)
+		const int32 numColumns = isBT ? kNumTextureColumnsMainSub : 1; // ロングBTノーツの場合はinvMultiply用のテクスチャ列が追加で存在する
+		for (int32 i = 0; i < numColumns; ++i)
+		{
+			const ScopedRenderTarget2D renderTarget((i == 0) ? target.additiveTexture() : target.invMultiplyTexture());
+			const ScopedRenderStates2D blendState((i == 0) ? (isBT ? BlendState::Additive : BlendState::Default2D) : BlendState::Subtractive);
+			for (const LongNoteDrawItem& item : drawItems)
+			{
+				// TODO: 始点テクスチャの描画
+				const Vec2 offsetPosition = kLanePositionOffset + (isBT ? kBTLanePositionDiff : kFXLanePositionDiff) * item.laneIdx;
+				const Vec2 position = offsetPosition + Vec2::Right(centerSplitShiftX * ((item.laneIdx >= numLanes / 2) ? 1 : -1)) + Vec2::Down(item.positionY);
+				sourceTexture(width * i, item.sourceY + kOnePixelTextureSourceOffset, width, kOnePixelTextureSourceSize)
+					.resized(width, item.height)
+					.draw(position);
+			}
+		}
+	}
+
+	void ButtonNoteGraphics::drawLongBTNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const
+	{
+		drawLongNotesCommon(viewStatus, target, true);
+	}
+
+	void ButtonNoteGraphics::drawLongFXNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const
+	{
+		drawLongNotesCommon(viewStatus, target, false);
 	}
 
 	ButtonNoteGraphics::ButtonNoteGraphics()
@@ -169,13 +242,46 @@ namespace MusicGame::Graphics
 			}))
 		, m_longFXNoteTexture(TextureAsset(kLongFXNoteTextureFilename))
 	{
+		resetDrawStartPulses();
+	}
+
+	void ButtonNoteGraphics::resetDrawStartPulses()
+	{
+		m_btDrawStartPulses.fill(kPastPulse);
+		m_fxDrawStartPulses.fill(kPastPulse);
+	}
+
+	void ButtonNoteGraphics::update(const kson::ChartData& chartData, const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext)
+	{
+		// 巻き戻り(シーク・リスタート)時やハイスピード変更時は通過済みのノーツが画面内に戻る可能性があるので先頭からやり直す
+		const int32 currentHispeed = highwayScrollContext.highwayScroll().currentHispeed();
+		if (gameStatus.currentPulse < m_prevPulse || currentHispeed != m_prevHispeed)
+		{
+			resetDrawStartPulses();
+		}
+		m_prevPulse = gameStatus.currentPulse;
+		m_prevHispeed = currentHispeed;
+
+		for (std::size_t laneIdx = 0U; laneIdx < kson::kNumBTLanesSZ; ++laneIdx)
+		{
+			m_btDrawStartPulses[laneIdx] = AdvanceDrawStartPulse(chartData.note.bt[laneIdx], m_btDrawStartPulses[laneIdx], gameStatus.currentPulse, highwayScrollContext);
+		}
+		for (std::size_t laneIdx = 0U; laneIdx < kson::kNumFXLanesSZ; ++laneIdx)
+		{
+			m_fxDrawStartPulses[laneIdx] = AdvanceDrawStartPulse(chartData.note.fx[laneIdx], m_fxDrawStartPulses[laneIdx], gameStatus.currentPulse, highwayScrollContext);
+		}
+		// 描画対象のノーツの座標を求める
+		updateLongNoteDrawItems(chartData, gameStatus, highwayScrollContext, false);
+		updateLongNoteDrawItems(chartData, gameStatus, highwayScrollContext, true);
+		updateChipNoteDrawItems(chartData, highwayScrollContext, false);
+		updateChipNoteDrawItems(chartData, highwayScrollContext, true);
 	}
 
-	void ButtonNoteGraphics::draw(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const
+	void ButtonNoteGraphics::draw(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const
 	{
-		drawLongFXNotes(chartData, gameStatus, viewStatus, highwayScrollContext, target);
-		drawLongBTNotes(chartData, gameStatus, viewStatus, highwayScrollContext, target);
-		drawChipFXNotes(chartData, viewStatus, highwayScrollContext, target);
-		drawChipBTNotes(chartData, viewStatus, highwayScrollContext, target);
+		drawLongFXNotes(viewStatus, target);
+		drawLongBTNotes(viewStatus, target);
+		drawChipFXNotes(viewStatus, target);
+		drawChipBTNotes(viewStatus, target);
 	}
 }
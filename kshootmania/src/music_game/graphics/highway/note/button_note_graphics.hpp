@@ -15,21 +15,63 @@ namespace MusicGame::Graphics
 		const TiledTexture m_chipFXNoteTexture;
 		const Texture m_longFXNoteTexture;
 
-		void drawChipNotesCommon(const kson::ChartData& chartData, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target, bool isBT) const;
+		/// @brief 各レーンで描画を開始するノーツのPulse値(これより前のノーツは画面外へ通過済み)
+		/// @note 現在のPulse値に合わせて単調増加し、巻き戻り時やハイスピード変更時のみリセットされる
+		std::array<kson::Pulse, kson::kNumBTLanesSZ> m_btDrawStartPulses;
+		std::array<kson::Pulse, kson::kNumFXLanesSZ> m_fxDrawStartPulses;
 
-		void drawChipBTNotes(const kson::ChartData& chartData, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const;
+		/// @brief 前回update時のPulse値(巻き戻りの検出用)
+		kson::Pulse m_prevPulse = kPastPulse;
 
-		void drawChipFXNotes(const kson::ChartData& chartData, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const;
+		/// @brief 前回update時のハイスピード値(ハイスピード変更の検出用)
+		int32 m_prevHispeed = 0;
 
-		void drawLongNotesCommon(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target, bool isBT) const;
+		/// @brief チップノーツの描画に必要な情報
+		struct ChipNoteDrawItem
+		{
+			int32 laneIdx;
+			int32 positionY;
+			int32 height;
+		};
 
-		void drawLongBTNotes(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const;
+		/// @brief ロングノーツの描画に必要な情報
+		struct LongNoteDrawItem
+		{
+			int32 laneIdx;
+			int32 positionY;
+			int32 height;
+			double sourceY;
+		};
 
-		void drawLongFXNotes(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const;
+		/// @brief 描画対象のノーツ(update()で作成し、draw()では種類ごとにまとめて描画する)
+		Array<ChipNoteDrawItem> m_chipBTDrawItems;
+		Array<ChipNoteDrawItem> m_chipFXDrawItems;
+		Array<LongNoteDrawItem> m_longBTDrawItems;
+		Array<LongNoteDrawItem> m_longFXDrawItems;
+
+		void resetDrawStartPulses();
+
+		void updateChipNoteDrawItems(const kson::ChartData& chartData, const Scroll::HighwayScrollContext& highwayScrollContext, bool isBT);
+
+		void updateLongNoteDrawItems(const kson::ChartData& chartData, const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext, bool isBT);
+
+		void drawChipNotesCommon(const ViewStatus& viewStatus, const HighwayRenderTexture& target, bool isBT) const;
+
+		void drawChipBTNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const;
+
+		void drawChipFXNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const;
+
+		void drawLongNotesCommon(const ViewStatus& viewStatus, const HighwayRenderTexture& target, bool isBT) const;
+
+		void drawLongBTNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const;
+
+		void drawLongFXNotes(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const;
 
 	public:
 		ButtonNoteGraphics();
 
-		void draw(const kson::ChartData& chartData, const GameStatus& gameStatus, const ViewStatus& viewStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const;
+		void update(const kson::ChartData& chartData, const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext);
+
+		void draw(const ViewStatus& viewStatus, const HighwayRenderTexture& target) const;
 	};
 }
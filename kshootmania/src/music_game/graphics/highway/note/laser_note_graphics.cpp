@@ -41,15 +41,15 @@ namespace MusicGame::Graphics
 			return (v * (kHighwayTextureSize.x - kLaserLineWidth) + kLaserLineWidth / 2) * xScale;
 		}
 
-		void DrawLaserLine(int32 laneIdx, int32 positionY, const kson::GraphValue& point, int32 nextPositionY, const kson::GraphValue& nextPoint, const Texture& laserNoteTexture, int32 laserNoteTextureRow, int32 xScale)
+		void DrawLaserLine(int32 laneIdx, int32 positionY, double startX, bool isStartSlam, int32 nextPositionY, double endX, const Texture& laserNoteTexture, int32 laserNoteTextureRow)
 		{
 			const Vec2 positionStart = {
-				LaserPointX(point.vf, xScale),
-				positionY - (point.v != point.vf ? kLaserTextureSize.y : 0)
+				startX,
+				positionY - (isStartSlam ? kLaserTextureSize.y : 0)
 			};
 
 			const Vec2 positionEnd = {
-				LaserPointX(nextPoint.v, xScale),
+				endX,
 				nextPositionY
 			};
 
@@ -74,20 +74,20 @@ namespace MusicGame::Graphics
 			};
 		}
 
-		void DrawLaserSlam(int32 laneIdx, int32 positionY, const kson::GraphValue& point, const Texture& laserNoteTexture, int32 laserNoteTextureRow, int32 xScale)
+		void DrawLaserSlam(int32 laneIdx, int32 positionY, double startX, double endX, const Texture& laserNoteTexture, int32 laserNoteTextureRow)
 		{
 			const Vec2 positionStart = {
-				LaserPointX(point.v, xScale),
+				startX,
 				positionY
 			};
 
 			const Vec2 positionEnd = {
-				LaserPointX(point.vf, xScale),
+				endX,
 				positionY
 			};
 
 			// 直角レーザーの角のテクスチャを描画
-			const bool isLeftToRight = (point.v < point.vf);
+			const bool isLeftToRight = (startX < endX);
 			laserNoteTexture(kLaserTextureSize.x * laneIdx, kLaserTextureSize.y * laserNoteTextureRow, kLaserTextureSize).mirrored(isLeftToRight).drawAt(positionStart + Vec2{ 0, -kLaserLineWidth / 2 });
 			laserNoteTexture(kLaserTextureSize.x * laneIdx, kLaserTextureSize.y * laserNoteTextureRow, kLaserTextureSize).mirrored(!isLeftToRight).flipped().drawAt(positionEnd + Vec2{ 0, -kLaserLineWidth / 2 });
 
@@ -96,10 +96,10 @@ namespace MusicGame::Graphics
 			quad(laserNoteTexture(kLaserTextureSize.x * laneIdx + kOnePixelTextureSourceOffset, kLaserTextureSize.y * laserNoteTextureRow, kOnePixelTextureSourceSize, kLaserTextureSize.y)).draw();
 		}
 
-		void DrawLaserSlamTail(int32 laneIdx, int32 positionY, const kson::GraphValue& point, const Texture& laserNoteTexture, int32 laserNoteTextureRow, int32 xScale)
+		void DrawLaserSlamTail(int32 laneIdx, int32 positionY, double x, const Texture& laserNoteTexture, int32 laserNoteTextureRow)
 		{
 			const Vec2 positionStart = {
-				LaserPointX(point.vf, xScale),
+				x,
 				positionY
 			};
 			const Quad quad = LaserLineQuad(positionStart + Vec2{ 0.0, -kLaserTextureSize.y }, positionStart + Vec2{ 0.0, -kLaserTextureSize.y - kLaserTailHeight });
@@ -124,90 +124,111 @@ namespace MusicGame::Graphics
 			return JudgmentStatus::kError;
 		}
 
-		void DrawLaserSection(int32 laneIdx, kson::Pulse y, const kson::LaserSection& laserSection, const Scroll::HighwayScrollContext& highwayScrollContext, const RenderTexture& target, const Texture& laserNoteTexture, int32 laserNoteTextureRow, const TextureRegion& laserStartTexture)
+		int32 LaserTextureRow(JudgmentStatus judgmentStatus, double currentTimeSec)
 		{
-			const ScopedRenderTarget2D renderTarget(target);
-
-			// はみ出しLASERの場合は描画領域を横幅2倍として扱う
-			const bool wide = laserSection.wide();
-			const int32 xScale = wide ? kLaserXScaleWide : kLaserXScaleNormal;
-			const Transformer2D transformer(Mat3x2::Translate(wide ? kLaserPositionOffsetWide : kLaserPositionOffsetNormal));
-
-			// LASERセクション内の各点をもとに描画
-			for (auto itr = laserSection.v.begin(); itr != laserSection.v.end(); ++itr)
+			switch (judgmentStatus)
 			{
-				const auto& [ry, point] = *itr;
-
-				const int32 positionY = highwayScrollContext.getPositionY(y + ry) + kLaserShiftY;
-
-				// レーザー開始テクスチャを描画
-				if (itr == laserSection.v.begin())
-				{
-					const Vec2 positionStart = {
-						LaserPointX(point.v, xScale),
-						positionY
-					};
-					laserStartTexture.draw(Arg::topCenter = positionStart);
-				}
+			case JudgmentStatus::kCritical:
+				return MathUtils::WrappedFmod(currentTimeSec, kLaserCriticalBlinkIntervalSec) < kLaserCriticalBlinkIntervalSec / 2 ? 2 : 1;
 
-				if (positionY < 0)
-				{
-					// レーザーの線を構成する2つの点(始点・終点)のうち始点が描画範囲より上にある場合は描画しない
-					// それ以降のレーザーも上にあるため描画対象外となるので、ここでreturnする
-					return;
-				}
+			case JudgmentStatus::kError:
+				return 3;
 
-				// 直角レーザーを描画
-				if (point.v != point.vf)
-				{
-					DrawLaserSlam(laneIdx, positionY, point, laserNoteTexture, laserNoteTextureRow, xScale);
-				}
+			case JudgmentStatus::kNormal:
+			default:
+				return 0;
+			}
+		}
 
-				// レーザー終端の点の場合は線を描画しない
-				const auto nextItr = std::next(itr);
-				if (nextItr == laserSection.v.end())
+		std::array<Array<LaserNoteGraphics::LaserSectionGeometry>, kson::kNumLaserLanesSZ> CreateLaserSectionGeometries(const kson::ChartData& chartData)
+		{
+			std::array<Array<LaserNoteGraphics::LaserSectionGeometry>, kson::kNumLaserLanesSZ> geometries;
+			for (std::size_t laneIdx = 0U; laneIdx < kson::kNumLaserLanesSZ; ++laneIdx)
+			{
+				const auto& lane = chartData.note.laser[laneIdx];
+				geometries[laneIdx].reserve(lane.size());
+				for (const auto& [y, laserSection] : lane)
 				{
-					// 終端が直角の場合は終端を伸ばす
-					if (point.v != point.vf)
-					{
-						DrawLaserSlamTail(laneIdx, positionY, point, laserNoteTexture, laserNoteTextureRow, xScale);
-					}
+					// はみ出しLASERの場合は描画領域を横幅2倍として扱う
+					const bool wide = laserSection.wide();
+					const int32 xScale = wide ? kLaserXScaleWide : kLaserXScaleNormal;
 
-					break;
-				}
-
-				// レーザーの2つの点をもとに線を描画
-				{
-					const auto& [nextRy, nextPoint] = *nextItr;
-					const int32 nextPositionY = highwayScrollContext.getPositionY(y + nextRy) + kLaserShiftY;
-					if (nextPositionY >= kHighwayTextureSize.y)
+					LaserNoteGraphics::LaserSectionGeometry geometry{
+						.y = y,
+						.wide = wide,
+					};
+					geometry.points.reserve(laserSection.v.size());
+					for (const auto& [ry, point] : laserSection.v)
 					{
-						// 描画範囲より下にある場合はスキップ
-						continue;
+						geometry.points.push_back({
+							.y = y + ry,
+							.x = LaserPointX(point.v, xScale),
+							.xf = LaserPointX(point.vf, xScale),
+							.isSlam = point.v != point.vf,
+						});
 					}
-					DrawLaserLine(laneIdx, positionY, point, nextPositionY, nextPoint, laserNoteTexture, laserNoteTextureRow, xScale);
+					geometries[laneIdx].push_back(std::move(geometry));
 				}
 			}
+			return geometries;
 		}
+	}
 
-		int32 LaserTextureRow(JudgmentStatus judgmentStatus, double currentTimeSec)
+	void LaserNoteGraphics::drawLaserSection(int32 laneIdx, const LaserSectionGeometry& geometry, const Array<int32>& positionYs, const RenderTexture& target, const Texture& laserNoteTexture, int32 laserNoteTextureRow, const TextureRegion& laserStartTexture) const
+	{
+		const ScopedRenderTarget2D renderTarget(target);
+		const Transformer2D transformer(Mat3x2::Translate(geometry.wide ? kLaserPositionOffsetWide : kLaserPositionOffsetNormal));
+
+		// LASERセクション内の各点をもとに描画
+		// (positionYsは描画範囲より上にある最初の点までしか求めていないので、その点で必ずreturnする)
+		for (std::size_t i = 0U; i < positionYs.size(); ++i)
 		{
-			switch (judgmentStatus)
+			const LaserPointGeometry& point = geometry.points[i];
+			const int32 positionY = positionYs[i];
+
+			// レーザー開始テクスチャを描画
+			if (i == 0U)
 			{
-			case JudgmentStatus::kCritical:
-				return MathUtils::WrappedFmod(currentTimeSec, kLaserCriticalBlinkIntervalSec) < kLaserCriticalBlinkIntervalSec / 2 ? 2 : 1;
+				laserStartTexture.draw(Arg::topCenter = Vec2{ point.x, positionY });
+			}
 
-			case JudgmentStatus::kError:
-				return 3;
+			if (positionY < 0)
+			{
+				// レーザーの線を構成する2つの点(始点・終点)のうち始点が描画範囲より上にある場合は描画しない
+				// それ以降のレーザーも上にあるため描画対象外となるので、ここでreturnする
+				return;
+			}
 
-			case JudgmentStatus::kNormal:
-			default:
-				return 0;
+			// 直角レーザーを描画
+			if (point.isSlam)
+			{
+				DrawLaserSlam(laneIdx, positionY, point.x, point.xf, laserNoteTexture, laserNoteTextureRow);
+			}
+
+			// レーザー終端の点の場合は線を描画しない
+			if (i + 1U == geometry.points.size())
+			{
+				// 終端が直角の場合は終端を伸ばす
+				if (point.isSlam)
+				{
+					DrawLaserSlamTail(laneIdx, positionY, point.xf, laserNoteTexture, laserNoteTextureRow);
+				}
+
+				break;
+			}
+
+			// レーザーの2つの点をもとに線を描画
+			const int32 nextPositionY = positionYs[i + 1U];
+			if (nextPositionY >= kHighwayTextureSize.y)
+			{
+				// 描画範囲より下にある場合はスキップ
+				continue;
 			}
+			DrawLaserLine(laneIdx, positionY, point.xf, point.isSlam, nextPositionY, geometry.points[i + 1U].x, laserNoteTexture, laserNoteTextureRow);
 		}
 	}
 
-	LaserNoteGraphics::LaserNoteGraphics()
+	LaserNoteGraphics::LaserNoteGraphics(const kson::ChartData& chartData)
 		: m_laserNoteTexture(TextureAsset(kLaserNoteTextureFilename))
 		, m_laserNoteMaskTexture(TextureAsset(kLaserNoteMaskTextureFilename))
 		, m_laserNoteStartTextures{
@@ -223,46 +244,73 @@ namespace MusicGame::Graphics
 					.column = kNumTextureColumnsMainSub,
 					.sourceSize = kLaserStartTextureSize,
 				}) }
+		, m_laserSectionGeometries(CreateLaserSectionGeometries(chartData))
 	{
 	}
 
-	void LaserNoteGraphics::draw(const kson::ChartData& chartData, const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const
+	void LaserNoteGraphics::draw(const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const
 	{
 		const ScopedRenderStates2D samplerState(SamplerState::ClampNearest);
 		const ScopedRenderStates2D renderState(BlendState::Additive);
 
+		// 各点のY座標(セクションごとに再利用)
+		Array<int32> positionYs;
+
 		// LASERノーツを描画
 		for (int32 laneIdx = 0; laneIdx < kson::kNumLaserLanes; ++laneIdx) // 座標計算で結局int32にする必要があるのでここではsize_t不使用
 		{
-			const auto& lane = chartData.note.laser[laneIdx];
+			const auto& geometries = m_laserSectionGeometries[laneIdx];
 			const auto& laneStatus = gameStatus.laserLaneStatus[laneIdx];
 
-			for (auto itr = kson::ValueItrAt(lane, gameStatus.currentPulse); itr != lane.end(); ++itr)
+			// 現在のPulse値の時点のセクション(なければ先頭のセクション)から描画
+			auto itr = std::upper_bound(geometries.begin(), geometries.end(), gameStatus.currentPulse, [](kson::Pulse pulse, const LaserSectionGeometry& geometry) { return pulse < geometry.y; });
+			if (itr != geometries.begin())
+			{
+				--itr;
+			}
+			for (; itr != geometries.end(); ++itr)
 			{
-				const auto& [y, laserSection] = *itr;
+				const LaserSectionGeometry& geometry = *itr;
+				if (geometry.points.empty())
+				{
+					continue;
+				}
 
-				const kson::RelPulse lengthRy = laserSection.v.rbegin()->first;
-				const int32 sectionEndPositionY = highwayScrollContext.getPositionY(y + lengthRy) + kLaserShiftY - kLaserTailHeight;
+				const int32 sectionEndPositionY = highwayScrollContext.getPositionY(geometry.points.back().y) + kLaserShiftY - kLaserTailHeight;
 				if (sectionEndPositionY >= kHighwayTextureSize.y)
 				{
 					// レーザーのセクション全体が描画範囲より下にある場合は描画しない
 					continue;
 				}
-				
-				const int32 sectionStartPositionY = highwayScrollContext.getPositionY(y) + kLaserShiftY;
+
+				const int32 sectionStartPositionY = highwayScrollContext.getPositionY(geometry.y) + kLaserShiftY;
 				if (sectionStartPositionY + kLaserStartTextureSize.y < 0)
 				{
 					// レーザーのセクション全体が描画範囲より上にある場合は描画しない
 					break;
 				}
 
+				// 各点のY座標を求める
+				// (加算テクスチャとマスクテクスチャの2回の描画で共通して使用するため、ここで1回だけ求める)
+				positionYs.clear();
+				for (const LaserPointGeometry& point : geometry.points)
+				{
+					const int32 positionY = highwayScrollContext.getPositionY(point.y) + kLaserShiftY;
+					positionYs.push_back(positionY);
+					if (positionY < 0)
+					{
+						// これ以降の点は描画範囲より上にあるため不要
+						break;
+					}
+				}
+
 				// LASERセクションの判定状況をもとに描画すべきテクスチャの行を取得
-				const JudgmentStatus judgmentStatus = GetLaserSectionJudgmentStatus(laneStatus, y);
+				const JudgmentStatus judgmentStatus = GetLaserSectionJudgmentStatus(laneStatus, geometry.y);
 				const int32 textureRow = LaserTextureRow(judgmentStatus, gameStatus.currentTimeSec);
 
 				// LASERセクションを描画
-				DrawLaserSection(laneIdx, y, laserSection, highwayScrollContext, target.additiveTexture(), m_laserNoteTexture, textureRow, m_laserNoteStartTextures[laneIdx](0, kTextureColumnMain));
-				DrawLaserSection(laneIdx, y, laserSection, highwayScrollContext, target.invMultiplyTexture(), m_laserNoteMaskTexture, textureRow, m_laserNoteStartTextures[laneIdx](0, kTextureColumnSub));
+				drawLaserSection(laneIdx, geometry, positionYs, target.additiveTexture(), m_laserNoteTexture, textureRow, m_laserNoteStartTextures[laneIdx](0, kTextureColumnMain));
+				drawLaserSection(laneIdx, geometry, positionYs, target.invMultiplyTexture(), m_laserNoteMaskTexture, textureRow, m_laserNoteStartTextures[laneIdx](0, kTextureColumnSub));
 			}
 		}
 	}
@@ -7,14 +7,49 @@ namespace MusicGame::Graphics
 {
 	class LaserNoteGraphics
 	{
+	public:
+		/// @brief LASERの点の描画用ジオメトリ(スクロールに依存しない部分)
+		struct LaserPointGeometry
+		{
+			/// @brief 点の絶対Pulse値
+			kson::Pulse y;
+
+			/// @brief 点の始点側のX座標
+			double x;
+
+			/// @brief 点の終点側のX座標(直角LASERでない場合はxと同じ)
+			double xf;
+
+			/// @brief 直角LASERかどうか
+			bool isSlam;
+		};
+
+		/// @brief LASERセクションの描画用ジオメトリ(スクロールに依存しない部分)
+		struct LaserSectionGeometry
+		{
+			/// @brief セクションの開始位置のPulse値
+			kson::Pulse y;
+
+			/// @brief はみ出しLASERかどうか
+			bool wide;
+
+			/// @brief セクション内の各点
+			Array<LaserPointGeometry> points;
+		};
+
 	private:
 		const Texture m_laserNoteTexture;
 		const Texture m_laserNoteMaskTexture;
 		const std::array<TiledTexture, kson::kNumLaserLanesSZ> m_laserNoteStartTextures;
 
+		/// @brief 譜面読み込み時に作成した各レーンのLASERセクションのジオメトリ(Pulse値の昇順)
+		const std::array<Array<LaserSectionGeometry>, kson::kNumLaserLanesSZ> m_laserSectionGeometries;
+
+		void drawLaserSection(int32 laneIdx, const LaserSectionGeometry& geometry, const Array<int32>& positionYs, const RenderTexture& target, const Texture& laserNoteTexture, int32 laserNoteTextureRow, const TextureRegion& laserStartTexture) const;
+
 	public:
-		LaserNoteGraphics();
+		explicit LaserNoteGraphics(const kson::ChartData& chartData);
 
-		void draw(const kson::ChartData& chartData, const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const;
+		void draw(const GameStatus& gameStatus, const Scroll::HighwayScrollContext& highwayScrollContext, const HighwayRenderTexture& target) const;
 	};
 }
@@ -61,6 +61,6 @@ namespace MusicGame::Graphics
 		comboTextureRegion.drawAt(Scene::Width() / 2 + shakeX, Scaled(300));
 
 		const NumberTextureFont& numberTextureFont = m_isNoError ? m_numberTextureFontNoError : m_numberTextureFont;
-		numberTextureFont.draw(m_numberLayout, { Scene::Width() / 2 + shakeX, Scaled(313) }, m_combo, ZeroPaddingYN::Yes);
+		m_numberCache.draw(numberTextureFont, m_numberLayout, { Scene::Width() / 2 + shakeX, Scaled(313) }, m_combo, ZeroPaddingYN::Yes);
 	}
 }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "graphics/number_texture_font.hpp"
+#include "graphics/number_texture_font_cache.hpp"
 #include "music_game/view_status.hpp"
 
 namespace MusicGame::Graphics
@@ -10,6 +11,7 @@ namespace MusicGame::Graphics
 		const NumberTextureFont m_numberTextureFont;
 		const NumberTextureFont m_numberTextureFontNoError;
 		const TextureFontTextLayout m_numberLayout;
+		NumberTextureFontCache m_numberCache;
 		const Texture m_comboTexture;
 		const TextureRegion m_comboTextureRegion;
 		const TextureRegion m_comboTextureRegionNoError;
@@ -1,4 +1,5 @@
 ﻿#include "frame_rate_monitor.hpp"
+#include "common/frame_rate_limit.hpp"
 
 namespace MusicGame::Graphics
 {
@@ -6,6 +7,32 @@ namespace MusicGame::Graphics
 	{
 		constexpr StringView kNumberTextureFontFilename = U"num2.png";
 		constexpr StringView kFPSTextureFilename = U"fps.png";
+
+		constexpr int32 kProfilerFontSize = 12;
+		constexpr int32 kProfilerLineHeight = 14;
+	}
+
+	void FrameRateMonitor::drawProfiler() const
+	{
+		// 各区間の所要時間のパーセンタイル値を表示
+		const Font font = AssetManagement::SystemFont();
+		const int32 numSections = static_cast<int32>(FrameProfiler::Section::kSectionEnumCount);
+		const Vec2 basePosition = { Scene::Width() - Scaled(4), Scaled(456) - kProfilerLineHeight * (numSections + 1) };
+		for (int32 i = 0; i < numSections; ++i)
+		{
+			const auto section = static_cast<FrameProfiler::Section>(i);
+			const FrameProfiler::Stats stats = FrameProfiler::SectionStats(section);
+			font(U"{} p50:{:.2f}ms p99:{:.2f}ms"_fmt(FrameProfiler::SectionName(section), stats.p50Ms, stats.p99Ms))
+				.draw(kProfilerFontSize, Arg::topRight = basePosition + Vec2::Down(kProfilerLineHeight * i));
+		}
+
+		// フレーム間隔の統計情報を表示
+		if (const auto pFrameRateLimit = Addon::GetAddon<FrameRateLimit>(U"FrameRateLimit"))
+		{
+			const FramePacingStats stats = pFrameRateLimit->pacingStats();
+			font(U"Interval mean:{:.2f}ms sd:{:.3f}ms spin:{:.2f}ms late:{}"_fmt(stats.meanIntervalMs, stats.stdDevIntervalMs, stats.spinMarginMs, stats.numLateFrames))
+				.draw(kProfilerFontSize, Arg::topRight = basePosition + Vec2::Down(kProfilerLineHeight * numSections));
+		}
 	}
 
 	FrameRateMonitor::FrameRateMonitor()
@@ -20,6 +47,11 @@ namespace MusicGame::Graphics
 		const ScopedRenderStates2D samplerState(SamplerState::ClampLinear);
 
 		m_fpsTexture.resized(Scaled(30, 9)).draw(Scene::Width() - Scaled(38), Scaled(460));
-		m_numberTextureFont.draw(m_numberLayout, { Scene::Width() - Scaled(40), Scaled(460) }, Profiler::FPS(), ZeroPaddingYN::No);
+		m_numberCache.draw(m_numberTextureFont, m_numberLayout, { Scene::Width() - Scaled(40), Scaled(460) }, Profiler::FPS(), ZeroPaddingYN::No);
+
+		if (FrameProfiler::IsEnabled())
+		{
+			drawProfiler();
+		}
 	}
 }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "graphics/number_texture_font.hpp"
+#include "graphics/number_texture_font_cache.hpp"
 
 namespace MusicGame::Graphics
 {
@@ -8,8 +9,11 @@ namespace MusicGame::Graphics
 	private:
 		const NumberTextureFont m_numberTextureFont;
 		const TextureFontTextLayout m_numberLayout;
+		NumberTextureFontCache m_numberCache;
 		const Texture m_fpsTexture;
 
+		void drawProfiler() const;
+
 	public:
 		FrameRateMonitor();
 
@@ -73,6 +73,6 @@ namespace MusicGame::Graphics
 		Scaled2x(m_percentBaseTexture).draw(percentBasePosition);
 
 		const Vec2 percentNumberBasePosition = percentBasePosition + Scaled2x(Vec2{ 72, 13 });
-		m_percentNumberTextureFont.draw(m_percentNumberLayout, percentNumberBasePosition, static_cast<int>(percent), ZeroPaddingYN::No);
+		m_percentNumberCache.draw(m_percentNumberTextureFont, m_percentNumberLayout, percentNumberBasePosition, static_cast<int>(percent), ZeroPaddingYN::No);
 	}
 }
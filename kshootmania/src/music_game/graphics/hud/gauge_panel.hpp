@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "music_game/game_defines.hpp"
 #include "graphics/number_texture_font.hpp"
+#include "graphics/number_texture_font_cache.hpp"
 
 namespace MusicGame::Graphics
 {
@@ -14,6 +15,7 @@ namespace MusicGame::Graphics
 		const Texture m_percentBaseTexture;
 		const NumberTextureFont m_percentNumberTextureFont;
 		const TextureFontTextLayout m_percentNumberLayout;
+		NumberTextureFontCache m_percentNumberCache;
 
 	public:
 		explicit GaugePanel(GaugeType gaugeType);
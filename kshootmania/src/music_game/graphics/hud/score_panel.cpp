@@ -19,6 +19,6 @@ namespace MusicGame::Graphics
 	void ScorePanel::draw(int32 score) const
 	{
 		m_captionTexture.resized(Scaled(240, 24)).draw(Scene::Width() / 2 + Scaled(60), Scaled(16));
-		m_numberTextureFont.draw(m_numberLayout, { Scene::Width() / 2 + Scaled(92), Scaled(42) }, score, ZeroPaddingYN::Yes);
+		m_numberCache.draw(m_numberTextureFont, m_numberLayout, { Scene::Width() / 2 + Scaled(92), Scaled(42) }, score, ZeroPaddingYN::Yes);
 	}
 }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "graphics/number_texture_font.hpp"
+#include "graphics/number_texture_font_cache.hpp"
 
 namespace MusicGame::Graphics
 {
@@ -9,6 +10,7 @@ namespace MusicGame::Graphics
 		const Texture m_captionTexture;
 		const NumberTextureFont m_numberTextureFont;
 		const TextureFontTextLayout m_numberLayout;
+		NumberTextureFontCache m_numberCache;
 
 	public:
 		ScorePanel();
@@ -67,11 +67,11 @@ namespace MusicGame::Graphics
 		m_difficultyTextureRegion.draw(m_detailPanelPosition + Scaled(13, 3));
 
 		// Level
-		m_numberTextureFont.draw(m_levelNumberLayout, m_detailPanelPosition + Scaled(79, 4), m_level, ZeroPaddingYN::No);
+		m_levelNumberCache.draw(m_numberTextureFont, m_levelNumberLayout, m_detailPanelPosition + Scaled(79, 4), m_level, ZeroPaddingYN::No);
 
 		// BPM
 		// TODO: BPMの小数部分を表示
-		m_numberTextureFont.draw(m_bpmNumberLayout, m_detailPanelPosition + Scaled(159, 4), static_cast<int32>(currentBPM), ZeroPaddingYN::No);
+		m_bpmNumberCache.draw(m_numberTextureFont, m_bpmNumberLayout, m_detailPanelPosition + Scaled(159, 4), static_cast<int32>(currentBPM), ZeroPaddingYN::No);
 
 		// ハイスピード設定
 		m_hispeedSettingPanel.draw(m_detailPanelPosition + Scaled(159, 27), highwayScrollContext);
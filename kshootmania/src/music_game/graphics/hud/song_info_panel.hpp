@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "graphics/number_texture_font.hpp"
+#include "graphics/number_texture_font_cache.hpp"
 #include "music_game/scroll/highway_scroll.hpp"
 #include "hispeed_setting_panel.hpp"
 #include "kson/chart_data.hpp"
@@ -27,6 +28,8 @@ namespace MusicGame::Graphics
 		const NumberTextureFont m_numberTextureFont;
 		const TextureFontTextLayout m_levelNumberLayout;
 		const TextureFontTextLayout m_bpmNumberLayout;
+		NumberTextureFontCache m_levelNumberCache;
+		NumberTextureFontCache m_bpmNumberCache;
 
 		const HispeedSettingPanel m_hispeedSettingPanel;
 
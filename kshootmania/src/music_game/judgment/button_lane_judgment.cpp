@@ -5,42 +5,6 @@ namespace MusicGame::Judgment
 {
 	namespace
 	{
-		std::map<kson::Pulse, double> CreatePulseToSec(const kson::ByPulse<kson::Interval>& lane, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache)
-		{
-			std::map<kson::Pulse, double> pulseToSec;
-
-			for (const auto& [y, note] : lane)
-			{
-				if (!pulseToSec.contains(y))
-				{
-					const double sec = kson::PulseToSec(y, beatInfo, timingCache);
-					pulseToSec.emplace(y, sec);
-				}
-				if (!pulseToSec.contains(y + note.length))
-				{
-					const double sec = kson::PulseToSec(y + note.length, beatInfo, timingCache);
-					pulseToSec.emplace(y + note.length, sec);
-				}
-			}
-
-			return pulseToSec;
-		}
-
-		kson::ByPulse<JudgmentResult> CreateChipNoteJudgmentArray(const kson::ByPulse<kson::Interval>& lane)
-		{
-			kson::ByPulse<JudgmentResult> judgmentArray;
-
-			for (const auto& [y, note] : lane)
-			{
-				if (note.length == 0)
-				{
-					judgmentArray.emplace(y, JudgmentResult::kUnspecified);
-				}
-			}
-
-			return judgmentArray;
-		}
-
 		using LongNoteJudgment = ButtonLaneJudgment::LongNoteJudgment;
 
 		kson::ByPulse<ButtonLaneJudgment::LongNoteJudgment> CreateLongNoteJudgmentArray(const kson::ByPulse<kson::Interval>& lane, const kson::BeatInfo& beatInfo)
@@ -84,26 +48,93 @@ namespace MusicGame::Judgment
 			return judgmentArray;
 		}
 
-		bool IsDuringLongNote(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, kson::Pulse* pLongNoteY = nullptr)
+		ButtonLaneJudgment::LongJudgmentTable CreateLongJudgmentTable(const kson::ByPulse<kson::Interval>& lane, const kson::BeatInfo& beatInfo)
 		{
-			const auto& currentNoteItr = kson::ValueItrAt(lane, currentPulse);
-			if (currentNoteItr != lane.end())
+			// 同一Pulseの判定の扱いを変えないよう、一旦ByPulseで作成してから配列に展開する
+			const kson::ByPulse<LongNoteJudgment> judgmentArray = CreateLongNoteJudgmentArray(lane, beatInfo);
+
+			ButtonLaneJudgment::LongJudgmentTable table;
+			table.y.reserve(judgmentArray.size());
+			table.endY.reserve(judgmentArray.size());
+			table.result.reserve(judgmentArray.size());
+			for (const auto& [y, judgment] : judgmentArray)
 			{
-				const auto& [y, note] = *currentNoteItr;
-				if (y <= currentPulse && currentPulse < y + note.length)
-				{
-					if (pLongNoteY != nullptr)
-					{
-						*pLongNoteY = y;
-					}
-					return true;
-				}
+				table.y.push_back(y);
+				table.endY.push_back(y + judgment.length);
+				table.result.push_back(judgment.result);
+			}
+
+			return table;
+		}
+
+		ButtonLaneJudgment::NoteTable CreateNoteTable(const kson::ByPulse<kson::Interval>& lane, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache, const ButtonLaneJudgment::LongJudgmentTable& longJudgmentTable)
+		{
+			ButtonLaneJudgment::NoteTable table;
+			table.y.reserve(lane.size());
+			table.endY.reserve(lane.size());
+			table.sec.reserve(lane.size());
+			table.endSec.reserve(lane.size());
+			table.chipResult.reserve(lane.size());
+			table.longJudgmentBeginIdx.reserve(lane.size());
+
+			for (const auto& [y, note] : lane)
+			{
+				const double sec = kson::PulseToSec(y, beatInfo, timingCache);
+				const auto longJudgmentItr = std::lower_bound(longJudgmentTable.y.begin(), longJudgmentTable.y.end(), y);
+
+				table.y.push_back(y);
+				table.endY.push_back(y + note.length);
+				table.sec.push_back(sec);
+				table.endSec.push_back((note.length == 0) ? sec : kson::PulseToSec(y + note.length, beatInfo, timingCache));
+				table.chipResult.push_back(JudgmentResult::kUnspecified);
+				table.longJudgmentBeginIdx.push_back(static_cast<std::size_t>(longJudgmentItr - longJudgmentTable.y.begin()));
 			}
+
+			return table;
+		}
+	}
+
+	Optional<std::size_t> ButtonLaneJudgment::noteIdxAt(kson::Pulse y) const
+	{
+		const auto itr = std::lower_bound(m_noteTable.y.begin(), m_noteTable.y.end(), y);
+		if (itr == m_noteTable.y.end() || *itr != y)
+		{
+			return none;
+		}
+		return static_cast<std::size_t>(itr - m_noteTable.y.begin());
+	}
+
+	bool ButtonLaneJudgment::isDuringLongNote(kson::Pulse currentPulse, std::size_t* pLongNoteIdx)
+	{
+		if (m_noteTable.size() == 0U)
+		{
 			return false;
 		}
+
+		// currentPulse以前で最後のノーツまでカーソルを移動
+		// (通常は前フレームから数個しか移動しないため、二分探索は使用しない)
+		while (m_currentNoteCursor > 0U && m_noteTable.y[m_currentNoteCursor] > currentPulse)
+		{
+			--m_currentNoteCursor;
+		}
+		while (m_currentNoteCursor + 1U < m_noteTable.size() && m_noteTable.y[m_currentNoteCursor + 1U] <= currentPulse)
+		{
+			++m_currentNoteCursor;
+		}
+
+		const std::size_t idx = m_currentNoteCursor;
+		if (m_noteTable.y[idx] <= currentPulse && currentPulse < m_noteTable.endY[idx])
+		{
+			if (pLongNoteIdx != nullptr)
+			{
+				*pLongNoteIdx = idx;
+			}
+			return true;
+		}
+		return false;
 	}
 
-	void ButtonLaneJudgment::processKeyDown(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
+	void ButtonLaneJudgment::processKeyDown(kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
 	{
 		using namespace TimingWindow;
 
@@ -111,28 +142,27 @@ namespace MusicGame::Judgment
 		bool found = false;
 		double minDistance = 0.0;
 		bool isFast = false;
-		kson::Pulse nearestNotePulse;
-		for (auto itr = m_passedNoteCursor; itr != lane.end(); ++itr)
+		std::size_t nearestNoteIdx = 0U;
+		for (std::size_t idx = m_passedNoteCursor; idx < m_noteTable.size(); ++idx)
 		{
-			const auto& [y, note] = *itr;
-			const double sec = m_pulseToSec.at(y);
-			const double endSec = (note.length == 0) ? sec : m_pulseToSec.at(y + note.length);
-			if (currentTimeSec - endSec >= ChipNote::kWindowSecError)
+			const kson::Pulse y = m_noteTable.y[idx];
+			const double sec = m_noteTable.sec[idx];
+			if (currentTimeSec - m_noteTable.endSec[idx] >= ChipNote::kWindowSecError)
 			{
 				continue;
 			}
 
 			const double diffSec = sec - currentTimeSec;
-			if (note.length == 0) // Chip note
+			if (m_noteTable.isChip(idx)) // Chip note
 			{
-				if (m_chipJudgmentArray.at(y) != JudgmentResult::kUnspecified)
+				if (m_noteTable.chipResult[idx] != JudgmentResult::kUnspecified)
 				{
 					continue;
 				}
 
 				if (!found || Abs(diffSec) < minDistance)
 				{
-					nearestNotePulse = y;
+					nearestNoteIdx = idx;
 					minDistance = Abs(diffSec);
 					isFast = currentTimeSec < sec;
 					found = true;
@@ -144,7 +174,7 @@ namespace MusicGame::Judgment
 			}
 			else // Long note
 			{
-				if ((!found || Abs(diffSec) < minDistance) && diffSec <= LongNote::kWindowSecPreHold && (y + note.length > currentPulse))
+				if ((!found || Abs(diffSec) < minDistance) && diffSec <= LongNote::kWindowSecPreHold && (m_noteTable.endY[idx] > currentPulse))
 				{
 					laneStatusRef.currentLongNotePulse = y;
 					laneStatusRef.currentLongNoteAnimOffsetTimeSec = currentTimeSec;
@@ -163,11 +193,12 @@ namespace MusicGame::Judgment
 		if (found)
 		{
 			// チップノーツの判定
+			JudgmentResult& chipResultRef = m_noteTable.chipResult[nearestNoteIdx];
 			Optional<JudgmentResult> chipAnimType = none;
 			if (minDistance < ChipNote::kWindowSecCritical)
 			{
 				// CRITICAL判定
-				m_chipJudgmentArray.at(nearestNotePulse) = JudgmentResult::kCritical;
+				chipResultRef = JudgmentResult::kCritical;
 				judgmentHandlerRef.onChipJudged(JudgmentResult::kCritical);
 				laneStatusRef.keyBeamType = KeyBeamType::kCritical;
 				chipAnimType = JudgmentResult::kCritical;
@@ -176,7 +207,7 @@ namespace MusicGame::Judgment
 			{
 				// NEAR判定
 				const auto judgmentResult = isFast ? JudgmentResult::kNearFast : JudgmentResult::kNearSlow;
-				m_chipJudgmentArray.at(nearestNotePulse) = judgmentResult;
+				chipResultRef = judgmentResult;
 				judgmentHandlerRef.onChipJudged(judgmentResult);
 				laneStatusRef.keyBeamType = KeyBeamType::kNear; // TODO: fast/slow
 				chipAnimType = judgmentResult;
@@ -184,7 +215,7 @@ namespace MusicGame::Judgment
 			else if (minDistance < ChipNote::kWindowSecError) // TODO: easy gauge
 			{
 				// ERROR判定
-				m_chipJudgmentArray.at(nearestNotePulse) = JudgmentResult::kError;
+				chipResultRef = JudgmentResult::kError;
 				judgmentHandlerRef.onChipJudged(JudgmentResult::kError);
 				laneStatusRef.keyBeamType = KeyBeamType::kDefault;
 				chipAnimType = JudgmentResult::kError; // TODO: fast/slow
@@ -200,58 +231,75 @@ namespace MusicGame::Judgment
 		}
 	}
 
-	void ButtonLaneJudgment::processKeyPressed(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, const ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
+	void ButtonLaneJudgment::processKeyPressed(kson::Pulse currentPulse, const ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
 	{
 		if (laneStatusRef.currentLongNotePulse.has_value())
 		{
-			const kson::Pulse noteStartPulse = laneStatusRef.currentLongNotePulse.value();
-			const kson::Pulse noteEndPulse = noteStartPulse + lane.at(noteStartPulse).length;
+			const Optional<std::size_t> noteIdx = noteIdxAt(laneStatusRef.currentLongNotePulse.value());
+			if (!noteIdx.has_value())
+			{
+				assert(false && "currentLongNotePulse must point to a note in the lane");
+				return;
+			}
+
+			const kson::Pulse noteEndPulse = m_noteTable.endY[*noteIdx];
 			const kson::Pulse limitPulse = Min(currentPulse + kson::RelPulse{ 1 }, noteEndPulse);
 
 			// 処理落ちした場合でも判定が漏れないように前回フレームからの判定を全て拾う
-			for (auto itr = m_longJudgmentArray.upper_bound(noteStartPulse - 1); itr != m_longJudgmentArray.end(); ++itr)
+			for (std::size_t idx = m_noteTable.longJudgmentBeginIdx[*noteIdx]; idx < m_longJudgmentTable.size(); ++idx)
 			{
-				auto& [y, judgment] = *itr;
-				if (y + judgment.length <= m_prevPulse)
+				if (m_longJudgmentTable.endY[idx] <= m_prevPulse)
 				{
 					continue;
 				}
 
-				if (y >= limitPulse)
+				if (m_longJudgmentTable.y[idx] >= limitPulse)
 				{
 					break;
 				}
 
-				if (judgment.result != JudgmentResult::kUnspecified)
+				JudgmentResult& resultRef = m_longJudgmentTable.result[idx];
+				if (resultRef != JudgmentResult::kUnspecified)
 				{
 					// 判定が既に決まっている場合はスキップ
 					continue;
 				}
 
 				// ロングノーツのCRITICAL判定
-				judgment.result = JudgmentResult::kCritical;
+				resultRef = JudgmentResult::kCritical;
 				judgmentHandlerRef.onLongJudged(JudgmentResult::kCritical);
 			}
 		}
 	}
 
-	void ButtonLaneJudgment::processPassedNoteJudgment(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef, IsAutoPlayYN isAutoPlay)
+	void ButtonLaneJudgment::releaseLongNote(double timeSec, ButtonLaneStatus& laneStatusRef)
+	{
+		laneStatusRef.currentLongNotePulse = none;
+		laneStatusRef.currentLongNoteAnimOffsetTimeSec = timeSec;
+	}
+
+	void ButtonLaneJudgment::processPassedNoteJudgment(kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef, IsAutoPlayYN isAutoPlay)
 	{
 		using namespace TimingWindow;
 
 		const JudgmentResult result = isAutoPlay ? JudgmentResult::kCritical : JudgmentResult::kError;
 		const double thresholdSec = isAutoPlay ? 0.0 : ChipNote::kWindowSecError;
 
-		for (auto itr = m_passedNoteCursor; itr != lane.end(); ++itr)
+		for (std::size_t idx = m_passedNoteCursor; idx < m_noteTable.size(); ++idx)
 		{
-			const auto& [y, note] = *itr;
-			const double passSec = ((note.length == 0) ? m_pulseToSec.at(y) : m_pulseToSec.at(y + note.length)) + thresholdSec;
+			// 始点を通過していなければ、以降のノーツも通過していない
+			if (currentTimeSec < m_noteTable.sec[idx] + thresholdSec)
+			{
+				break;
+			}
+
+			const double passSec = m_noteTable.endSec[idx] + thresholdSec;
 			if (currentTimeSec >= passSec)
 			{
 				// 通過済みチップノーツの判定
-				if (note.length == 0 && m_chipJudgmentArray.at(y) == JudgmentResult::kUnspecified)
+				if (m_noteTable.isChip(idx) && m_noteTable.chipResult[idx] == JudgmentResult::kUnspecified)
 				{
-					m_chipJudgmentArray.at(y) = result;
+					m_noteTable.chipResult[idx] = result;
 					judgmentHandlerRef.onChipJudged(result);
 
 					laneStatusRef.chipAnim.push({
@@ -267,23 +315,28 @@ namespace MusicGame::Judgment
 					}
 				}
 
-				m_passedNoteCursor = std::next(itr);
+				m_passedNoteCursor = idx + 1U;
 			}
 		}
 
-		for (auto itr = m_passedLongJudgmentCursor; itr != m_longJudgmentArray.end(); ++itr)
+		for (std::size_t idx = m_passedLongJudgmentCursor; idx < m_longJudgmentTable.size(); ++idx)
 		{
-			auto& [y, judgment] = *itr;
-			if (y + judgment.length < currentPulse)
+			// 始点を通過していなければ、以降の判定も通過していない
+			if (m_longJudgmentTable.y[idx] >= currentPulse)
+			{
+				break;
+			}
+
+			if (m_longJudgmentTable.endY[idx] < currentPulse)
 			{
 				// 通過済みロングノーツの判定
-				if (judgment.result == JudgmentResult::kUnspecified)
+				if (m_longJudgmentTable.result[idx] == JudgmentResult::kUnspecified)
 				{
-					judgment.result = result;
+					m_longJudgmentTable.result[idx] = result;
 					judgmentHandlerRef.onLongJudged(result);
 				}
 
-				m_passedLongJudgmentCursor = std::next(itr);
+				m_passedLongJudgmentCursor = idx + 1U;
 			}
 		}
 	}
@@ -291,42 +344,61 @@ namespace MusicGame::Judgment
 	ButtonLaneJudgment::ButtonLaneJudgment(JudgmentPlayMode judgmentPlayMode, KeyConfig::Button keyConfigButton, const kson::ByPulse<kson::Interval>& lane, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache)
 		: m_judgmentPlayMode(judgmentPlayMode)
 		, m_keyConfigButton(keyConfigButton)
-		, m_pulseToSec(CreatePulseToSec(lane, beatInfo, timingCache))
-		, m_chipJudgmentArray(CreateChipNoteJudgmentArray(lane))
-		, m_longJudgmentArray(CreateLongNoteJudgmentArray(lane, beatInfo))
-		, m_passedNoteCursor(lane.begin())
-		, m_passedLongJudgmentCursor(m_longJudgmentArray.begin())
+		, m_longJudgmentTable(CreateLongJudgmentTable(lane, beatInfo))
+		, m_noteTable(CreateNoteTable(lane, beatInfo, timingCache, m_longJudgmentTable))
+		, m_chipJudgmentCount(static_cast<std::size_t>(std::count_if(lane.begin(), lane.end(), [](const auto& pair) { return pair.second.length == 0; })))
 	{
 	}
 
-	void ButtonLaneJudgment::update(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
+	void ButtonLaneJudgment::update(kson::Pulse currentPulse, double currentTimeSec, const ButtonInputFrame& input, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
 	{
 		if (m_judgmentPlayMode == JudgmentPlayMode::kOn)
 		{
-			// チップノーツとロングノーツの始点の判定処理
-			if (!m_isLockedForExit && KeyConfig::Down(m_keyConfigButton))
+			// 前フレーム以降の入力を発生順に、それぞれの発生時刻で処理する
+			// (フレーム毎の入力状態ではなく入力の発生時刻で判定するため、判定精度がフレームレートに依存しない)
+			for (const ButtonInputEvent& event : input.events)
 			{
-				processKeyDown(lane, currentPulse, currentTimeSec, laneStatusRef, judgmentHandlerRef);
+				if (event.button != m_keyConfigButton)
+				{
+					continue;
+				}
+
+				const double eventTimeSec = ClampInputEventTimeSec(event.sec, m_prevTimeSec, currentTimeSec);
+				const kson::Pulse eventPulse = InterpolatePulse(m_prevPulse, m_prevTimeSec, currentPulse, currentTimeSec, eventTimeSec);
+				if (event.pressed)
+				{
+					// チップノーツとロングノーツの始点の判定処理
+					if (!m_isLockedForExit)
+					{
+						processKeyDown(eventPulse, eventTimeSec, laneStatusRef, judgmentHandlerRef);
+					}
+				}
+				else if (laneStatusRef.currentLongNotePulse.has_value())
+				{
+					// ロングノーツを離したときの判定処理
+					// (離した時点までのロングノーツ押下中の判定を先に拾う)
+					processKeyPressed(eventPulse, laneStatusRef, judgmentHandlerRef);
+					releaseLongNote(eventTimeSec, laneStatusRef);
+				}
 			}
 
 			// ロングノーツ押下中の判定処理
-			if (KeyConfig::Pressed(m_keyConfigButton))
+			if (input.pressed[m_keyConfigButton])
 			{
-				processKeyPressed(lane, currentPulse, laneStatusRef, judgmentHandlerRef);
+				processKeyPressed(currentPulse, laneStatusRef, judgmentHandlerRef);
 			}
 
-			// ロングノーツを離したときの判定処理
+			// ロングノーツの終点を過ぎたときの処理
 			if (laneStatusRef.currentLongNotePulse.has_value() &&
-				(KeyConfig::Up(m_keyConfigButton) || (*laneStatusRef.currentLongNotePulse + lane.at(*laneStatusRef.currentLongNotePulse).length < currentPulse)))
+				m_noteTable.endY[noteIdxAt(*laneStatusRef.currentLongNotePulse).value()] < currentPulse)
 			{
-				laneStatusRef.currentLongNotePulse = none;
-				laneStatusRef.currentLongNoteAnimOffsetTimeSec = currentTimeSec;
+				releaseLongNote(currentTimeSec, laneStatusRef);
 			}
 
 			// 通り過ぎたノーツをERROR判定にする
-			processPassedNoteJudgment(lane, currentPulse, currentTimeSec, laneStatusRef, judgmentHandlerRef, IsAutoPlayYN::No);
+			processPassedNoteJudgment(currentPulse, currentTimeSec, laneStatusRef, judgmentHandlerRef, IsAutoPlayYN::No);
 
-			if (IsDuringLongNote(lane, currentPulse))
+			if (isDuringLongNote(currentPulse))
 			{
 				laneStatusRef.longNotePressed = laneStatusRef.currentLongNotePulse.has_value();
 			}
@@ -338,15 +410,15 @@ namespace MusicGame::Judgment
 		else if (m_judgmentPlayMode == JudgmentPlayMode::kAuto)
 		{
 			// 通り過ぎたノーツをCRITICAL判定にする
-			processPassedNoteJudgment(lane, currentPulse, currentTimeSec, laneStatusRef, judgmentHandlerRef, IsAutoPlayYN::Yes);
+			processPassedNoteJudgment(currentPulse, currentTimeSec, laneStatusRef, judgmentHandlerRef, IsAutoPlayYN::Yes);
 
-			kson::Pulse currentLongNoteY;
-			if (IsDuringLongNote(lane, currentPulse, &currentLongNoteY))
+			std::size_t currentLongNoteIdx;
+			if (isDuringLongNote(currentPulse, &currentLongNoteIdx))
 			{
 				// ロングノーツ中の場合は押下中にする
 				laneStatusRef.longNotePressed = true;
-				laneStatusRef.currentLongNotePulse = currentLongNoteY;
-				laneStatusRef.currentLongNoteAnimOffsetTimeSec = m_pulseToSec.at(currentLongNoteY);
+				laneStatusRef.currentLongNotePulse = m_noteTable.y[currentLongNoteIdx];
+				laneStatusRef.currentLongNoteAnimOffsetTimeSec = m_noteTable.sec[currentLongNoteIdx];
 			}
 			else
 			{
@@ -362,16 +434,17 @@ namespace MusicGame::Judgment
 		}
 
 		m_prevPulse = currentPulse;
+		m_prevTimeSec = currentTimeSec;
 	}
 
 	std::size_t ButtonLaneJudgment::chipJudgmentCount() const
 	{
-		return m_chipJudgmentArray.size();
+		return m_chipJudgmentCount;
 	}
 
 	std::size_t ButtonLaneJudgment::longJudgmentCount() const
 	{
-		return m_longJudgmentArray.size();
+		return m_longJudgmentTable.size();
 	}
 
 	void ButtonLaneJudgment::lockForExit()
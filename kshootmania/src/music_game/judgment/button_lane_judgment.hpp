@@ -17,31 +17,81 @@ namespace MusicGame::Judgment
 			JudgmentResult result = JudgmentResult::kUnspecified;
 		};
 
+		// レーン上のノーツの判定用テーブル
+		// (毎フレーム走査するため、std::mapではなく要素毎の配列として連続したメモリに保持する。インデックスはノーツのPulse順)
+		struct NoteTable
+		{
+			std::vector<kson::Pulse> y;
+
+			std::vector<kson::Pulse> endY; // チップノーツの場合はyと同じ
+
+			std::vector<double> sec;
+
+			std::vector<double> endSec; // チップノーツの場合はsecと同じ
+
+			std::vector<JudgmentResult> chipResult; // ロングノーツの場合は使用しない
+
+			std::vector<std::size_t> longJudgmentBeginIdx; // ノーツの始点以降で最初のロングノーツ判定のインデックス
+
+			std::size_t size() const
+			{
+				return y.size();
+			}
+
+			bool isChip(std::size_t idx) const
+			{
+				return y[idx] == endY[idx];
+			}
+		};
+
+		// ロングノーツの判定用テーブル(インデックスは判定のPulse順)
+		struct LongJudgmentTable
+		{
+			std::vector<kson::Pulse> y;
+
+			std::vector<kson::Pulse> endY;
+
+			std::vector<JudgmentResult> result;
+
+			std::size_t size() const
+			{
+				return y.size();
+			}
+		};
+
 	private:
 		const JudgmentPlayMode m_judgmentPlayMode;
 		const KeyConfig::Button m_keyConfigButton;
-		const std::map<kson::Pulse, double> m_pulseToSec;
 
 		bool m_isLockedForExit = false;
 
-		kson::ByPulse<JudgmentResult> m_chipJudgmentArray;
-		kson::ByPulse<LongNoteJudgment> m_longJudgmentArray;
+		LongJudgmentTable m_longJudgmentTable;
+		NoteTable m_noteTable;
+		std::size_t m_chipJudgmentCount = 0U;
 
 		kson::Pulse m_prevPulse = kPastPulse;
+		double m_prevTimeSec = kPastTimeSec;
+
+		std::size_t m_passedNoteCursor = 0U;
+		std::size_t m_passedLongJudgmentCursor = 0U;
+		std::size_t m_currentNoteCursor = 0U; // currentPulse以前で最後のノーツのインデックス(isDuringLongNote()用)
+
+		Optional<std::size_t> noteIdxAt(kson::Pulse y) const;
+
+		bool isDuringLongNote(kson::Pulse currentPulse, std::size_t* pLongNoteIdx = nullptr);
 
-		kson::ByPulse<kson::Interval>::const_iterator m_passedNoteCursor;
-		kson::ByPulse<LongNoteJudgment>::iterator m_passedLongJudgmentCursor;
+		void processKeyDown(kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
 
-		void processKeyDown(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
+		void processKeyPressed(kson::Pulse currentPulse, const ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
 
-		void processKeyPressed(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, const ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
+		void releaseLongNote(double timeSec, ButtonLaneStatus& laneStatusRef);
 
-		void processPassedNoteJudgment(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef, IsAutoPlayYN isAutoPlay);
+		void processPassedNoteJudgment(kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef, IsAutoPlayYN isAutoPlay);
 
 	public:
 		ButtonLaneJudgment(JudgmentPlayMode judgmentPlayMode, KeyConfig::Button keyConfigButton, const kson::ByPulse<kson::Interval>& lane, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache);
 
-		void update(const kson::ByPulse<kson::Interval>& lane, kson::Pulse currentPulse, double currentTimeSec, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
+		void update(kson::Pulse currentPulse, double currentTimeSec, const ButtonInputFrame& input, ButtonLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
 
 		std::size_t chipJudgmentCount() const;
 
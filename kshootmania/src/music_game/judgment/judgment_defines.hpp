@@ -88,6 +88,47 @@ namespace MusicGame::Judgment
 	constexpr double kLaserAutoSecBeforeLineDirectionChangeByCorrectMovement = 0.2;
 	constexpr double kLaserAutoSecAfterLineDirectionChange = 0.05;
 
+	// 判定に使用するボタン入力イベント
+	struct ButtonInputEvent
+	{
+		KeyConfig::Button button = KeyConfig::kUnspecifiedButton;
+
+		// true:押した, false:離した
+		bool pressed = false;
+
+		// 入力の発生時刻をBGMの再生位置に換算した時間(秒)
+		double sec = 0.0;
+	};
+
+	// 1フレーム分のボタン入力
+	struct ButtonInputFrame
+	{
+		// 前フレーム以降に発生した入力イベント(発生順)
+		Array<ButtonInputEvent> events;
+
+		// 現フレーム時点での押下状態
+		std::array<bool, KeyConfig::kButtonEnumCount> pressed = {};
+	};
+
+	// 入力イベントの時間(秒)を前フレームから現フレームまでの範囲に収める
+	// (BGMの再生位置の揺らぎにより、範囲外の時間に換算される場合があるため)
+	constexpr double ClampInputEventTimeSec(double eventTimeSec, double prevTimeSec, double currentTimeSec)
+	{
+		return Min(Max(eventTimeSec, prevTimeSec), currentTimeSec);
+	}
+
+	// 前フレームから現フレームまでの間の時間(秒)に対応するPulse値を線形補間で求める
+	constexpr kson::Pulse InterpolatePulse(kson::Pulse prevPulse, double prevTimeSec, kson::Pulse currentPulse, double currentTimeSec, double timeSec)
+	{
+		if (prevPulse == kPastPulse || currentTimeSec <= prevTimeSec)
+		{
+			return currentPulse;
+		}
+
+		const double rate = (timeSec - prevTimeSec) / (currentTimeSec - prevTimeSec);
+		return prevPulse + static_cast<kson::Pulse>(static_cast<double>(currentPulse - prevPulse) * rate);
+	}
+
 	class ButtonLaneJudgment;
 	class LaserLaneJudgment;
 
@@ -25,7 +25,7 @@ namespace MusicGame::Judgment
 			return btCombo + fxCombo + laserCombo;
 		}
 
-		int32 TotalGaugeValueButtonLane(ButtonLaneJudgment laneJudgment, int32 chipValue, int32 longValue)
+		int32 TotalGaugeValueButtonLane(const ButtonLaneJudgment& laneJudgment, int32 chipValue, int32 longValue)
 		{
 			const int32 chipJudgmentCount = static_cast<int32>(laneJudgment.chipJudgmentCount());
 			const int32 longJudgmentCount = static_cast<int32>(laneJudgment.longJudgmentCount());
@@ -46,7 +46,7 @@ namespace MusicGame::Judgment
 			int32 chipValue,
 			int32 longValue)
 		{
-			const auto totalGaugeValueButtonLane = [chipValue, longValue](ButtonLaneJudgment laneJudgment)
+			const auto totalGaugeValueButtonLane = [chipValue, longValue](const ButtonLaneJudgment& laneJudgment)
 			{
 				return TotalGaugeValueButtonLane(laneJudgment, chipValue, longValue);
 			};
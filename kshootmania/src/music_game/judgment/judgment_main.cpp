@@ -19,28 +19,60 @@ namespace MusicGame::Judgment
 	{
 	}
 
-	void JudgmentMain::update(const kson::ChartData& chartData, GameStatus& gameStatusRef, ViewStatus& viewStatusRef)
+	void JudgmentMain::updateButtonInputFrame(const GameStatus& gameStatus)
 	{
+		m_buttonInput.update(gameStatus.currentTimeSampledAt);
+
+		// 各入力の発生時刻を、再生位置を取得した時刻との差をもとにBGMの再生位置に換算
+		m_buttonInputFrame.events.clear();
+		for (const auto& event : m_buttonInput.events())
+		{
+			const double secBeforeSampled = std::chrono::duration<double>(gameStatus.currentTimeSampledAt - event.time).count();
+			m_buttonInputFrame.events.push_back({
+				.button = event.button,
+				.pressed = event.pressed,
+				.sec = gameStatus.currentTimeSec - secBeforeSampled,
+			});
+		}
+
+		for (std::size_t i = 0U; i < m_buttonInputFrame.pressed.size(); ++i)
+		{
+			m_buttonInputFrame.pressed[i] = m_buttonInput.pressed(static_cast<KeyConfig::Button>(i));
+		}
+	}
+
+	void JudgmentMain::pollFrameInputs(std::chrono::steady_clock::time_point frameTime)
+	{
+		m_buttonInput.pollFrameInputs(frameTime);
+	}
+
+	void JudgmentMain::update(const kson::ChartData& chartData, GameStatus& gameStatusRef)
+	{
+		// ボタン入力の取得
+		updateButtonInputFrame(gameStatusRef);
+
 		// BTレーンの判定
 		for (std::size_t i = 0U; i < kson::kNumBTLanesSZ; ++i)
 		{
-			m_btLaneJudgments[i].update(chartData.note.bt[i], gameStatusRef.currentPulse, gameStatusRef.currentTimeSec, gameStatusRef.btLaneStatus[i], m_judgmentHandler);
+			m_btLaneJudgments[i].update(gameStatusRef.currentPulse, gameStatusRef.currentTimeSec, m_buttonInputFrame, gameStatusRef.btLaneStatus[i], m_judgmentHandler);
 		}
 
 		// FXレーンの判定
 		for (std::size_t i = 0U; i < kson::kNumFXLanesSZ; ++i)
 		{
-			m_fxLaneJudgments[i].update(chartData.note.fx[i], gameStatusRef.currentPulse, gameStatusRef.currentTimeSec, gameStatusRef.fxLaneStatus[i], m_judgmentHandler);
+			m_fxLaneJudgments[i].update(gameStatusRef.currentPulse, gameStatusRef.currentTimeSec, m_buttonInputFrame, gameStatusRef.fxLaneStatus[i], m_judgmentHandler);
 		}
 
 		// LASERレーンの判定
 		for (std::size_t i = 0U; i < kson::kNumLaserLanesSZ; ++i)
 		{
-			m_laserLaneJudgments[i].update(chartData.note.laser[i], gameStatusRef.currentPulse, gameStatusRef.currentTimeSec, gameStatusRef.laserLaneStatus[i], m_judgmentHandler);
+			m_laserLaneJudgments[i].update(chartData.note.laser[i], gameStatusRef.currentPulse, gameStatusRef.currentTimeSec, m_buttonInputFrame, gameStatusRef.laserLaneStatus[i], m_judgmentHandler);
 		}
+	}
 
-		// 状態をViewStatusに反映
-		m_judgmentHandler.applyToViewStatus(viewStatusRef, gameStatusRef.currentTimeSec, gameStatusRef.currentPulse);
+	void JudgmentMain::applyToViewStatus(const GameStatus& gameStatus, ViewStatus& viewStatusRef)
+	{
+		m_judgmentHandler.applyToViewStatus(viewStatusRef, gameStatus.currentTimeSec, gameStatus.currentPulse);
 	}
 
 	void JudgmentMain::lockForExit()
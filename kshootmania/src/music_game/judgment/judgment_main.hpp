@@ -4,6 +4,7 @@
 #include "button_lane_judgment.hpp"
 #include "laser_lane_judgment.hpp"
 #include "judgment_handler.hpp"
+#include "input/timestamped_button_input.hpp"
 
 namespace MusicGame::Judgment
 {
@@ -18,10 +19,30 @@ namespace MusicGame::Judgment
 
 		JudgmentHandler m_judgmentHandler;
 
+		TimestampedButtonInput m_buttonInput;
+		ButtonInputFrame m_buttonInputFrame;
+
+		void updateButtonInputFrame(const GameStatus& gameStatus);
+
 	public:
 		explicit JudgmentMain(const kson::ChartData& chartData, const kson::TimingCache& timingCache, const PlayOption& playOption);
 
-		void update(const kson::ChartData& chartData, GameStatus& gameStatusRef, ViewStatus& viewStatusRef);
+		/// @brief 入力スレッドの対象外のデバイス(ゲームパッド等)の入力状態を取得する
+		/// @param frameTime フレームの時刻(入力状態の変化は前回の呼び出し時のframeTime、つまりこのフレームの開始時刻で記録される)
+		/// @note 描画フレーム毎に、そのフレームのupdate()より前に呼ぶ
+		void pollFrameInputs(std::chrono::steady_clock::time_point frameTime);
+
+		/// @brief 判定を更新する
+		/// @param chartData 譜面データ
+		/// @param gameStatusRef ゲームステータスへの参照(currentTimeSec等の時刻は判定する時点のものを入れておくこと)
+		/// @note シミュレーションのティック毎に呼ぶ
+		void update(const kson::ChartData& chartData, GameStatus& gameStatusRef);
+
+		/// @brief 判定の状態をViewStatusに反映する
+		/// @param gameStatus ゲームステータス
+		/// @param viewStatusRef 反映先のViewStatusへの参照
+		/// @note 描画フレーム毎に呼ぶ。ViewStatus::camStatusに値を相対的に反映するので、判定と関係ないカメラの値はあらかじめ設定しておくこと
+		void applyToViewStatus(const GameStatus& gameStatus, ViewStatus& viewStatusRef);
 
 		void lockForExit();
 
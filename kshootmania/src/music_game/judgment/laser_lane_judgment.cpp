@@ -309,6 +309,31 @@ namespace MusicGame::Judgment
 		}
 	}
 
+	int32 LaserLaneJudgment::keyboardCursorDirection() const
+	{
+		// 左向きキーと右向きキーを同時に押している場合、最後に押した方を優先する
+		if (m_isKeyPressed[0] && m_isKeyPressed[1])
+		{
+			return m_keyDownTimeSec[0] >= m_keyDownTimeSec[1] ? -1 : 1;
+		}
+		else if (m_isKeyPressed[0])
+		{
+			return -1;
+		}
+		else if (m_isKeyPressed[1])
+		{
+			return 1;
+		}
+		return 0;
+	}
+
+	void LaserLaneJudgment::processKeyboardCursorMovement(const kson::ByPulse<kson::LaserSection>& lane, double durationSec, kson::Pulse pulse, double timeSec, LaserLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
+	{
+		const double deltaCursorX = kLaserKeyboardCursorXPerSec * durationSec * keyboardCursorDirection();
+		processCursorMovement(deltaCursorX, pulse, timeSec, laneStatusRef);
+		processSlamJudgment(lane, deltaCursorX, timeSec, laneStatusRef, judgmentHandlerRef, IsAutoPlayYN::No);
+	}
+
 	void LaserLaneJudgment::processCursorMovement(double deltaCursorX, kson::Pulse currentPulse, double currentTimeSec, LaserLaneStatus& laneStatusRef)
 	{
 		if (!laneStatusRef.cursorX.has_value())
@@ -671,7 +696,7 @@ namespace MusicGame::Judgment
 	{
 	}
 
-	void LaserLaneJudgment::update(const kson::ByPulse<kson::LaserSection>& lane, kson::Pulse currentPulse, double currentTimeSec, LaserLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
+	void LaserLaneJudgment::update(const kson::ByPulse<kson::LaserSection>& lane, kson::Pulse currentPulse, double currentTimeSec, const ButtonInputFrame& input, LaserLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef)
 	{
 		laneStatusRef.noteCursorX = kson::GraphSectionValueAt(lane, currentPulse);
 		laneStatusRef.noteVisualCursorX = laneStatusRef.noteCursorX; // TODO: タイミング調整に合わせてずらして取得
@@ -747,20 +772,39 @@ namespace MusicGame::Judgment
 		if (m_judgmentPlayMode == JudgmentPlayMode::kOn)
 		{
 			// キー押下中の判定処理
-			// (左向きキーと右向きキーを同時に押している場合、最後に押した方を優先する)
-			const Optional<KeyConfig::Button> lastPressedButton = KeyConfig::LastPressedLaserButton(m_keyConfigButtonL, m_keyConfigButtonR);
-			double deltaCursorX;
-			if (lastPressedButton.has_value())
-			{
-				const int32 direction = lastPressedButton == m_keyConfigButtonL ? -1 : 1;
-				deltaCursorX = kLaserKeyboardCursorXPerSec * Scene::DeltaTime() * direction; // TODO: Scene::DeltaTime()を使わずcurrentTimeSecの差分を使う
-			}
-			else
+			// (前フレーム以降に左右のキーを押した・離した時刻で区間を分割し、区間毎にその時刻でカーソル移動と直角LASERの判定を行う)
+			double segmentStartSec = (m_prevTimeSec == kPastTimeSec) ? currentTimeSec : Min(m_prevTimeSec, currentTimeSec);
+			for (const ButtonInputEvent& event : input.events)
 			{
-				deltaCursorX = 0.0;
+				std::size_t keyIdx;
+				if (event.button == m_keyConfigButtonL)
+				{
+					keyIdx = 0U;
+				}
+				else if (event.button == m_keyConfigButtonR)
+				{
+					keyIdx = 1U;
+				}
+				else
+				{
+					continue;
+				}
+
+				const double eventTimeSec = ClampInputEventTimeSec(event.sec, segmentStartSec, currentTimeSec);
+				if (eventTimeSec > segmentStartSec && keyboardCursorDirection() != 0)
+				{
+					const kson::Pulse eventPulse = InterpolatePulse(m_prevPulse, m_prevTimeSec, currentPulse, currentTimeSec, eventTimeSec);
+					processKeyboardCursorMovement(lane, eventTimeSec - segmentStartSec, eventPulse, eventTimeSec, laneStatusRef, judgmentHandlerRef);
+				}
+
+				m_isKeyPressed[keyIdx] = event.pressed;
+				if (event.pressed)
+				{
+					m_keyDownTimeSec[keyIdx] = eventTimeSec;
+				}
+				segmentStartSec = eventTimeSec;
 			}
-			processCursorMovement(deltaCursorX, currentPulse, currentTimeSec, laneStatusRef);
-			processSlamJudgment(lane, deltaCursorX, currentTimeSec, laneStatusRef, judgmentHandlerRef, IsAutoPlayYN::No);
+			processKeyboardCursorMovement(lane, currentTimeSec - segmentStartSec, currentPulse, currentTimeSec, laneStatusRef, judgmentHandlerRef);
 
 			// 直角LASER判定直後のカーソル自動移動
 			processAutoCursorMovementBySlamJudgment(currentTimeSec, laneStatusRef);
@@ -70,6 +70,14 @@ namespace MusicGame::Judgment
 		kson::Pulse m_prevPulse = kPastPulse;
 		double m_prevTimeSec = kPastTimeSec;
 
+		// 左向き・右向きキーの押下状態と、最後に押した時間(秒)
+		std::array<bool, 2U> m_isKeyPressed = {};
+		std::array<double, 2U> m_keyDownTimeSec = { kPastTimeSec, kPastTimeSec };
+
+		int32 keyboardCursorDirection() const;
+
+		void processKeyboardCursorMovement(const kson::ByPulse<kson::LaserSection>& lane, double durationSec, kson::Pulse pulse, double timeSec, LaserLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
+
 		void processCursorMovement(double deltaCursorX, kson::Pulse currentPulse, double currentTimeSec, LaserLaneStatus& laneStatusRef);
 
 		void processSlamJudgment(const kson::ByPulse<kson::LaserSection>& lane, double deltaCursorX, double currentTimeSec, LaserLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef, IsAutoPlayYN isAutoPlay);
@@ -89,7 +97,7 @@ namespace MusicGame::Judgment
 	public:
 		LaserLaneJudgment(JudgmentPlayMode judgmentPlayMode, KeyConfig::Button keyConfigButtonL, KeyConfig::Button keyConfigButtonR, const kson::ByPulse<kson::LaserSection>& lane, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache);
 
-		void update(const kson::ByPulse<kson::LaserSection>& lane, kson::Pulse currentPulse, double currentSec, LaserLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
+		void update(const kson::ByPulse<kson::LaserSection>& lane, kson::Pulse currentPulse, double currentSec, const ButtonInputFrame& input, LaserLaneStatus& laneStatusRef, JudgmentHandler& judgmentHandlerRef);
 
 		void lockForExit();
 
@@ -11,6 +11,9 @@ namespace MusicGame::Scroll
 		// 上記の「108/2」と「10」を乗算した値にあたる
 		constexpr double kBasePixels = 540.0;
 
+		// Pulse値から秒数への変換テーブルのバケットの間隔(4/4拍子の1小節)
+		constexpr kson::Pulse kPulseToSecBucketPulses = kson::kResolution4;
+
 		/// @brief BPMの最頻値(累計Pulse値が最も大きいBPM)を返す
 		/// @param chartData 譜面データ
 		/// @return BPM
@@ -137,10 +140,8 @@ namespace MusicGame::Scroll
 		}
 	}
 
-	HighwayScrollContext::HighwayScrollContext(const HighwayScroll* pHighwayScroll, const kson::BeatInfo* pBeatInfo, const kson::TimingCache* pTimingCache, const GameStatus* pGameStatus)
+	HighwayScrollContext::HighwayScrollContext(const HighwayScroll* pHighwayScroll, const GameStatus* pGameStatus)
 		: m_pHighwayScroll(pHighwayScroll)
-		, m_pBeatInfo(pBeatInfo)
-		, m_pTimingCache(pTimingCache)
 		, m_pGameStatus(pGameStatus)
 	{
 	}
@@ -149,7 +150,7 @@ namespace MusicGame::Scroll
 
 	int32 HighwayScrollContext::getPositionY(kson::Pulse pulse) const
 	{
-		return m_pHighwayScroll->getPositionY(pulse, *m_pBeatInfo, *m_pTimingCache, *m_pGameStatus);
+		return m_pHighwayScroll->getPositionY(pulse, *m_pGameStatus);
 	}
 
 	const HighwayScroll& HighwayScrollContext::highwayScroll() const
@@ -157,28 +158,36 @@ namespace MusicGame::Scroll
 		return *m_pHighwayScroll;
 	}
 
-	double HighwayScroll::pulseToSec(kson::Pulse pulse, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache) const
+	double HighwayScroll::pulseToSec(kson::Pulse pulse) const
 	{
-		// mutableな変数を操作するのでロック
-		std::lock_guard lock(m_mutex);
+		if (m_pulseToSecSegments.empty())
+		{
+			assert(false && "m_pulseToSecSegments must not be empty");
+			return 0.0;
+		}
 
-		// 既に結果がキャッシュ上にあればキャッシュの値を返す
-		if (m_pulseToSecCache.contains(pulse))
+		// バケットから探索開始位置の区間を求め、その後は次の区間の開始位置を超えるまで進める
+		// (1バケット内のBPM変更は通常ごく少数なので実質定数時間)
+		std::size_t segmentIdx = 0U;
+		if (pulse > 0)
+		{
+			const std::size_t bucketIdx = static_cast<std::size_t>(pulse / kPulseToSecBucketPulses);
+			segmentIdx = m_pulseToSecSegmentIdxByBucket[Min(bucketIdx, m_pulseToSecSegmentIdxByBucket.size() - 1U)];
+		}
+		while (segmentIdx + 1U < m_pulseToSecSegments.size() && m_pulseToSecSegments[segmentIdx + 1U].startPulse <= pulse)
 		{
-			return m_pulseToSecCache.at(pulse);
+			++segmentIdx;
 		}
 
-		// キャッシュ上になければ計算してキャッシュする
-		const double sec = kson::PulseToSec(pulse, beatInfo, timingCache);
-		m_pulseToSecCache.emplace(pulse, sec);
-		return sec;
+		const PulseToSecSegment& segment = m_pulseToSecSegments[segmentIdx];
+		return segment.startSec + static_cast<double>(pulse - segment.startPulse) * segment.secPerPulse;
 	}
 
-	double HighwayScroll::getRelPulseEquvalent(kson::Pulse pulse, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache, const GameStatus& gameStatus) const
+	double HighwayScroll::getRelPulseEquvalent(kson::Pulse pulse, const GameStatus& gameStatus) const
 	{
 		if (m_hispeedSetting.type == HispeedType::CMod)
 		{
-			const double sec = pulseToSec(pulse, beatInfo, timingCache);
+			const double sec = pulseToSec(pulse);
 			const double relTimeSec = sec - gameStatus.currentTimeSec;
 			return relTimeSec / 60 * kson::kResolution;
 		}
@@ -188,9 +197,46 @@ namespace MusicGame::Scroll
 		}
 	}
 
-	HighwayScroll::HighwayScroll(const kson::ChartData& chartData)
+	HighwayScroll::HighwayScroll(const kson::ChartData& chartData, const kson::TimingCache& timingCache)
 		: m_stdBPM(chartData.meta.stdBPM > 0.0 ? chartData.meta.stdBPM : GetModeBPM(chartData))
 	{
+		// BPM変更ごとの区間からPulse値→秒数の変換テーブルを作成
+		// (区間内は線形なので、区間の開始時点の秒数とPulse値あたりの秒数のみを持てば良い)
+		m_pulseToSecSegments.reserve(chartData.beat.bpm.size());
+		for (const auto& [y, bpm] : chartData.beat.bpm)
+		{
+			if (bpm <= 0.0)
+			{
+				assert(false && "BPM must be positive");
+				continue;
+			}
+			m_pulseToSecSegments.push_back({
+				.startPulse = y,
+				.startSec = kson::PulseToSec(y, chartData.beat, timingCache),
+				.secPerPulse = 60.0 / bpm / kson::kResolution,
+			});
+		}
+		if (m_pulseToSecSegments.empty())
+		{
+			// BPMは1個以上存在するはず
+			assert(false && "kson.beat.bpm is empty");
+			m_pulseToSecSegments.push_back({ .startPulse = 0, .startSec = 0.0, .secPerPulse = 60.0 / 120.0 / kson::kResolution });
+		}
+
+		// 各バケットの先頭時点での区間インデックスを求める
+		const kson::Pulse lastSegmentStartPulse = Max(m_pulseToSecSegments.back().startPulse, kson::Pulse{ 0 });
+		const std::size_t numBuckets = static_cast<std::size_t>(lastSegmentStartPulse / kPulseToSecBucketPulses) + 1U;
+		m_pulseToSecSegmentIdxByBucket.reserve(numBuckets);
+		std::size_t segmentIdx = 0U;
+		for (std::size_t bucketIdx = 0U; bucketIdx < numBuckets; ++bucketIdx)
+		{
+			const kson::Pulse bucketStartPulse = static_cast<kson::Pulse>(bucketIdx) * kPulseToSecBucketPulses;
+			while (segmentIdx + 1U < m_pulseToSecSegments.size() && m_pulseToSecSegments[segmentIdx + 1U].startPulse <= bucketStartPulse)
+			{
+				++segmentIdx;
+			}
+			m_pulseToSecSegmentIdxByBucket.push_back(segmentIdx);
+		}
 	}
 
 	void HighwayScroll::update(const HispeedSetting& hispeedSetting, double currentBPM)
@@ -199,14 +245,15 @@ namespace MusicGame::Scroll
 		m_currentBPM = currentBPM;
 		m_hispeedFactor = HispeedFactor(hispeedSetting, m_stdBPM);
 		m_currentHispeed = CurrentHispeed(hispeedSetting, currentBPM, m_stdBPM);
+		m_pixelsPerPulse = kBasePixels * m_hispeedFactor / kson::kResolution4;
 	}
 
-	int32 HighwayScroll::getPositionY(kson::Pulse pulse, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache, const GameStatus& gameStatus) const
+	int32 HighwayScroll::getPositionY(kson::Pulse pulse, const GameStatus& gameStatus) const
 	{
 		assert(m_hispeedFactor != 0.0 && "HighwayScroll::update() must be called at least once before HighwayScroll::getPositionY()");
 
-		const double relPulseEquivalent = getRelPulseEquvalent(pulse, beatInfo, timingCache, gameStatus);
-		return Graphics::kHighwayTextureSize.y - static_cast<int32>(relPulseEquivalent * kBasePixels * m_hispeedFactor / kson::kResolution4);
+		const double relPulseEquivalent = getRelPulseEquvalent(pulse, gameStatus);
+		return Graphics::kHighwayTextureSize.y - static_cast<int32>(relPulseEquivalent * m_pixelsPerPulse);
 	}
 	
 	const HispeedSetting& HighwayScroll::hispeedSetting() const
@@ -1,5 +1,4 @@
 ﻿#pragma once
-#include <mutex>
 #include "music_game/game_status.hpp"
 #include "music_game/graphics/graphics_defines.hpp"
 #include "hispeed_setting.hpp"
@@ -14,17 +13,13 @@ namespace MusicGame::Scroll
 	{
 	private:
 		const HighwayScroll* const m_pHighwayScroll;
-		const kson::BeatInfo* const m_pBeatInfo;
-		const kson::TimingCache* const m_pTimingCache;
 		const GameStatus* const m_pGameStatus;
 
 	public:
 		/// @brief コンストラクタ
 		/// @param pHighwayScroll HighwayScrollのポインタ(メンバ関数呼出時点で有効なポインタであること)
-		/// @param pBeatInfo kson.beatのポインタ(メンバ関数呼出時点で有効なポインタであること)
-		/// @param pTimingCache TimingCacheのポインタ(メンバ関数呼出時点で有効なポインタであること)
 		/// @param pGameStatus GameStatusのポインタ(メンバ関数呼出時点で有効なポインタであること)
-		explicit HighwayScrollContext(const HighwayScroll* pHighwayScroll, const kson::BeatInfo* pBeatInfo, const kson::TimingCache* pTimingCache, const GameStatus* pGameStatus);
+		explicit HighwayScrollContext(const HighwayScroll* pHighwayScroll, const GameStatus* pGameStatus);
 
 		~HighwayScrollContext();
 
@@ -57,32 +52,41 @@ namespace MusicGame::Scroll
 		/// @brief 現在のハイスピード値
 		int32 m_currentHispeed = 0;
 
-		/// @brief キャッシュの排他処理用mutex(M&M rule)
-		mutable std::mutex m_mutex;
+		/// @brief 1Pulseあたりのピクセル数(ハイスピード係数を乗算済み)
+		double m_pixelsPerPulse = 0.0;
 
-		/// @brief pulseToSecのキャッシュ
-		mutable std::unordered_map<kson::Pulse, double> m_pulseToSecCache; // TODO: reserveした方が良さそう。そもそも譜面読み込み時に最初に計算した方が良い
+		/// @brief Pulse値から秒数への変換テーブルの区間(BPMが一定の区間)
+		struct PulseToSecSegment
+		{
+			kson::Pulse startPulse;
+			double startSec;
+			double secPerPulse;
+		};
 
-		/// @brief 時間をPulse値から秒数へ変換(キャッシュ付き)
+		/// @brief Pulse値から秒数への変換テーブル(区分線形、譜面読み込み時に作成)
+		Array<PulseToSecSegment> m_pulseToSecSegments;
+
+		/// @brief 一定Pulse間隔のバケットごとの、バケット先頭時点の区間インデックス(変換テーブルの探索を定数時間にするためのもの)
+		Array<std::size_t> m_pulseToSecSegmentIdxByBucket;
+
+		/// @brief 時間をPulse値から秒数へ変換(事前計算したテーブルを使用)
 		/// @param pulse Pulse値
-		/// @param beatInfo kson.beat
-		/// @param timingCache 事前計算したTimingCache
 		/// @return 秒数
 		/// @note ハイスピードの種類のうちC-modでのみ使用される
-		double pulseToSec(kson::Pulse pulse, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache) const;
+		double pulseToSec(kson::Pulse pulse) const;
 
 		/// @brief 現在時間からの相対Pulse数を求める(C-modの場合は秒数をもとに計算した換算値を返す)
 		/// @param pulse Pulse値
-		/// @param beatInfo kson.beat
-		/// @param timingCache 事前計算したTimingCache
 		/// @param gameStatus ゲーム状態
-		/// @param hispeedSetting ハイスピード設定
 		/// @return 相対Pulse数換算値
 		/// @note HSP版: https://github.com/m4saka/kshootmania-v1-hsp/blob/1c75880b545d1232eeffc4bb3fc19704a3622f73/src/scene/play/play_utils.hsp#L246-L269
-		double getRelPulseEquvalent(kson::Pulse pulse, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache, const GameStatus& gameStatus) const;
+		double getRelPulseEquvalent(kson::Pulse pulse, const GameStatus& gameStatus) const;
 
 	public:
-		explicit HighwayScroll(const kson::ChartData& chartData);
+		/// @brief コンストラクタ
+		/// @param chartData 譜面データ
+		/// @param timingCache 事前計算したTimingCache
+		HighwayScroll(const kson::ChartData& chartData, const kson::TimingCache& timingCache);
 
 		/// @brief 毎フレームの更新
 		/// @param hispeedSetting ハイスピード設定
@@ -91,12 +95,9 @@ namespace MusicGame::Scroll
 
 		/// @brief Pulse値をもとにHighway上のY座標を求める
 		/// @param pulse Pulse値
-		/// @param beatInfo kson.beat
-		/// @param timingCache 事前計算したTimingCache
 		/// @param gameStatus ゲーム状態
-		/// @param hispeedSetting ハイスピード設定
 		/// @return Y座標
-		int32 getPositionY(kson::Pulse pulse, const kson::BeatInfo& beatInfo, const kson::TimingCache& timingCache, const GameStatus& gameStatus) const;
+		int32 getPositionY(kson::Pulse pulse, const GameStatus& gameStatus) const;
 
 		/// @brief ハイスピード設定を返す
 		/// @return ハイスピード設定
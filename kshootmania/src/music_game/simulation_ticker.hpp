@@ -0,0 +1,63 @@
+﻿#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+// 判定・効果音を一定間隔のティックで更新するための、各ティックの時刻の計算
+// Note: 描画なしでテストできるよう、Siv3Dに依存しないようにしている
+namespace MusicGame
+{
+	/// @brief シミュレーション(判定・効果音)を一定間隔のティックで実行するクラス
+	/// @note 描画のフレームレートに関係なく、常に同じ時刻のティックが同じ順番で実行される
+	class SimulationTicker
+	{
+	public:
+		/// @brief ティック間隔(秒)
+		static constexpr double kTickSec = 1.0 / 1000;
+
+		/// @brief 1フレームで実行するティック数の上限
+		static constexpr std::int64_t kMaxTicksPerFrame = 100;
+
+	private:
+		// 次に実行するティック番号
+		// (ティックの時刻はティック番号とティック間隔の積。未開始の場合はstd::nullopt)
+		std::optional<std::int64_t> m_nextTickIdx = std::nullopt;
+
+	public:
+		SimulationTicker() = default;
+
+		/// @brief フレームの時刻までの未実行のティックを順番に実行する
+		/// @param frameTimeSec フレームの時刻(BGMの再生位置)
+		/// @param frameTimeSampledAt frameTimeSecを取得した時点の時刻
+		/// @param tickFunc 各ティックで呼ぶ関数(引数はティックの時刻(秒)と、そのティックの時刻に対応する取得時点の時刻)
+		/// @note 初回、または再生位置が戻った場合はフレームの時刻のティックから開始する。処理落ち等で大きく遅れた場合は古いティックを省略する
+		template <typename TickFunc>
+		void advance(double frameTimeSec, std::chrono::steady_clock::time_point frameTimeSampledAt, TickFunc&& tickFunc)
+		{
+			// frameTimeSec以前で最後のティック番号
+			const std::int64_t lastTickIdx = static_cast<std::int64_t>(std::floor(frameTimeSec / kTickSec));
+			if (!m_nextTickIdx.has_value() || lastTickIdx < m_nextTickIdx.value() - 1)
+			{
+				// 初回、または再生位置が戻った場合は現在時刻のティックから開始
+				m_nextTickIdx = lastTickIdx;
+			}
+			else if (lastTickIdx - m_nextTickIdx.value() >= kMaxTicksPerFrame)
+			{
+				// 処理落ち等で大きく遅れた場合は古いティックを省略
+				m_nextTickIdx = lastTickIdx - kMaxTicksPerFrame + 1;
+			}
+
+			// 前回のフレーム以降の各ティックを順番に実行
+			// (各ティックの時刻でBGMの再生位置を取得した扱いにするため、取得時点の時刻もティックの時刻に合わせてずらす)
+			for (std::int64_t tickIdx = m_nextTickIdx.value(); tickIdx <= lastTickIdx; ++tickIdx)
+			{
+				const double tickTimeSec = static_cast<double>(tickIdx) * kTickSec;
+				const auto tickTimeSampledAt = frameTimeSampledAt - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(frameTimeSec - tickTimeSec));
+				tickFunc(tickTimeSec, tickTimeSampledAt);
+			}
+			m_nextTickIdx = (std::max)(m_nextTickIdx.value(), lastTickIdx + 1);
+		}
+	};
+}
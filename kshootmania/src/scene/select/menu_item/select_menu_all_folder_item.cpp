@@ -13,7 +13,14 @@ SelectMenuAllFolderItem::SelectMenuAllFolderItem(IsCurrentFolderYN isCurrentFold
 
 void SelectMenuAllFolderItem::decide(const SelectMenuEventContext& context, [[maybe_unused]] int32 difficultyIdx)
 {
-	//Print << U"Not Implemented (SelectMenuAllFolderItem::decide)";
+	if (m_isCurrentFolder)
+	{
+		context.fnCloseFolder();
+	}
+	else
+	{
+		context.fnOpenDirectory(FilePath{ kAllFolderSpecialPath });
+	}
 }
 
 void SelectMenuAllFolderItem::drawCenter([[maybe_unused]] int32 difficultyIdx, const RenderTexture& renderTexture, const SelectMenuItemGraphicAssets& assets) const
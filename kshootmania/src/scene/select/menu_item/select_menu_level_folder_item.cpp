@@ -0,0 +1,57 @@
+﻿#include "select_menu_level_folder_item.hpp"
+#include "scene/select/select_menu_graphics.hpp"
+
+FilePath SelectMenuLevelFolderItem::LevelFolderSpecialPath(int32 level)
+{
+	return U"{}{}"_fmt(kLevelFolderSpecialPathPrefix, level);
+}
+
+Optional<int32> SelectMenuLevelFolderItem::LevelFromSpecialPath(FilePathView fullPath)
+{
+	if (!fullPath.starts_with(kLevelFolderSpecialPathPrefix))
+	{
+		return none;
+	}
+
+	const Optional<int32> level = ParseIntOpt<int32>(fullPath.substr(kLevelFolderSpecialPathPrefix.size()));
+	if (!level.has_value() || level.value() < kLevelMin || kLevelMax < level.value())
+	{
+		return none;
+	}
+	return level;
+}
+
+SelectMenuLevelFolderItem::SelectMenuLevelFolderItem(IsCurrentFolderYN isCurrentFolder, int32 level)
+	: m_isCurrentFolder(isCurrentFolder)
+	, m_fullPath(LevelFolderSpecialPath(level))
+	, m_displayName(U"Level {}"_fmt(level))
+{
+}
+
+void SelectMenuLevelFolderItem::decide(const SelectMenuEventContext& context, [[maybe_unused]] int32 difficultyIdx)
+{
+	if (m_isCurrentFolder)
+	{
+		context.fnCloseFolder();
+	}
+	else
+	{
+		context.fnOpenDirectory(m_fullPath);
+	}
+}
+
+void SelectMenuLevelFolderItem::drawCenter([[maybe_unused]] int32 difficultyIdx, const RenderTexture& renderTexture, const SelectMenuItemGraphicAssets& assets) const
+{
+	Shader::Copy(assets.dirItemTextures.center, renderTexture);
+
+	const ScopedRenderTarget2D scopedRenderTarget(renderTexture);
+	assets.font(FolderDisplayNameCenter(m_displayName, m_isCurrentFolder)).drawAt(44, Vec2{ 16 + 740 / 2, 135 + 102 / 2 });
+}
+
+void SelectMenuLevelFolderItem::drawUpperLower([[maybe_unused]] int32 difficultyIdx, const RenderTexture& renderTexture, const SelectMenuItemGraphicAssets& assets, bool isUpper) const
+{
+	Shader::Copy(isUpper ? assets.dirItemTextures.upperHalf : assets.dirItemTextures.lowerHalf, renderTexture);
+
+	const ScopedRenderTarget2D scopedRenderTarget(renderTexture);
+	assets.font(FolderDisplayNameUpperLower(m_displayName, m_isCurrentFolder)).drawAt(38, isUpper ? Vec2{ 16 + 770 / 2, 12 + 86 / 2 } : Vec2{ 16 + 770 / 2, 126 + 86 / 2 });
+}
@@ -0,0 +1,38 @@
+﻿#pragma once
+#include "iselect_menu_item.hpp"
+
+class SelectMenuLevelFolderItem : public ISelectMenuItem
+{
+private:
+	const IsCurrentFolderYN m_isCurrentFolder;
+	const FilePath m_fullPath;
+	const String m_displayName;
+
+public:
+	static constexpr StringView kLevelFolderSpecialPathPrefix = U"*level"; // FullPathがこの接頭辞に続けてレベルの数値の場合は例外的にレベルフォルダを表す
+
+	/// @brief レベルフォルダを表すFullPathを返す
+	/// @param level レベル
+	/// @return FullPath
+	static FilePath LevelFolderSpecialPath(int32 level);
+
+	/// @brief FullPathがレベルフォルダを表す場合にそのレベルを返す
+	/// @param fullPath FullPath
+	/// @return レベル(レベルフォルダを表さない場合はnone)
+	static Optional<int32> LevelFromSpecialPath(FilePathView fullPath);
+
+	SelectMenuLevelFolderItem(IsCurrentFolderYN isCurrentFolder, int32 level);
+
+	virtual ~SelectMenuLevelFolderItem() = default;
+
+	virtual FilePathView fullPath() const override
+	{
+		return m_fullPath;
+	}
+
+	virtual void decide(const SelectMenuEventContext& context, int32 difficultyIdx) override;
+
+	virtual void drawCenter(int32 difficultyIdx, const RenderTexture& renderTexture, const SelectMenuItemGraphicAssets& assets) const override;
+
+	virtual void drawUpperLower(int32 difficultyIdx, const RenderTexture& renderTexture, const SelectMenuItemGraphicAssets& assets, bool isUpper) const override;
+};
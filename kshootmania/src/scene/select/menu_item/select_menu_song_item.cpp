@@ -5,16 +5,26 @@
 
 namespace
 {
-	void DrawJacketImage(FilePathView filePath, const Vec2& pos, SizeF size)
+	// デコード中のジャケット画像の代わりに表示する矩形の色
+	constexpr ColorF kJacketPlaceholderColor{ 0.0, 0.5 };
+
+	void DrawJacketImage(const SelectJacketCache& jacketCache, FilePathView filePath, const Vec2& pos, SizeF size)
 	{
-		// TODO: Cache jacket image texture
+		const Optional<Texture> jacketTextureOpt = jacketCache.get(filePath);
+		if (!jacketTextureOpt.has_value())
+		{
+			// デコード中は代わりの矩形を表示
+			RectF{ pos, size }.draw(kJacketPlaceholderColor);
+			return;
+		}
 
-		if (!FileSystem::IsFile(filePath))
+		const Texture& jacketTexture = jacketTextureOpt.value();
+		if (jacketTexture.isEmpty())
 		{
+			// 画像が存在しない
 			return;
 		}
 
-		const Texture jacketTexture(filePath);
 		if (jacketTexture.width() < jacketTexture.height())
 		{
 			size.x *= static_cast<double>(jacketTexture.width()) / jacketTexture.height();
@@ -132,7 +142,7 @@ void SelectMenuSongItem::drawCenter(int32 difficultyIdx, const RenderTexture& re
 	FontUtils::DrawTextCenterWithFitWidth(assets.font(pChartInfo->artist()), 23, 22, { 16, 48, 462, 36 });
 
 	// Jacket
-	DrawJacketImage(pChartInfo->jacketFilePath(), { 492, 22 }, { 254, 254 });
+	DrawJacketImage(assets.jacketCache, pChartInfo->jacketFilePath(), { 492, 22 }, { 254, 254 });
 
 	// Jacket author (Illustrated by)
 	FontUtils::DrawTextLeftWithFitWidth(assets.font(pChartInfo->jacketAuthor()), 17, 15, { 630, 290, 110, 18 }, Palette::Black, 1);
@@ -178,7 +188,7 @@ void SelectMenuSongItem::drawUpperLower(int32 difficultyIdx, const RenderTexture
 	FontUtils::DrawTextCenterWithFitWidth(assets.font(pAltChartInfo->artist()), 24, 22, { 245, isUpper ? 67 : 171, 324, 40 });
 
 	// ジャケット画像を描画
-	DrawJacketImage(pAltChartInfo->jacketFilePath(), { 600, 10 }, { 208, 208 });
+	DrawJacketImage(assets.jacketCache, pAltChartInfo->jacketFilePath(), { 600, 10 }, { 208, 208 });
 
 	// レベル・クリアメダル・グレードは、現在カーソルの難易度が存在しない場合は表示しないようにする必要がある
 	// そのため、difficultyIdxのままの難易度で取得したpChartInfoを使用する
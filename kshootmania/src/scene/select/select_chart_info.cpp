@@ -1,6 +1,7 @@
 ﻿#include "select_chart_info.hpp"
 #include "high_score/ksc_io.hpp"
 #include "kson/io/ksh_io.hpp"
+#include "select_chart_metadata_index.hpp"
 
 namespace
 {
@@ -20,36 +21,35 @@ namespace
 	}
 }
 
-FilePath SelectChartInfo::toFullPath(const std::string& u8Filename) const
+FilePath SelectChartInfo::toFullPath(const String& filename) const
 {
-	return FileSystem::PathAppend(FileSystem::ParentPath(m_chartFilePath), Unicode::FromUTF8(u8Filename));
+	return FileSystem::PathAppend(FileSystem::ParentPath(m_chartFilePath), filename);
 }
 
 SelectChartInfo::SelectChartInfo(FilePathView chartFilePath)
 	: m_chartFilePath(chartFilePath)
-	, m_chartData(kson::LoadKSHMetaChartData(chartFilePath.narrow()))
-	, m_highScoreInfo(LoadHighScoreInfo(chartFilePath))
+	, m_metadata(SelectChartMetadataIndex::Get(chartFilePath))
 {
 }
 
 String SelectChartInfo::title() const
 {
-	return Unicode::FromUTF8(m_chartData.meta.title);
+	return m_metadata.title;
 }
 
 String SelectChartInfo::artist() const
 {
-	return Unicode::FromUTF8(m_chartData.meta.artist);
+	return m_metadata.artist;
 }
 
 FilePath SelectChartInfo::jacketFilePath() const
 {
-	return toFullPath(m_chartData.meta.jacketFilename);
+	return toFullPath(m_metadata.jacketFilename);
 }
 
 String SelectChartInfo::jacketAuthor() const
 {
-	return Unicode::FromUTF8(m_chartData.meta.jacketAuthor);
+	return m_metadata.jacketAuthor;
 }
 
 FilePathView SelectChartInfo::chartFilePath() const
@@ -59,60 +59,70 @@ FilePathView SelectChartInfo::chartFilePath() const
 
 String SelectChartInfo::chartAuthor() const
 {
-	return Unicode::FromUTF8(m_chartData.meta.chartAuthor);
+	return m_metadata.chartAuthor;
 }
 
 int32 SelectChartInfo::difficultyIdx() const
 {
-	return m_chartData.meta.difficulty.idx;
+	return m_metadata.difficultyIdx;
 }
 
 int32 SelectChartInfo::level() const
 {
-	return m_chartData.meta.level;
+	return m_metadata.level;
+}
+
+Optional<double> SelectChartInfo::maxBPM() const
+{
+	return m_metadata.maxBPM;
 }
 
 FilePath SelectChartInfo::previewBGMFilePath() const
 {
-	return toFullPath(m_chartData.audio.bgm.filename);
+	return toFullPath(m_metadata.bgmFilename);
 }
 
 SecondsF SelectChartInfo::previewBGMOffset() const
 {
-	return SecondsF{ m_chartData.audio.bgm.preview.offset / 1000.0 };
+	return SecondsF{ m_metadata.previewOffsetMs / 1000.0 };
 }
 
 Duration SelectChartInfo::previewBGMDuration() const
 {
-	return Duration{ m_chartData.audio.bgm.preview.duration / 1000.0 };
+	return Duration{ m_metadata.previewDurationMs / 1000.0 };
 }
 
 double SelectChartInfo::previewBGMVolume() const
 {
-	return m_chartData.audio.bgm.vol;
+	return m_metadata.bgmVolume;
 }
 
 FilePath SelectChartInfo::iconFilePath() const
 {
-	return toFullPath(m_chartData.meta.iconFilename);
+	return toFullPath(m_metadata.iconFilename);
 }
 
 String SelectChartInfo::information() const
 {
-	return Unicode::FromUTF8(m_chartData.meta.information);
+	return m_metadata.information;
 }
 
 const HighScoreInfo& SelectChartInfo::highScoreInfo() const
 {
-	return m_highScoreInfo;
+	// 選曲画面で表示されない譜面のkscファイルは読み込まずに済むよう、初回参照時に読み込む
+	if (!m_highScoreInfo.has_value())
+	{
+		m_highScoreInfo = LoadHighScoreInfo(m_chartFilePath);
+	}
+	return m_highScoreInfo.value();
 }
 
 bool SelectChartInfo::hasError() const
 {
-	return m_chartData.error != kson::ErrorType::None;
+	return m_metadata.error != kson::ErrorType::None;
 }
 
 String SelectChartInfo::errorString() const
 {
-	return Unicode::FromUTF8(kson::GetErrorString(m_chartData.error));
+	return Unicode::FromUTF8(kson::GetErrorString(m_metadata.error));
 }
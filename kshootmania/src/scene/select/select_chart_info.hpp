@@ -1,5 +1,5 @@
 ﻿#pragma once
-#include "kson/chart_data.hpp"
+#include "select_chart_metadata.hpp"
 #include "high_score/high_score_info.hpp"
 
 class SelectChartInfo
@@ -7,11 +7,12 @@ class SelectChartInfo
 private:
 	FilePath m_chartFilePath;
 
-	kson::MetaChartData m_chartData;
+	SelectChartMetadata m_metadata;
 
-	HighScoreInfo m_highScoreInfo;
+	// ハイスコア情報(表示時に初めて読み込む)
+	mutable Optional<HighScoreInfo> m_highScoreInfo = none;
 
-	FilePath toFullPath(const std::string& u8Filename) const;
+	FilePath toFullPath(const String& filename) const;
 
 public:
 	explicit SelectChartInfo(FilePathView chartFilePath);
@@ -32,6 +33,10 @@ public:
 
 	int32 level() const;
 
+	/// @brief 表示用のBPMの最大値
+	/// @return BPM(BPM変化がある場合は範囲の最大値。表示用のBPMに数値が含まれない場合はnone)
+	Optional<double> maxBPM() const;
+
 	FilePath previewBGMFilePath() const;
 
 	SecondsF previewBGMOffset() const;
@@ -0,0 +1,62 @@
+﻿#include "select_chart_metadata.hpp"
+
+namespace
+{
+	/// @brief 表示用のBPMに含まれる数値の最小値・最大値を求める
+	/// @param dispBPM 表示用のBPM("120-240"のような範囲の場合がある)
+	/// @return 最小値・最大値(数値を含まない場合はnone)
+	std::pair<Optional<double>, Optional<double>> BPMRange(StringView dispBPM)
+	{
+		Optional<double> minBPM = none;
+		Optional<double> maxBPM = none;
+		std::size_t pos = 0U;
+		while (pos < dispBPM.size())
+		{
+			// 数字と小数点の並びを1つの数値として扱う
+			// (範囲の区切りの'-'などはそれ以外の文字として読み飛ばす)
+			std::size_t endPos = pos;
+			while (endPos < dispBPM.size() && (IsDigit(dispBPM[endPos]) || dispBPM[endPos] == U'.'))
+			{
+				++endPos;
+			}
+			if (endPos == pos)
+			{
+				++pos;
+				continue;
+			}
+
+			if (const Optional<double> bpm = ParseOpt<double>(dispBPM.substr(pos, endPos - pos)))
+			{
+				minBPM = minBPM ? Min(*minBPM, *bpm) : *bpm;
+				maxBPM = maxBPM ? Max(*maxBPM, *bpm) : *bpm;
+			}
+			pos = endPos;
+		}
+		return { minBPM, maxBPM };
+	}
+}
+
+SelectChartMetadata SelectChartMetadata::FromMetaChartData(const kson::MetaChartData& chartData)
+{
+	String dispBPM = Unicode::FromUTF8(chartData.meta.dispBPM);
+	const auto [minBPM, maxBPM] = BPMRange(dispBPM);
+	return {
+		.title = Unicode::FromUTF8(chartData.meta.title),
+		.artist = Unicode::FromUTF8(chartData.meta.artist),
+		.jacketFilename = Unicode::FromUTF8(chartData.meta.jacketFilename),
+		.jacketAuthor = Unicode::FromUTF8(chartData.meta.jacketAuthor),
+		.chartAuthor = Unicode::FromUTF8(chartData.meta.chartAuthor),
+		.iconFilename = Unicode::FromUTF8(chartData.meta.iconFilename),
+		.information = Unicode::FromUTF8(chartData.meta.information),
+		.difficultyIdx = chartData.meta.difficulty.idx,
+		.level = chartData.meta.level,
+		.dispBPM = std::move(dispBPM),
+		.minBPM = minBPM,
+		.maxBPM = maxBPM,
+		.bgmFilename = Unicode::FromUTF8(chartData.audio.bgm.filename),
+		.bgmVolume = chartData.audio.bgm.vol,
+		.previewOffsetMs = static_cast<int32>(chartData.audio.bgm.preview.offset),
+		.previewDurationMs = static_cast<int32>(chartData.audio.bgm.preview.duration),
+		.error = chartData.error,
+	};
+}
@@ -0,0 +1,45 @@
+﻿#pragma once
+#include "kson/chart_data.hpp"
+
+/// @brief 選曲画面で使用する譜面のメタデータ
+/// @note インデックスファイルにキャッシュできるよう、kson::MetaChartDataのうち選曲画面で必要なものだけを値として持つ
+struct SelectChartMetadata
+{
+	String title;
+
+	String artist;
+
+	String jacketFilename;
+
+	String jacketAuthor;
+
+	String chartAuthor;
+
+	String iconFilename;
+
+	String information;
+
+	int32 difficultyIdx = 0;
+
+	int32 level = 1;
+
+	// 表示用のBPM(BPM変化がある場合は"120-240"のような範囲の文字列)
+	String dispBPM;
+
+	// 表示用のBPMに含まれる数値の最小値・最大値(並べ替え用。数値を含まない場合はnone)
+	Optional<double> minBPM = none;
+
+	Optional<double> maxBPM = none;
+
+	String bgmFilename;
+
+	double bgmVolume = 1.0;
+
+	int32 previewOffsetMs = 0;
+
+	int32 previewDurationMs = 0;
+
+	kson::ErrorType error = kson::ErrorType::None;
+
+	static SelectChartMetadata FromMetaChartData(const kson::MetaChartData& chartData);
+};
@@ -0,0 +1,294 @@
+﻿#include "select_chart_metadata_index.hpp"
+#include <mutex>
+#include "select_chart_metadata_index_prune.hpp"
+#include "kson/io/ksh_io.hpp"
+
+namespace SelectChartMetadataIndex
+{
+	namespace
+	{
+		constexpr FilePathView kIndexFilePath = U"cache/chart_metadata_index.tsv";
+
+		// インデックスファイルの1行目
+		// (項目の形式を変更した場合は末尾のバージョンを上げること。異なる場合はインデックスファイル全体を読み捨てる)
+		constexpr StringView kIndexFileHeader = U"#kshootmania-chart-metadata-index 2";
+
+		constexpr std::size_t kNumColumns = 20U;
+
+		struct Entry
+		{
+			int64 fileSize = 0;
+
+			String writeTime;
+
+			SelectChartMetadata metadata;
+
+			// 最後に参照された走査の番号(インデックスファイルには保存しない)
+			uint64 visitedScanId = 0;
+		};
+
+		// 曲の走査スレッドからも参照されるため、以下の変数はs_mutexで保護する
+		std::mutex s_mutex;
+
+		HashTable<FilePath, Entry> s_entries;
+
+		bool s_isLoaded = false;
+
+		bool s_isDirty = false;
+
+		uint64 s_scanId = 0;
+
+		/// @brief ファイルの更新日時をインデックス上の比較用の文字列で返す
+		/// @param filePath ファイルパス
+		/// @return 比較用の文字列(取得できない場合は空文字列)
+		String WriteTimeString(FilePathView filePath)
+		{
+			const Optional<DateTime> writeTime = FileSystem::WriteTime(filePath);
+			if (!writeTime.has_value())
+			{
+				return U"";
+			}
+			return writeTime->format(U"yyyyMMddHHmmssSSS");
+		}
+
+		/// @brief インデックスファイルの列として書き込める文字列を返す
+		/// @param str 文字列
+		/// @return タブ・改行を空白に置換した文字列
+		/// @note KSHのヘッダの値は1行なので、実際に置換が発生することはほぼない
+		String SanitizeColumn(const String& str)
+		{
+			return str.replaced(U'\t', U' ').replaced(U'\r', U' ').replaced(U'\n', U' ');
+		}
+
+		/// @brief 値がない場合がある数値の列を読み込む
+		/// @param column 列の文字列
+		/// @param pValue 読み込んだ値の格納先(空文字列の場合はnone)
+		/// @return 空文字列または数値の場合はtrue
+		bool TryParseOptionalColumn(const String& column, Optional<double>* pValue)
+		{
+			if (column.empty())
+			{
+				*pValue = none;
+				return true;
+			}
+			*pValue = ParseOpt<double>(column);
+			return pValue->has_value();
+		}
+
+		/// @brief 値がない場合がある数値を列の文字列にする
+		/// @param value 値
+		/// @return 列の文字列(noneの場合は空文字列)
+		String FormatOptionalColumn(const Optional<double>& value)
+		{
+			return value ? Format(*value) : U"";
+		}
+
+		bool TryParseLine(const String& line, FilePath* pChartFilePath, Entry* pEntry)
+		{
+			if (pChartFilePath == nullptr || pEntry == nullptr)
+			{
+				assert(false && "pChartFilePath and pEntry must not be NULL");
+				return false;
+			}
+
+			const Array<String> columns = line.split(U'\t');
+			if (columns.size() != kNumColumns)
+			{
+				return false;
+			}
+
+			const Optional<int64> fileSize = ParseOpt<int64>(columns[1]);
+			const Optional<int32> difficultyIdx = ParseOpt<int32>(columns[10]);
+			const Optional<int32> level = ParseOpt<int32>(columns[11]);
+			const Optional<double> bgmVolume = ParseOpt<double>(columns[16]);
+			const Optional<int32> previewOffsetMs = ParseOpt<int32>(columns[17]);
+			const Optional<int32> previewDurationMs = ParseOpt<int32>(columns[18]);
+			const Optional<int32> error = ParseOpt<int32>(columns[19]);
+			if (!fileSize || !difficultyIdx || !level || !bgmVolume || !previewOffsetMs || !previewDurationMs || !error)
+			{
+				return false;
+			}
+
+			Optional<double> minBPM;
+			Optional<double> maxBPM;
+			if (!TryParseOptionalColumn(columns[13], &minBPM) || !TryParseOptionalColumn(columns[14], &maxBPM))
+			{
+				return false;
+			}
+
+			*pChartFilePath = columns[0];
+			*pEntry = {
+				.fileSize = *fileSize,
+				.writeTime = columns[2],
+				.metadata = {
+					.title = columns[3],
+					.artist = columns[4],
+					.jacketFilename = columns[5],
+					.jacketAuthor = columns[6],
+					.chartAuthor = columns[7],
+					.iconFilename = columns[8],
+					.information = columns[9],
+					.difficultyIdx = *difficultyIdx,
+					.level = *level,
+					.dispBPM = columns[12],
+					.minBPM = minBPM,
+					.maxBPM = maxBPM,
+					.bgmFilename = columns[15],
+					.bgmVolume = *bgmVolume,
+					.previewOffsetMs = *previewOffsetMs,
+					.previewDurationMs = *previewDurationMs,
+					.error = static_cast<kson::ErrorType>(*error),
+				},
+			};
+			return true;
+		}
+
+		String ToLine(FilePathView chartFilePath, const Entry& entry)
+		{
+			const SelectChartMetadata& metadata = entry.metadata;
+			const Array<String> columns = {
+				SanitizeColumn(String{ chartFilePath }),
+				Format(entry.fileSize),
+				entry.writeTime,
+				SanitizeColumn(metadata.title),
+				SanitizeColumn(metadata.artist),
+				SanitizeColumn(metadata.jacketFilename),
+				SanitizeColumn(metadata.jacketAuthor),
+				SanitizeColumn(metadata.chartAuthor),
+				SanitizeColumn(metadata.iconFilename),
+				SanitizeColumn(metadata.information),
+				Format(metadata.difficultyIdx),
+				Format(metadata.level),
+				SanitizeColumn(metadata.dispBPM),
+				FormatOptionalColumn(metadata.minBPM),
+				FormatOptionalColumn(metadata.maxBPM),
+				SanitizeColumn(metadata.bgmFilename),
+				Format(metadata.bgmVolume),
+				Format(metadata.previewOffsetMs),
+				Format(metadata.previewDurationMs),
+				Format(static_cast<int32>(metadata.error)),
+			};
+			assert(columns.size() == kNumColumns && "Column count mismatch");
+			return columns.join(U"\t", U"", U"");
+		}
+
+		void LoadIfNotLoaded()
+		{
+			if (s_isLoaded)
+			{
+				return;
+			}
+			s_isLoaded = true;
+
+			TextReader reader(kIndexFilePath);
+			if (!reader)
+			{
+				// インデックスファイルがない場合は空の状態から作成
+				return;
+			}
+
+			String line;
+			if (!reader.readLine(line) || line != kIndexFileHeader)
+			{
+				// 形式が異なる場合は作り直す
+				Logger << U"[SelectChartMetadataIndex] Index file version mismatch. Rebuilding...";
+				s_isDirty = true;
+				return;
+			}
+
+			FilePath chartFilePath;
+			Entry entry;
+			while (reader.readLine(line))
+			{
+				if (!TryParseLine(line, &chartFilePath, &entry))
+				{
+					s_isDirty = true;
+					continue;
+				}
+				s_entries[std::move(chartFilePath)] = std::move(entry);
+			}
+		}
+	}
+
+	SelectChartMetadata Get(FilePathView chartFilePath)
+	{
+		FilePath chartFilePathKey{ chartFilePath };
+		const int64 fileSize = FileSystem::FileSize(chartFilePath);
+		String writeTime = WriteTimeString(chartFilePath);
+		{
+			const std::lock_guard lock(s_mutex);
+			LoadIfNotLoaded();
+
+			if (const auto itr = s_entries.find(chartFilePathKey); itr != s_entries.end())
+			{
+				Entry& entry = itr->second;
+				if (entry.fileSize == fileSize && entry.writeTime == writeTime)
+				{
+					entry.visitedScanId = s_scanId;
+					return entry.metadata;
+				}
+			}
+		}
+
+		// インデックスにないか、譜面ファイルが変更されている場合は読み込み直す
+		// (譜面ファイルの読み込み中は他のスレッドを待たせないようロックしない)
+		Entry entry{
+			.fileSize = fileSize,
+			.writeTime = std::move(writeTime),
+			.metadata = SelectChartMetadata::FromMetaChartData(kson::LoadKSHMetaChartData(chartFilePath.narrow())),
+		};
+		const SelectChartMetadata metadata = entry.metadata;
+		{
+			const std::lock_guard lock(s_mutex);
+			entry.visitedScanId = s_scanId;
+			s_entries[std::move(chartFilePathKey)] = std::move(entry);
+			s_isDirty = true;
+		}
+		return metadata;
+	}
+
+	uint64 BeginScan()
+	{
+		const std::lock_guard lock(s_mutex);
+		return ++s_scanId;
+	}
+
+	void PruneUnvisited(FilePathView directoryPath, uint64 scanId)
+	{
+		// 譜面ファイルのパスは走査時のフルパスなので、ディレクトリのフルパスとの前方一致で判定する
+		FilePath directoryPathPrefix = FileSystem::FullPath(directoryPath);
+		if (!directoryPathPrefix.ends_with(U'/'))
+		{
+			directoryPathPrefix.push_back(U'/');
+		}
+
+		const std::lock_guard lock(s_mutex);
+		LoadIfNotLoaded();
+		if (EraseUnvisitedEntries(s_entries, StringView{ directoryPathPrefix }, scanId) > 0U)
+		{
+			s_isDirty = true;
+		}
+	}
+
+	void SaveIfDirty()
+	{
+		const std::lock_guard lock(s_mutex);
+		if (!s_isDirty)
+		{
+			return;
+		}
+
+		TextWriter writer(kIndexFilePath, TextEncoding::UTF8_NO_BOM);
+		if (!writer)
+		{
+			Logger << U"[SelectChartMetadataIndex] Could not open index file: {}"_fmt(kIndexFilePath);
+			return;
+		}
+		writer.writeln(kIndexFileHeader);
+		for (const auto& [chartFilePath, entry] : s_entries)
+		{
+			writer.writeln(ToLine(chartFilePath, entry));
+		}
+		s_isDirty = false;
+	}
+}
@@ -0,0 +1,32 @@
+﻿#pragma once
+#include "select_chart_metadata.hpp"
+
+/// @brief 譜面のメタデータのインデックス
+/// @note 譜面ファイルのサイズ・更新日時とともにメタデータをファイルに保存しておき、変更のない譜面ファイルは読み込まずにインデックスの値を使用する
+namespace SelectChartMetadataIndex
+{
+	/// @brief 譜面のメタデータを取得する
+	/// @param chartFilePath 譜面ファイルのパス
+	/// @return メタデータ
+	/// @note 初回呼び出し時にインデックスファイルを読み込む。インデックスにないか、ファイルサイズ・更新日時が異なる場合は譜面ファイルを読み込んでインデックスを更新する
+	/// @note スレッドセーフ
+	SelectChartMetadata Get(FilePathView chartFilePath);
+
+	/// @brief 曲の走査の開始を通知する
+	/// @return 走査の番号(PruneUnvisitedに渡す)
+	/// @note 以降のGetで参照された項目には、この走査で参照済みであることを記録する
+	/// @note スレッドセーフ
+	uint64 BeginScan();
+
+	/// @brief 走査が完了したディレクトリ以下で、その走査中に参照されなかった譜面の項目を削除する
+	/// @param directoryPath 走査したディレクトリのパス
+	/// @param scanId BeginScanが返した走査の番号
+	/// @note 譜面ファイルの存在確認は行わないため、曲の走査スレッドから走査の完了時に呼ぶ
+	/// @note スレッドセーフ
+	void PruneUnvisited(FilePathView directoryPath, uint64 scanId);
+
+	/// @brief インデックスに変更があればインデックスファイルへ書き込む
+	/// @note ファイルの書き込みが発生するため、曲の走査スレッドから走査の完了時に呼ぶ
+	/// @note スレッドセーフ
+	void SaveIfDirty();
+}
@@ -0,0 +1,33 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace SelectChartMetadataIndex
+{
+	/// @brief 走査が完了したディレクトリ以下で、その走査中に参照されなかった項目を削除する
+	/// @param entries 譜面ファイルのパスをキーとする項目の連想配列(値はvisitedScanIdを持つ)
+	/// @param directoryPathPrefix 走査したディレクトリのパス(末尾はスラッシュ)
+	/// @param scanId 走査の番号
+	/// @return 削除した項目の数
+	/// @note 譜面ファイルの存在確認は行わず、走査中に参照されなかった譜面ファイルを削除されたものとみなす
+	/// @note Siv3Dに依存しないベンチマークからも使用するため、テンプレートとしてヘッダに記述している
+	template <typename EntryMap, typename StringView>
+	std::size_t EraseUnvisitedEntries(EntryMap& entries, StringView directoryPathPrefix, std::uint64_t scanId)
+	{
+		std::size_t numErased = 0U;
+		for (auto itr = entries.begin(); itr != entries.end();)
+		{
+			if (itr->second.visitedScanId < scanId && itr->first.starts_with(directoryPathPrefix))
+			{
+				// Note: Siv3DのHashTableはerase()がイテレータを返さないため、後置インクリメントで次の要素へ進める
+				entries.erase(itr++);
+				++numErased;
+			}
+			else
+			{
+				++itr;
+			}
+		}
+		return numErased;
+	}
+}
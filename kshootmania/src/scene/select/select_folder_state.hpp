@@ -7,6 +7,7 @@ struct SelectFolderState
 		kNone = 0,
 		kDirectory,
 		kAll,
+		kLevel,
 		kFavorite,
 	};
 
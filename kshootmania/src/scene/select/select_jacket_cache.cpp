@@ -0,0 +1,162 @@
+﻿#include "select_jacket_cache.hpp"
+
+namespace
+{
+	// キャッシュするテクスチャの枚数の上限
+	constexpr std::size_t kMaxNumTextures = 64U;
+
+	// キャッシュするテクスチャの合計バイト数の上限
+	constexpr std::size_t kMaxTotalBytes = 64U * 1024U * 1024U;
+
+	// デコード待ちのファイルパスの数の上限
+	// (カーソル移動が速い場合に、既に表示範囲外になった古い要求は破棄する)
+	constexpr std::size_t kMaxNumRequests = 32U;
+
+	// ジャケット画像の最大サイズ
+	// (これより大きい画像は縮小してからテクスチャにする)
+	constexpr int32 kMaxJacketImageSize = 512;
+
+	Image LoadJacketImage(FilePathView filePath)
+	{
+		if (!FileSystem::IsFile(filePath))
+		{
+			return Image{};
+		}
+
+		Image image(filePath);
+		if (image.width() > kMaxJacketImageSize || image.height() > kMaxJacketImageSize)
+		{
+			const double scale = Min(static_cast<double>(kMaxJacketImageSize) / image.width(), static_cast<double>(kMaxJacketImageSize) / image.height());
+			image = image.scaled(scale);
+		}
+		return image;
+	}
+}
+
+void SelectJacketCache::threadMain(std::stop_token stopToken)
+{
+	while (true)
+	{
+		FilePath filePath;
+		{
+			std::unique_lock lock(m_mutex);
+			if (!m_condition.wait(lock, stopToken, [this] { return !m_requestedFilePaths.empty(); }))
+			{
+				// 停止が要求された
+				return;
+			}
+
+			// 最後に要求されたもの(カーソルに最も近いもの)からデコードする
+			filePath = std::move(m_requestedFilePaths.back());
+			m_requestedFilePaths.pop_back();
+		}
+
+		Image image = LoadJacketImage(filePath);
+
+		const std::lock_guard lock(m_mutex);
+		m_decodedImages.emplace_back(std::move(filePath), std::move(image));
+	}
+}
+
+void SelectJacketCache::request(const FilePath& filePath) const
+{
+	if (m_pendingFilePaths.contains(filePath))
+	{
+		return;
+	}
+	m_pendingFilePaths.insert(filePath);
+
+	{
+		const std::lock_guard lock(m_mutex);
+		m_requestedFilePaths.push_back(filePath);
+		if (m_requestedFilePaths.size() > kMaxNumRequests)
+		{
+			m_pendingFilePaths.erase(m_requestedFilePaths.front());
+			m_requestedFilePaths.erase(m_requestedFilePaths.begin());
+		}
+	}
+	m_condition.notify_one();
+}
+
+void SelectJacketCache::touch(CacheEntry& entry) const
+{
+	m_lruFilePaths.splice(m_lruFilePaths.begin(), m_lruFilePaths, entry.lruItr);
+}
+
+void SelectJacketCache::evict()
+{
+	while (!m_lruFilePaths.empty() && (m_entries.size() > kMaxNumTextures || m_totalBytes > kMaxTotalBytes))
+	{
+		const auto itr = m_entries.find(m_lruFilePaths.back());
+		if (itr != m_entries.end())
+		{
+			m_totalBytes -= itr->second.numBytes;
+			m_entries.erase(itr);
+		}
+		m_lruFilePaths.pop_back();
+	}
+}
+
+SelectJacketCache::SelectJacketCache()
+	: m_thread([this](std::stop_token stopToken) { threadMain(stopToken); })
+{
+}
+
+Optional<Texture> SelectJacketCache::get(FilePathView filePath) const
+{
+	const FilePath filePathKey{ filePath };
+	if (const auto itr = m_entries.find(filePathKey); itr != m_entries.end())
+	{
+		touch(itr->second);
+		return itr->second.texture;
+	}
+
+	request(filePathKey);
+	return none;
+}
+
+void SelectJacketCache::prefetch(FilePathView filePath) const
+{
+	const FilePath filePathKey{ filePath };
+	if (m_entries.contains(filePathKey))
+	{
+		return;
+	}
+
+	request(filePathKey);
+}
+
+bool SelectJacketCache::update()
+{
+	Array<std::pair<FilePath, Image>> decodedImages;
+	{
+		const std::lock_guard lock(m_mutex);
+		decodedImages = std::exchange(m_decodedImages, {});
+	}
+	if (decodedImages.empty())
+	{
+		return false;
+	}
+
+	// テクスチャの作成はメインスレッドで行う必要がある
+	for (auto& [filePath, image] : decodedImages)
+	{
+		m_pendingFilePaths.erase(filePath);
+		if (m_entries.contains(filePath))
+		{
+			continue;
+		}
+
+		m_lruFilePaths.push_front(filePath);
+		const std::size_t numBytes = image.size_bytes();
+		m_entries.emplace(filePath, CacheEntry{
+			.texture = image.isEmpty() ? Texture{} : Texture{ image },
+			.numBytes = numBytes,
+			.lruItr = m_lruFilePaths.begin(),
+		});
+		m_totalBytes += numBytes;
+	}
+	evict();
+
+	return true;
+}
@@ -0,0 +1,74 @@
+﻿#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <list>
+
+/// @brief 選曲画面のジャケット画像のキャッシュ
+/// @note 画像のデコードは専用スレッドで行い、テクスチャの作成はメインスレッドのupdate()で行う。
+///       テクスチャは枚数と合計バイト数の上限を超えた場合に最後に参照されてから最も時間が経ったものから破棄する
+class SelectJacketCache
+{
+private:
+	struct CacheEntry
+	{
+		Texture texture;
+
+		std::size_t numBytes = 0U;
+
+		std::list<FilePath>::iterator lruItr;
+	};
+
+	// 参照された順のファイルパス(先頭が最新)
+	mutable std::list<FilePath> m_lruFilePaths;
+
+	mutable HashTable<FilePath, CacheEntry> m_entries;
+
+	mutable std::size_t m_totalBytes = 0U;
+
+	// デコードを要求済みでテクスチャ未作成のファイルパス(メインスレッドのみで使用)
+	mutable HashSet<FilePath> m_pendingFilePaths;
+
+	mutable std::mutex m_mutex;
+
+	mutable std::condition_variable_any m_condition;
+
+	// デコード待ちのファイルパス(末尾から順にデコードする。m_mutexで保護)
+	mutable Array<FilePath> m_requestedFilePaths;
+
+	// デコード済みの画像(m_mutexで保護)
+	Array<std::pair<FilePath, Image>> m_decodedImages;
+
+	// Note: デストラクタで最初に停止・joinされるよう、メンバ変数の最後に置く必要がある
+	std::jthread m_thread;
+
+	void threadMain(std::stop_token stopToken);
+
+	void request(const FilePath& filePath) const;
+
+	void touch(CacheEntry& entry) const;
+
+	void evict();
+
+public:
+	SelectJacketCache();
+
+	SelectJacketCache(const SelectJacketCache&) = delete;
+
+	SelectJacketCache& operator=(const SelectJacketCache&) = delete;
+
+	/// @brief ジャケット画像のテクスチャを取得する
+	/// @param filePath ジャケット画像のファイルパス
+	/// @return テクスチャ(デコード中の場合はnone。画像が存在しない場合は空のテクスチャ)
+	/// @note キャッシュにない場合はデコードを要求する
+	Optional<Texture> get(FilePathView filePath) const;
+
+	/// @brief ジャケット画像を事前にデコードしておく
+	/// @param filePath ジャケット画像のファイルパス
+	void prefetch(FilePathView filePath) const;
+
+	/// @brief デコード済みの画像からテクスチャを作成する
+	/// @return 新たにテクスチャを作成した場合はtrue
+	/// @note 毎フレーム呼ぶ
+	bool update();
+};
@@ -0,0 +1,172 @@
+﻿#include "select_library.hpp"
+#include "menu_item/select_menu_song_item.hpp"
+
+namespace
+{
+	static_assert(SelectLibraryIndex::kNumDifficulties == kNumDifficulties);
+
+	/// @brief 曲のディレクトリのパスとの前方一致の判定に使用するフォルダのパスを返す
+	/// @param folderPath フォルダのパス
+	/// @return フォルダのフルパス(末尾はスラッシュ)
+	FilePath FolderPathPrefix(FilePathView folderPath)
+	{
+		FilePath prefix = FileSystem::FullPath(folderPath);
+		if (!prefix.ends_with(U'/'))
+		{
+			prefix.push_back(U'/');
+		}
+		return prefix;
+	}
+}
+
+void SelectLibrary::removeSongByIdx(uint32 songIdx)
+{
+	m_index.removeSong(songIdx);
+	m_songIdxs.erase(m_songDirectoryPaths[songIdx]);
+	m_songDirectoryPaths[songIdx].clear();
+	m_isIndexFinalized = false;
+}
+
+uint64 SelectLibrary::beginScan()
+{
+	const std::lock_guard lock(m_mutex);
+	return ++m_scanId;
+}
+
+void SelectLibrary::updateSong(const SelectMenuSongItem& songItem, uint64 scanId)
+{
+	const SelectChartInfo* pFirstChartInfo = nullptr;
+	for (int32 difficultyIdx = 0; difficultyIdx < kNumDifficulties && pFirstChartInfo == nullptr; ++difficultyIdx)
+	{
+		pFirstChartInfo = songItem.chartInfoPtr(difficultyIdx);
+	}
+	if (pFirstChartInfo == nullptr)
+	{
+		return;
+	}
+	const std::u32string title = pFirstChartInfo->title().toUTF32();
+	const std::u32string artist = pFirstChartInfo->artist().toUTF32();
+
+	const std::lock_guard lock(m_mutex);
+
+	FilePath songDirectoryPath{ songItem.fullPath() };
+	uint32 songIdx;
+	if (const auto itr = m_songIdxs.find(songDirectoryPath); itr != m_songIdxs.end())
+	{
+		songIdx = itr->second;
+		m_index.replaceSong(songIdx, title, artist);
+		m_songScanIds[songIdx] = scanId;
+	}
+	else
+	{
+		songIdx = m_index.addSong(title, artist);
+		m_songDirectoryPaths.push_back(songDirectoryPath);
+		m_songScanIds.push_back(scanId);
+		m_songIdxs.emplace(std::move(songDirectoryPath), songIdx);
+	}
+
+	for (int32 difficultyIdx = 0; difficultyIdx < kNumDifficulties; ++difficultyIdx)
+	{
+		const SelectChartInfo* pChartInfo = songItem.chartInfoPtr(difficultyIdx);
+		if (pChartInfo == nullptr)
+		{
+			continue;
+		}
+
+		const GaugeType gaugeType = GaugeType::kNormalGauge; // TODO: 現在選択中のゲージタイプを反映
+		const HighScoreInfo& highScoreInfo = pChartInfo->highScoreInfo();
+		const Optional<double> maxBPM = pChartInfo->maxBPM();
+		m_index.addChart(songIdx, difficultyIdx, pChartInfo->level(), maxBPM ? static_cast<float>(*maxBPM) : SelectLibraryIndex::kUnknownBPM, highScoreInfo.score(gaugeType), static_cast<int32>(highScoreInfo.medal()));
+	}
+	m_isIndexFinalized = false;
+}
+
+void SelectLibrary::removeSong(FilePathView songDirectoryPath)
+{
+	const std::lock_guard lock(m_mutex);
+	if (const auto itr = m_songIdxs.find(FilePath{ songDirectoryPath }); itr != m_songIdxs.end())
+	{
+		removeSongByIdx(itr->second);
+	}
+}
+
+void SelectLibrary::finishFolderScan(FilePathView folderPath, uint64 scanId)
+{
+	FilePath folderPathPrefix = FolderPathPrefix(folderPath);
+
+	const std::lock_guard lock(m_mutex);
+	for (uint32 songIdx = 0U; songIdx < m_songDirectoryPaths.size(); ++songIdx)
+	{
+		const FilePath& songDirectoryPath = m_songDirectoryPaths[songIdx];
+		if (!songDirectoryPath.empty() && m_songScanIds[songIdx] < scanId && songDirectoryPath.starts_with(folderPathPrefix))
+		{
+			removeSongByIdx(songIdx);
+		}
+	}
+	m_scannedFolderPaths.insert(std::move(folderPathPrefix));
+}
+
+void SelectLibrary::retainFolders(const Array<FilePath>& folderPaths)
+{
+	const Array<FilePath> folderPathPrefixes = folderPaths.map(FolderPathPrefix);
+
+	const std::lock_guard lock(m_mutex);
+	for (uint32 songIdx = 0U; songIdx < m_songDirectoryPaths.size(); ++songIdx)
+	{
+		const FilePath& songDirectoryPath = m_songDirectoryPaths[songIdx];
+		if (!songDirectoryPath.empty() && !folderPathPrefixes.any([&songDirectoryPath](const FilePath& prefix) { return songDirectoryPath.starts_with(prefix); }))
+		{
+			removeSongByIdx(songIdx);
+		}
+	}
+	for (auto itr = m_scannedFolderPaths.begin(); itr != m_scannedFolderPaths.end();)
+	{
+		if (folderPathPrefixes.contains(*itr))
+		{
+			++itr;
+		}
+		else
+		{
+			m_scannedFolderPaths.erase(itr++);
+		}
+	}
+}
+
+bool SelectLibrary::isFolderScanned(FilePathView folderPath) const
+{
+	const FilePath folderPathPrefix = FolderPathPrefix(folderPath);
+
+	const std::lock_guard lock(m_mutex);
+	return m_scannedFolderPaths.contains(folderPathPrefix);
+}
+
+bool SelectLibrary::isComplete(const Array<FilePath>& folderPaths) const
+{
+	return folderPaths.all([this](const FilePath& folderPath) { return isFolderScanned(folderPath); });
+}
+
+Array<FilePath> SelectLibrary::query(const SelectLibraryQuery& query)
+{
+	const std::lock_guard lock(m_mutex);
+
+	// 前回から曲が更新されていれば並べ替え用の順位を計算し直す
+	if (!m_isIndexFinalized)
+	{
+		m_index.finalize();
+		m_isIndexFinalized = true;
+	}
+
+	Array<FilePath> songDirectoryPaths;
+	for (const uint32 songIdx : m_index.query(query))
+	{
+		songDirectoryPaths.push_back(m_songDirectoryPaths[songIdx]);
+	}
+	return songDirectoryPaths;
+}
+
+Array<int32> SelectLibrary::levels() const
+{
+	const std::lock_guard lock(m_mutex);
+	const std::vector<std::int32_t> levels = m_index.levels();
+	return Array<int32>(levels.begin(), levels.end());
+}
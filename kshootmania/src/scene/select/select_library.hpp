@@ -0,0 +1,85 @@
+﻿#pragma once
+#include <mutex>
+#include "select_library_index.hpp"
+
+class SelectMenuSongItem;
+
+/// @brief 選曲画面の全フォルダの曲のライブラリ
+/// @note SelectLibraryIndexの曲に曲のディレクトリのパスを対応付けて保持する。
+///       曲の走査スレッドが走査した曲ごとに更新し、Allフォルダ・レベルフォルダを開く際にはこれを絞り込み・並べ替えて項目を作成する。
+///       一度走査したフォルダは、そのフォルダを開いて走査し直すまで再走査しない
+/// @note スレッドセーフ
+class SelectLibrary
+{
+private:
+	mutable std::mutex m_mutex;
+
+	SelectLibraryIndex m_index;
+
+	bool m_isIndexFinalized = false;
+
+	// 曲のインデックスごとの曲のディレクトリのパス(取り除いた曲は空文字列)
+	Array<FilePath> m_songDirectoryPaths;
+
+	// 曲のインデックスごとの、最後に更新された走査の番号
+	Array<uint64> m_songScanIds;
+
+	HashTable<FilePath, uint32> m_songIdxs;
+
+	// 走査済みのフォルダのパス
+	HashSet<FilePath> m_scannedFolderPaths;
+
+	uint64 m_scanId = 0;
+
+	void removeSongByIdx(uint32 songIdx);
+
+public:
+	SelectLibrary() = default;
+
+	SelectLibrary(const SelectLibrary&) = delete;
+
+	SelectLibrary& operator=(const SelectLibrary&) = delete;
+
+	/// @brief 曲の走査の開始を通知する
+	/// @return 走査の番号(updateSong・finishFolderScanに渡す)
+	uint64 beginScan();
+
+	/// @brief 走査した曲を追加する(既に存在する場合は置き換える)
+	/// @param songItem 曲の項目
+	/// @param scanId beginScanが返した走査の番号
+	void updateSong(const SelectMenuSongItem& songItem, uint64 scanId);
+
+	/// @brief 曲を取り除く
+	/// @param songDirectoryPath 曲のディレクトリのパス
+	void removeSong(FilePathView songDirectoryPath);
+
+	/// @brief フォルダの走査の完了を通知する
+	/// @param folderPath フォルダのパス
+	/// @param scanId beginScanが返した走査の番号
+	/// @note フォルダ内の曲のうち、この走査で更新されなかった(削除された)曲を取り除き、フォルダを走査済みにする
+	void finishFolderScan(FilePathView folderPath, uint64 scanId);
+
+	/// @brief 指定したフォルダ以外の曲を取り除く
+	/// @param folderPaths フォルダのパスの配列
+	/// @note 選曲画面のルートから削除されたフォルダの曲を取り除くために使用する
+	void retainFolders(const Array<FilePath>& folderPaths);
+
+	/// @brief フォルダが走査済みかどうか
+	/// @param folderPath フォルダのパス
+	/// @return 走査済みの場合はtrue
+	bool isFolderScanned(FilePathView folderPath) const;
+
+	/// @brief 全てのフォルダが走査済みかどうか
+	/// @param folderPaths フォルダのパスの配列
+	/// @return 全て走査済みの場合はtrue
+	bool isComplete(const Array<FilePath>& folderPaths) const;
+
+	/// @brief 条件に合う曲を並べ替えて返す
+	/// @param query 絞り込み・並べ替えの条件
+	/// @return 曲のディレクトリのパスの配列(並べ替え済み)
+	Array<FilePath> query(const SelectLibraryQuery& query);
+
+	/// @brief 譜面が存在するレベルを返す
+	/// @return レベルの配列(昇順、重複なし)
+	Array<int32> levels() const;
+};
@@ -0,0 +1,294 @@
+﻿#include "select_library_index.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+	// BPMの並べ替えに使用する精度(この値で割った単位で比較する)
+	constexpr float kBPMSortResolution = 0.001f;
+
+	char32_t NormalizeSearchChar(char32_t c)
+	{
+		if (U'A' <= c && c <= U'Z')
+		{
+			return c - U'A' + U'a';
+		}
+		if (U'Ａ' <= c && c <= U'Ｚ')
+		{
+			return c - U'Ａ' + U'a';
+		}
+		if (U'ａ' <= c && c <= U'ｚ')
+		{
+			return c - U'ａ' + U'a';
+		}
+		if (c == U'　')
+		{
+			return U' ';
+		}
+		return c;
+	}
+
+	/// @brief 文字列の昇順での順位を計算する
+	/// @param keys 文字列の配列
+	/// @return 各要素の順位(同じ文字列の場合は要素の順番)
+	std::vector<std::uint32_t> MakeRanks(const std::vector<std::u32string>& keys)
+	{
+		std::vector<std::uint32_t> order(keys.size());
+		std::iota(order.begin(), order.end(), 0U);
+		std::stable_sort(order.begin(), order.end(), [&keys](std::uint32_t a, std::uint32_t b) { return keys[a] < keys[b]; });
+
+		std::vector<std::uint32_t> ranks(keys.size());
+		for (std::uint32_t rank = 0U; rank < order.size(); ++rank)
+		{
+			ranks[order[rank]] = rank;
+		}
+		return ranks;
+	}
+}
+
+std::int32_t SelectLibraryIndex::keyChartIdx(std::uint32_t songIdx, const SelectLibraryQuery& query) const
+{
+	// 選曲画面のカーソルと同様に、指定の難易度、それより下の難易度、それより上の難易度の順に探す
+	const std::int32_t difficultyIdx = std::clamp(query.difficultyIdx, 0, kNumDifficulties - 1);
+	const auto matches = [this, songIdx, &query](std::int32_t idx)
+		{
+			const std::int32_t chartIdx = m_songChartIdxs[idx][songIdx];
+			return chartIdx != kNoChart && (!query.level.has_value() || m_chartLevels[chartIdx] == query.level.value());
+		};
+
+	if (matches(difficultyIdx))
+	{
+		return m_songChartIdxs[difficultyIdx][songIdx];
+	}
+	for (std::int32_t idx = difficultyIdx - 1; idx >= 0; --idx)
+	{
+		if (matches(idx))
+		{
+			return m_songChartIdxs[idx][songIdx];
+		}
+	}
+	for (std::int32_t idx = difficultyIdx + 1; idx < kNumDifficulties; ++idx)
+	{
+		if (matches(idx))
+		{
+			return m_songChartIdxs[idx][songIdx];
+		}
+	}
+	return kNoChart;
+}
+
+std::uint32_t SelectLibraryIndex::sortValue(std::int32_t chartIdx, std::uint32_t songIdx, SelectLibrarySortType sortType) const
+{
+	switch (sortType)
+	{
+	case SelectLibrarySortType::kArtist:
+		return m_songArtistRanks[songIdx];
+
+	case SelectLibrarySortType::kLevel:
+		return static_cast<std::uint32_t>(m_chartLevels[chartIdx]);
+
+	case SelectLibrarySortType::kBPM:
+		if (m_chartMaxBPMs[chartIdx] < 0.0f)
+		{
+			// 最大BPMが不明な譜面は末尾に並べる
+			return std::numeric_limits<std::uint32_t>::max();
+		}
+		return static_cast<std::uint32_t>(std::lround(m_chartMaxBPMs[chartIdx] / kBPMSortResolution));
+
+	case SelectLibrarySortType::kScore:
+		return static_cast<std::uint32_t>(std::max(m_chartScores[chartIdx], 0));
+
+	case SelectLibrarySortType::kMedal:
+		return static_cast<std::uint32_t>(std::max(m_chartMedals[chartIdx], std::int8_t{ 0 }));
+
+	default:
+		// 曲名順は同じ値の場合の比較に使用する曲名順の順位のみで並べる
+		return 0U;
+	}
+}
+
+std::u32string SelectLibraryIndex::NormalizeSearchText(std::u32string_view text)
+{
+	std::u32string normalized(text.size(), U'\0');
+	std::transform(text.begin(), text.end(), normalized.begin(), NormalizeSearchChar);
+	return normalized;
+}
+
+std::uint32_t SelectLibraryIndex::addSong(std::u32string_view title, std::u32string_view artist)
+{
+	const auto songIdx = static_cast<std::uint32_t>(m_songSearchKeys.size());
+
+	std::u32string titleKey = NormalizeSearchText(title);
+	std::u32string artistKey = NormalizeSearchText(artist);
+	m_songSearchKeys.push_back(titleKey + U'\n' + artistKey);
+	m_songTitleKeys.push_back(std::move(titleKey));
+	m_songArtistKeys.push_back(std::move(artistKey));
+	for (auto& chartIdxs : m_songChartIdxs)
+	{
+		chartIdxs.push_back(kNoChart);
+	}
+
+	m_isFinalized = false;
+	return songIdx;
+}
+
+bool SelectLibraryIndex::replaceSong(std::uint32_t songIdx, std::u32string_view title, std::u32string_view artist)
+{
+	if (songIdx >= m_songSearchKeys.size())
+	{
+		return false;
+	}
+
+	std::u32string titleKey = NormalizeSearchText(title);
+	std::u32string artistKey = NormalizeSearchText(artist);
+	m_songSearchKeys[songIdx] = titleKey + U'\n' + artistKey;
+	m_songTitleKeys[songIdx] = std::move(titleKey);
+	m_songArtistKeys[songIdx] = std::move(artistKey);
+	for (auto& chartIdxs : m_songChartIdxs)
+	{
+		chartIdxs[songIdx] = kNoChart;
+	}
+
+	m_isFinalized = false;
+	return true;
+}
+
+bool SelectLibraryIndex::removeSong(std::uint32_t songIdx)
+{
+	if (songIdx >= m_songSearchKeys.size())
+	{
+		return false;
+	}
+
+	for (auto& chartIdxs : m_songChartIdxs)
+	{
+		chartIdxs[songIdx] = kNoChart;
+	}
+	return true;
+}
+
+bool SelectLibraryIndex::addChart(std::uint32_t songIdx, std::int32_t difficultyIdx, std::int32_t level, float maxBPM, std::int32_t score, std::int32_t medal)
+{
+	if (songIdx >= m_songSearchKeys.size() || difficultyIdx < 0 || kNumDifficulties <= difficultyIdx)
+	{
+		return false;
+	}
+
+	m_songChartIdxs[difficultyIdx][songIdx] = static_cast<std::int32_t>(m_chartLevels.size());
+	m_chartLevels.push_back(static_cast<std::int8_t>(level));
+	m_chartMaxBPMs.push_back(maxBPM);
+	m_chartScores.push_back(score);
+	m_chartMedals.push_back(static_cast<std::int8_t>(medal));
+	return true;
+}
+
+void SelectLibraryIndex::finalize()
+{
+	m_songTitleRanks = MakeRanks(m_songTitleKeys);
+	m_songArtistRanks = MakeRanks(m_songArtistKeys);
+
+	m_songIdxsByTitleRank.resize(m_songTitleRanks.size());
+	for (std::uint32_t songIdx = 0U; songIdx < m_songTitleRanks.size(); ++songIdx)
+	{
+		m_songIdxsByTitleRank[m_songTitleRanks[songIdx]] = songIdx;
+	}
+
+	m_isFinalized = true;
+}
+
+std::vector<std::uint32_t> SelectLibraryIndex::query(const SelectLibraryQuery& query) const
+{
+	assert(m_isFinalized && "SelectLibraryIndex::finalize() must be called before query()");
+	if (!m_isFinalized)
+	{
+		return {};
+	}
+
+	const std::u32string searchKey = NormalizeSearchText(query.searchText);
+
+	// 上位32bitに並べ替えの値、下位32bitに曲名順の順位を入れた値で並べ替える
+	// (曲名順の順位は曲ごとに異なるので、比較が整数1回で済み、並べ替え後に曲のインデックスへ戻せる)
+	std::vector<std::uint64_t> sortKeys;
+	sortKeys.reserve(m_songSearchKeys.size());
+	for (std::uint32_t songIdx = 0U; songIdx < m_songSearchKeys.size(); ++songIdx)
+	{
+		const std::int32_t chartIdx = keyChartIdx(songIdx, query);
+		if (chartIdx == kNoChart)
+		{
+			continue;
+		}
+		if (!searchKey.empty() && m_songSearchKeys[songIdx].find(searchKey) == std::u32string::npos)
+		{
+			continue;
+		}
+		sortKeys.push_back((static_cast<std::uint64_t>(sortValue(chartIdx, songIdx, query.sortType)) << 32) | m_songTitleRanks[songIdx]);
+	}
+	std::sort(sortKeys.begin(), sortKeys.end());
+
+	std::vector<std::uint32_t> songIdxs(sortKeys.size());
+	std::transform(sortKeys.begin(), sortKeys.end(), songIdxs.begin(),
+		[this](std::uint64_t sortKey)
+		{
+			return m_songIdxsByTitleRank[static_cast<std::uint32_t>(sortKey & 0xFFFFFFFFU)];
+		});
+	return songIdxs;
+}
+
+std::vector<std::uint32_t> SelectLibraryIndex::search(std::u32string_view searchText, std::span<const std::uint32_t> songIdxs) const
+{
+	const std::u32string searchKey = NormalizeSearchText(searchText);
+	if (searchKey.empty())
+	{
+		return std::vector<std::uint32_t>(songIdxs.begin(), songIdxs.end());
+	}
+
+	std::vector<std::uint32_t> result;
+	for (const std::uint32_t songIdx : songIdxs)
+	{
+		if (songIdx < m_songSearchKeys.size() && m_songSearchKeys[songIdx].find(searchKey) != std::u32string::npos)
+		{
+			result.push_back(songIdx);
+		}
+	}
+	return result;
+}
+
+std::vector<std::int32_t> SelectLibraryIndex::levels() const
+{
+	// 取り除いた譜面の列は含めないよう、曲から参照されている譜面のみを対象にする
+	// (レベルはint8で保持しているので、値ごとの有無を配列で数える)
+	std::array<bool, 256U> exists{};
+	for (const auto& chartIdxs : m_songChartIdxs)
+	{
+		for (const std::int32_t chartIdx : chartIdxs)
+		{
+			if (chartIdx != kNoChart)
+			{
+				exists[static_cast<std::uint8_t>(m_chartLevels[chartIdx])] = true;
+			}
+		}
+	}
+
+	std::vector<std::int32_t> levels;
+	for (std::int32_t level = -128; level < 128; ++level)
+	{
+		if (exists[static_cast<std::uint8_t>(level)])
+		{
+			levels.push_back(level);
+		}
+	}
+	return levels;
+}
+
+std::size_t SelectLibraryIndex::numSongs() const
+{
+	return m_songSearchKeys.size();
+}
+
+std::size_t SelectLibraryIndex::numCharts() const
+{
+	return m_chartLevels.size();
+}
@@ -0,0 +1,161 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief 全曲を対象とした並べ替えの種類
+/// @note ConfigIniに値を保存するため、値の順番は変更しないこと
+enum class SelectLibrarySortType : std::int32_t
+{
+	kTitle = 0,
+	kArtist,
+	kLevel,
+	kBPM,
+	kScore,
+	kMedal,
+
+	kNumSortTypes,
+};
+
+/// @brief 全曲を対象とした絞り込み・並べ替えの条件
+struct SelectLibraryQuery
+{
+	/// @brief 並べ替えの種類(いずれも昇順で、同じ値の曲は曲名順)
+	SelectLibrarySortType sortType = SelectLibrarySortType::kTitle;
+
+	/// @brief 並べ替えに使用する譜面の難易度
+	/// @note 曲にこの難易度の譜面が存在しない場合は、選曲画面のカーソルと同様に近い難易度の譜面を使用する
+	std::int32_t difficultyIdx = 0;
+
+	/// @brief 指定したレベルの譜面を含む曲のみに絞り込む(std::nulloptの場合は絞り込まない)
+	std::optional<std::int32_t> level = std::nullopt;
+
+	/// @brief 曲名・アーティスト名の部分一致で絞り込む(空の場合は絞り込まない。英字の大文字小文字は区別しない)
+	std::u32string searchText;
+};
+
+/// @brief 選曲画面の全曲・全譜面のインデックス
+/// @note 曲と譜面の属性を列ごとの配列で保持し、ライブラリ全体の絞り込み・並べ替え・インクリメンタルサーチを1フレームより十分短い時間で行う。
+///       Siv3Dに依存しないので、合成したインデックスに対してベンチマークを計測できる
+class SelectLibraryIndex
+{
+public:
+	/// @brief 1曲あたりの譜面の難易度の数
+	static constexpr std::int32_t kNumDifficulties = 4;
+
+	/// @brief 譜面が存在しないことを表す譜面のインデックス
+	static constexpr std::int32_t kNoChart = -1;
+
+	/// @brief 最大BPMが不明(表示用のBPMに数値が含まれない)ことを表す値
+	/// @note BPM順ではBPMが分かっている譜面の後に並べる
+	static constexpr float kUnknownBPM = -1.0f;
+
+private:
+	// 曲の列: 曲名・アーティスト名を正規化して改行で連結した検索用の文字列
+	std::vector<std::u32string> m_songSearchKeys;
+
+	// 曲の列: 正規化した曲名(曲名順の順位の計算用)
+	std::vector<std::u32string> m_songTitleKeys;
+
+	// 曲の列: 正規化したアーティスト名(アーティスト名順の順位の計算用)
+	std::vector<std::u32string> m_songArtistKeys;
+
+	// 曲の列: 曲名順の順位(同じ曲名の場合は追加順。finalize()で計算)
+	std::vector<std::uint32_t> m_songTitleRanks;
+
+	// 曲の列: アーティスト名順の順位(finalize()で計算)
+	std::vector<std::uint32_t> m_songArtistRanks;
+
+	// 曲の列: 難易度ごとの譜面のインデックス(存在しない場合はkNoChart)
+	std::array<std::vector<std::int32_t>, kNumDifficulties> m_songChartIdxs;
+
+	// 曲名順の順位から曲のインデックスへの変換表(finalize()で計算)
+	std::vector<std::uint32_t> m_songIdxsByTitleRank;
+
+	// 譜面の列: レベル
+	std::vector<std::int8_t> m_chartLevels;
+
+	// 譜面の列: 最大BPM
+	std::vector<float> m_chartMaxBPMs;
+
+	// 譜面の列: ハイスコア
+	std::vector<std::int32_t> m_chartScores;
+
+	// 譜面の列: クリアメダル
+	std::vector<std::int8_t> m_chartMedals;
+
+	bool m_isFinalized = false;
+
+	std::int32_t keyChartIdx(std::uint32_t songIdx, const SelectLibraryQuery& query) const;
+
+	std::uint32_t sortValue(std::int32_t chartIdx, std::uint32_t songIdx, SelectLibrarySortType sortType) const;
+
+public:
+	SelectLibraryIndex() = default;
+
+	/// @brief 検索用に文字列を正規化する
+	/// @param text 文字列
+	/// @return 英字(全角を含む)を半角小文字にし、全角スペースを半角スペースにした文字列
+	static std::u32string NormalizeSearchText(std::u32string_view text);
+
+	/// @brief 曲を追加する
+	/// @param title 曲名
+	/// @param artist アーティスト名
+	/// @return 追加した曲のインデックス
+	std::uint32_t addSong(std::u32string_view title, std::u32string_view artist);
+
+	/// @brief 曲の曲名・アーティスト名を置き換え、曲の譜面を全て取り除く
+	/// @param songIdx 曲のインデックス
+	/// @param title 曲名
+	/// @param artist アーティスト名
+	/// @return 置き換えた場合はtrue
+	/// @note 譜面はaddChart()で追加し直す。取り除いた譜面の列は参照されなくなるだけで配列には残る
+	bool replaceSong(std::uint32_t songIdx, std::u32string_view title, std::u32string_view artist);
+
+	/// @brief 曲の譜面を全て取り除き、どの条件にも該当しないようにする
+	/// @param songIdx 曲のインデックス
+	/// @return 取り除いた場合はtrue
+	/// @note 曲のインデックスを変えないよう、曲の列は配列に残す
+	bool removeSong(std::uint32_t songIdx);
+
+	/// @brief 譜面を追加する
+	/// @param songIdx 譜面が属する曲のインデックス
+	/// @param difficultyIdx 難易度(範囲外の場合は追加しない)
+	/// @param level レベル
+	/// @param maxBPM 最大BPM(不明な場合はkUnknownBPM)
+	/// @param score ハイスコア
+	/// @param medal クリアメダル
+	/// @return 追加した場合はtrue
+	bool addChart(std::uint32_t songIdx, std::int32_t difficultyIdx, std::int32_t level, float maxBPM, std::int32_t score, std::int32_t medal);
+
+	/// @brief 並べ替え用の順位を計算する
+	/// @note 曲・譜面を全て追加した後、query()・search()より前に呼ぶ
+	void finalize();
+
+	/// @brief 条件に合う曲を並べ替えて返す
+	/// @param query 絞り込み・並べ替えの条件
+	/// @return 曲のインデックスの配列(並べ替え済み)
+	std::vector<std::uint32_t> query(const SelectLibraryQuery& query) const;
+
+	/// @brief 曲名・アーティスト名の部分一致で曲を絞り込む
+	/// @param searchText 検索文字列(正規化前のもの)
+	/// @param songIdxs 絞り込み対象の曲のインデックスの配列
+	/// @return 条件に合う曲のインデックスの配列(songIdxsの順番を保つ)
+	/// @note インクリメンタルサーチでは、検索文字列が前回の検索文字列を含む場合に前回の結果をsongIdxsに渡すことで対象を減らせる
+	std::vector<std::uint32_t> search(std::u32string_view searchText, std::span<const std::uint32_t> songIdxs) const;
+
+	/// @brief 譜面が存在するレベルを返す
+	/// @return レベルの配列(昇順、重複なし)
+	/// @note finalize()を呼ぶ前でも使用できる
+	std::vector<std::int32_t> levels() const;
+
+	/// @brief 曲の数
+	std::size_t numSongs() const;
+
+	/// @brief 譜面の数
+	std::size_t numCharts() const;
+};
@@ -4,7 +4,7 @@
 #include "menu_item/select_menu_song_item.hpp"
 #include "menu_item/select_menu_all_folder_item.hpp"
 #include "menu_item/select_menu_dir_folder_item.hpp"
-#include "menu_item/select_menu_sub_dir_section_item.hpp"
+#include "menu_item/select_menu_level_folder_item.hpp"
 
 namespace
 {
@@ -19,6 +19,73 @@ namespace
 					});
 	}
 
+	/// @brief 選曲画面のルートに表示するフォルダのパスを返す
+	/// @return フォルダのフルパスの配列
+	Array<FilePath> GetFolderDirectories()
+	{
+		const Array<FilePath> searchPaths = {
+			U"songs", // TODO: 設定可能にする
+		};
+
+		Array<FilePath> directories;
+		for (const auto& path : searchPaths)
+		{
+			directories.append(GetSubDirectories(path).map([](FilePathView p) { return FileSystem::FullPath(p); }));
+		}
+		return directories;
+	}
+
+	/// @brief Allフォルダ・レベルフォルダの並べ替えの種類を返す
+	SelectLibrarySortType AllFolderSortType()
+	{
+		const int32 sortType = ConfigIni::GetInt(ConfigIni::Key::kSelectAllFolderSortType, static_cast<int32>(SelectLibrarySortType::kTitle));
+		if (sortType < 0 || static_cast<int32>(SelectLibrarySortType::kNumSortTypes) <= sortType)
+		{
+			return SelectLibrarySortType::kTitle;
+		}
+		return static_cast<SelectLibrarySortType>(sortType);
+	}
+
+	using DisplayedItems = std::array<const ISelectMenuItem*, SelectMenuGraphics::kNumDisplayItems>;
+
+	/// @brief 表示中の項目を返す
+	/// @param menu メニュー
+	/// @return 表示中の項目へのポインタの配列(上から順)
+	DisplayedItems GetDisplayedItems(const ArrayWithLinearMenu<std::unique_ptr<ISelectMenuItem>>& menu)
+	{
+		DisplayedItems displayedItems{};
+		if (menu.empty())
+		{
+			return displayedItems;
+		}
+		for (int32 i = 0; i < SelectMenuGraphics::kNumDisplayItems; ++i)
+		{
+			displayedItems[i] = menu.atCyclic(menu.cursor() - SelectMenuGraphics::kNumUpperHalfItems + i).get();
+		}
+		return displayedItems;
+	}
+
+	// 楽曲プレビュー音声を事前にデコードしておくカーソル前後の項目数(上下それぞれ)
+	constexpr int32 kNumSongPreviewPrefetchItems = 2;
+
+	void PrefetchSongPreview(const ISelectMenuItem& item, int32 difficultyIdx, SelectSongPreview& songPreview)
+	{
+		if (!item.difficultyMenuExists())
+		{
+			return;
+		}
+
+		const int32 altDifficultyIdx = SelectDifficultyMenu::GetAlternativeCursor(difficultyIdx,
+			[&item](int32 idx)
+			{
+				return item.chartInfoPtr(idx) != nullptr;
+			});
+		if (const SelectChartInfo* pChartInfo = item.chartInfoPtr(altDifficultyIdx))
+		{
+			songPreview.prefetchSongPreview(pChartInfo->previewBGMFilePath(), pChartInfo->previewBGMOffset(), pChartInfo->previewBGMDuration());
+		}
+	}
+
 	Vec2 ShakeVec(SelectMenuShakeDirection direction, double timeSec)
 	{
 		constexpr double kShakeHeight = 2.0;
@@ -41,28 +108,39 @@ bool SelectMenu::openDirectory(FilePathView directoryPath, PlaySeYN playSe)
 		m_folderSelectSe.play();
 	}
 
-	// 曲の項目を挿入する関数
-	// (挿入されたかどうかを返す)
-	const auto fnInsertSongItem = [this](const String& songDirectory) -> bool
+	// 走査中の曲があれば中断
+	m_songScanner.reset();
+	m_pendingCursor = none;
+
+	const Optional<int32> levelFolderLevel = SelectMenuLevelFolderItem::LevelFromSpecialPath(directoryPath);
+	if (directoryPath == SelectMenuAllFolderItem::kAllFolderSpecialPath || levelFolderLevel.has_value())
 	{
-		if (!FileSystem::IsDirectory(songDirectory))
-		{
-			return false;
-		}
+		m_menu.clear();
 
-		std::unique_ptr<SelectMenuSongItem> item = std::make_unique<SelectMenuSongItem>(songDirectory);
-		if (item->chartExists())
+		// Allフォルダ・レベルフォルダの見出し項目を追加
+		if (levelFolderLevel.has_value())
 		{
-			m_menu.push_back(std::move(item));
-			return true;
+			m_menu.push_back(std::make_unique<SelectMenuLevelFolderItem>(IsCurrentFolderYN::Yes, levelFolderLevel.value()));
 		}
 		else
 		{
-			return false;
+			m_menu.push_back(std::make_unique<SelectMenuAllFolderItem>(IsCurrentFolderYN::Yes));
 		}
-	};
 
-	if (!directoryPath.empty())
+		// ライブラリで絞り込み・並べ替えた曲の項目を別スレッドで作成し、作成済みのものから順次追加
+		// (ライブラリ上で未走査のフォルダがあれば、先にそのフォルダを走査する)
+		m_scannedItemInsertIdx = m_menu.size();
+		m_songScanner = std::make_unique<SelectSongScanner>(m_library, GetFolderDirectories(), SelectLibraryQuery{
+			.sortType = AllFolderSortType(),
+			.difficultyIdx = m_difficultyMenu.rawCursor(),
+			.level = levelFolderLevel,
+			.searchText = U"",
+		});
+
+		m_folderState.folderType = levelFolderLevel.has_value() ? SelectFolderState::kLevel : SelectFolderState::kAll;
+		m_folderState.fullPath = directoryPath;
+	}
+	else if (!directoryPath.empty())
 	{
 		if (!FileSystem::IsDirectory(directoryPath))
 		{
@@ -77,46 +155,10 @@ bool SelectMenu::openDirectory(FilePathView directoryPath, PlaySeYN playSe)
 
 		// TODO: Insert course items
 
-		// 曲の項目を追加
-		Array<FilePath> subDirCandidates;
-		{
-			const Array<FilePath> songDirectories = GetSubDirectories(directoryPath);
-			for (const auto& songDirectory : songDirectories)
-			{
-				// 項目追加
-				const bool chartExists = fnInsertSongItem(songDirectory);
-
-				// フォルダ直下に譜面がなかった場合はサブディレクトリの候補に追加
-				if (!chartExists)
-				{
-					subDirCandidates.push_back(songDirectory);
-				}
-			}
-		}
-
-		// サブディレクトリ内の曲の項目を追加
-		for (const auto& subDirCandidate : subDirCandidates)
-		{
-			// サブディレクトリの見出し項目を追加
-			m_menu.push_back(std::make_unique<SelectMenuSubDirSectionItem>(FileSystem::FullPath(subDirCandidate))); // TODO: foldername.csvから読み込んだフォルダ名で置換
-
-			bool chartExists = false;
-			const Array<FilePath> songDirectories = GetSubDirectories(subDirCandidate);
-			for (const auto& songDirectory : songDirectories)
-			{
-				// 項目追加
-				if (fnInsertSongItem(songDirectory))
-				{
-					chartExists = true;
-				}
-			}
-
-			// サブディレクトリ内に譜面が存在しなかった場合は見出し項目を削除
-			if (!chartExists)
-			{
-				m_menu.pop_back();
-			}
-		}
+		// 曲の項目は別スレッドで走査し、走査済みのものから順次追加
+		// (フォルダ項目より手前に挿入していく)
+		m_scannedItemInsertIdx = m_menu.size();
+		m_songScanner = std::make_unique<SelectSongScanner>(m_library, directoryPath);
 
 		m_folderState.folderType = SelectFolderState::kDirectory;
 		m_folderState.fullPath = FileSystem::FullPath(directoryPath);
@@ -127,21 +169,24 @@ bool SelectMenu::openDirectory(FilePathView directoryPath, PlaySeYN playSe)
 
 		m_folderState.folderType = SelectFolderState::kNone;
 		m_folderState.fullPath = U"";
+
+		// レベルフォルダは譜面が存在するレベルのものだけを表示するため、ライブラリ上で未走査のフォルダがあれば別スレッドで走査しておく
+		// (走査完了後にルートの項目を作り直す)
+		if (!ConfigIni::GetBool(ConfigIni::Key::kHideAllFolder))
+		{
+			const Array<FilePath> folderPaths = GetFolderDirectories();
+			if (!m_library.isComplete(folderPaths))
+			{
+				m_songScanner = std::make_unique<SelectSongScanner>(m_library, folderPaths, none);
+			}
+		}
 	}
 
 	// フォルダ項目を追加
 	// (フォルダを開いていない場合、または現在開いていないフォルダを表示する設定の場合のみ)
 	if (directoryPath.empty() || ConfigIni::GetBool(ConfigIni::Key::kAlwaysShowOtherFolders))
 	{
-		const Array<FilePath> searchPaths = {
-			U"songs", // TODO: 設定可能にする
-		};
-
-		Array<FilePath> directories;
-		for (const auto& path : searchPaths)
-		{
-			directories.append(GetSubDirectories(path).map([](FilePathView p) { return FileSystem::FullPath(p); }));
-		}
+		const Array<FilePath> directories = GetFolderDirectories();
 
 		// フォルダを開いている場合は、そのフォルダが先頭になるような順番で項目を追加する必要があるので、現在開いているフォルダのインデックスを調べる
 		std::size_t currentDirectoryIdx = 0;
@@ -161,23 +206,27 @@ bool SelectMenu::openDirectory(FilePathView directoryPath, PlaySeYN playSe)
 		{
 			const std::size_t rotatedIdx = (i + currentDirectoryIdx) % directories.size();
 
-			if (found && i == 0)
+			// 現在開いているフォルダは項目タイプkCurrentFolderとして既に追加済みなのでスキップ
+			// (末尾のフォルダの場合も後続のAllフォルダ等の項目は追加する必要があるので、continueはしない)
+			if (!found || i != 0)
 			{
-				// 現在開いているフォルダは項目タイプkCurrentFolderとして既に追加済みなのでスキップ
-				continue;
+				const auto& directory = directories[rotatedIdx];
+				m_menu.push_back(std::make_unique<SelectMenuDirFolderItem>(IsCurrentFolderYN::No, FileSystem::FullPath(directory)));
 			}
 
-			const auto& directory = directories[rotatedIdx];
-			m_menu.push_back(std::make_unique<SelectMenuDirFolderItem>(IsCurrentFolderYN::No, FileSystem::FullPath(directory)));
-
 			if (rotatedIdx == directories.size() - 1)
 			{
-				// "All"フォルダの項目を追加
-				//m_menu.push_back(std::make_unique<SelectMenuAllFolderItem>(IsCurrentFolderYN::No));
+				// "All"フォルダ・レベルフォルダの項目を追加
+				pushVirtualFolderItems();
 
 				// TODO: "Courses"フォルダの項目を追加
 			}
 		}
+
+		if (directories.empty())
+		{
+			pushVirtualFolderItems();
+		}
 	}
 
 	ConfigIni::SetString(ConfigIni::Key::kSelectDirectory, directoryPath);
@@ -189,6 +238,94 @@ bool SelectMenu::openDirectory(FilePathView directoryPath, PlaySeYN playSe)
 	return true;
 }
 
+void SelectMenu::pushVirtualFolderItems()
+{
+	if (ConfigIni::GetBool(ConfigIni::Key::kHideAllFolder))
+	{
+		return;
+	}
+
+	// 現在開いているフォルダは見出し項目として既に追加済みなのでスキップ
+	if (m_folderState.fullPath != SelectMenuAllFolderItem::kAllFolderSpecialPath)
+	{
+		m_menu.push_back(std::make_unique<SelectMenuAllFolderItem>(IsCurrentFolderYN::No));
+	}
+
+	// レベルフォルダは譜面が存在するレベルのもののみ追加
+	// (ライブラリ上で未走査のフォルダがある間は、走査済みの曲に存在するレベルのもののみとなる)
+	for (const int32 level : m_library.levels())
+	{
+		if (level < kLevelMin || kLevelMax < level)
+		{
+			continue;
+		}
+
+		if (m_folderState.fullPath != SelectMenuLevelFolderItem::LevelFolderSpecialPath(level))
+		{
+			m_menu.push_back(std::make_unique<SelectMenuLevelFolderItem>(IsCurrentFolderYN::No, level));
+		}
+	}
+}
+
+void SelectMenu::updateSongScanner()
+{
+	if (m_songScanner == nullptr)
+	{
+		return;
+	}
+
+	// Note: 全ての項目を取り出すため、isFinished()はpopScannedItems()より先に呼ぶ必要がある
+	const bool isFinished = m_songScanner->isFinished();
+	Array<std::unique_ptr<ISelectMenuItem>> scannedItems = m_songScanner->popScannedItems();
+	if (!scannedItems.empty())
+	{
+		// 走査済みの項目を挿入
+		// (カーソル位置の項目は変わらないよう、カーソルより手前に挿入した場合はカーソルをずらす)
+		const DisplayedItems prevDisplayedItems = GetDisplayedItems(m_menu);
+		for (auto& item : scannedItems)
+		{
+			m_menu.insert(m_scannedItemInsertIdx, std::move(item));
+			++m_scannedItemInsertIdx;
+		}
+		if (!m_pendingCursor.has_value())
+		{
+			ConfigIni::SetInt(ConfigIni::Key::kSelectSongIndex, m_menu.cursor());
+		}
+
+		// 表示中の項目が変わった場合のみ再描画
+		if (GetDisplayedItems(m_menu) != prevDisplayedItems)
+		{
+			refreshGraphics(SelectMenuGraphics::kAll);
+		}
+	}
+
+	if (isFinished)
+	{
+		m_songScanner.reset();
+
+		// ルートでライブラリの作成が完了した場合は、レベルフォルダの項目に反映するためルートの項目を作り直す
+		if (m_folderState.folderType == SelectFolderState::kNone)
+		{
+			const Optional<int32> pendingCursor = m_pendingCursor;
+			const FilePath cursorFullPath{ (m_menu.empty() || m_menu.cursorValue() == nullptr) ? FilePathView{} : m_menu.cursorValue()->fullPath() };
+			openDirectory(U"", PlaySeYN::No);
+			m_pendingCursor = pendingCursor;
+			setCursorToItemByFullPath(cursorFullPath);
+			refreshGraphics(SelectMenuGraphics::kAll);
+			refreshSongPreview();
+		}
+
+		// 前回選択していた項目を復元
+		if (m_pendingCursor.has_value())
+		{
+			setCursorAndSave(m_pendingCursor.value());
+			m_pendingCursor = none;
+			refreshGraphics(SelectMenuGraphics::kAll);
+			refreshSongPreview();
+		}
+	}
+}
+
 void SelectMenu::setCursorAndSave(int32 cursor)
 {
 	m_menu.setCursor(cursor);
@@ -238,6 +375,14 @@ void SelectMenu::refreshSongPreview()
 		return;
 	}
 
+	// カーソル前後の項目のプレビュー音声のデコードを要求
+	// (デコードは後に要求したものから行われるため、カーソルから遠い項目から順に要求し、カーソル位置の項目は最後に要求する)
+	for (int32 i = kNumSongPreviewPrefetchItems; i >= 1; --i)
+	{
+		PrefetchSongPreview(*m_menu.atCyclic(m_menu.cursor() - i), m_difficultyMenu.rawCursor(), m_songPreview);
+		PrefetchSongPreview(*m_menu.atCyclic(m_menu.cursor() + i), m_difficultyMenu.rawCursor(), m_songPreview);
+	}
+
 	const auto pChartInfo = m_menu.cursorValue()->chartInfoPtr(m_difficultyMenu.cursor());
 	if (pChartInfo == nullptr)
 	{
@@ -277,7 +422,15 @@ SelectMenu::SelectMenu(std::function<void(FilePathView, MusicGame::IsAutoPlayYN)
 	if (openDirectory(ConfigIni::GetString(ConfigIni::Key::kSelectDirectory), PlaySeYN::No))
 	{
 		// 前回選択していたインデックスを復元
-		m_menu.setCursor(loadedCursor);
+		// (曲の項目の走査中は項目が揃っていないので、走査完了後に復元する)
+		if (m_songScanner != nullptr)
+		{
+			m_pendingCursor = loadedCursor;
+		}
+		else
+		{
+			m_menu.setCursor(loadedCursor);
+		}
 		ConfigIni::SetInt(ConfigIni::Key::kSelectSongIndex, loadedCursor);
 
 		// 前回選択していた難易度を復元
@@ -300,6 +453,9 @@ void SelectMenu::update()
 	m_menu.update();
 	if (const int32 deltaCursor = m_menu.deltaCursor(); deltaCursor != 0)
 	{
+		// 走査完了前にカーソルを動かした場合は前回選択していた項目の復元をしない
+		m_pendingCursor = none;
+
 		ConfigIni::SetInt(ConfigIni::Key::kSelectSongIndex, m_menu.cursor());
 		m_songSelectSe.play();
 		refreshGraphics(deltaCursor > 0 ? SelectMenuGraphics::kCursorDown : SelectMenuGraphics::kCursorUp);
@@ -315,6 +471,15 @@ void SelectMenu::update()
 		refreshSongPreview();
 	}
 
+	// 走査済みの曲の項目を追加
+	updateSongScanner();
+
+	// デコードが完了したジャケット画像を反映
+	if (m_graphics.updateJacketCache() && !m_menu.empty())
+	{
+		refreshGraphics(SelectMenuGraphics::kAll);
+	}
+
 	m_songPreview.update();
 }
 
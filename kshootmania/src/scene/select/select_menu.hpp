@@ -4,6 +4,8 @@
 #include "select_difficulty_menu.hpp"
 #include "select_menu_graphics.hpp"
 #include "select_song_preview.hpp"
+#include "select_library.hpp"
+#include "select_song_scanner.hpp"
 #include "ksmaudio/ksmaudio.hpp"
 
 using PlaySeYN = YesNo<struct PlaySeYN_tag>;
@@ -43,8 +45,26 @@ private:
 
 	const ksmaudio::Sample m_folderSelectSe{"se/sel_dir.wav"};
 
+	// 全フォルダの曲のライブラリ(Allフォルダ・レベルフォルダで使用)
+	// Note: 走査スレッドから参照されるため、m_songScannerより前に置く必要がある
+	SelectLibrary m_library;
+
+	// 開いているフォルダ内の曲の走査(走査中でなければnullptr)
+	std::unique_ptr<SelectSongScanner> m_songScanner;
+
+	// 走査済みの曲の項目を挿入する位置(フォルダ項目の手前)
+	std::size_t m_scannedItemInsertIdx = 0U;
+
+	// 走査完了後に設定するカーソル位置(前回選択していた項目の復元用)
+	Optional<int32> m_pendingCursor = none;
+
 	bool openDirectory(FilePathView directoryPath, PlaySeYN playSe);
 
+	/// @brief Allフォルダ・レベルフォルダの項目を追加する
+	void pushVirtualFolderItems();
+
+	void updateSongScanner();
+
 	void setCursorAndSave(int32 cursor);
 
 	void setCursorToItemByFullPath(FilePathView fullPath);
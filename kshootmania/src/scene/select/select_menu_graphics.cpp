@@ -12,6 +12,27 @@ namespace
 		BlendOp::Add,
 		Blend::One);
 
+	// ジャケット画像を事前にデコードしておく表示範囲外の項目数(上下それぞれ)
+	constexpr int32 kNumJacketPrefetchItems = 3;
+
+	void PrefetchJacketImage(const ISelectMenuItem& item, int32 difficultyIdx, const SelectJacketCache& jacketCache)
+	{
+		if (!item.difficultyMenuExists())
+		{
+			return;
+		}
+
+		const int32 altDifficultyIdx = SelectDifficultyMenu::GetAlternativeCursor(difficultyIdx,
+			[&item](int32 idx)
+			{
+				return item.chartInfoPtr(idx) != nullptr;
+			});
+		if (const SelectChartInfo* pChartInfo = item.chartInfoPtr(altDifficultyIdx))
+		{
+			jacketCache.prefetch(pChartInfo->jacketFilePath());
+		}
+	}
+
 	Array<RenderTexture> MakeRenderTextureArray(int32 arrayLength, const Size& textureSize)
 	{
 		Array<RenderTexture> array;
@@ -42,6 +63,14 @@ SelectMenuGraphics::SelectMenuGraphics()
 
 void SelectMenuGraphics::refresh(const ArrayWithLinearMenu<std::unique_ptr<ISelectMenuItem>>& menu, int32 difficultyIdx, RefreshType type)
 {
+	// 表示範囲外の前後の項目のジャケット画像のデコードを要求
+	// (デコードは後に要求したものから行われるため、表示中の項目の描画より先に要求しておく)
+	for (int32 i = 1; i <= kNumJacketPrefetchItems; ++i)
+	{
+		PrefetchJacketImage(*menu.atCyclic(menu.cursor() - kNumUpperHalfItems - i), difficultyIdx, m_menuItemGraphicAssets.jacketCache);
+		PrefetchJacketImage(*menu.atCyclic(menu.cursor() + kNumLowerHalfItems + i), difficultyIdx, m_menuItemGraphicAssets.jacketCache);
+	}
+
 	const ScopedRenderStates2D state(kBlendState);
 	const bool hasDifficultyChanged = m_prevDifficultyIdx != difficultyIdx; // 難易度に変更があった場合は使い回せないので全描画になる
 
@@ -100,6 +129,11 @@ void SelectMenuGraphics::refresh(const ArrayWithLinearMenu<std::unique_ptr<ISele
 	m_prevDifficultyIdx = difficultyIdx;
 }
 
+bool SelectMenuGraphics::updateJacketCache()
+{
+	return m_menuItemGraphicAssets.jacketCache.update();
+}
+
 void SelectMenuGraphics::draw(const Vec2& shakeVec) const
 {
 	// 上半分の項目を描画
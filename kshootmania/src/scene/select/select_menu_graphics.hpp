@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "select_assets.hpp"
 #include "graphics/number_texture_font.hpp"
+#include "select_jacket_cache.hpp"
 
 class ISelectMenuItem;
 
@@ -68,6 +69,8 @@ struct SelectMenuItemGraphicAssets
 			.sourceSize = { 64, 64 },
 		}
 	};
+
+	SelectJacketCache jacketCache;
 };
 
 enum class SelectMenuShakeDirection
@@ -80,11 +83,7 @@ enum class SelectMenuShakeDirection
 class SelectMenuGraphics
 {
 private:
-	const SelectMenuItemGraphicAssets m_menuItemGraphicAssets;
-
-	static constexpr int32 kNumDisplayItems = 8;
-	static constexpr int32 kNumUpperHalfItems = kNumDisplayItems / 2;
-	static constexpr int32 kNumLowerHalfItems = kNumDisplayItems - kNumUpperHalfItems - 1;
+	SelectMenuItemGraphicAssets m_menuItemGraphicAssets;
 
 	RenderTexture m_centerItem;
 	Array<RenderTexture> m_upperHalfItems;
@@ -97,6 +96,10 @@ private:
 	void refreshUpperLowerMenuItem(const RenderTexture& target, const ISelectMenuItem& item, int32 difficultyIdx, bool isUpper) const;
 
 public:
+	static constexpr int32 kNumDisplayItems = 8;
+	static constexpr int32 kNumUpperHalfItems = kNumDisplayItems / 2;
+	static constexpr int32 kNumLowerHalfItems = kNumDisplayItems - kNumUpperHalfItems - 1;
+
 	enum RefreshType
 	{
 		kAll,
@@ -108,5 +111,9 @@ public:
 
 	void refresh(const ArrayWithLinearMenu<std::unique_ptr<ISelectMenuItem>>& menu, int32 difficultyIdx, RefreshType type);
 
+	/// @brief デコード済みのジャケット画像を反映する
+	/// @return 新たに反映したジャケット画像がある場合はtrue(項目の再描画が必要)
+	bool updateJacketCache();
+
 	void draw(const Vec2& shakeVec) const;
 };
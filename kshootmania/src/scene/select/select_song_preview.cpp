@@ -19,12 +19,29 @@ SelectSongPreview::SelectSongPreview()
 
 void SelectSongPreview::update()
 {
+	m_cache.update();
+
 	if (!m_songPreviewFilename.empty() && (m_songPreviewStartTimer.reachedZero() || m_isFirst))
 	{
+		// デコード済みのプレビュー音声があればメモリ上から再生し、なければファイルから直接再生する
+		// (デコード済みのものはコンプレッサー適用済み)
+		const auto binary = m_cache.get(m_songPreviewFilename, m_songPreviewOffset, m_songPreviewDuration);
+		if (binary)
+		{
+			m_songPreviewStream = std::make_unique<ksmaudio::Stream>(binary, m_songPreviewVolume, false);
+			m_songPreviewStreamOffset = 0s;
+			m_songPreviewStreamDuration = Min(m_songPreviewDuration, m_songPreviewStream->duration());
+		}
+		else
+		{
+			m_songPreviewStream = std::make_unique<ksmaudio::Stream>(m_songPreviewFilename.narrow(), m_songPreviewVolume, true, false);
+			m_songPreviewStreamOffset = m_songPreviewOffset;
+			m_songPreviewStreamDuration = m_songPreviewDuration;
+		}
+
 		// フェードインして再生開始
-		m_songPreviewStream = std::make_unique<ksmaudio::Stream>(m_songPreviewFilename.narrow(), m_songPreviewVolume, true, false);
 		m_songPreviewStream->lockBegin();
-		m_songPreviewStream->seekPosSec(m_songPreviewOffset);
+		m_songPreviewStream->seekPosSec(m_songPreviewStreamOffset);
 		const Duration fadeInDuration = m_isFirst ? kFadeInDurationFirst : kFadeInDuration;
 		m_songPreviewStream->setFadeIn(fadeInDuration);
 		m_songPreviewStream->play();
@@ -41,14 +58,14 @@ void SelectSongPreview::update()
 	const bool isPlayingSongPreview = m_songPreviewStream != nullptr;
 	if (isPlayingSongPreview)
 	{
-		const SecondsF previewEndSec = m_songPreviewOffset + m_songPreviewDuration;
+		const SecondsF previewEndSec = m_songPreviewStreamOffset + m_songPreviewStreamDuration;
 		const SecondsF posSec = m_songPreviewStream->posSec();
 		if (previewEndSec <= posSec)
 		{
 			// フェードアウトが終了したら再び最初からフェードインして再生開始
 			// (途中の音が鳴らないようロックを挟んでいる)
 			m_songPreviewStream->lockBegin();
-			m_songPreviewStream->seekPosSec(m_songPreviewOffset);
+			m_songPreviewStream->seekPosSec(m_songPreviewStreamOffset);
 			m_songPreviewStream->setFadeIn(kFadeInDuration);
 			m_songPreviewStream->play();
 			m_songPreviewStream->lockEnd();
@@ -104,6 +121,14 @@ void SelectSongPreview::requestSongPreview(FilePathView filename, SecondsF offse
 	m_songPreviewVolume = volume;
 
 	m_songPreviewStartTimer.restart();
+
+	// 再生開始までの猶予の間にデコードしておく
+	m_cache.prefetch(m_songPreviewFilename, m_songPreviewOffset, m_songPreviewDuration);
+}
+
+void SelectSongPreview::prefetchSongPreview(FilePathView filename, SecondsF offset, SecondsF duration)
+{
+	m_cache.prefetch(filename, offset, duration);
 }
 
 void SelectSongPreview::requestDefaultBgm()
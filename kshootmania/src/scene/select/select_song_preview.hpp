@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "kson/chart_data.hpp"
 #include "ksmaudio/ksmaudio.hpp"
+#include "select_song_preview_cache.hpp"
 
 class SelectSongPreview
 {
@@ -17,6 +18,16 @@ private:
 
 	double m_songPreviewVolume = 1.0;
 
+	/// @brief 再生中のストリーム上でのプレビュー開始位置
+	/// @note メモリ上のデコード済みのプレビュー音声から再生する場合はプレビュー範囲のみがストリームになっているため0になる
+	SecondsF m_songPreviewStreamOffset = 0s;
+
+	/// @brief 再生中のストリーム上でのプレビューの再生時間
+	SecondsF m_songPreviewStreamDuration = 0s;
+
+	/// @brief デコード済みのプレビュー音声のキャッシュ
+	SelectSongPreviewCache m_cache;
+
 	double m_defaultBgmVolumeWithFade = 1.0;
 
 	/// @brief 楽曲プレビュー開始までに猶予を持たせるためのタイマー
@@ -36,6 +47,12 @@ public:
 
 	void requestSongPreview(FilePathView filename, SecondsF offset, SecondsF duration, double volume);
 
+	/// @brief カーソル付近の項目のプレビュー音声を事前にデコードしておく
+	/// @param filename 音声ファイルのパス
+	/// @param offset プレビューのオフセット
+	/// @param duration プレビューの再生時間
+	void prefetchSongPreview(FilePathView filename, SecondsF offset, SecondsF duration);
+
 	void requestDefaultBgm();
 
 	void fadeOutForExit(Duration duration);
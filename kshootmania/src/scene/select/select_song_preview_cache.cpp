@@ -0,0 +1,181 @@
+﻿#include "select_song_preview_cache.hpp"
+#include "ksmaudio/ksmaudio.hpp"
+
+namespace
+{
+	// キャッシュするプレビュー音声の件数の上限
+	constexpr std::size_t kMaxNumEntries = 8U;
+
+	// キャッシュするプレビュー音声の合計バイト数の上限
+	constexpr std::size_t kMaxTotalBytes = 96U * 1024U * 1024U;
+
+	// デコード待ちの要求の数の上限
+	// (カーソル移動が速い場合に、既にカーソルから離れた古い要求は破棄する)
+	constexpr std::size_t kMaxNumRequests = 8U;
+
+	// キャッシュ対象とするプレビューの再生時間の上限
+	// (これより長い場合はメモリ消費が大きいため、従来通りファイルから直接再生する)
+	constexpr SecondsF kMaxCachedDuration = 30s;
+
+	SelectSongPreviewCache::Binary DecodePreview(FilePathView filePath, SecondsF offset, SecondsF duration)
+	{
+		if (!FileSystem::IsFile(filePath))
+		{
+			return nullptr;
+		}
+
+		const ksmaudio::DecodedAudio decoded = ksmaudio::DecodeRange(filePath.narrow(), offset, duration);
+		if (decoded.data.empty())
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<const std::vector<char>>(ksmaudio::EncodeWAV(decoded.data, decoded.sampleRate, decoded.numChannels));
+	}
+}
+
+void SelectSongPreviewCache::threadMain(std::stop_token stopToken)
+{
+	while (true)
+	{
+		Request request;
+		{
+			std::unique_lock lock(m_mutex);
+			if (!m_condition.wait(lock, stopToken, [this] { return !m_requests.empty(); }))
+			{
+				// 停止が要求された
+				return;
+			}
+
+			// 最後に要求されたもの(カーソル位置の項目)からデコードする
+			request = std::move(m_requests.back());
+			m_requests.pop_back();
+		}
+
+		Binary binary = DecodePreview(request.filePath, request.offset, request.duration);
+
+		const std::lock_guard lock(m_mutex);
+		m_decodedResults.emplace_back(std::move(request), std::move(binary));
+	}
+}
+
+void SelectSongPreviewCache::evict()
+{
+	while (!m_lruFilePaths.empty() && (m_entries.size() > kMaxNumEntries || m_totalBytes > kMaxTotalBytes))
+	{
+		const auto itr = m_entries.find(m_lruFilePaths.back());
+		if (itr != m_entries.end())
+		{
+			if (itr->second.binary)
+			{
+				m_totalBytes -= itr->second.binary->size();
+			}
+			m_entries.erase(itr);
+		}
+		m_lruFilePaths.pop_back();
+	}
+}
+
+SelectSongPreviewCache::SelectSongPreviewCache()
+	: m_thread([this](std::stop_token stopToken) { threadMain(stopToken); })
+{
+}
+
+SelectSongPreviewCache::Binary SelectSongPreviewCache::get(FilePathView filePath, SecondsF offset, SecondsF duration)
+{
+	const FilePath filePathKey{ filePath };
+	if (const auto itr = m_entries.find(filePathKey); itr != m_entries.end() && itr->second.offset == offset && itr->second.duration == duration)
+	{
+		m_lruFilePaths.splice(m_lruFilePaths.begin(), m_lruFilePaths, itr->second.lruItr);
+		return itr->second.binary;
+	}
+
+	prefetch(filePath, offset, duration);
+	return nullptr;
+}
+
+void SelectSongPreviewCache::prefetch(FilePathView filePath, SecondsF offset, SecondsF duration)
+{
+	if (filePath.empty() || duration <= 0s || duration > kMaxCachedDuration)
+	{
+		return;
+	}
+
+	const FilePath filePathKey{ filePath };
+	if (const auto itr = m_entries.find(filePathKey); itr != m_entries.end() && itr->second.offset == offset && itr->second.duration == duration)
+	{
+		return;
+	}
+
+	Request request{
+		.filePath = filePathKey,
+		.offset = offset,
+		.duration = duration,
+	};
+	{
+		const std::lock_guard lock(m_mutex);
+
+		// デコード待ちの同じ要求は末尾(次にデコードされる位置)へ移動する
+		const auto itr = std::find_if(m_requests.begin(), m_requests.end(), [&filePathKey](const Request& r) { return r.filePath == filePathKey; });
+		if (itr != m_requests.end())
+		{
+			m_requests.erase(itr);
+		}
+		else if (const auto pendingItr = m_pendingRequests.find(filePathKey); pendingItr != m_pendingRequests.end() && pendingItr->second.offset == offset && pendingItr->second.duration == duration)
+		{
+			// デコード中のため結果を待つ
+			return;
+		}
+
+		m_requests.push_back(request);
+		if (m_requests.size() > kMaxNumRequests)
+		{
+			m_pendingRequests.erase(m_requests.front().filePath);
+			m_requests.erase(m_requests.begin());
+		}
+	}
+	m_pendingRequests.insert_or_assign(filePathKey, std::move(request));
+	m_condition.notify_one();
+}
+
+void SelectSongPreviewCache::update()
+{
+	Array<std::pair<Request, Binary>> decodedResults;
+	{
+		const std::lock_guard lock(m_mutex);
+		decodedResults = std::exchange(m_decodedResults, {});
+	}
+
+	for (auto& [request, binary] : decodedResults)
+	{
+		// 既に別のオフセット・再生時間で要求し直されている場合は、その結果を待つ
+		if (const auto itr = m_pendingRequests.find(request.filePath); itr != m_pendingRequests.end()
+			&& itr->second.offset == request.offset && itr->second.duration == request.duration)
+		{
+			m_pendingRequests.erase(itr);
+		}
+
+		if (const auto itr = m_entries.find(request.filePath); itr != m_entries.end())
+		{
+			if (itr->second.binary)
+			{
+				m_totalBytes -= itr->second.binary->size();
+			}
+			m_lruFilePaths.erase(itr->second.lruItr);
+			m_entries.erase(itr);
+		}
+
+		m_lruFilePaths.push_front(request.filePath);
+		if (binary)
+		{
+			m_totalBytes += binary->size();
+		}
+		m_entries.emplace(request.filePath, CacheEntry{
+			.offset = request.offset,
+			.duration = request.duration,
+			.binary = std::move(binary),
+			.lruItr = m_lruFilePaths.begin(),
+		});
+	}
+	evict();
+}
@@ -0,0 +1,88 @@
+﻿#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <list>
+
+/// @brief 選曲画面の楽曲プレビュー音声のキャッシュ
+/// @note プレビュー範囲(オフセットから再生時間分)のみを専用スレッドでデコードし、WAVファイルのバイナリとしてメモリ上に保持する。
+///       件数と合計バイト数の上限を超えた場合は最後に参照されてから最も時間が経ったものから破棄する
+class SelectSongPreviewCache
+{
+public:
+	using Binary = std::shared_ptr<const std::vector<char>>;
+
+private:
+	struct Request
+	{
+		FilePath filePath;
+
+		SecondsF offset = 0s;
+
+		SecondsF duration = 0s;
+	};
+
+	struct CacheEntry
+	{
+		SecondsF offset = 0s;
+
+		SecondsF duration = 0s;
+
+		// デコード結果(デコードに失敗した場合はnullptr)
+		Binary binary;
+
+		std::list<FilePath>::iterator lruItr;
+	};
+
+	// 参照された順のファイルパス(先頭が最新)
+	std::list<FilePath> m_lruFilePaths;
+
+	HashTable<FilePath, CacheEntry> m_entries;
+
+	std::size_t m_totalBytes = 0U;
+
+	// デコードを要求済みで結果を未反映の要求(メインスレッドのみで使用)
+	HashTable<FilePath, Request> m_pendingRequests;
+
+	std::mutex m_mutex;
+
+	std::condition_variable_any m_condition;
+
+	// デコード待ちの要求(末尾から順にデコードする。m_mutexで保護)
+	Array<Request> m_requests;
+
+	// デコード済みの結果(m_mutexで保護)
+	Array<std::pair<Request, Binary>> m_decodedResults;
+
+	// Note: デストラクタで最初に停止・joinされるよう、メンバ変数の最後に置く必要がある
+	std::jthread m_thread;
+
+	void threadMain(std::stop_token stopToken);
+
+	void evict();
+
+public:
+	SelectSongPreviewCache();
+
+	SelectSongPreviewCache(const SelectSongPreviewCache&) = delete;
+
+	SelectSongPreviewCache& operator=(const SelectSongPreviewCache&) = delete;
+
+	/// @brief デコード済みのプレビュー音声を取得する
+	/// @param filePath 音声ファイルのパス
+	/// @param offset プレビューのオフセット
+	/// @param duration プレビューの再生時間
+	/// @return WAVファイルのバイナリ(デコード中・デコード失敗・キャッシュ対象外の場合はnullptr)
+	Binary get(FilePathView filePath, SecondsF offset, SecondsF duration);
+
+	/// @brief プレビュー音声を事前にデコードしておく
+	/// @param filePath 音声ファイルのパス
+	/// @param offset プレビューのオフセット
+	/// @param duration プレビューの再生時間
+	/// @note 後に要求したものから順にデコードされる
+	void prefetch(FilePathView filePath, SecondsF offset, SecondsF duration);
+
+	/// @brief デコード済みの結果をキャッシュに反映する
+	/// @note 毎フレーム呼ぶ
+	void update();
+};
@@ -0,0 +1,229 @@
+﻿#include "select_song_scanner.hpp"
+#include "select_chart_metadata_index.hpp"
+#include "menu_item/select_menu_song_item.hpp"
+#include "menu_item/select_menu_sub_dir_section_item.hpp"
+
+namespace
+{
+	Array<FilePath> GetSubDirectories(FilePathView path)
+	{
+		return
+			FileSystem::DirectoryContents(path, Recursive::No)
+				.filter(
+					[](FilePathView p)
+					{
+						return FileSystem::IsDirectory(p);
+					});
+	}
+
+	/// @brief 曲の項目を作成する
+	/// @param songDirectory 曲のディレクトリのパス
+	/// @return 曲の項目(譜面が存在しない場合はnullptr)
+	std::unique_ptr<SelectMenuSongItem> CreateSongItem(const FilePath& songDirectory)
+	{
+		std::unique_ptr<SelectMenuSongItem> item = std::make_unique<SelectMenuSongItem>(songDirectory);
+		if (!item->chartExists())
+		{
+			return nullptr;
+		}
+		return item;
+	}
+}
+
+void SelectSongScanner::threadMain(std::stop_token stopToken, FilePath directoryPath)
+{
+	const uint64 scanId = SelectChartMetadataIndex::BeginScan();
+	const uint64 libraryScanId = m_library.beginScan();
+
+	// 曲の項目を追加
+	Array<FilePath> subDirCandidates;
+	for (const auto& songDirectory : GetSubDirectories(directoryPath))
+	{
+		if (stopToken.stop_requested())
+		{
+			return;
+		}
+
+		if (auto item = CreateSongItem(songDirectory))
+		{
+			m_library.updateSong(*item, libraryScanId);
+
+			Array<std::unique_ptr<ISelectMenuItem>> items;
+			items.push_back(std::move(item));
+			pushScannedItems(std::move(items));
+		}
+		else
+		{
+			// フォルダ直下に譜面がなかった場合はサブディレクトリの候補に追加
+			subDirCandidates.push_back(songDirectory);
+		}
+	}
+
+	// サブディレクトリ内の曲の項目を追加
+	// (サブディレクトリ内に譜面が存在しない場合は見出し項目を表示しないため、サブディレクトリ単位でまとめて渡す)
+	for (const auto& subDirCandidate : subDirCandidates)
+	{
+		Array<std::unique_ptr<ISelectMenuItem>> items;
+		items.push_back(std::make_unique<SelectMenuSubDirSectionItem>(FileSystem::FullPath(subDirCandidate))); // TODO: foldername.csvから読み込んだフォルダ名で置換
+		for (const auto& songDirectory : GetSubDirectories(subDirCandidate))
+		{
+			if (stopToken.stop_requested())
+			{
+				return;
+			}
+
+			if (auto item = CreateSongItem(songDirectory))
+			{
+				m_library.updateSong(*item, libraryScanId);
+				items.push_back(std::move(item));
+			}
+		}
+
+		if (items.size() > 1U)
+		{
+			pushScannedItems(std::move(items));
+		}
+	}
+
+	// 参照されなかった(削除された)譜面の項目をインデックスから削除し、次回以降譜面ファイルを読み込まずに済むようインデックスを保存
+	// (最後まで走査できた場合のみ。メインスレッドでファイルの存在確認や書き込みが発生しないよう、走査スレッドで行う)
+	SelectChartMetadataIndex::PruneUnvisited(directoryPath, scanId);
+	SelectChartMetadataIndex::SaveIfDirty();
+	m_library.finishFolderScan(directoryPath, libraryScanId);
+
+	m_isFinished.store(true, std::memory_order_release);
+}
+
+void SelectSongScanner::threadMainLibrary(std::stop_token stopToken, Array<FilePath> folderPaths, Optional<SelectLibraryQuery> query)
+{
+	const uint64 scanId = SelectChartMetadataIndex::BeginScan();
+	const uint64 libraryScanId = m_library.beginScan();
+
+	// ルートから削除されたフォルダの曲を取り除く
+	m_library.retainFolders(folderPaths);
+
+	// ライブラリ上で未走査のフォルダの曲を走査してライブラリに反映
+	// (フォルダ直下に譜面がないディレクトリは、開いたフォルダの場合と同様にサブディレクトリ内の曲を対象にする)
+	// (ここで作成した項目は、絞り込み・並べ替え後に作成し直さずにそのまま使用する)
+	HashTable<FilePath, std::unique_ptr<SelectMenuSongItem>> scannedSongItems;
+	const auto addScannedSongItem = [&](std::unique_ptr<SelectMenuSongItem>&& item)
+		{
+			m_library.updateSong(*item, libraryScanId);
+			if (query.has_value())
+			{
+				FilePath songDirectoryPath{ item->fullPath() };
+				scannedSongItems.emplace(std::move(songDirectoryPath), std::move(item));
+			}
+		};
+	for (const auto& folderPath : folderPaths)
+	{
+		if (m_library.isFolderScanned(folderPath))
+		{
+			continue;
+		}
+
+		for (const auto& songDirectory : GetSubDirectories(folderPath))
+		{
+			if (stopToken.stop_requested())
+			{
+				return;
+			}
+
+			if (auto item = CreateSongItem(songDirectory))
+			{
+				addScannedSongItem(std::move(item));
+				continue;
+			}
+
+			for (const auto& subDirSongDirectory : GetSubDirectories(songDirectory))
+			{
+				if (stopToken.stop_requested())
+				{
+					return;
+				}
+
+				if (auto item = CreateSongItem(subDirSongDirectory))
+				{
+					addScannedSongItem(std::move(item));
+				}
+			}
+		}
+
+		SelectChartMetadataIndex::PruneUnvisited(folderPath, scanId);
+		m_library.finishFolderScan(folderPath, libraryScanId);
+	}
+	SelectChartMetadataIndex::SaveIfDirty();
+
+	if (!query.has_value())
+	{
+		m_isFinished.store(true, std::memory_order_release);
+		return;
+	}
+
+	// 絞り込み・並べ替えた順に項目を作成して渡す
+	// (ハイスコアの読み込みが発生するため、ここでも中断を受け付ける)
+	for (const auto& songDirectoryPath : m_library.query(*query))
+	{
+		if (stopToken.stop_requested())
+		{
+			return;
+		}
+
+		std::unique_ptr<SelectMenuSongItem> item;
+		if (const auto itr = scannedSongItems.find(songDirectoryPath); itr != scannedSongItems.end())
+		{
+			item = std::move(itr->second);
+		}
+		else
+		{
+			item = CreateSongItem(songDirectoryPath);
+		}
+
+		if (item == nullptr)
+		{
+			// 前回の走査以降に削除された曲はライブラリから取り除く
+			m_library.removeSong(songDirectoryPath);
+			continue;
+		}
+
+		Array<std::unique_ptr<ISelectMenuItem>> items;
+		items.push_back(std::move(item));
+		pushScannedItems(std::move(items));
+	}
+
+	m_isFinished.store(true, std::memory_order_release);
+}
+
+void SelectSongScanner::pushScannedItems(Array<std::unique_ptr<ISelectMenuItem>>&& items)
+{
+	const std::lock_guard lock(m_mutex);
+	for (auto& item : items)
+	{
+		m_scannedItems.push_back(std::move(item));
+	}
+}
+
+SelectSongScanner::SelectSongScanner(SelectLibrary& library, FilePathView directoryPath)
+	: m_library(library)
+	, m_thread([this, directoryPath = FilePath{ directoryPath }](std::stop_token stopToken) { threadMain(stopToken, directoryPath); })
+{
+}
+
+SelectSongScanner::SelectSongScanner(SelectLibrary& library, const Array<FilePath>& folderPaths, const Optional<SelectLibraryQuery>& query)
+	: m_library(library)
+	, m_thread([this, folderPaths, query](std::stop_token stopToken) { threadMainLibrary(stopToken, folderPaths, query); })
+{
+}
+
+SelectSongScanner::~SelectSongScanner() = default;
+
+Array<std::unique_ptr<ISelectMenuItem>> SelectSongScanner::popScannedItems()
+{
+	const std::lock_guard lock(m_mutex);
+	return std::exchange(m_scannedItems, {});
+}
+
+bool SelectSongScanner::isFinished() const
+{
+	return m_isFinished.load(std::memory_order_acquire);
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <thread>
+#include <mutex>
+#include "select_library.hpp"
+
+class ISelectMenuItem;
+
+/// @brief 選曲画面で開いたフォルダ内の曲を別スレッドで走査する
+/// @note 走査済みの曲の項目(サブディレクトリの見出し項目を含む)は表示順に溜めておき、メインスレッドからpopScannedItems()で取り出す。
+///       走査した曲はSelectLibraryにも反映する。
+///       Allフォルダ・レベルフォルダの場合は未走査のフォルダのみを走査し、SelectLibraryで絞り込み・並べ替えた順に項目を渡す。
+///       破棄時には走査を中断する
+class SelectSongScanner
+{
+private:
+	SelectLibrary& m_library;
+
+	std::mutex m_mutex;
+
+	// 走査済みでまだ取り出されていない項目(m_mutexで保護)
+	Array<std::unique_ptr<ISelectMenuItem>> m_scannedItems;
+
+	std::atomic<bool> m_isFinished = false;
+
+	// Note: デストラクタで最初に停止・joinされるよう、メンバ変数の最後に置く必要がある
+	std::jthread m_thread;
+
+	void threadMain(std::stop_token stopToken, FilePath directoryPath);
+
+	void threadMainLibrary(std::stop_token stopToken, Array<FilePath> folderPaths, Optional<SelectLibraryQuery> query);
+
+	void pushScannedItems(Array<std::unique_ptr<ISelectMenuItem>>&& items);
+
+public:
+	/// @brief フォルダ内の曲を走査する
+	/// @param library 走査した曲を反映するライブラリ
+	/// @param directoryPath フォルダのパス
+	SelectSongScanner(SelectLibrary& library, FilePathView directoryPath);
+
+	/// @brief Allフォルダ・レベルフォルダ用に、ライブラリで絞り込み・並べ替えた曲の項目を作成する
+	/// @param library ライブラリ
+	/// @param folderPaths 全フォルダのパス(ライブラリ上で未走査のフォルダのみ走査する)
+	/// @param query 絞り込み・並べ替えの条件(noneの場合はライブラリの作成のみ行い、項目は作成しない)
+	SelectSongScanner(SelectLibrary& library, const Array<FilePath>& folderPaths, const Optional<SelectLibraryQuery>& query);
+
+	~SelectSongScanner(); // ヘッダではISelectMenuItemが不完全型なのでソースファイル側で定義
+
+	SelectSongScanner(const SelectSongScanner&) = delete;
+
+	SelectSongScanner& operator=(const SelectSongScanner&) = delete;
+
+	/// @brief 走査済みの項目を表示順に取り出す
+	/// @return 前回の呼び出し以降に走査済みになった項目
+	Array<std::unique_ptr<ISelectMenuItem>> popScannedItems();
+
+	/// @brief 走査が完了したかどうか
+	/// @return 完了した場合はtrue
+	/// @note trueを返した後にpopScannedItems()を呼べば、全ての項目を取り出したことになる
+	bool isFinished() const;
+};
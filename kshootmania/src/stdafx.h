@@ -7,6 +7,7 @@
 #include "common/asset_management.hpp"
 #include "common/math_utils.hpp"
 #include "common/fs_utils.hpp"
+#include "common/frame_profiler.hpp"
 #include "addon/auto_mute_addon.hpp"
 #include "graphics/screen_utils.hpp"
 #include "graphics/tiled_texture.hpp"
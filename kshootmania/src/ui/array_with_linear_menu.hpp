@@ -64,6 +64,12 @@ public:
 
 	void pop_back();
 
+	/// @brief 指定位置に要素を挿入する
+	/// @param idx 挿入位置
+	/// @param value 挿入する要素
+	/// @note 挿入位置がカーソル位置以前の場合はカーソルを後ろにずらし、カーソル位置の要素が変わらないようにする
+	void insert(std::size_t idx, T&& value);
+
 	auto begin();
 
 	auto begin() const;
@@ -304,6 +310,19 @@ void ArrayWithLinearMenu<T>::pop_back()
 	updateLinearMenuCursorMax();
 }
 
+template <typename T>
+void ArrayWithLinearMenu<T>::insert(std::size_t idx, T&& value)
+{
+	const int32 cursor = m_linearMenu.cursor();
+	const bool shiftCursor = !m_array.empty() && idx <= static_cast<std::size_t>(cursor);
+	m_array.insert(m_array.begin() + idx, std::move(value));
+	updateLinearMenuCursorMax();
+	if (shiftCursor)
+	{
+		m_linearMenu.setCursor(cursor + 1);
+	}
+}
+
 template <typename T>
 auto ArrayWithLinearMenu<T>::begin()
 {
@@ -0,0 +1,94 @@
+﻿// HighwayMeshMathのテスト
+// Highwayのメッシュの頂点座標の計算結果を、代表的なカメラの値で確認する
+#include <cmath>
+#include <initializer_list>
+#include "music_game/graphics/highway/highway_mesh_math.hpp"
+#include "test_common.hpp"
+
+namespace
+{
+	using namespace MusicGame::Graphics;
+
+	// rotationXの1周分の値(360度)
+	constexpr double kRotationXPeriod = 2400.0;
+
+	bool AlmostEquals(double a, double b)
+	{
+		return std::abs(a - b) < 1e-9;
+	}
+
+	// rotationXが0・zoomが0の場合はHighwayは傾かず、Y座標は0になる
+	void TestDefaultCamera()
+	{
+		const auto positions = HighwayMeshMath::CalculateVertexPositions({ .scaledZoom = 0.0, .rotationX = 0.0 });
+		KSMAUDIO_TEST_CHECK(AlmostEquals(positions.farY, 0.0));
+		KSMAUDIO_TEST_CHECK(AlmostEquals(positions.farZ, HighwayMeshMath::kPlaneHeightAboveJdgline / 2));
+		KSMAUDIO_TEST_CHECK(AlmostEquals(positions.nearY, 0.0));
+		KSMAUDIO_TEST_CHECK(AlmostEquals(positions.nearZ, -HighwayMeshMath::kPlaneHeightAboveJdgline / 2 - HighwayMeshMath::kPlaneHeightBelowJdgline / 2));
+		KSMAUDIO_TEST_CHECK(!positions.trianglesFlipped);
+	}
+
+	// zoomは手前の辺のみに影響する
+	void TestZoomMovesOnlyNearEdge()
+	{
+		const auto positions = HighwayMeshMath::CalculateVertexPositions({ .scaledZoom = 0.0, .rotationX = 100.0 });
+		const auto zoomedPositions = HighwayMeshMath::CalculateVertexPositions({ .scaledZoom = 0.5, .rotationX = 100.0 });
+		KSMAUDIO_TEST_CHECK(zoomedPositions.farY == positions.farY);
+		KSMAUDIO_TEST_CHECK(zoomedPositions.farZ == positions.farZ);
+		KSMAUDIO_TEST_CHECK(zoomedPositions.nearY > positions.nearY);
+		KSMAUDIO_TEST_CHECK(zoomedPositions.nearZ < positions.nearZ);
+		KSMAUDIO_TEST_CHECK(zoomedPositions.trianglesFlipped == positions.trianglesFlipped);
+	}
+
+	// rotationXは1周(2400)で元に戻り、負の値でも同じ結果になる
+	void TestRotationXIsPeriodic()
+	{
+		for (const double rotationX : { 0.0, 300.0, 900.0, 1500.0, 1900.0 })
+		{
+			const auto positions = HighwayMeshMath::CalculateVertexPositions({ .scaledZoom = 0.2, .rotationX = rotationX });
+			for (const double shiftedRotationX : { rotationX + kRotationXPeriod, rotationX - kRotationXPeriod })
+			{
+				const auto shiftedPositions = HighwayMeshMath::CalculateVertexPositions({ .scaledZoom = 0.2, .rotationX = shiftedRotationX });
+				KSMAUDIO_TEST_CHECK(AlmostEquals(shiftedPositions.farY, positions.farY));
+				KSMAUDIO_TEST_CHECK(AlmostEquals(shiftedPositions.farZ, positions.farZ));
+				KSMAUDIO_TEST_CHECK(AlmostEquals(shiftedPositions.nearY, positions.nearY));
+				KSMAUDIO_TEST_CHECK(AlmostEquals(shiftedPositions.nearZ, positions.nearZ));
+				KSMAUDIO_TEST_CHECK(shiftedPositions.trianglesFlipped == positions.trianglesFlipped);
+			}
+		}
+	}
+
+	// Highwayを裏側から見る角度(カメラの傾き60度を加えて180度～360度)の範囲でのみ三角形を反転する
+	void TestTrianglesFlipped()
+	{
+		// 度数法の角度をrotationXの値に変換する
+		const auto rotationXFromDegrees = [](double degrees) { return degrees * kRotationXPeriod / 360; };
+
+		KSMAUDIO_TEST_CHECK(!HighwayMeshMath::CalculateVertexPositions({ .rotationX = rotationXFromDegrees(119.0) }).trianglesFlipped);
+		KSMAUDIO_TEST_CHECK(HighwayMeshMath::CalculateVertexPositions({ .rotationX = rotationXFromDegrees(121.0) }).trianglesFlipped);
+		KSMAUDIO_TEST_CHECK(HighwayMeshMath::CalculateVertexPositions({ .rotationX = rotationXFromDegrees(299.0) }).trianglesFlipped);
+		KSMAUDIO_TEST_CHECK(!HighwayMeshMath::CalculateVertexPositions({ .rotationX = rotationXFromDegrees(301.0) }).trianglesFlipped);
+		KSMAUDIO_TEST_CHECK(HighwayMeshMath::CalculateVertexPositions({ .rotationX = rotationXFromDegrees(-90.0) }).trianglesFlipped);
+		KSMAUDIO_TEST_CHECK(!HighwayMeshMath::CalculateVertexPositions({ .rotationX = rotationXFromDegrees(-30.0) }).trianglesFlipped);
+	}
+
+	// 前回の値との比較(メッシュの更新要否の判定)はzoomとrotationXの両方を見る
+	void TestVertexInputsEquality()
+	{
+		const HighwayMeshMath::VertexInputs inputs{ .scaledZoom = 0.1, .rotationX = 10.0 };
+		KSMAUDIO_TEST_CHECK((inputs == HighwayMeshMath::VertexInputs{ .scaledZoom = 0.1, .rotationX = 10.0 }));
+		KSMAUDIO_TEST_CHECK((inputs != HighwayMeshMath::VertexInputs{ .scaledZoom = 0.2, .rotationX = 10.0 }));
+		KSMAUDIO_TEST_CHECK((inputs != HighwayMeshMath::VertexInputs{ .scaledZoom = 0.1, .rotationX = 20.0 }));
+	}
+}
+
+int main()
+{
+	TestDefaultCamera();
+	TestZoomMovesOnlyNearEdge();
+	TestRotationXIsPeriodic();
+	TestTrianglesFlipped();
+	TestVertexInputsEquality();
+
+	return ksmaudio::Test::Result("highway_mesh_math_test");
+}
@@ -0,0 +1,190 @@
+﻿// SimulationTickerのテスト
+// 同じ入力を異なるフレーム間隔で与えても、各ティックでの判定結果が同じになることを確認する
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "music_game/simulation_ticker.hpp"
+#include "test_common.hpp"
+
+namespace
+{
+	using MusicGame::SimulationTicker;
+	using Clock = std::chrono::steady_clock;
+
+	// BGMの再生位置0秒に対応する時刻
+	// (テストではBGMの再生位置は実時間と同じ速さで進むものとする)
+	const Clock::time_point kStartTime{};
+
+	// 判定の許容範囲(秒)
+	constexpr double kCriticalWindowSec = 0.042;
+	constexpr double kNearWindowSec = 0.1;
+
+	// ノーツの時刻(秒)
+	const std::vector<double> kNoteTimes = { 0.5, 0.75, 1.0, 1.25, 1.5, 2.0 };
+
+	// ボタンを押した時刻(BGMの再生位置で指定。ティック間隔の境界と重ならないようにずらしている)
+	const std::vector<double> kPressTimes = { 0.5103, 0.7903, 1.0707, 1.4602, 2.1804 };
+
+	Clock::time_point ToClockTime(double sec)
+	{
+		return kStartTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(sec));
+	}
+
+	enum class JudgmentResult
+	{
+		kCritical,
+		kNear,
+		kError,
+	};
+
+	struct JudgmentRecord
+	{
+		std::size_t noteIdx = 0U;
+
+		JudgmentResult result = JudgmentResult::kError;
+
+		// 判定したティックの時刻(ミリ秒)
+		std::int64_t tickTimeMs = 0;
+
+		bool operator==(const JudgmentRecord&) const = default;
+	};
+
+	// JudgmentMainと同様に、ティックの取得時点の時刻までに発生した入力を取り出し、
+	// ティックの時刻から入力の時刻までの差をもとに判定する簡易的な判定処理
+	class TestJudgment
+	{
+	private:
+		std::size_t m_nextPressIdx = 0U;
+		std::size_t m_nextNoteIdx = 0U;
+		std::vector<JudgmentRecord> m_records;
+
+		void judge(JudgmentResult result, double tickTimeSec)
+		{
+			m_records.push_back({
+				.noteIdx = m_nextNoteIdx,
+				.result = result,
+				.tickTimeMs = std::llround(tickTimeSec * 1000),
+			});
+			++m_nextNoteIdx;
+		}
+
+	public:
+		void tick(double tickTimeSec, Clock::time_point tickTimeSampledAt)
+		{
+			// 取得時点の時刻以前に発生した入力を判定
+			while (m_nextPressIdx < kPressTimes.size() && ToClockTime(kPressTimes[m_nextPressIdx]) <= tickTimeSampledAt)
+			{
+				const double secBeforeSampled = std::chrono::duration<double>(tickTimeSampledAt - ToClockTime(kPressTimes[m_nextPressIdx])).count();
+				const double pressTimeSec = tickTimeSec - secBeforeSampled;
+				++m_nextPressIdx;
+				if (m_nextNoteIdx < kNoteTimes.size())
+				{
+					const double diffSec = std::abs(pressTimeSec - kNoteTimes[m_nextNoteIdx]);
+					if (diffSec < kCriticalWindowSec)
+					{
+						judge(JudgmentResult::kCritical, tickTimeSec);
+					}
+					else if (diffSec < kNearWindowSec)
+					{
+						judge(JudgmentResult::kNear, tickTimeSec);
+					}
+				}
+			}
+
+			// 押されずに許容範囲を過ぎたノーツはERROR
+			while (m_nextNoteIdx < kNoteTimes.size() && tickTimeSec > kNoteTimes[m_nextNoteIdx] + kNearWindowSec)
+			{
+				judge(JudgmentResult::kError, tickTimeSec);
+			}
+		}
+
+		const std::vector<JudgmentRecord>& records() const
+		{
+			return m_records;
+		}
+	};
+
+	// 指定したフレームの時刻(秒)の列で描画フレームを進めた場合の判定結果を返す
+	std::vector<JudgmentRecord> RunFrames(const std::vector<double>& frameTimes)
+	{
+		SimulationTicker ticker;
+		TestJudgment judgment;
+		for (const double frameTimeSec : frameTimes)
+		{
+			ticker.advance(frameTimeSec, ToClockTime(frameTimeSec), [&judgment](double tickTimeSec, Clock::time_point tickTimeSampledAt)
+				{
+					judgment.tick(tickTimeSec, tickTimeSampledAt);
+				});
+		}
+		return judgment.records();
+	}
+
+	// 一定のフレームレートでの、0秒から2.5秒までのフレームの時刻の列
+	std::vector<double> FixedRateFrameTimes(double fps)
+	{
+		std::vector<double> frameTimes;
+		for (int i = 0; static_cast<double>(i) / fps <= 2.5; ++i)
+		{
+			frameTimes.push_back(static_cast<double>(i) / fps);
+		}
+		return frameTimes;
+	}
+
+	void TestSameResultsAtDifferentFrameRates()
+	{
+		// 判定結果・判定したティックの時刻がフレームレートに依存しない
+		const std::vector<JudgmentRecord> reference = RunFrames(FixedRateFrameTimes(1000.0));
+		KSMAUDIO_TEST_CHECK(reference.size() == kNoteTimes.size());
+		for (const double fps : { 30.0, 60.0, 144.0, 240.0 })
+		{
+			KSMAUDIO_TEST_CHECK(RunFrames(FixedRateFrameTimes(fps)) == reference);
+		}
+	}
+
+	void TestSameResultsWithIrregularFrameIntervals()
+	{
+		// フレーム間隔が不規則でも、1フレームあたりのティック数の上限を超えなければ結果は変わらない
+		std::vector<double> frameTimes;
+		double frameTimeSec = 0.0;
+		for (int i = 0; frameTimeSec <= 2.5; ++i)
+		{
+			frameTimes.push_back(frameTimeSec);
+			frameTimeSec += 0.003 + 0.011 * static_cast<double>((i * 7) % 9);
+		}
+		KSMAUDIO_TEST_CHECK(RunFrames(frameTimes) == RunFrames(FixedRateFrameTimes(1000.0)));
+	}
+
+	void TestTicksPerFrameAreCapped()
+	{
+		// 大きく遅れたフレームでは直近のティックのみを実行する
+		SimulationTicker ticker;
+		std::vector<double> tickTimes;
+		const auto recordTick = [&tickTimes](double tickTimeSec, Clock::time_point)
+			{
+				tickTimes.push_back(tickTimeSec);
+			};
+		ticker.advance(0.0, ToClockTime(0.0), recordTick);
+		KSMAUDIO_TEST_CHECK(tickTimes.size() == 1U);
+
+		tickTimes.clear();
+		ticker.advance(1.0, ToClockTime(1.0), recordTick);
+		KSMAUDIO_TEST_CHECK(tickTimes.size() == static_cast<std::size_t>(SimulationTicker::kMaxTicksPerFrame));
+		KSMAUDIO_TEST_CHECK(!tickTimes.empty() && std::llround(tickTimes.back() * 1000) == 1000);
+
+		// 再生位置が戻った場合はその時刻のティックから再開する
+		tickTimes.clear();
+		ticker.advance(0.5, ToClockTime(0.5), recordTick);
+		KSMAUDIO_TEST_CHECK(tickTimes.size() == 1U);
+		KSMAUDIO_TEST_CHECK(!tickTimes.empty() && std::llround(tickTimes.front() * 1000) == 500);
+	}
+}
+
+int main()
+{
+	TestSameResultsAtDifferentFrameRates();
+	TestSameResultsWithIrregularFrameIntervals();
+	TestTicksPerFrameAreCapped();
+	return ksmaudio::Test::Result("simulation_ticker_test");
+}
@@ -0,0 +1,204 @@
+﻿// Biquadフィルタの処理方式のベンチマーク
+// 最適化前の実装(チャンネル毎のスカラーのフィルタで、サンプル毎にa0で割る)と、
+// detail::StereoBiquadFilter(正規化済みの係数で左右のチャンネルを同時に処理する)で、1フレームあたりの処理時間を比較する
+// また、フィルタ係数をフレーム毎に計算していたWobble・Phaserと、制御レートで計算する現在のWobbleDSP・PhaserDSPを比較する
+//
+// 使い方: ksmaudio_biquad_benchmark [計測する音声の長さ(秒、デフォルト10)]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+#include "ksmaudio/audio_effect/detail/biquad_filter.hpp"
+#include "ksmaudio/audio_effect/dsp/phaser_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/wobble_dsp.hpp"
+#include "legacy_dsp_reference.hpp"
+
+namespace
+{
+	using namespace ksmaudio::AudioEffect;
+	using LegacyBiquadFilter = ksmaudio::Test::Legacy::BiquadFilter;
+
+	// 1回の処理で処理するフレーム数
+	constexpr std::size_t kBlockFrames = 512U;
+
+	constexpr std::size_t kSampleRate = 44100U;
+
+	constexpr std::size_t kNumChannels = 2U;
+
+	// 計測前に処理する音声の長さ(秒)
+	constexpr double kWarmUpSec = 0.5;
+
+	// 白色雑音を生成する
+	std::vector<float> MakeNoise(std::size_t size)
+	{
+		std::vector<float> signal(size);
+		std::uint32_t seed = 12345U;
+		for (float& v : signal)
+		{
+			seed = seed * 1664525U + 1013904223U;
+			v = static_cast<float>(seed >> 8) / static_cast<float>(1U << 24) * 2.0f - 1.0f;
+		}
+		return signal;
+	}
+
+	// seconds秒分の音声をブロック毎にprocessBlockFuncで処理した時間を計測し、1フレームあたりの処理時間(ns)を返す
+	double Run(double seconds, const std::function<void(float*, std::size_t)>& processBlockFunc)
+	{
+		const std::vector<float> signal = MakeNoise(kBlockFrames * kNumChannels);
+		std::vector<float> block(signal.size());
+
+		const std::size_t numWarmUpBlocks = static_cast<std::size_t>(kWarmUpSec * kSampleRate / kBlockFrames);
+		const std::size_t numBlocks = (std::max)(static_cast<std::size_t>(seconds * kSampleRate / kBlockFrames), std::size_t{ 1U });
+		std::chrono::steady_clock::duration elapsed{};
+		for (std::size_t blockIdx = 0U; blockIdx < numWarmUpBlocks + numBlocks; ++blockIdx)
+		{
+			block = signal;
+
+			const auto startTime = std::chrono::steady_clock::now();
+			processBlockFunc(block.data(), kBlockFrames);
+			if (blockIdx >= numWarmUpBlocks)
+			{
+				elapsed += std::chrono::steady_clock::now() - startTime;
+			}
+		}
+
+		const double elapsedSec = std::chrono::duration<double>(elapsed).count();
+		return elapsedSec * 1e9 / static_cast<double>(numBlocks * kBlockFrames);
+	}
+
+	struct BenchmarkCase
+	{
+		std::string name;
+
+		std::function<double(double)> runLegacy;
+
+		std::function<double(double)> run;
+	};
+
+	// 同じ係数を設定したフィルタで、最適化前の実装とStereoBiquadFilterを比較するケースを作成する
+	BenchmarkCase MakeFilterCase(const std::string& name, const std::function<void(detail::BiquadCoefficients<float>&)>& setCoefsFunc, const std::function<void(LegacyBiquadFilter&)>& setLegacyFunc)
+	{
+		return {
+			.name = name,
+			.runLegacy = [setLegacyFunc](double seconds)
+			{
+				LegacyBiquadFilter filters[kNumChannels];
+				for (LegacyBiquadFilter& filter : filters)
+				{
+					setLegacyFunc(filter);
+				}
+				return Run(seconds, [&filters](float* pData, std::size_t numFrames)
+				{
+					for (std::size_t i = 0U; i < numFrames; ++i)
+					{
+						for (std::size_t ch = 0U; ch < kNumChannels; ++ch)
+						{
+							*pData = filters[ch].process(*pData);
+							++pData;
+						}
+					}
+				});
+			},
+			.run = [setCoefsFunc](double seconds)
+			{
+				detail::BiquadCoefficients<float> coefs;
+				setCoefsFunc(coefs);
+				detail::StereoBiquadFilter filter;
+				filter.setCoefficients(coefs);
+				return Run(seconds, [&filter](float* pData, std::size_t numFrames)
+				{
+					filter.process(pData, numFrames);
+				});
+			},
+		};
+	}
+
+	std::vector<BenchmarkCase> MakeCases()
+	{
+		constexpr float kSampleRateFloat = static_cast<float>(kSampleRate);
+
+		std::vector<BenchmarkCase> cases;
+		cases.push_back(MakeFilterCase("LowPass",
+			[](detail::BiquadCoefficients<float>& coefs) { coefs.setLowPassFilter(1200.0f, 1.414f, kSampleRateFloat); },
+			[](LegacyBiquadFilter& filter) { filter.setLowPassFilter(1200.0f, 1.414f, kSampleRateFloat); }));
+		cases.push_back(MakeFilterCase("HighPass",
+			[](detail::BiquadCoefficients<float>& coefs) { coefs.setHighPassFilter(800.0f, 0.707f, kSampleRateFloat); },
+			[](LegacyBiquadFilter& filter) { filter.setHighPassFilter(800.0f, 0.707f, kSampleRateFloat); }));
+		cases.push_back(MakeFilterCase("Peaking",
+			[](detail::BiquadCoefficients<float>& coefs) { coefs.setPeakingFilter(3000.0f, 1.2f, 15.0f, kSampleRateFloat); },
+			[](LegacyBiquadFilter& filter) { filter.setPeakingFilter(3000.0f, 1.2f, 15.0f, kSampleRateFloat); }));
+
+		cases.push_back({
+			.name = "Wobble",
+			.runLegacy = [](double seconds)
+			{
+				const WobbleDSPParams params{ .secUntilTrigger = 0.0f, .waveLength = 0.25f, .mix = 1.0f };
+				ksmaudio::Test::Legacy::Wobble wobble(kSampleRate, kNumChannels);
+				wobble.updateParams(params);
+				return Run(seconds, [&wobble, &params](float* pData, std::size_t numFrames)
+				{
+					wobble.process(pData, numFrames * kNumChannels, params);
+				});
+			},
+			.run = [](double seconds)
+			{
+				const WobbleDSPParams params{ .secUntilTrigger = 0.0f, .waveLength = 0.25f, .mix = 1.0f };
+				WobbleDSP wobble(DSPCommonInfo{ kSampleRate, kNumChannels, nullptr });
+				wobble.updateParams(params);
+				return Run(seconds, [&wobble, &params](float* pData, std::size_t numFrames)
+				{
+					wobble.process(pData, numFrames * kNumChannels, false, params);
+				});
+			},
+		});
+
+		// ステージ数は最大(12)で計測する
+		cases.push_back({
+			.name = "Phaser",
+			.runLegacy = [](double seconds)
+			{
+				const PhaserDSPParams params{ .stage = PhaserDSP::kMaxNumAllPassFilters, .mix = 1.0f };
+				ksmaudio::Test::Legacy::Phaser phaser(kSampleRate, kNumChannels);
+				return Run(seconds, [&phaser, &params](float* pData, std::size_t numFrames)
+				{
+					phaser.process(pData, numFrames * kNumChannels, params);
+				});
+			},
+			.run = [](double seconds)
+			{
+				const PhaserDSPParams params{ .stage = PhaserDSP::kMaxNumAllPassFilters, .mix = 1.0f };
+				PhaserDSP phaser(DSPCommonInfo{ kSampleRate, kNumChannels, nullptr });
+				return Run(seconds, [&phaser, &params](float* pData, std::size_t numFrames)
+				{
+					phaser.process(pData, numFrames * kNumChannels, false, params);
+				});
+			},
+		});
+
+		return cases;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const double seconds = argc >= 2 ? std::atof(argv[1]) : 10.0;
+	if (seconds <= 0.0)
+	{
+		std::fprintf(stderr, "Usage: %s [seconds]\n", argv[0]);
+		return 1;
+	}
+
+	std::printf("%-16s %14s %14s %8s\n", "case", "legacy ns/frm", "new ns/frm", "speedup");
+	for (const BenchmarkCase& benchmarkCase : MakeCases())
+	{
+		const double legacyNsPerFrame = benchmarkCase.runLegacy(seconds);
+		const double nsPerFrame = benchmarkCase.run(seconds);
+		std::printf("%-16s %14.2f %14.2f %7.2fx\n", benchmarkCase.name.c_str(), legacyNsPerFrame, nsPerFrame, nsPerFrame > 0.0 ? legacyNsPerFrame / nsPerFrame : 0.0);
+	}
+
+	return 0;
+}
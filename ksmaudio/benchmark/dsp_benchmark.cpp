@@ -0,0 +1,218 @@
+﻿// 音声エフェクトのDSP単体のベンチマーク
+// BASSを使用せず、各DSPクラスをDSPCommonInfoから直接生成して合成した音声データを処理させ、1フレームあたりの処理時間を計測する
+//
+// 使い方: ksmaudio_dsp_benchmark [計測する音声の長さ(秒、デフォルト10)] [DSP名のフィルタ(部分一致)]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <numbers>
+#include <string>
+#include <vector>
+#include "ksmaudio/audio_effect/dsp/retrigger_echo_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/gate_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/flanger_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/bitcrusher_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/phaser_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/wobble_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/tapestop_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/sidechain_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/peaking_filter_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/high_pass_filter_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/low_pass_filter_dsp.hpp"
+
+namespace
+{
+	using namespace ksmaudio::AudioEffect;
+
+	// 1回のprocess()で処理するフレーム数
+	constexpr std::size_t kBlockFrames = 512U;
+
+	// 計測前に処理する音声の長さ(秒)
+	// (遅延バッファの確保などの初回のみの処理を計測から除外するため)
+	constexpr double kWarmUpSec = 0.5;
+
+	// 遅延バッファを使用するDSPに対して事前に確保する遅延バッファの秒数
+	// (ゲーム中と同様、DSPの処理中にはメモリ確保が発生しないようにするため)
+	constexpr float kReservedDelaySec = 2.0f;
+
+	constexpr std::size_t kSampleRates[] = { 44100U, 48000U, 96000U };
+
+	constexpr std::size_t kNumChannelsList[] = { 1U, 2U };
+
+	struct BenchmarkResult
+	{
+		double nsPerFrame;
+
+		double realtimeRatio;
+	};
+
+	// 正弦波と白色雑音を混ぜた音声を生成する
+	std::vector<float> MakeSyntheticSignal(std::size_t sampleRate, std::size_t numChannels)
+	{
+		const std::size_t numFrames = sampleRate; // 1秒分をループして使用する
+		std::vector<float> signal(numFrames * numChannels);
+		std::uint32_t seed = 12345U;
+		for (std::size_t i = 0U; i < numFrames; ++i)
+		{
+			const float t = static_cast<float>(i) / static_cast<float>(sampleRate);
+			const float tone = 0.3f * std::sin(2.0f * std::numbers::pi_v<float> * 220.0f * t) + 0.2f * std::sin(2.0f * std::numbers::pi_v<float> * 3520.0f * t);
+			for (std::size_t ch = 0U; ch < numChannels; ++ch)
+			{
+				seed = seed * 1664525U + 1013904223U;
+				const float noise = static_cast<float>(seed >> 8) / static_cast<float>(1U << 24) * 2.0f - 1.0f;
+				signal[i * numChannels + ch] = tone + 0.2f * noise;
+			}
+		}
+		return signal;
+	}
+
+	// DSPを生成し、seconds秒分の音声を処理した時間を計測する
+	// (beforeBlockFuncは各ブロックの処理前に呼ばれ、トリガの更新などに使用する)
+	template <typename DSP, typename DSPParams>
+	BenchmarkResult Run(std::size_t sampleRate, std::size_t numChannels, double seconds, const DSPParams& params, const std::function<void(DSP&, std::size_t)>& beforeBlockFunc)
+	{
+		detail::DelayLineArena delayLineArena;
+		DSP dsp(DSPCommonInfo{ sampleRate, numChannels, &delayLineArena });
+		if constexpr (requires { dsp.reserveDelayTime(kReservedDelaySec); })
+		{
+			dsp.reserveDelayTime(kReservedDelaySec);
+		}
+
+		const std::vector<float> signal = MakeSyntheticSignal(sampleRate, numChannels);
+		const std::size_t signalFrames = signal.size() / numChannels;
+		std::vector<float> block(kBlockFrames * numChannels);
+
+		const std::size_t numWarmUpBlocks = static_cast<std::size_t>(kWarmUpSec * sampleRate / kBlockFrames);
+		const std::size_t numBlocks = (std::max)(static_cast<std::size_t>(seconds * sampleRate / kBlockFrames), std::size_t{ 1U });
+		std::chrono::steady_clock::duration elapsed{};
+		for (std::size_t blockIdx = 0U; blockIdx < numWarmUpBlocks + numBlocks; ++blockIdx)
+		{
+			const std::size_t signalOffsetFrame = (blockIdx * kBlockFrames) % (signalFrames - kBlockFrames);
+			std::memcpy(block.data(), &signal[signalOffsetFrame * numChannels], sizeof(float) * block.size());
+
+			if (beforeBlockFunc)
+			{
+				beforeBlockFunc(dsp, blockIdx);
+			}
+
+			const auto startTime = std::chrono::steady_clock::now();
+			dsp.process(block.data(), block.size(), false, params);
+			if (blockIdx >= numWarmUpBlocks)
+			{
+				elapsed += std::chrono::steady_clock::now() - startTime;
+			}
+		}
+
+		const double elapsedSec = std::chrono::duration<double>(elapsed).count();
+		const double numFrames = static_cast<double>(numBlocks * kBlockFrames);
+		return {
+			.nsPerFrame = elapsedSec * 1e9 / numFrames,
+			.realtimeRatio = elapsedSec > 0.0 ? numFrames / sampleRate / elapsedSec : 0.0,
+		};
+	}
+
+	struct BenchmarkCase
+	{
+		std::string name;
+
+		std::function<BenchmarkResult(std::size_t, std::size_t, double)> run;
+	};
+
+	template <typename DSP, typename DSPParams>
+	BenchmarkCase MakeCase(const std::string& name, const DSPParams& params, const std::function<void(DSP&, std::size_t)>& beforeBlockFunc = nullptr)
+	{
+		return {
+			.name = name,
+			.run = [params, beforeBlockFunc](std::size_t sampleRate, std::size_t numChannels, double seconds)
+			{
+				return Run<DSP>(sampleRate, numChannels, seconds, params, beforeBlockFunc);
+			},
+		};
+	}
+
+	// トリガ付きのDSPに対し、一定間隔でトリガが発生するようupdateParams()を呼ぶ
+	template <typename DSP, typename DSPParams>
+	std::function<void(DSP&, std::size_t)> PeriodicTrigger(DSPParams params, float intervalSec)
+	{
+		return [params, intervalSec](DSP& dsp, std::size_t blockIdx) mutable
+		{
+			params.secUntilTrigger = intervalSec;
+			dsp.updateParams(params);
+		};
+	}
+
+	std::vector<BenchmarkCase> MakeCases()
+	{
+		std::vector<BenchmarkCase> cases;
+
+		{
+			const RetriggerEchoDSPParams params{ .updateTrigger = true, .waveLength = 0.125f, .rate = 0.7f, .mix = 1.0f };
+			cases.push_back(MakeCase<RetriggerEchoDSP>("Retrigger", params, PeriodicTrigger<RetriggerEchoDSP>(params, 0.5f)));
+		}
+		{
+			const RetriggerEchoDSPParams params{ .updateTrigger = true, .waveLength = 0.25f, .rate = 1.0f, .fadesOut = true, .feedbackLevel = 0.6f, .mix = 1.0f };
+			cases.push_back(MakeCase<RetriggerEchoDSP>("Echo", params, PeriodicTrigger<RetriggerEchoDSP>(params, 1.0f)));
+		}
+		{
+			const GateDSPParams params{ .waveLength = 0.125f, .rate = 0.5f, .mix = 0.9f };
+			cases.push_back(MakeCase<GateDSP>("Gate", params, PeriodicTrigger<GateDSP>(params, 0.5f)));
+		}
+		cases.push_back(MakeCase<FlangerDSP>("Flanger", FlangerDSPParams{}));
+		cases.push_back(MakeCase<BitcrusherDSP>("Bitcrusher", BitcrusherDSPParams{ .reduction = 10.0f, .mix = 1.0f }));
+		cases.push_back(MakeCase<PhaserDSP>("Phaser", PhaserDSPParams{}));
+		{
+			const WobbleDSPParams params{ .waveLength = 0.25f, .mix = 1.0f };
+			cases.push_back(MakeCase<WobbleDSP>("Wobble", params, PeriodicTrigger<WobbleDSP>(params, 1.0f)));
+		}
+		cases.push_back(MakeCase<TapestopDSP>("Tapestop", TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = false, .mix = 1.0f },
+			std::function<void(TapestopDSP&, std::size_t)>([](TapestopDSP& dsp, std::size_t blockIdx)
+			{
+				// 一定間隔(44.1kHzで約1秒)毎にテープストップをやり直す
+				constexpr std::size_t kResetIntervalBlocks = 44100U / kBlockFrames;
+				dsp.updateParams(TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = blockIdx % kResetIntervalBlocks == 0U, .mix = 1.0f });
+			})));
+		{
+			const SidechainDSPParams params{};
+			cases.push_back(MakeCase<SidechainDSP>("Sidechain", params, PeriodicTrigger<SidechainDSP>(params, 0.5f)));
+		}
+		cases.push_back(MakeCase<PeakingFilterDSP>("PeakingFilter", PeakingFilterDSPParams{ .v = 0.5f, .mix = 1.0f }));
+		cases.push_back(MakeCase<HighPassFilterDSP>("HighPassFilter", HighPassFilterDSPParams{ .v = 0.5f, .mix = 1.0f }));
+		cases.push_back(MakeCase<LowPassFilterDSP>("LowPassFilter", LowPassFilterDSPParams{ .v = 0.5f, .mix = 1.0f }));
+
+		return cases;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const double seconds = argc >= 2 ? std::atof(argv[1]) : 10.0;
+	const std::string filter = argc >= 3 ? argv[2] : "";
+	if (seconds <= 0.0)
+	{
+		std::fprintf(stderr, "Usage: %s [seconds] [dsp name filter]\n", argv[0]);
+		return 1;
+	}
+
+	std::printf("%-16s %8s %4s %12s %12s\n", "DSP", "rate", "ch", "ns/frame", "realtime");
+	for (const BenchmarkCase& benchmarkCase : MakeCases())
+	{
+		if (!filter.empty() && benchmarkCase.name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		for (const std::size_t sampleRate : kSampleRates)
+		{
+			for (const std::size_t numChannels : kNumChannelsList)
+			{
+				const BenchmarkResult result = benchmarkCase.run(sampleRate, numChannels, seconds);
+				std::printf("%-16s %8zu %4zu %12.2f %11.1fx\n", benchmarkCase.name.c_str(), sampleRate, numChannels, result.nsPerFrame, result.realtimeRatio);
+			}
+		}
+	}
+
+	return 0;
+}
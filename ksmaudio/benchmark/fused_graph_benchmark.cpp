@@ -0,0 +1,217 @@
+﻿// 音声エフェクトの処理方式のベンチマーク
+// BASSのDSPをエフェクトごとに登録する方式(per-effect)と、FusedAudioEffectGraphで1つのDSPにまとめる方式(fused)で、
+// 1ブロックの処理時間を比較する
+// (BASSを使用しないため、per-effectはBASSがDSPコールバックを順に呼ぶ処理を関数ポインタ経由の呼び出しで再現している。
+//  実際のper-effectではこれに加えてDSPコールバックごとにBASS_ChannelGetPositionの呼び出しが発生する)
+//
+// 使い方: ksmaudio_fused_graph_benchmark [計測する音声の長さ(秒、デフォルト10)]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <numbers>
+#include <set>
+#include <string>
+#include <vector>
+#include "ksmaudio/audio_effect/all.hpp"
+#include "ksmaudio/audio_effect/fused_audio_effect_graph.hpp"
+
+namespace
+{
+	using namespace ksmaudio;
+	using namespace ksmaudio::AudioEffect;
+
+	// 1回のDSPコールバックで処理するフレーム数
+	constexpr std::size_t kBlockFrames = 512U;
+
+	constexpr std::size_t kSampleRate = 44100U;
+
+	constexpr std::size_t kNumChannels = 2U;
+
+	// 計測前に処理する音声の長さ(秒)
+	constexpr double kWarmUpSec = 0.5;
+
+	constexpr float kReservedDelaySec = 2.0f;
+
+	// BASSのDSPコールバック(DSPPROC)と同じ形の関数
+	using DSPProc = void (*)(float* pData, std::size_t dataSize, void* user);
+
+	void ProcessAudioEffect(float* pData, std::size_t dataSize, void* user)
+	{
+		static_cast<IAudioEffect*>(user)->process(pData, dataSize, std::nullopt);
+	}
+
+	struct EffectEntry
+	{
+		std::string name;
+
+		std::unique_ptr<IAudioEffect> audioEffect;
+
+		int priority;
+	};
+
+	template <typename T>
+	void AddEffect(std::vector<EffectEntry>& entries, const std::string& name, detail::DelayLineArena* pDelayLineArena)
+	{
+		std::unique_ptr<IAudioEffect> audioEffect;
+		if constexpr (T::kIsWithTrigger)
+		{
+			audioEffect = std::make_unique<T>(kSampleRate, kNumChannels, false, pDelayLineArena, std::set<float>{});
+		}
+		else
+		{
+			audioEffect = std::make_unique<T>(kSampleRate, kNumChannels, false, pDelayLineArena);
+		}
+		audioEffect->reserveDelayTime(kReservedDelaySec);
+		entries.push_back({ .name = name, .audioEffect = std::move(audioEffect), .priority = T::kPriority });
+	}
+
+	// ゲーム中のFXのバスと同様に、全種類の音声エフェクトを追加する
+	std::vector<EffectEntry> MakeEffects(detail::DelayLineArena* pDelayLineArena)
+	{
+		std::vector<EffectEntry> entries;
+		AddEffect<Retrigger>(entries, "Retrigger", pDelayLineArena);
+		AddEffect<Gate>(entries, "Gate", pDelayLineArena);
+		AddEffect<Flanger>(entries, "Flanger", pDelayLineArena);
+		AddEffect<Bitcrusher>(entries, "Bitcrusher", pDelayLineArena);
+		AddEffect<Phaser>(entries, "Phaser", pDelayLineArena);
+		AddEffect<Wobble>(entries, "Wobble", pDelayLineArena);
+		AddEffect<Tapestop>(entries, "Tapestop", pDelayLineArena);
+		AddEffect<Echo>(entries, "Echo", pDelayLineArena);
+		AddEffect<Sidechain>(entries, "Sidechain", pDelayLineArena);
+		AddEffect<PeakingFilter>(entries, "PeakingFilter", pDelayLineArena);
+		AddEffect<HighPassFilter>(entries, "HighPassFilter", pDelayLineArena);
+		AddEffect<LowPassFilter>(entries, "LowPassFilter", pDelayLineArena);
+
+		// BASSと同様、priorityが大きいものから先に処理する
+		std::stable_sort(entries.begin(), entries.end(), [](const EffectEntry& a, const EffectEntry& b) { return a.priority > b.priority; });
+		return entries;
+	}
+
+	std::vector<float> MakeSyntheticSignal()
+	{
+		const std::size_t numFrames = kSampleRate; // 1秒分をループして使用する
+		std::vector<float> signal(numFrames * kNumChannels);
+		std::uint32_t seed = 12345U;
+		for (std::size_t i = 0U; i < numFrames; ++i)
+		{
+			const float t = static_cast<float>(i) / static_cast<float>(kSampleRate);
+			const float tone = 0.3f * std::sin(2.0f * std::numbers::pi_v<float> * 220.0f * t);
+			for (std::size_t ch = 0U; ch < kNumChannels; ++ch)
+			{
+				seed = seed * 1664525U + 1013904223U;
+				const float noise = static_cast<float>(seed >> 8) / static_cast<float>(1U << 24) * 2.0f - 1.0f;
+				signal[i * kNumChannels + ch] = tone + 0.2f * noise;
+			}
+		}
+		return signal;
+	}
+
+	// seconds秒分の音声を処理した時間を計測し、1ブロックあたりの平均処理時間(マイクロ秒)を返す
+	double Measure(double seconds, const std::function<void(float*, std::size_t)>& processFunc)
+	{
+		const std::vector<float> signal = MakeSyntheticSignal();
+		const std::size_t signalFrames = signal.size() / kNumChannels;
+		std::vector<float> block(kBlockFrames * kNumChannels);
+
+		const std::size_t numWarmUpBlocks = static_cast<std::size_t>(kWarmUpSec * kSampleRate / kBlockFrames);
+		const std::size_t numBlocks = (std::max)(static_cast<std::size_t>(seconds * kSampleRate / kBlockFrames), std::size_t{ 1U });
+		std::chrono::steady_clock::duration elapsed{};
+		for (std::size_t blockIdx = 0U; blockIdx < numWarmUpBlocks + numBlocks; ++blockIdx)
+		{
+			const std::size_t signalOffsetFrame = (blockIdx * kBlockFrames) % (signalFrames - kBlockFrames);
+			std::memcpy(block.data(), &signal[signalOffsetFrame * kNumChannels], sizeof(float) * block.size());
+
+			const auto startTime = std::chrono::steady_clock::now();
+			processFunc(block.data(), block.size());
+			if (blockIdx >= numWarmUpBlocks)
+			{
+				elapsed += std::chrono::steady_clock::now() - startTime;
+			}
+		}
+		return std::chrono::duration<double, std::micro>(elapsed).count() / static_cast<double>(numBlocks);
+	}
+
+	struct Scenario
+	{
+		std::string name;
+
+		// バイパスしない(使用中の)音声エフェクトの名前
+		std::set<std::string> activeEffectNames;
+	};
+
+	// 計測ごとにエフェクトの内部状態を揃えるため、方式ごとにエフェクトを作り直す
+	std::vector<EffectEntry> MakeScenarioEffects(const Scenario& scenario, detail::DelayLineArena* pDelayLineArena)
+	{
+		std::vector<EffectEntry> entries = MakeEffects(pDelayLineArena);
+		for (EffectEntry& entry : entries)
+		{
+			const bool isActive = scenario.activeEffectNames.contains(entry.name);
+			entry.audioEffect->updateStatusByFX(Status{ .sec = 0.0f }, isActive ? std::make_optional<std::size_t>(0U) : std::nullopt);
+			entry.audioEffect->setBypass(!isActive);
+		}
+		return entries;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const double seconds = argc >= 2 ? std::atof(argv[1]) : 10.0;
+	if (seconds <= 0.0)
+	{
+		std::fprintf(stderr, "Usage: %s [seconds]\n", argv[0]);
+		return 1;
+	}
+
+	const std::vector<Scenario> scenarios = {
+		{ .name = "no effect", .activeEffectNames = {} },
+		{ .name = "1 effect", .activeEffectNames = { "Flanger" } },
+		{ .name = "2 effects", .activeEffectNames = { "Retrigger", "PeakingFilter" } },
+		{ .name = "all effects", .activeEffectNames = { "Retrigger", "Gate", "Flanger", "Bitcrusher", "Phaser", "Wobble", "Tapestop", "Echo", "Sidechain", "PeakingFilter", "HighPassFilter", "LowPassFilter" } },
+	};
+
+	std::printf("%-12s %6s %16s %16s %8s\n", "scenario", "active", "per-effect(us)", "fused(us)", "ratio");
+	for (const Scenario& scenario : scenarios)
+	{
+		// per-effect: BASSと同様に、全ての音声エフェクトのDSPコールバックを順に呼ぶ
+		detail::DelayLineArena perEffectArena;
+		const std::vector<EffectEntry> perEffectEntries = MakeScenarioEffects(scenario, &perEffectArena);
+		std::vector<std::pair<DSPProc, void*>> dspProcs;
+		for (const EffectEntry& entry : perEffectEntries)
+		{
+			dspProcs.emplace_back(ProcessAudioEffect, entry.audioEffect.get());
+		}
+		const double perEffectUs = Measure(seconds, [&dspProcs](float* pData, std::size_t dataSize)
+			{
+				for (const auto& [dspProc, user] : dspProcs)
+				{
+					dspProc(pData, dataSize, user);
+				}
+			});
+
+		// fused: 1つのDSPコールバックからFusedAudioEffectGraphを処理する
+		detail::DelayLineArena fusedArena;
+		const std::vector<EffectEntry> fusedEntries = MakeScenarioEffects(scenario, &fusedArena);
+		FusedAudioEffectGraph graph;
+		for (const EffectEntry& entry : fusedEntries)
+		{
+			graph.add(entry.audioEffect.get(), entry.priority);
+		}
+		const DSPProc fusedDSPProc = [](float* pData, std::size_t dataSize, void* user)
+			{
+				static_cast<FusedAudioEffectGraph*>(user)->process(pData, dataSize, std::nullopt);
+			};
+		const double fusedUs = Measure(seconds, [&graph, fusedDSPProc](float* pData, std::size_t dataSize)
+			{
+				fusedDSPProc(pData, dataSize, &graph);
+			});
+
+		std::printf("%-12s %3zu/%-2zu %16.3f %16.3f %7.2fx\n", scenario.name.c_str(), scenario.activeEffectNames.size(), fusedEntries.size(), perEffectUs, fusedUs, fusedUs > 0.0 ? perEffectUs / fusedUs : 0.0);
+	}
+
+	return 0;
+}
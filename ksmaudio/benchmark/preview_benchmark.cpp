@@ -0,0 +1,152 @@
+﻿// 選曲画面の楽曲プレビュー音声の再生開始レイテンシのベンチマーク
+// 出力デバイスを使用せずにBASSを初期化し、プレビュー開始時に行う処理(ストリームの作成・シーク・最初のブロックのデコード)にかかる時間を、
+// ファイルから直接再生する場合とメモリ上のデコード済みのプレビュー範囲から再生する場合とで比較する
+//
+// 使い方: ksmaudio_preview_benchmark <音声ファイル> [プレビューのオフセット(秒、デフォルト30)] [プレビューの再生時間(秒、デフォルト15)] [試行回数(デフォルト20)]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ksmaudio/ksmaudio.hpp"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// プレビュー開始時にデコードされる最初のブロックのフレーム数
+	constexpr std::size_t kFirstBlockFrames = 512U;
+
+	struct LatencyStats
+	{
+		double meanMs;
+
+		double p50Ms;
+
+		double p99Ms;
+
+		double maxMs;
+	};
+
+	LatencyStats MakeStats(std::vector<double> samplesMs)
+	{
+		std::sort(samplesMs.begin(), samplesMs.end());
+		double sumMs = 0.0;
+		for (const double ms : samplesMs)
+		{
+			sumMs += ms;
+		}
+		const auto percentile = [&samplesMs](double rate)
+			{
+				const std::size_t idx = std::min(static_cast<std::size_t>(rate * samplesMs.size()), samplesMs.size() - 1U);
+				return samplesMs[idx];
+			};
+		return {
+			.meanMs = sumMs / samplesMs.size(),
+			.p50Ms = percentile(0.5),
+			.p99Ms = percentile(0.99),
+			.maxMs = samplesMs.back(),
+		};
+	}
+
+	// funcをnumIterations回実行し、1回あたりの所要時間を計測する
+	LatencyStats Measure(int numIterations, const std::function<bool()>& func)
+	{
+		std::vector<double> samplesMs;
+		samplesMs.reserve(numIterations);
+		for (int i = 0; i < numIterations; ++i)
+		{
+			const auto startTime = Clock::now();
+			if (!func())
+			{
+				return {};
+			}
+			samplesMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+		}
+		return MakeStats(std::move(samplesMs));
+	}
+
+	// プレビュー開始時の処理を再現する
+	// (再生用のストリームの代わりにデコード専用のストリームを作成し、最初のブロックのデコードまでを行う)
+	bool StartPreview(const ksmaudio::Stream& stream, ksmaudio::SecondsF offset)
+	{
+		if (stream.numChannels() == 0U)
+		{
+			return false;
+		}
+		stream.seekPosSec(offset);
+		std::vector<float> block(kFirstBlockFrames * stream.numChannels());
+		return stream.readDecodedData(block.data(), block.size()) > 0U;
+	}
+
+	void PrintStats(const char* name, const LatencyStats& stats)
+	{
+		std::printf("%-24s %10.3f %10.3f %10.3f %10.3f\n", name, stats.meanMs, stats.p50Ms, stats.p99Ms, stats.maxMs);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::fprintf(stderr, "Usage: %s <audio file> [offset sec] [duration sec] [iterations]\n", argv[0]);
+		return 1;
+	}
+	const std::string filePath = argv[1];
+	const ksmaudio::SecondsF offset{ argc >= 3 ? std::atof(argv[2]) : 30.0 };
+	const ksmaudio::SecondsF duration{ argc >= 4 ? std::atof(argv[3]) : 15.0 };
+	const int numIterations = argc >= 5 ? std::atoi(argv[4]) : 20;
+	if (duration <= ksmaudio::SecondsF::zero() || numIterations <= 0)
+	{
+		std::fprintf(stderr, "Usage: %s <audio file> [offset sec] [duration sec] [iterations]\n", argv[0]);
+		return 1;
+	}
+
+	ksmaudio::InitNoSound();
+
+	// バックグラウンドで行うプレビュー範囲のデコード(カーソル移動時の事前デコードに相当)
+	std::shared_ptr<const std::vector<char>> binary;
+	const LatencyStats decodeStats = Measure(numIterations, [&]
+		{
+			const ksmaudio::DecodedAudio decoded = ksmaudio::DecodeRange(filePath, offset, duration);
+			if (decoded.data.empty())
+			{
+				return false;
+			}
+			binary = std::make_shared<const std::vector<char>>(ksmaudio::EncodeWAV(decoded.data, decoded.sampleRate, decoded.numChannels));
+			return true;
+		});
+	if (binary == nullptr)
+	{
+		std::fprintf(stderr, "Could not decode '%s'\n", filePath.c_str());
+		ksmaudio::Terminate();
+		return 1;
+	}
+
+	// プレビュー開始(ファイルから直接再生する場合)
+	const LatencyStats fileStats = Measure(numIterations, [&]
+		{
+			const ksmaudio::Stream stream(filePath, 1.0, true, false, false, true);
+			return StartPreview(stream, offset);
+		});
+
+	// プレビュー開始(メモリ上のデコード済みのプレビュー範囲から再生する場合)
+	const LatencyStats memoryStats = Measure(numIterations, [&]
+		{
+			const ksmaudio::Stream stream(binary, 1.0, false, false, true);
+			return StartPreview(stream, ksmaudio::SecondsF::zero());
+		});
+
+	std::printf("%-24s %10s %10s %10s %10s\n", "", "mean(ms)", "p50(ms)", "p99(ms)", "max(ms)");
+	PrintStats("start (file)", fileStats);
+	PrintStats("start (memory)", memoryStats);
+	PrintStats("decode range (bg)", decodeStats);
+	std::printf("preview binary size: %.1f MiB\n", binary->size() / (1024.0 * 1024.0));
+
+	ksmaudio::Terminate();
+
+	return 0;
+}
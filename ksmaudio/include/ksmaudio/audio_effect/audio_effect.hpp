@@ -1,11 +1,13 @@
 ﻿#pragma once
 #include <array>
 #include <memory>
-#include <mutex>
+#include <optional>
+#include <cstdint>
 #include <cassert>
-#include "bass.h"
 #include "audio_effect_param.hpp"
 #include "detail/update_trigger_timeline.hpp"
+#include "detail/dsp_params_handoff.hpp"
+#include "detail/delay_line_arena.hpp"
 
 namespace ksmaudio::AudioEffect
 {
@@ -14,7 +16,8 @@ namespace ksmaudio::AudioEffect
 	public:
 		virtual ~IAudioEffect() = default;
 
-		virtual void process(float* pData, std::size_t dataSize) = 0;
+		// blockStartFrameはブロック先頭のストリーム上の位置(フレーム数)。不明な場合はstd::nullopt
+		virtual void process(float* pData, std::size_t dataSize, std::optional<std::int64_t> blockStartFrame) = 0;
 
 		virtual void updateStatusByFX(const Status& status, std::optional<std::size_t> laneIdx) = 0;
 
@@ -25,6 +28,14 @@ namespace ksmaudio::AudioEffect
 		virtual std::unordered_map<ParamID, ValueSet> paramValueSetDict() const = 0;
 
 		virtual void setBypass(bool bypass) = 0;
+
+		// 譜面中で使用される最大のディレイタイム(秒)をもとに、遅延バッファを事前に確保する
+		// (遅延バッファを使用しない音声エフェクトでは何もしない)
+		// Note: DSPコールバックと同時に実行されないよう、呼び出し側でチャンネルをロックした状態で呼ぶこと
+		virtual void reserveDelayTime(float maxDelaySec) = 0;
+
+		// 譜面上の時間(Status::sec)をストリーム上の時間に変換する際に加算するオフセット(秒)を設定する
+		virtual void setStreamTimeOffset(double offsetSec) = 0;
 	};
 
 	struct DSPCommonInfo
@@ -39,12 +50,16 @@ namespace ksmaudio::AudioEffect
 
 		std::size_t numChannels;
 
-		constexpr DSPCommonInfo(std::size_t sampleRate, std::size_t numChannels)
+		// 遅延バッファの確保元(同じストリームの音声エフェクト間で共有)
+		detail::DelayLineArena* pDelayLineArena;
+
+		constexpr DSPCommonInfo(std::size_t sampleRate, std::size_t numChannels, detail::DelayLineArena* pDelayLineArena)
 			: isUnsupported(numChannels == 0U || numChannels >= 3U) // Supports stereo and mono only
 			, sampleRate(sampleRate)
 			, sampleRateFloat(static_cast<float>(sampleRate))
 			, sampleRateScale(sampleRate / 44100.0f)
 			, numChannels(numChannels)
+			, pDelayLineArena(pDelayLineArena)
 		{
 		}
 	};
@@ -57,16 +72,17 @@ namespace ksmaudio::AudioEffect
 		bool m_bypass = false;
 		Params m_params;
 		DSPParams m_dspParams;
-		DSP m_dsp;
-		std::mutex m_mutex;
+		DSP m_dsp; // updateParams()・process()はDSPスレッドからのみ呼ぶ
+		detail::DSPParamsHandoff<DSPParams> m_handoff;
 
 	public:
 		static constexpr bool kIsWithTrigger = false;
 		static constexpr int kPriority = Priority;
 
-		BasicAudioEffect(std::size_t sampleRate, std::size_t numChannels, bool isLaser)
+		BasicAudioEffect(std::size_t sampleRate, std::size_t numChannels, bool isLaser, detail::DelayLineArena* pDelayLineArena)
 			: m_isLaser(isLaser)
-			, m_dsp(DSPCommonInfo{ sampleRate, numChannels })
+			, m_dsp(DSPCommonInfo{ sampleRate, numChannels, pDelayLineArena })
+			, m_handoff(sampleRate, numChannels)
 		{
 			if (isLaser)
 			{
@@ -81,36 +97,33 @@ namespace ksmaudio::AudioEffect
 		virtual ~BasicAudioEffect() = default;
 
 		// この関数のみ他の関数とは別のスレッドからも呼ばれるので注意
-		virtual void process(float* pData, std::size_t dataSize) override
+		// (ゲームスレッド側とはm_handoffを介してのみやり取りするため、ロック不要)
+		virtual void process(float* pData, std::size_t dataSize, std::optional<std::int64_t> blockStartFrame) override
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-
-			m_dsp.process(pData, dataSize, m_bypass, m_dspParams);
+			m_handoff.process(m_dsp, pData, dataSize, blockStartFrame);
 		}
 
 		virtual void updateStatusByFX(const Status& status, std::optional<std::size_t> laneIdx) override
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-
 			assert(!m_isLaser);
 
 			m_dspParams = m_params.renderByFX(status, laneIdx);
-			m_dsp.updateParams(m_dspParams);
+			const bool isIdle = m_dsp.isIdle(m_bypass, m_dspParams);
+			m_handoff.publish(m_dspParams, m_bypass, status.sec, isIdle);
 		}
 
 		virtual void updateStatusByLaser(const Status& status, bool isOn) override
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-
 			assert(m_isLaser);
 
 			m_dspParams = m_params.renderByLaser(status, isOn);
-			m_dsp.updateParams(m_dspParams);
+			const bool isIdle = m_dsp.isIdle(m_bypass, m_dspParams);
+			m_handoff.publish(m_dspParams, m_bypass, status.sec, isIdle);
 		}
 
 		virtual void setParamValueSet(ParamID paramID, const ValueSet& valueSet) override
 		{
-			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでlock_guard不要
+			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでスレッド間の受け渡し不要
 
 			if (m_params.dict.contains(paramID))
 			{
@@ -120,7 +133,7 @@ namespace ksmaudio::AudioEffect
 
 		virtual std::unordered_map<ParamID, ValueSet> paramValueSetDict() const override
 		{
-			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでlock_guard不要
+			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでスレッド間の受け渡し不要
 
 			std::unordered_map<ParamID, ValueSet> dict;
 			for (const auto& [paramID, pParam] : m_params.dict)
@@ -134,11 +147,24 @@ namespace ksmaudio::AudioEffect
 		{
 			if (m_bypass != bypass)
 			{
-				std::lock_guard<std::mutex> lock(m_mutex);
-
 				m_bypass = bypass;
+				const bool isIdle = m_dsp.isIdle(m_bypass, m_dspParams);
+				m_handoff.publishBypass(m_dspParams, m_bypass, isIdle);
 			}
 		}
+
+		virtual void reserveDelayTime(float maxDelaySec) override
+		{
+			if constexpr (requires { m_dsp.reserveDelayTime(maxDelaySec); })
+			{
+				m_dsp.reserveDelayTime(maxDelaySec);
+			}
+		}
+
+		virtual void setStreamTimeOffset(double offsetSec) override
+		{
+			m_handoff.setStreamTimeOffset(offsetSec);
+		}
 	};
 
 	template <typename Params, typename DSP, typename DSPParams, int Priority>
@@ -149,18 +175,19 @@ namespace ksmaudio::AudioEffect
 		bool m_bypass = false;
 		Params m_params;
 		DSPParams m_dspParams;
-		DSP m_dsp;
+		DSP m_dsp; // updateParams()・process()はDSPスレッドからのみ呼ぶ
 		detail::UpdateTriggerTimeline m_updateTriggerTimeline;
-		std::mutex m_mutex;
+		detail::DSPParamsHandoff<DSPParams> m_handoff;
 
 	public:
 		static constexpr bool kIsWithTrigger = true;
 		static constexpr int kPriority = Priority;
 
-		BasicAudioEffectWithTrigger(std::size_t sampleRate, std::size_t numChannels, bool isLaser, const std::set<float>& updateTriggerTiming)
+		BasicAudioEffectWithTrigger(std::size_t sampleRate, std::size_t numChannels, bool isLaser, detail::DelayLineArena* pDelayLineArena, const std::set<float>& updateTriggerTiming)
 			: m_isLaser(isLaser)
-			, m_dsp(DSPCommonInfo{ sampleRate, numChannels })
+			, m_dsp(DSPCommonInfo{ sampleRate, numChannels, pDelayLineArena })
 			, m_updateTriggerTimeline(updateTriggerTiming)
+			, m_handoff(sampleRate, numChannels)
 		{
 			if (isLaser)
 			{
@@ -175,17 +202,14 @@ namespace ksmaudio::AudioEffect
 		virtual ~BasicAudioEffectWithTrigger() = default;
 
 		// この関数のみ他の関数とは別のスレッドからも呼ばれるので注意
-		virtual void process(float* pData, std::size_t dataSize) override
+		// (ゲームスレッド側とはm_handoffを介してのみやり取りするため、ロック不要)
+		virtual void process(float* pData, std::size_t dataSize, std::optional<std::int64_t> blockStartFrame) override
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-
-			m_dsp.process(pData, dataSize, m_bypass, m_dspParams);
+			m_handoff.process(m_dsp, pData, dataSize, blockStartFrame);
 		}
 
 		virtual void updateStatusByFX(const Status& status, std::optional<std::size_t> laneIdx) override
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-
 			assert(!m_isLaser);
 
 			m_dspParams = m_params.renderByFX(status, laneIdx);
@@ -193,13 +217,12 @@ namespace ksmaudio::AudioEffect
 			m_updateTriggerTimeline.update(status.sec);
 			m_dspParams.secUntilTrigger = m_updateTriggerTimeline.secUntilTrigger();
 
-			m_dsp.updateParams(m_dspParams);
+			const bool isIdle = m_dsp.isIdle(m_bypass, m_dspParams);
+			m_handoff.publish(m_dspParams, m_bypass, status.sec, isIdle);
 		}
 
 		virtual void updateStatusByLaser(const Status& status, bool isOn) override
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-
 			assert(m_isLaser);
 
 			m_dspParams = m_params.renderByLaser(status, isOn);
@@ -207,12 +230,13 @@ namespace ksmaudio::AudioEffect
 			m_updateTriggerTimeline.update(status.sec);
 			m_dspParams.secUntilTrigger = m_updateTriggerTimeline.secUntilTrigger();
 
-			m_dsp.updateParams(m_dspParams);
+			const bool isIdle = m_dsp.isIdle(m_bypass, m_dspParams);
+			m_handoff.publish(m_dspParams, m_bypass, status.sec, isIdle);
 		}
 
 		virtual void setParamValueSet(ParamID paramID, const ValueSet& valueSet) override
 		{
-			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでlock_guard不要
+			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでスレッド間の受け渡し不要
 
 			if (m_params.dict.contains(paramID))
 			{
@@ -222,7 +246,7 @@ namespace ksmaudio::AudioEffect
 
 		virtual std::unordered_map<ParamID, ValueSet> paramValueSetDict() const override
 		{
-			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでlock_guard不要
+			// updateStatusと同じスレッドで実行され、processとの同一変数操作もないのでスレッド間の受け渡し不要
 
 			std::unordered_map<ParamID, ValueSet> dict;
 			for (const auto& [paramID, pParam] : m_params.dict)
@@ -236,10 +260,23 @@ namespace ksmaudio::AudioEffect
 		{
 			if (m_bypass != bypass)
 			{
-				std::lock_guard<std::mutex> lock(m_mutex);
-
 				m_bypass = bypass;
+				const bool isIdle = m_dsp.isIdle(m_bypass, m_dspParams);
+				m_handoff.publishBypass(m_dspParams, m_bypass, isIdle);
 			}
 		}
+
+		virtual void reserveDelayTime(float maxDelaySec) override
+		{
+			if constexpr (requires { m_dsp.reserveDelayTime(maxDelaySec); })
+			{
+				m_dsp.reserveDelayTime(maxDelaySec);
+			}
+		}
+
+		virtual void setStreamTimeOffset(double offsetSec) override
+		{
+			m_handoff.setStreamTimeOffset(offsetSec);
+		}
 	};
 }
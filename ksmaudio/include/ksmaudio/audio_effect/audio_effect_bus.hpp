@@ -9,6 +9,7 @@
 #include "bass.h"
 #include "audio_effect.hpp"
 #include "param_controller.hpp"
+#include "fused_audio_effect_graph.hpp"
 #include "ksmaudio/stream.hpp"
 
 namespace ksmaudio::AudioEffect
@@ -28,14 +29,17 @@ namespace ksmaudio::AudioEffect
 	private:
 		const bool m_isLaser; // TODO: なるべく型で区別したい
 		Stream* const m_pStream;
+		detail::DelayLineArena* const m_pDelayLineArena;
+		FusedAudioEffectGraph* const m_pFusedGraph; // nullptrの場合はエフェクト毎にDSPを登録する
 		std::vector<std::unique_ptr<AudioEffect::IAudioEffect>> m_audioEffects;
 		std::vector<HDSP> m_hDSPs;
 		std::vector<ParamController> m_paramControllers;
 		std::unordered_map<std::string, std::size_t> m_nameIdxDict;
 		std::unordered_set<std::size_t> m_activeAudioEffectIdxs;
+		double m_streamTimeOffsetSec = 0.0;
 
 	public:
-		AudioEffectBus(bool isLaser, Stream* pStream);
+		AudioEffectBus(bool isLaser, Stream* pStream, detail::DelayLineArena* pDelayLineArena, FusedAudioEffectGraph* pFusedGraph = nullptr);
 
 		~AudioEffectBus();
 
@@ -60,13 +64,14 @@ namespace ksmaudio::AudioEffect
 
 			if constexpr (T::kIsWithTrigger)
 			{
-				m_audioEffects.push_back(std::make_unique<T>(m_pStream->sampleRate(), m_pStream->numChannels(), m_isLaser, updateTriggerTiming));
+				m_audioEffects.push_back(std::make_unique<T>(m_pStream->sampleRate(), m_pStream->numChannels(), m_isLaser, m_pDelayLineArena, updateTriggerTiming));
 			}
 			else
 			{
-				m_audioEffects.push_back(std::make_unique<T>(m_pStream->sampleRate(), m_pStream->numChannels(), m_isLaser));
+				m_audioEffects.push_back(std::make_unique<T>(m_pStream->sampleRate(), m_pStream->numChannels(), m_isLaser, m_pDelayLineArena));
 			}
 			const auto& audioEffect = m_audioEffects.back();
+			audioEffect->setStreamTimeOffset(m_streamTimeOffsetSec);
 
 			for (const auto& [paramID, valueSet] : params)
 			{
@@ -75,8 +80,18 @@ namespace ksmaudio::AudioEffect
 
 			m_nameIdxDict.emplace(name, m_audioEffects.size() - 1U);
 
-			const HDSP hDSP = m_pStream->addAudioEffect(audioEffect.get(), T::kPriority);
-			m_hDSPs.push_back(hDSP);
+			if (m_pFusedGraph != nullptr)
+			{
+				// DSPコールバックと同時に実行されないようロックした上でグラフに追加
+				m_pStream->lockBegin();
+				m_pFusedGraph->add(audioEffect.get(), T::kPriority);
+				m_pStream->lockEnd();
+			}
+			else
+			{
+				const HDSP hDSP = m_pStream->addAudioEffect(audioEffect.get(), T::kPriority);
+				m_hDSPs.push_back(hDSP);
+			}
 
 			// ここで、paramsを渡すのではなくparamValueSetDict()で改めて取得しているのは、Dict内に暗黙に定義されるデフォルト値も入れる必要があるため
 			m_paramControllers.emplace_back(audioEffect->paramValueSetDict(), paramChanges);
@@ -94,6 +109,13 @@ namespace ksmaudio::AudioEffect
 
 		void setBypass(bool bypass);
 
+		// 譜面上の時間をストリーム上の時間に変換する際に加算するオフセット(秒)を設定する
+		// (パラメータの変更をストリーム上の位置で適用するため、BGMのオフセットを指定する)
+		void setStreamTimeOffset(double offsetSec);
+
+		// 譜面中で使用される最大のディレイタイム(秒)をもとに、遅延バッファを事前に確保する
+		void reserveDelayTime(std::size_t audioEffectIdx, float maxDelaySec);
+
 		bool audioEffectContainsName(const std::string& name) const;
 
 		std::size_t audioEffectNameToIdx(const std::string& name) const;
@@ -1,41 +1,39 @@
 ﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cassert>
+#include <cstddef>
 #include <numbers>
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define KSMAUDIO_BIQUAD_FILTER_SSE2
+#include <xmmintrin.h>
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+#define KSMAUDIO_BIQUAD_FILTER_NEON
+#include <arm_neon.h>
+#endif
+
 namespace ksmaudio::AudioEffect::detail
 {
+    // a0で正規化済みのBiquadフィルタ係数
+    // (処理時にサンプル毎の除算が発生しないよう、係数の設定時に正規化しておく)
     template <typename T>
-    class BiquadFilter
+    struct BiquadCoefficients
     {
-    private:
-        T m_a0 = T{ 1 };
-        T m_a1 = T{ 0 };
-        T m_a2 = T{ 0 };
-        T m_b0 = T{ 1 };
-        T m_b1 = T{ 0 };
-        T m_b2 = T{ 0 };
-        T m_input1 = T{ 0 };
-        T m_input2 = T{ 0 };
-        T m_output1 = T{ 0 };
-        T m_output2 = T{ 0 };
+        T b0 = T{ 1 };
+        T b1 = T{ 0 };
+        T b2 = T{ 0 };
+        T a1 = T{ 0 };
+        T a2 = T{ 0 };
 
-    public:
-        BiquadFilter() = default;
-
-        T process(T input)
+        void set(T a0, T a1Value, T a2Value, T b0Value, T b1Value, T b2Value)
         {
-            const T output
-                = m_b0 / m_a0 * input
-                + m_b1 / m_a0 * m_input1
-                + m_b2 / m_a0 * m_input2
-                - m_a1 / m_a0 * m_output1
-                - m_a2 / m_a0 * m_output2;
-
-            m_input2 = m_input1;
-            m_input1 = input;
-            m_output2 = m_output1;
-            m_output1 = output;
-
-            return output;
+            b0 = b0Value / a0;
+            b1 = b1Value / a0;
+            b2 = b2Value / a0;
+            a1 = a1Value / a0;
+            a2 = a2Value / a0;
         }
 
         void setLowPassFilter(T freq, T q, T sampleRate)
@@ -44,12 +42,13 @@ namespace ksmaudio::AudioEffect::detail
             const T alpha = std::sin(omega) / (q * 2);
 
             const T cosOmega = std::cos(omega);
-            m_a0 = T{ 1 } + alpha;
-            m_a1 = -T{ 2 } * cosOmega;
-            m_a2 = T{ 1 } - alpha;
-            m_b0 = (T{ 1 } - cosOmega) / 2;
-            m_b1 = T{ 1 } - cosOmega;
-            m_b2 = (T{ 1 } - cosOmega) / 2;
+            set(
+                T{ 1 } + alpha,
+                -T{ 2 } * cosOmega,
+                T{ 1 } - alpha,
+                (T{ 1 } - cosOmega) / 2,
+                T{ 1 } - cosOmega,
+                (T{ 1 } - cosOmega) / 2);
         }
 
         void setLowShelfFilter(T freq, T q, T gainDb, T sampleRate)
@@ -60,12 +59,13 @@ namespace ksmaudio::AudioEffect::detail
 
             const T sinOmega = std::sin(omega);
             const T cosOmega = std::cos(omega);
-            m_a0 = (A + T{ 1 }) + (A - T{ 1 }) * cosOmega + beta * sinOmega;
-            m_a1 = -T{ 2 } * ((A - T{ 1 }) + (A + T{ 1 }) * cosOmega);
-            m_a2 = (A + T{ 1 }) + (A - T{ 1 }) * cosOmega - beta * sinOmega;
-            m_b0 = A * ((A + T{ 1 }) - (A - T{ 1 }) * cosOmega + beta * sinOmega);
-            m_b1 = T{ 2 } * A * ((A - T{ 1 }) - (A + T{ 1 }) * cosOmega);
-            m_b2 = A * ((A + T{ 1 }) - (A - T{ 1 }) * cosOmega - beta * sinOmega);
+            set(
+                (A + T{ 1 }) + (A - T{ 1 }) * cosOmega + beta * sinOmega,
+                -T{ 2 } * ((A - T{ 1 }) + (A + T{ 1 }) * cosOmega),
+                (A + T{ 1 }) + (A - T{ 1 }) * cosOmega - beta * sinOmega,
+                A * ((A + T{ 1 }) - (A - T{ 1 }) * cosOmega + beta * sinOmega),
+                T{ 2 } * A * ((A - T{ 1 }) - (A + T{ 1 }) * cosOmega),
+                A * ((A + T{ 1 }) - (A - T{ 1 }) * cosOmega - beta * sinOmega));
         }
 
         void setHighPassFilter(T freq, T q, T sampleRate)
@@ -74,12 +74,13 @@ namespace ksmaudio::AudioEffect::detail
             const T alpha = std::sin(omega) / (q * 2);
 
             const T cosOmega = std::cos(omega);
-            m_a0 = T{ 1 } + alpha;
-            m_a1 = -T{ 2 } * cosOmega;
-            m_a2 = T{ 1 } - alpha;
-            m_b0 = (T{ 1 } + cosOmega) / 2;
-            m_b1 = -T{ 1 } - cosOmega;
-            m_b2 = (T{ 1 } + cosOmega) / 2;
+            set(
+                T{ 1 } + alpha,
+                -T{ 2 } * cosOmega,
+                T{ 1 } - alpha,
+                (T{ 1 } + cosOmega) / 2,
+                -T{ 1 } - cosOmega,
+                (T{ 1 } + cosOmega) / 2);
         }
 
         void setHighShelfFilter(T freq, T q, T gainDb, T sampleRate)
@@ -90,12 +91,13 @@ namespace ksmaudio::AudioEffect::detail
 
             const T sinOmega = std::sin(omega);
             const T cosOmega = std::cos(omega);
-            m_a0 = (A + T{ 1 }) - (A - T{ 1 }) * cosOmega + beta * sinOmega;
-            m_a1 = T{ 2 } *((A - T{ 1 }) - (A + T{ 1 }) * cosOmega);
-            m_a2 = (A + T{ 1 }) - (A - T{ 1 }) * cosOmega - beta * sinOmega;
-            m_b0 = A * ((A + T{ 1 }) + (A - T{ 1 }) * cosOmega + beta * sinOmega);
-            m_b1 = -T{ 2 } * A * ((A - T{ 1 }) + (A + T{ 1 }) * cosOmega);
-            m_b2 = A * ((A + T{ 1 }) + (A - T{ 1 }) * cosOmega - beta * sinOmega);
+            set(
+                (A + T{ 1 }) - (A - T{ 1 }) * cosOmega + beta * sinOmega,
+                T{ 2 } * ((A - T{ 1 }) - (A + T{ 1 }) * cosOmega),
+                (A + T{ 1 }) - (A - T{ 1 }) * cosOmega - beta * sinOmega,
+                A * ((A + T{ 1 }) + (A - T{ 1 }) * cosOmega + beta * sinOmega),
+                -T{ 2 } * A * ((A - T{ 1 }) + (A + T{ 1 }) * cosOmega),
+                A * ((A + T{ 1 }) + (A - T{ 1 }) * cosOmega - beta * sinOmega));
         }
 
         void setPeakingFilter(T freq, T bandwidth, T gainDb, T sampleRate)
@@ -105,12 +107,13 @@ namespace ksmaudio::AudioEffect::detail
             const T A = std::pow(T{ 10 }, gainDb / 40);
 
             const T cosOmega = std::cos(omega);
-            m_a0 = T{ 1 } + alpha / A;
-            m_a1 = -T{ 2 } * cosOmega;
-            m_a2 = T{ 1 } - alpha / A;
-            m_b0 = T{ 1 } + alpha * A;
-            m_b1 = -T{ 2 } * cosOmega;
-            m_b2 = T{ 1 } - alpha * A;
+            set(
+                T{ 1 } + alpha / A,
+                -T{ 2 } * cosOmega,
+                T{ 1 } - alpha / A,
+                T{ 1 } + alpha * A,
+                -T{ 2 } * cosOmega,
+                T{ 1 } - alpha * A);
         }
 
         void setAllPassFilter(T freq, T q, T sampleRate)
@@ -119,12 +122,482 @@ namespace ksmaudio::AudioEffect::detail
             const T alpha = std::sin(omega) / (q * 2);
 
             const T cosOmega = std::cos(omega);
-            m_a0 = T{ 1 } + alpha;
-            m_a1 = -T{ 2 } * cosOmega;
-            m_a2 = T{ 1 } - alpha;
-            m_b0 = T{ 1 } - alpha;
-            m_b1 = -T{ 2 } * cosOmega;
-            m_b2 = T{ 1 } + alpha;
+            set(
+                T{ 1 } + alpha,
+                -T{ 2 } * cosOmega,
+                T{ 1 } - alpha,
+                T{ 1 } - alpha,
+                -T{ 2 } * cosOmega,
+                T{ 1 } + alpha);
+        }
+    };
+
+    template <typename T>
+    class BiquadFilter
+    {
+    private:
+        BiquadCoefficients<T> m_coefs;
+        T m_input1 = T{ 0 };
+        T m_input2 = T{ 0 };
+        T m_output1 = T{ 0 };
+        T m_output2 = T{ 0 };
+
+    public:
+        BiquadFilter() = default;
+
+        T process(T input)
+        {
+            const T output
+                = m_coefs.b0 * input
+                + m_coefs.b1 * m_input1
+                + m_coefs.b2 * m_input2
+                - m_coefs.a1 * m_output1
+                - m_coefs.a2 * m_output2;
+
+            m_input2 = m_input1;
+            m_input1 = input;
+            m_output2 = m_output1;
+            m_output1 = output;
+
+            return output;
+        }
+
+        void setCoefficients(const BiquadCoefficients<T>& coefs)
+        {
+            m_coefs = coefs;
+        }
+
+        void setLowPassFilter(T freq, T q, T sampleRate)
+        {
+            m_coefs.setLowPassFilter(freq, q, sampleRate);
+        }
+
+        void setLowShelfFilter(T freq, T q, T gainDb, T sampleRate)
+        {
+            m_coefs.setLowShelfFilter(freq, q, gainDb, sampleRate);
+        }
+
+        void setHighPassFilter(T freq, T q, T sampleRate)
+        {
+            m_coefs.setHighPassFilter(freq, q, sampleRate);
+        }
+
+        void setHighShelfFilter(T freq, T q, T gainDb, T sampleRate)
+        {
+            m_coefs.setHighShelfFilter(freq, q, gainDb, sampleRate);
+        }
+
+        void setPeakingFilter(T freq, T bandwidth, T gainDb, T sampleRate)
+        {
+            m_coefs.setPeakingFilter(freq, bandwidth, gainDb, sampleRate);
+        }
+
+        void setAllPassFilter(T freq, T q, T sampleRate)
+        {
+            m_coefs.setAllPassFilter(freq, q, sampleRate);
+        }
+    };
+
+    // フィルタ係数を制御レートで更新する際の更新間隔(フレーム数)
+    // (更新間の各フレームでは係数を線形補間する)
+    constexpr std::size_t kBiquadControlRateFrames = 32U;
+
+    namespace StereoLanes
+    {
+        // 左右チャンネルを2レーンとして扱うSIMD演算
+        // (融合積和は使用しない。各レーンの結果はfloatのスカラー演算と一致する)
+#if defined(KSMAUDIO_BIQUAD_FILTER_SSE2)
+        using Lanes = __m128;
+
+        inline Lanes Load(const float* p)
+        {
+            return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+        }
+
+        inline Lanes Load1(const float* p)
+        {
+            return _mm_load_ss(p);
+        }
+
+        inline void Store(float* p, Lanes v)
+        {
+            _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+        }
+
+        inline void Store1(float* p, Lanes v)
+        {
+            _mm_store_ss(p, v);
+        }
+
+        inline Lanes Add(Lanes a, Lanes b)
+        {
+            return _mm_add_ps(a, b);
+        }
+
+        inline Lanes Sub(Lanes a, Lanes b)
+        {
+            return _mm_sub_ps(a, b);
+        }
+
+        inline Lanes Mul(Lanes a, Lanes b)
+        {
+            return _mm_mul_ps(a, b);
+        }
+#elif defined(KSMAUDIO_BIQUAD_FILTER_NEON)
+        using Lanes = float32x2_t;
+
+        inline Lanes Load(const float* p)
+        {
+            return vld1_f32(p);
+        }
+
+        inline Lanes Load1(const float* p)
+        {
+            return vset_lane_f32(*p, vdup_n_f32(0.0f), 0);
+        }
+
+        inline void Store(float* p, Lanes v)
+        {
+            vst1_f32(p, v);
+        }
+
+        inline void Store1(float* p, Lanes v)
+        {
+            vst1_lane_f32(p, v, 0);
+        }
+
+        inline Lanes Add(Lanes a, Lanes b)
+        {
+            return vadd_f32(a, b);
+        }
+
+        inline Lanes Sub(Lanes a, Lanes b)
+        {
+            return vsub_f32(a, b);
+        }
+
+        inline Lanes Mul(Lanes a, Lanes b)
+        {
+            return vmul_f32(a, b);
+        }
+#else
+        struct Lanes
+        {
+            float l;
+            float r;
+        };
+
+        inline Lanes Load(const float* p)
+        {
+            return { p[0], p[1] };
+        }
+
+        inline Lanes Load1(const float* p)
+        {
+            return { p[0], 0.0f };
+        }
+
+        inline void Store(float* p, Lanes v)
+        {
+            p[0] = v.l;
+            p[1] = v.r;
+        }
+
+        inline void Store1(float* p, Lanes v)
+        {
+            p[0] = v.l;
+        }
+
+        inline Lanes Add(Lanes a, Lanes b)
+        {
+            return { a.l + b.l, a.r + b.r };
+        }
+
+        inline Lanes Sub(Lanes a, Lanes b)
+        {
+            return { a.l - b.l, a.r - b.r };
+        }
+
+        inline Lanes Mul(Lanes a, Lanes b)
+        {
+            return { a.l * b.l, a.r * b.r };
+        }
+#endif
+    }
+
+    // インターリーブされたステレオ(またはモノラル)の音声に対するBiquadフィルタ
+    // 左右チャンネルをSIMDレジスタの2レーンに載せて同時に処理する
+    // (各レーンの演算順序はBiquadFilter<float>::process()と同一のため、同じ係数であれば結果も一致する)
+    class StereoBiquadFilter
+    {
+    public:
+        // processWithMix()で原音とのミックス前の音声を一時的に保持する単位(フレーム数)
+        static constexpr std::size_t kMixBlockFrames = 256U;
+
+    private:
+        // 係数の並び順
+        enum CoefIdx : std::size_t
+        {
+            kB0 = 0U,
+            kB1,
+            kB2,
+            kA1,
+            kA2,
+            kNumCoefs,
+        };
+
+        // 各要素はチャンネル(L, R)の順
+        using LaneArray = std::array<float, 2>;
+
+        std::array<LaneArray, kNumCoefs> m_coefs = { LaneArray{ 1.0f, 1.0f }, {}, {}, {}, {} };
+        LaneArray m_input1 = {};
+        LaneArray m_input2 = {};
+        LaneArray m_output1 = {};
+        LaneArray m_output2 = {};
+
+        // rampCoefficients()による係数の線形補間の状態
+        std::array<LaneArray, kNumCoefs> m_targetCoefs = m_coefs;
+        std::array<LaneArray, kNumCoefs> m_coefDeltas = {};
+        std::size_t m_numRampFrames = 0U;
+
+        template <std::size_t NumChannels, bool Ramp>
+        void processImpl(const float* pInput, float* pOutput, std::size_t numFrames)
+        {
+            using namespace StereoLanes;
+
+            static_assert(NumChannels == 1U || NumChannels == 2U);
+            constexpr auto load = NumChannels == 2U ? Load : Load1;
+            constexpr auto store = NumChannels == 2U ? Store : Store1;
+
+            Lanes coefs[kNumCoefs];
+            Lanes coefDeltas[kNumCoefs];
+            for (std::size_t i = 0U; i < kNumCoefs; ++i)
+            {
+                coefs[i] = Load(m_coefs[i].data());
+                if constexpr (Ramp)
+                {
+                    coefDeltas[i] = Load(m_coefDeltas[i].data());
+                }
+            }
+            Lanes input1 = Load(m_input1.data());
+            Lanes input2 = Load(m_input2.data());
+            Lanes output1 = Load(m_output1.data());
+            Lanes output2 = Load(m_output2.data());
+            for (std::size_t i = 0U; i < numFrames; ++i)
+            {
+                if constexpr (Ramp)
+                {
+                    for (std::size_t j = 0U; j < kNumCoefs; ++j)
+                    {
+                        coefs[j] = Add(coefs[j], coefDeltas[j]);
+                    }
+                }
+
+                const Lanes input = load(pInput + i * NumChannels);
+                Lanes output = Mul(coefs[kB0], input);
+                output = Add(output, Mul(coefs[kB1], input1));
+                output = Add(output, Mul(coefs[kB2], input2));
+                output = Sub(output, Mul(coefs[kA1], output1));
+                output = Sub(output, Mul(coefs[kA2], output2));
+                store(pOutput + i * NumChannels, output);
+
+                input2 = input1;
+                input1 = input;
+                output2 = output1;
+                output1 = output;
+            }
+            Store(m_input1.data(), input1);
+            Store(m_input2.data(), input2);
+            Store(m_output1.data(), output1);
+            Store(m_output2.data(), output2);
+
+            if constexpr (Ramp)
+            {
+                m_numRampFrames -= numFrames;
+                if (m_numRampFrames == 0U)
+                {
+                    // 誤差が蓄積しないよう、補間の終了時は目標の係数に揃える
+                    m_coefs = m_targetCoefs;
+                }
+                else
+                {
+                    for (std::size_t i = 0U; i < kNumCoefs; ++i)
+                    {
+                        Store(m_coefs[i].data(), coefs[i]);
+                    }
+                }
+            }
+        }
+
+        template <std::size_t NumChannels>
+        void processChannels(const float* pInput, float* pOutput, std::size_t numFrames)
+        {
+            const std::size_t numRampFrames = (std::min)(numFrames, m_numRampFrames);
+            if (numRampFrames > 0U)
+            {
+                processImpl<NumChannels, true>(pInput, pOutput, numRampFrames);
+            }
+            if (numFrames > numRampFrames)
+            {
+                const std::size_t offset = numRampFrames * NumChannels;
+                processImpl<NumChannels, false>(pInput + offset, pOutput + offset, numFrames - numRampFrames);
+            }
+        }
+
+        static std::array<float, kNumCoefs> ToArray(const BiquadCoefficients<float>& coefs)
+        {
+            return { coefs.b0, coefs.b1, coefs.b2, coefs.a1, coefs.a2 };
+        }
+
+    public:
+        StereoBiquadFilter() = default;
+
+        // インターリーブされたステレオ音声に対してフィルタを適用する(in-place)
+        void process(float* pInterleaved, std::size_t numFrames)
+        {
+            process(pInterleaved, pInterleaved, numFrames);
+        }
+
+        // インターリーブされたステレオ音声に対してフィルタを適用する
+        // (pInputとpOutputは同一でもよい)
+        void process(const float* pInput, float* pOutput, std::size_t numFrames)
+        {
+            processChannels<2U>(pInput, pOutput, numFrames);
+        }
+
+        // モノラル音声に対してフィルタを適用する(Lチャンネル側の係数・状態を使用)
+        // (pInputとpOutputは同一でもよい)
+        void processMono(const float* pInput, float* pOutput, std::size_t numFrames)
+        {
+            processChannels<1U>(pInput, pOutput, numFrames);
+        }
+
+        // チャンネル数に応じてprocess()またはprocessMono()を呼ぶ
+        void process(const float* pInput, float* pOutput, std::size_t numFrames, std::size_t numChannels)
+        {
+            assert(numChannels == 1U || numChannels == 2U);
+            if (numChannels == 2U)
+            {
+                process(pInput, pOutput, numFrames);
+            }
+            else
+            {
+                processMono(pInput, pOutput, numFrames);
+            }
+        }
+
+        // フィルタを適用し、原音とmixの割合でミックスする
+        // (mixが0の場合は原音のまま変更しないが、切り替え時のノイズ回避のためにフィルタの状態は更新する)
+        void processWithMix(float* pData, std::size_t numFrames, std::size_t numChannels, float mix)
+        {
+            std::array<float, kMixBlockFrames * 2> wetBuffer;
+            while (numFrames > 0U)
+            {
+                const std::size_t numBlockFrames = (std::min)(numFrames, kMixBlockFrames);
+                const std::size_t blockSize = numBlockFrames * numChannels;
+                process(pData, wetBuffer.data(), numBlockFrames, numChannels);
+                if (mix != 0.0f)
+                {
+                    for (std::size_t i = 0U; i < blockSize; ++i)
+                    {
+                        pData[i] = std::lerp(pData[i], wetBuffer[i], mix);
+                    }
+                }
+                pData += blockSize;
+                numFrames -= numBlockFrames;
+            }
+        }
+
+        // 1フレーム分(L, R)を処理する
+        // (フレーム毎に係数を変更する場合やフィードバックを伴う場合に使用)
+        std::array<float, 2> processFrame(const std::array<float, 2>& input)
+        {
+            std::array<float, 2> output;
+            process(input.data(), output.data(), 1U);
+            return output;
+        }
+
+        // 係数を即座に変更する(係数の線形補間中の場合は中断する)
+        void setCoefficients(const BiquadCoefficients<float>& coefs)
+        {
+            setCoefficients(0U, coefs);
+            setCoefficients(1U, coefs);
+        }
+
+        // 指定チャンネルの係数のみ即座に変更する
+        void setCoefficients(std::size_t channel, const BiquadCoefficients<float>& coefs)
+        {
+            assert(channel < 2U);
+            const auto coefArray = ToArray(coefs);
+            for (std::size_t i = 0U; i < kNumCoefs; ++i)
+            {
+                m_coefs[i][channel] = coefArray[i];
+                m_targetCoefs[i][channel] = coefArray[i];
+                m_coefDeltas[i][channel] = 0.0f;
+            }
+        }
+
+        // 係数を現在の値からnumFramesフレームかけて線形に変化させる
+        // (最後のフレームで目標の係数に一致する。安定なフィルタ同士の係数の線形補間は安定なまま保たれる)
+        void rampCoefficients(const BiquadCoefficients<float>& targetCoefs, std::size_t numFrames)
+        {
+            rampCoefficients(0U, targetCoefs, numFrames);
+            rampCoefficients(1U, targetCoefs, numFrames);
+        }
+
+        // 指定チャンネルの係数を現在の値からnumFramesフレームかけて線形に変化させる
+        // Note: 補間の残りフレーム数は全チャンネルで共通のため、各チャンネルに同じnumFramesを指定すること
+        void rampCoefficients(std::size_t channel, const BiquadCoefficients<float>& targetCoefs, std::size_t numFrames)
+        {
+            assert(channel < 2U);
+            if (numFrames == 0U)
+            {
+                setCoefficients(channel, targetCoefs);
+                return;
+            }
+
+            const auto coefArray = ToArray(targetCoefs);
+            for (std::size_t i = 0U; i < kNumCoefs; ++i)
+            {
+                m_targetCoefs[i][channel] = coefArray[i];
+                m_coefDeltas[i][channel] = (coefArray[i] - m_coefs[i][channel]) / static_cast<float>(numFrames);
+            }
+            m_numRampFrames = numFrames;
+        }
+
+        void setLowPassFilter(float freq, float q, float sampleRate)
+        {
+            BiquadCoefficients<float> coefs;
+            coefs.setLowPassFilter(freq, q, sampleRate);
+            setCoefficients(coefs);
+        }
+
+        void setHighPassFilter(float freq, float q, float sampleRate)
+        {
+            BiquadCoefficients<float> coefs;
+            coefs.setHighPassFilter(freq, q, sampleRate);
+            setCoefficients(coefs);
+        }
+
+        void setHighShelfFilter(float freq, float q, float gainDb, float sampleRate)
+        {
+            BiquadCoefficients<float> coefs;
+            coefs.setHighShelfFilter(freq, q, gainDb, sampleRate);
+            setCoefficients(coefs);
+        }
+
+        void setPeakingFilter(float freq, float bandwidth, float gainDb, float sampleRate)
+        {
+            BiquadCoefficients<float> coefs;
+            coefs.setPeakingFilter(freq, bandwidth, gainDb, sampleRate);
+            setCoefficients(coefs);
+        }
+
+        void setAllPassFilter(float freq, float q, float sampleRate)
+        {
+            BiquadCoefficients<float> coefs;
+            coefs.setAllPassFilter(freq, q, sampleRate);
+            setCoefficients(coefs);
         }
     };
 }
@@ -0,0 +1,62 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstddef>
+
+namespace ksmaudio::AudioEffect::detail
+{
+	// 遅延バッファを使用するDSPが、未使用時に内部に保持しておく直近のフレーム数
+	// (有効化時に直前の入力を参照できるようにして、プチノイズを防ぐためのもの)
+	constexpr std::size_t kDelayLineTailFrames = 1024U;
+
+	// ストリーム毎に共有する遅延バッファ用のメモリプール
+	//
+	// 使用中のブロックのみを保持し、不要になったブロックは同じストリームの他の音声エフェクトで再利用する。
+	// DSPコールバック内、または、チャンネルをロックした状態でのみ使用すること
+	// (同じチャンネルのDSPは同時に実行されないため、内部でのロックは行わない)
+	//
+	// メモリの確保はacquire()・reserve()でのみ行い、これらは譜面のロード時などにDSPコールバック外で呼ぶ。
+	// DSPコールバック内ではメモリ確保を行わないtryAcquire()・release()のみを使用すること
+	class DelayLineArena
+	{
+	private:
+		// 確保済みの全ブロック
+		// (ブロックはアリーナの破棄時にまとめて解放する。音声エフェクトの破棄時に他のDSPと競合しないよう、個別には解放しない)
+		std::vector<std::unique_ptr<float[]>> m_blocks;
+
+		// 未使用のブロック
+		std::vector<std::span<float>> m_freeBlocks;
+
+		std::size_t m_totalSize = 0U;
+
+		std::span<float> allocate(std::size_t size);
+
+	public:
+		DelayLineArena() = default;
+
+		DelayLineArena(const DelayLineArena&) = delete;
+
+		DelayLineArena& operator=(const DelayLineArena&) = delete;
+
+		// minSize以上のサイズのブロックを取得する
+		// (未使用のブロックがなければ新たに確保するため、DSPコールバック外でのみ呼ぶこと。
+		//  再利用したブロックの場合は前回の内容が残っているので、必要に応じて利用側で初期化すること)
+		std::span<float> acquire(std::size_t minSize);
+
+		// 未使用のブロックからminSize以上のサイズのものを取得する
+		// (メモリ確保は行わないので、DSPコールバック内で呼んでもよい。該当するブロックがなければ空のspanを返す)
+		std::span<float> tryAcquire(std::size_t minSize);
+
+		// minSize以上のサイズのブロックを新たに確保し、未使用のブロックとして追加しておく
+		// (DSPコールバック内でtryAcquire()により取得するためのもの。DSPコールバック外でのみ呼ぶこと)
+		void reserve(std::size_t minSize);
+
+		// acquire()・tryAcquire()で取得したブロックを返却する
+		// (メモリ確保は行わないので、DSPコールバック内で呼んでもよい)
+		void release(std::span<float> block);
+
+		// 確保済みの全ブロックの合計サイズ
+		std::size_t totalSize() const;
+	};
+}
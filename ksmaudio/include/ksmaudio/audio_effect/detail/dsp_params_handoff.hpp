@@ -0,0 +1,355 @@
+﻿#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include "triple_buffer.hpp"
+#include "spsc_queue.hpp"
+
+namespace ksmaudio::AudioEffect::detail
+{
+	// タイムスタンプ付きのDSPパラメータの更新イベント
+	template <typename DSPParams>
+	struct DSPParamsEvent
+	{
+		DSPParams params;
+
+		bool bypass = false;
+
+		// falseの場合はバイパス状態のみの変更(updateParams()は呼ばれない)
+		bool updatesParams = true;
+
+		// このイベントの適用後はDSPのprocess()を呼ばなくても結果が変わらない状態かどうか
+		bool isIdle = false;
+
+		// 適用するストリーム上の位置(フレーム数)
+		std::int64_t frame = 0;
+
+		// 発行順の通し番号
+		std::uint64_t seq = 0U;
+	};
+
+	// ゲームスレッドからDSPスレッドへDSPパラメータをロックなしで受け渡す
+	//
+	// - パラメータはストリーム上の位置(フレーム数)のタイムスタンプ付きでキューに入れ、DSPスレッド側でその位置に到達した時点で適用する
+	//   (ゲームスレッドの更新頻度やBASSのブロックサイズに関係なく、サンプル単位のタイミングでパラメータが切り替わる)
+	// - 次のイベントが既に届いている場合、LASERの値(v)は次のイベントの値に向けて補間する
+	// - updateParams()はトリガ更新などの一度きりのイベントを含むため、イベントを適用するたびに呼ぶ
+	// - ゲームスレッドは毎回publishするが、キューに入れるのは値が変化した場合と一度きりのイベントのみ
+	//   (値が変化しない間の最新の値は保留しておき、次に値が変化した際にその直前に入れる。LASERの値の補間の起点とするため)
+	// - 処理不要な状態(isIdle)はイベントと同じ位置で切り替え、処理不要な区間はDSPのprocess()を呼ばない
+	//   (ゲームスレッド側で即座に切り替えると、まだ再生されていない直前のイベントの区間まで省略され、余韻やリリースが途切れるため)
+	// - エフェクトが処理不要な状態へ切り替わるイベントはキューに入れ、処理不要な状態が続く間のイベントは出力に影響しないため、キューには入れずに保留する
+	// - キューが溢れた場合は新しい方を破棄し、process()で使用する値はトリプルバッファ経由で最新のものを使う
+	// - 適用が遅れたイベントのトリガ更新までの時間(secUntilTrigger)は、遅れた分を差し引いてから適用する
+	template <typename DSPParams>
+	class DSPParamsHandoff
+	{
+	public:
+		using Event = DSPParamsEvent<DSPParams>;
+
+	private:
+		// DSPスレッドが停止している間(一時停止中など)に溜まる分を考慮した容量
+		static constexpr std::size_t kEventQueueCapacity = 256U;
+
+		// パラメータ値を補間する際にDSPのprocess()を分割して呼ぶ単位(フレーム数)
+		static constexpr std::size_t kInterpolationFrames = 32U;
+
+		// 処理中の位置より先のイベントを保留する最大の時間(秒)
+		// (シークで時間が巻き戻った場合などに、古い時間軸のイベントがいつまでも適用されないことを防ぐため、これより先のものは即座に適用する)
+		static constexpr double kMaxEventLeadSec = 1.0;
+
+		// トリガ更新の位置の差がこれ未満であれば同じトリガとみなす時間(秒)
+		// (secUntilTriggerは毎回の更新で減っていくため、トリガ更新の絶対位置で比較する。浮動小数点数の誤差を吸収するための許容幅)
+		static constexpr double kTriggerPositionToleranceSec = 0.001;
+
+		const std::size_t m_sampleRate;
+
+		const std::size_t m_numChannels;
+
+		TripleBuffer<Event> m_latestEvent;
+
+		SPSCQueue<Event, kEventQueueCapacity> m_eventQueue;
+
+		// キューが満杯でイベントを破棄した場合にtrueになる
+		std::atomic<bool> m_eventDropped = false;
+
+		// 以下はゲームスレッドのみが使用
+		std::uint64_t m_publishedSeq = 0U;
+		std::int64_t m_lastPublishedFrame = 0;
+		double m_streamTimeOffsetSec = 0.0; // 譜面上の時間からストリーム上の時間への変換に加算する値(秒)
+		Event m_lastQueuedEvent;
+		bool m_hasLastQueuedEvent = false;
+		Event m_pendingEvent; // キューに入れずに保留している最新のイベント
+		bool m_hasPendingEvent = false;
+
+		// 以下はDSPスレッドのみが使用
+		Event m_currentEvent;
+		std::int64_t m_currentStartFrame = 0; // 現在のイベントを実際に適用し始めた位置
+		Event m_nextEvent;
+		bool m_hasNextEvent = false;
+
+		// トリガ更新のストリーム上の位置(フレーム数)を返す(トリガ更新がない場合はstd::nullopt)
+		std::optional<std::int64_t> triggerFrame(const Event& event) const
+		{
+			if constexpr (requires { event.params.secUntilTrigger; })
+			{
+				if (event.params.secUntilTrigger >= 0.0f)
+				{
+					return event.frame + static_cast<std::int64_t>(std::llround(static_cast<double>(event.params.secUntilTrigger) * static_cast<double>(m_sampleRate)));
+				}
+			}
+			return std::nullopt;
+		}
+
+		// DSP側から見て同じ内容のイベントかどうか
+		bool isSameEvent(const Event& a, const Event& b) const
+		{
+			if (a.bypass != b.bypass || a.updatesParams != b.updatesParams || a.isIdle != b.isIdle)
+			{
+				return false;
+			}
+
+			DSPParams paramsA = a.params;
+			DSPParams paramsB = b.params;
+			if constexpr (requires { paramsA.secUntilTrigger; })
+			{
+				const std::optional<std::int64_t> triggerFrameA = triggerFrame(a);
+				const std::optional<std::int64_t> triggerFrameB = triggerFrame(b);
+				if (triggerFrameA.has_value() != triggerFrameB.has_value())
+				{
+					return false;
+				}
+				const std::int64_t toleranceFrames = static_cast<std::int64_t>(kTriggerPositionToleranceSec * static_cast<double>(m_sampleRate));
+				if (triggerFrameA.has_value() && std::abs(triggerFrameA.value() - triggerFrameB.value()) >= toleranceFrames)
+				{
+					return false;
+				}
+				paramsA.secUntilTrigger = paramsB.secUntilTrigger = 0.0f;
+			}
+
+			// 一度きりのイベントは同じ値が続いても省略しない
+			if constexpr (requires { paramsA.updateTrigger; })
+			{
+				if (paramsA.updateTrigger)
+				{
+					return false;
+				}
+			}
+			if constexpr (requires { paramsA.reset; })
+			{
+				if (paramsA.reset)
+				{
+					return false;
+				}
+			}
+
+			return paramsA == paramsB;
+		}
+
+		void enqueue(const Event& event)
+		{
+			if (!m_eventQueue.push(event))
+			{
+				m_eventDropped.store(true, std::memory_order_relaxed);
+			}
+			m_lastQueuedEvent = event;
+			m_hasLastQueuedEvent = true;
+		}
+
+		void push(Event event)
+		{
+			event.seq = ++m_publishedSeq;
+			m_latestEvent.write(event);
+
+			// 処理不要な状態へ切り替わった後のイベントと、値が変化しないイベントは保留する
+			if (m_hasLastQueuedEvent && ((event.isIdle && m_lastQueuedEvent.isIdle) || isSameEvent(event, m_lastQueuedEvent)))
+			{
+				m_pendingEvent = event;
+				m_hasPendingEvent = true;
+				return;
+			}
+
+			if (m_hasPendingEvent)
+			{
+				enqueue(m_pendingEvent);
+				m_hasPendingEvent = false;
+			}
+			enqueue(event);
+		}
+
+		template <typename DSP>
+		void apply(DSP& dsp, const Event& event, std::int64_t frame)
+		{
+			if (event.updatesParams)
+			{
+				if constexpr (requires { event.params.secUntilTrigger; })
+				{
+					if (event.params.secUntilTrigger >= 0.0f && frame > event.frame)
+					{
+						// 適用が遅れた分を差し引く
+						// (既に過ぎたトリガ更新は、それより前のイベントで反映済みのため無視する)
+						DSPParams params = event.params;
+						const double lateSec = static_cast<double>(frame - event.frame) / static_cast<double>(m_sampleRate);
+						params.secUntilTrigger = static_cast<float>(static_cast<double>(params.secUntilTrigger) - lateSec);
+						if (params.secUntilTrigger < 0.0f)
+						{
+							params.secUntilTrigger = -1.0f;
+						}
+						dsp.updateParams(params);
+					}
+					else
+					{
+						dsp.updateParams(event.params);
+					}
+				}
+				else
+				{
+					dsp.updateParams(event.params);
+				}
+			}
+			if (event.seq > m_currentEvent.seq)
+			{
+				m_currentEvent = event;
+				m_currentStartFrame = (std::max)(event.frame, frame);
+			}
+		}
+
+		// 指定位置までに適用すべきイベントをすべて適用する
+		// (frameがstd::nulloptの場合は届いているイベントをすべて適用する)
+		template <typename DSP>
+		void applyDueEvents(DSP& dsp, std::optional<std::int64_t> frame)
+		{
+			const std::int64_t maxLeadFrames = static_cast<std::int64_t>(kMaxEventLeadSec * static_cast<double>(m_sampleRate));
+			while (true)
+			{
+				if (!m_hasNextEvent)
+				{
+					if (!m_eventQueue.pop(m_nextEvent))
+					{
+						break;
+					}
+					m_hasNextEvent = true;
+				}
+
+				if (frame.has_value())
+				{
+					const std::int64_t leadFrames = m_nextEvent.frame - frame.value();
+					if (0 < leadFrames && leadFrames <= maxLeadFrames)
+					{
+						// まだ適用する位置に到達していない
+						break;
+					}
+				}
+
+				apply(dsp, m_nextEvent, frame.value_or(m_nextEvent.frame));
+				m_hasNextEvent = false;
+			}
+
+			// キューから溢れたイベントがある場合は、最新の値を使用する
+			if (!m_hasNextEvent && m_eventDropped.exchange(false, std::memory_order_relaxed))
+			{
+				m_latestEvent.update();
+				const Event& latestEvent = m_latestEvent.read();
+				if (latestEvent.seq > m_currentEvent.seq)
+				{
+					apply(dsp, latestEvent, frame.value_or(latestEvent.frame));
+				}
+			}
+		}
+
+	public:
+		DSPParamsHandoff(std::size_t sampleRate, std::size_t numChannels)
+			: m_sampleRate(sampleRate)
+			, m_numChannels(numChannels)
+		{
+		}
+
+		// ゲームスレッドから呼ぶ
+		// (譜面上の時間にoffsetSecを加算したものをストリーム上の時間として扱う。BGMのオフセットを指定する)
+		void setStreamTimeOffset(double offsetSec)
+		{
+			m_streamTimeOffsetSec = offsetSec;
+		}
+
+		// ゲームスレッドから呼ぶ
+		// (secはパラメータを適用する譜面上の時間。setStreamTimeOffset()のオフセットを加算したストリーム上の位置で適用する)
+		// (isIdleはこのパラメータでDSPのprocess()を呼ぶ必要がなくなるかどうか。処理不要な状態が続く間はキューに入れずに保留する)
+		void publish(const DSPParams& params, bool bypass, float sec, bool isIdle)
+		{
+			const double streamSec = static_cast<double>(sec) + m_streamTimeOffsetSec;
+			m_lastPublishedFrame = static_cast<std::int64_t>(std::llround(streamSec * static_cast<double>(m_sampleRate)));
+			push({ .params = params, .bypass = bypass, .updatesParams = true, .isIdle = isIdle, .frame = m_lastPublishedFrame });
+		}
+
+		// ゲームスレッドから呼ぶ
+		// (バイパス状態のみの変更ではupdateParams()は呼ばれない。適用位置は直前のpublish()と同じ)
+		void publishBypass(const DSPParams& params, bool bypass, bool isIdle)
+		{
+			push({ .params = params, .bypass = bypass, .updatesParams = false, .isIdle = isIdle, .frame = m_lastPublishedFrame });
+		}
+
+		// DSPスレッドから呼ぶ
+		// ブロック内のイベントの位置でブロックを分割し、それぞれの区間を適用済みのパラメータでDSPに処理させる
+		// (処理不要な状態のイベントを適用済みの区間はDSPを呼ばずにスキップする)
+		// (blockStartFrameはブロック先頭のストリーム上の位置。不明な場合はstd::nulloptを指定し、届いているイベントをすべて先頭で適用する)
+		template <typename DSP>
+		void process(DSP& dsp, float* pData, std::size_t dataSize, std::optional<std::int64_t> blockStartFrame)
+		{
+			const std::size_t numFrames = m_numChannels == 0U ? 0U : dataSize / m_numChannels;
+			if (!blockStartFrame.has_value() || numFrames == 0U)
+			{
+				applyDueEvents(dsp, std::nullopt);
+				if (!m_currentEvent.isIdle)
+				{
+					dsp.process(pData, dataSize, m_currentEvent.bypass, m_currentEvent.params);
+				}
+				return;
+			}
+
+			std::size_t cursor = 0U;
+			while (true)
+			{
+				const std::int64_t frame = blockStartFrame.value() + static_cast<std::int64_t>(cursor);
+				applyDueEvents(dsp, frame);
+				if (cursor >= numFrames)
+				{
+					break;
+				}
+
+				// 次のイベントの位置までを同じパラメータで処理する
+				std::size_t endCursor = numFrames;
+				if (m_hasNextEvent)
+				{
+					endCursor = static_cast<std::size_t>((std::min)(m_nextEvent.frame - blockStartFrame.value(), static_cast<std::int64_t>(numFrames)));
+				}
+
+				if (m_currentEvent.isIdle)
+				{
+					// 処理不要な区間はDSPを呼ばない
+					cursor = endCursor;
+					continue;
+				}
+
+				DSPParams params = m_currentEvent.params;
+				if constexpr (requires { params.v; })
+				{
+					// LASERの値は次のイベントの値に向けて線形補間する
+					// (ゲームスレッドの更新頻度が低い場合でも値が階段状に変化しないようにするため)
+					if (m_hasNextEvent && m_nextEvent.updatesParams && !m_currentEvent.bypass && !m_nextEvent.bypass)
+					{
+						endCursor = (std::min)(endCursor, cursor + kInterpolationFrames);
+						const float rate = static_cast<float>(frame - m_currentStartFrame) / static_cast<float>(m_nextEvent.frame - m_currentStartFrame);
+						params.v = std::lerp(m_currentEvent.params.v, m_nextEvent.params.v, std::clamp(rate, 0.0f, 1.0f));
+					}
+				}
+
+				dsp.process(pData + cursor * m_numChannels, (endCursor - cursor) * m_numChannels, m_currentEvent.bypass, params);
+				cursor = endCursor;
+			}
+		}
+	};
+}
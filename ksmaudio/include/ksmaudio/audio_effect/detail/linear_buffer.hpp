@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <algorithm>
 #include <vector>
+#include <span>
 #include <type_traits>
 #include <cassert>
 #include <cstring>
@@ -19,7 +20,11 @@ namespace ksmaudio::AudioEffect::detail
             "Value type of LinearBuffer is required to be arithmetic");
 
     private:
-        std::vector<T> m_buffer;
+        // 外部のバッファが割り当てられていない場合に使用する内部のバッファ
+        std::vector<T> m_ownedBuffer;
+
+        // 現在使用中のバッファ(m_ownedBufferまたは外部のバッファ)
+        std::span<T> m_buffer;
 
         std::size_t m_readCursorFrame = 0U;
 
@@ -27,21 +32,25 @@ namespace ksmaudio::AudioEffect::detail
 
         float m_currentFadeOutScale = 1.0f;
 
-        const std::size_t m_numFrames;
+        std::size_t m_numFrames;
 
         const std::size_t m_numChannels;
 
     public:
         explicit LinearBuffer(std::size_t size, std::size_t numChannels)
-            : m_buffer(size, T{ 0 })
+            : m_ownedBuffer(size, T{ 0 })
+            , m_buffer(m_ownedBuffer)
             , m_numFrames(numChannels == 0U ? 0U : size / numChannels)
             , m_numChannels(numChannels)
         {
             assert(m_numChannels > 0U);
             assert(size % m_numChannels == 0U);
-            m_buffer.shrink_to_fit();
         }
 
+        LinearBuffer(const LinearBuffer&) = delete;
+
+        LinearBuffer& operator=(const LinearBuffer&) = delete;
+
         void write(const T* pData, std::size_t size)
         {
             assert(size % m_numChannels == 0U);
@@ -53,13 +62,15 @@ namespace ksmaudio::AudioEffect::detail
             }
 
             const std::size_t frameSize = size / m_numChannels;
-            const std::size_t numWriteFrames = (std::min)(frameSize, m_numFrames - m_writeCursorFrame);
-            if (numWriteFrames == 0U)
+            const std::size_t numWriteFrames = m_writeCursorFrame < m_numFrames ? (std::min)(frameSize, m_numFrames - m_writeCursorFrame) : 0U;
+            if (numWriteFrames > 0U)
             {
-                return;
+                std::memcpy(&m_buffer[m_writeCursorFrame * m_numChannels], pData, sizeof(T) * numWriteFrames * m_numChannels);
             }
-            std::memcpy(&m_buffer[m_writeCursorFrame * m_numChannels], pData, sizeof(T) * numWriteFrames * m_numChannels);
-            m_writeCursorFrame += numWriteFrames;
+
+            // バッファに収まらない分も書き込みカーソルは進める
+            // (後からattach()でバッファを拡張した場合に、書き込み位置が読み出しカーソルとずれないようにするため)
+            m_writeCursorFrame += frameSize;
         }
 
         void read(T* pData, std::size_t size, std::size_t numLoopFrames, std::size_t numNonZeroFrames, bool fadesOut = false, float fadeOutFeedbackLevel = 1.0f, float mix = 1.0f, bool bypass = false)
@@ -161,11 +172,12 @@ namespace ksmaudio::AudioEffect::detail
             }
 
             const std::size_t frameSize = size / m_numChannels;
-            if (m_writeCursorFrame <= m_readCursorFrame)
+            const std::size_t writtenFrames = (std::min)(m_writeCursorFrame, m_numFrames);
+            if (writtenFrames <= m_readCursorFrame)
             {
                 std::memset(pData, 0, sizeof(T) * frameSize * m_numChannels); // HACK: This assumes IEEE 754
             }
-            else if (m_writeCursorFrame - m_readCursorFrame < frameSize)
+            else if (writtenFrames - m_readCursorFrame < frameSize)
             {
                 const std::size_t numReadFrames = m_numFrames - m_readCursorFrame;
                 std::memcpy(pData, &m_buffer[m_readCursorFrame * m_numChannels], sizeof(T) * numReadFrames * m_numChannels);
@@ -207,12 +219,34 @@ namespace ksmaudio::AudioEffect::detail
             return m_numFrames;
         }
 
-        std::vector<T>& buffer()
+        // 外部のバッファ(DelayLineArenaのブロックなど)に切り替える
+        // (書き込み済みの内容は新しいバッファに収まる分だけ引き継ぐ。以前に割り当てていた外部のバッファがあればそれを返す)
+        std::span<T> attach(std::span<T> storage)
+        {
+            assert(storage.size() % m_numChannels == 0U);
+
+            const std::span<T> prevStorage = isAttached() ? m_buffer : std::span<T>{};
+            const std::size_t newNumFrames = storage.size() / m_numChannels;
+            const std::size_t numCopyFrames = (std::min)(m_writeCursorFrame, (std::min)(m_numFrames, newNumFrames));
+            std::memcpy(storage.data(), m_buffer.data(), sizeof(T) * numCopyFrames * m_numChannels);
+            std::fill(storage.begin() + numCopyFrames * m_numChannels, storage.end(), T{ 0 });
+
+            m_buffer = storage;
+            m_numFrames = newNumFrames;
+            return prevStorage;
+        }
+
+        bool isAttached() const
+        {
+            return m_buffer.data() != m_ownedBuffer.data();
+        }
+
+        std::span<T> buffer()
         {
             return m_buffer;
         }
 
-        const std::vector<T>& buffer() const
+        std::span<const T> buffer() const
         {
             return m_buffer;
         }
@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include <vector>
+#include <span>
+#include <algorithm>
 #include <type_traits>
 #include <cassert>
 #include <cstring>
@@ -19,11 +21,15 @@ namespace ksmaudio::AudioEffect::detail
     private:
         static constexpr std::size_t kSafeFadeoutFrames = 4U;
 
-        std::vector<T> m_buffer;
+        // 外部のバッファが割り当てられていない場合に使用する内部のバッファ
+        std::vector<T> m_ownedBuffer;
+
+        // 現在使用中のバッファ(m_ownedBufferまたは外部のバッファ)
+        std::span<T> m_buffer;
 
         std::size_t m_cursorFrame = 0U;
 
-        const std::size_t m_numFrames;
+        std::size_t m_numFrames;
 
         const std::size_t m_numChannels;
 
@@ -87,19 +93,57 @@ namespace ksmaudio::AudioEffect::detail
             std::memcpy(pDest, &m_buffer[index], sizeof(T) * size);
         }
 
+        // 直近の履歴を新しいバッファへ古い順にコピーし、新しいバッファに切り替える
+        void moveHistoryTo(std::span<T> dest, bool clearsRest = true)
+        {
+            assert(dest.size() % m_numChannels == 0U);
+
+            const std::size_t destNumFrames = dest.size() / m_numChannels;
+            assert(destNumFrames > 0U);
+            const std::size_t numHistoryFrames = (std::min)(m_numFrames, destNumFrames);
+            const std::size_t startFrame = delayCursor(numHistoryFrames);
+            const std::size_t firstFrameSize = (std::min)(numHistoryFrames, m_numFrames - startFrame);
+            std::memcpy(dest.data(), &m_buffer[startFrame * m_numChannels], sizeof(T) * firstFrameSize * m_numChannels);
+            std::memcpy(dest.data() + firstFrameSize * m_numChannels, m_buffer.data(), sizeof(T) * (numHistoryFrames - firstFrameSize) * m_numChannels);
+            if (clearsRest)
+            {
+                std::fill(dest.begin() + numHistoryFrames * m_numChannels, dest.end(), T{ 0 });
+            }
+
+            m_buffer = dest;
+            m_numFrames = destNumFrames;
+            m_cursorFrame = numHistoryFrames % destNumFrames;
+        }
+
     public:
         RingBuffer(std::size_t size, std::size_t numChannels)
-            : m_buffer(size, T{ 0 })
+            : m_ownedBuffer(size, T{ 0 })
+            , m_buffer(m_ownedBuffer)
             , m_numFrames(size / numChannels)
             , m_numChannels(numChannels)
         {
             assert(m_numChannels > 0U);
             assert(size % m_numChannels == 0U);
-            m_buffer.shrink_to_fit();
+            assert(m_numFrames > 0U);
         }
 
+        RingBuffer(const RingBuffer&) = delete;
+
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
         void write(const T* pData, std::size_t size)
         {
+            assert(size % m_numChannels == 0U);
+
+            // バッファより長い場合は、上書きされて残らない先頭部分を飛ばす
+            const std::size_t frameSize = size / m_numChannels;
+            if (frameSize > m_numFrames)
+            {
+                const std::size_t skipFrames = frameSize - m_numFrames;
+                writeImpl(pData + skipFrames * m_numChannels, m_numFrames * m_numChannels, (m_cursorFrame + skipFrames) % m_numFrames);
+                return;
+            }
+
             writeImpl(pData, size, m_cursorFrame);
         }
 
@@ -174,12 +218,40 @@ namespace ksmaudio::AudioEffect::detail
             return m_cursorFrame;
         }
 
-        std::vector<T>& buffer()
+        // 外部のバッファ(DelayLineArenaのブロックなど)に切り替える
+        // (直近の履歴は新しいバッファに収まる分だけ引き継ぐ。以前に割り当てていた外部のバッファがあればそれを返す)
+        // (clearsRestがfalseの場合、履歴より古い部分を0で埋めない。履歴より古い部分を読まないことが保証できる場合に、大きなバッファの初期化を省くためのもの)
+        std::span<T> attach(std::span<T> storage, bool clearsRest = true)
+        {
+            const std::span<T> prevStorage = isAttached() ? m_buffer : std::span<T>{};
+            moveHistoryTo(storage, clearsRest);
+            return prevStorage;
+        }
+
+        // 内部のバッファに戻す
+        // (直近の履歴は内部のバッファに収まる分だけ引き継ぐ。切り離した外部のバッファを返す)
+        std::span<T> detach()
+        {
+            if (!isAttached())
+            {
+                return {};
+            }
+            const std::span<T> prevStorage = m_buffer;
+            moveHistoryTo(m_ownedBuffer);
+            return prevStorage;
+        }
+
+        bool isAttached() const
+        {
+            return m_buffer.data() != m_ownedBuffer.data();
+        }
+
+        std::span<T> buffer()
         {
             return m_buffer;
         }
 
-        const std::vector<T>& buffer() const
+        std::span<const T> buffer() const
         {
             return m_buffer;
         }
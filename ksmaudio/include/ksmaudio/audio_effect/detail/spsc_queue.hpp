@@ -0,0 +1,59 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace ksmaudio::AudioEffect::detail
+{
+	// 書き込み側1スレッド・読み込み側1スレッド用の固定長のロックフリーキュー
+	template <typename T, std::size_t Capacity>
+	class SPSCQueue
+	{
+		static_assert(Capacity >= 2U, "Capacity of SPSCQueue must be at least 2");
+
+	private:
+		std::array<T, Capacity> m_buffer;
+
+		// 読み込み側が次に読む位置
+		std::atomic<std::size_t> m_head = 0U;
+
+		// 書き込み側が次に書く位置
+		std::atomic<std::size_t> m_tail = 0U;
+
+	public:
+		SPSCQueue() = default;
+
+		SPSCQueue(const SPSCQueue&) = delete;
+
+		SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+		// 書き込み側のスレッドから呼ぶ
+		// (キューが満杯の場合は何もせずfalseを返す)
+		bool push(const T& value)
+		{
+			const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+			const std::size_t nextTail = (tail + 1U) % Capacity;
+			if (nextTail == m_head.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+			m_buffer[tail] = value;
+			m_tail.store(nextTail, std::memory_order_release);
+			return true;
+		}
+
+		// 読み込み側のスレッドから呼ぶ
+		// (キューが空の場合はfalseを返す)
+		bool pop(T& value)
+		{
+			const std::size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_tail.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+			value = m_buffer[head];
+			m_head.store((head + 1U) % Capacity, std::memory_order_release);
+			return true;
+		}
+	};
+}
@@ -9,12 +9,10 @@ namespace ksmaudio::AudioEffect::detail
     private:
         RingBuffer<float> m_ringBuffer;
         float m_delaySample = 0.0f;
-        const float m_maxDelayFrames;
 
     public:
         TimeModulator(std::size_t size, std::size_t numChannels)
             : m_ringBuffer(size, numChannels)
-            , m_maxDelayFrames(static_cast<float>(m_ringBuffer.numFrames()))
         {
         }
 
@@ -23,7 +21,7 @@ namespace ksmaudio::AudioEffect::detail
             // 再生速度をもとにディレイタイムを更新
             if (playSpeed != 1.0f)
             {
-                m_delaySample = std::clamp(m_delaySample + 1.0f - playSpeed, 0.0f, m_maxDelayFrames);
+                m_delaySample = std::clamp(m_delaySample + 1.0f - playSpeed, 0.0f, static_cast<float>(m_ringBuffer.numFrames()));
             }
         }
 
@@ -73,5 +71,37 @@ namespace ksmaudio::AudioEffect::detail
         {
             m_delaySample = 0.0f;
         }
+
+        float delaySample() const
+        {
+            return m_delaySample;
+        }
+
+        std::size_t numFrames() const
+        {
+            return m_ringBuffer.numFrames();
+        }
+
+        // リングバッファを外部のバッファに切り替える(RingBuffer::attach()を参照)
+        std::span<float> attach(std::span<float> storage, bool clearsRest = true)
+        {
+            return m_ringBuffer.attach(storage, clearsRest);
+        }
+
+        // リングバッファを内部のバッファに戻す(RingBuffer::detach()を参照)
+        std::span<float> detach()
+        {
+            return m_ringBuffer.detach();
+        }
+
+        bool isAttached() const
+        {
+            return m_ringBuffer.isAttached();
+        }
+
+        std::span<const float> buffer() const
+        {
+            return m_ringBuffer.buffer();
+        }
     };
 }
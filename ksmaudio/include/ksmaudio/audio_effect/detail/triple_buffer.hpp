@@ -0,0 +1,68 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ksmaudio::AudioEffect::detail
+{
+	// 書き込み側1スレッド・読み込み側1スレッドの間で、最新の値をロックなしで受け渡すためのトリプルバッファ
+	// (書き込み側・読み込み側ともに待機が発生しないため、DSPスレッドがゲームスレッドにブロックされない)
+	template <typename T>
+	class TripleBuffer
+	{
+	private:
+		static constexpr std::uint8_t kIdxMask = 0b011;
+		static constexpr std::uint8_t kDirtyFlag = 0b100;
+
+		std::array<T, 3> m_buffers;
+
+		// 書き込み側と読み込み側で受け渡し中のバッファのインデックス
+		// (未読の値が入っている場合はkDirtyFlagが立つ)
+		std::atomic<std::uint8_t> m_middleIdx = 1U;
+
+		// 書き込み側のみが使用
+		std::uint8_t m_writeIdx = 0U;
+
+		// 読み込み側のみが使用
+		std::uint8_t m_readIdx = 2U;
+
+	public:
+		TripleBuffer() = default;
+
+		explicit TripleBuffer(const T& initialValue)
+			: m_buffers{ initialValue, initialValue, initialValue }
+		{
+		}
+
+		TripleBuffer(const TripleBuffer&) = delete;
+
+		TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+		// 書き込み側のスレッドから呼ぶ
+		void write(const T& value)
+		{
+			m_buffers[m_writeIdx] = value;
+			const std::uint8_t prevMiddleIdx = m_middleIdx.exchange(m_writeIdx | kDirtyFlag, std::memory_order_acq_rel);
+			m_writeIdx = prevMiddleIdx & kIdxMask;
+		}
+
+		// 読み込み側のスレッドから呼ぶ
+		// (新しい値が書き込まれていればそれに切り替えてtrueを返す)
+		bool update()
+		{
+			if ((m_middleIdx.load(std::memory_order_relaxed) & kDirtyFlag) == 0U)
+			{
+				return false;
+			}
+			const std::uint8_t prevMiddleIdx = m_middleIdx.exchange(m_readIdx, std::memory_order_acq_rel);
+			m_readIdx = prevMiddleIdx & kIdxMask;
+			return true;
+		}
+
+		// 読み込み側のスレッドから呼ぶ
+		const T& read() const
+		{
+			return m_buffers[m_readIdx];
+		}
+	};
+}
@@ -17,5 +17,7 @@ namespace ksmaudio::AudioEffect
 		void process(float* pData, std::size_t dataSize, bool bypass, const BitcrusherDSPParams& params);
 
 		void updateParams(const BitcrusherDSPParams& params);
+
+		bool isIdle(bool bypass, const BitcrusherDSPParams& params) const;
 	};
 }
@@ -14,11 +14,18 @@ namespace ksmaudio::AudioEffect
 		float m_lfoTimeRate = 0.0f;
 		std::array<detail::BiquadFilter<float>, 2> m_lowShelfFilters;
 
+		// allowsAllocationがfalseの場合(DSPコールバック内)は、確保済みの未使用のブロックがある場合のみ拡張する
+		void reserveDelayFrames(std::size_t numFrames, bool allowsAllocation);
+
 	public:
 		explicit FlangerDSP(const DSPCommonInfo& info);
 
 		void process(float* pData, std::size_t dataSize, bool bypass, const FlangerDSPParams& params);
 
 		void updateParams(const FlangerDSPParams& params);
+
+		bool isIdle(bool bypass, const FlangerDSPParams& params) const;
+
+		void reserveDelayTime(float maxDelaySec);
 	};
 }
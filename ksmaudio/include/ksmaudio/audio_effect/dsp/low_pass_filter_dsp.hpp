@@ -10,7 +10,7 @@ namespace ksmaudio::AudioEffect
 	{
 	private:
 		const DSPCommonInfo m_info;
-		std::array<detail::BiquadFilter<float>, 2> m_lowPassFilters;
+		detail::StereoBiquadFilter m_lowPassFilter;
 		detail::LinearEasing<float> m_vEasing;
 
 	public:
@@ -19,5 +19,7 @@ namespace ksmaudio::AudioEffect
 		void process(float* pData, std::size_t dataSize, bool bypass, const LowPassFilterDSPParams& params);
 
 		void updateParams(const LowPassFilterDSPParams& params);
+
+		bool isIdle(bool bypass, const LowPassFilterDSPParams& params) const;
 	};
 }
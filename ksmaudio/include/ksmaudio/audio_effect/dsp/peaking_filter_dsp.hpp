@@ -52,7 +52,7 @@ namespace ksmaudio::AudioEffect
 		public:
 			explicit PeakingFilterRelease(std::size_t sampleRate);
 
-			void update(float freq, float baseGainDb, float mix, bool mixSkipped);
+			void update(float freq, float baseGainDb, float mix, bool mixSkipped, std::size_t numFrames = 1U);
 
 			bool hasValue() const;
 
@@ -68,7 +68,7 @@ namespace ksmaudio::AudioEffect
 	{
 	private:
 		const DSPCommonInfo m_info;
-		std::array<detail::BiquadFilter<float>, 2> m_peakingFilters;
+		detail::StereoBiquadFilter m_peakingFilter;
 		detail::PeakingFilterValueController m_valueController;
 		detail::PeakingFilterRelease m_release;
 
@@ -78,5 +78,7 @@ namespace ksmaudio::AudioEffect
 		void process(float* pData, std::size_t dataSize, bool bypass, const PeakingFilterDSPParams& params);
 
 		void updateParams(const PeakingFilterDSPParams& params);
+
+		bool isIdle(bool bypass, const PeakingFilterDSPParams& params) const;
 	};
 }
@@ -14,9 +14,10 @@ namespace ksmaudio::AudioEffect
 	private:
 		const DSPCommonInfo m_info;
 		float m_lfoTimeRate = 0.0f;
-		std::array<std::array<detail::BiquadFilter<float>, 2>, kMaxNumAllPassFilters> m_allPassFilters;
-		std::array<detail::BiquadFilter<float>, 2> m_hiCutFilters;
+		std::array<detail::StereoBiquadFilter, kMaxNumAllPassFilters> m_allPassFilters;
+		detail::StereoBiquadFilter m_hiCutFilter;
 		std::array<std::array<float, 2>, kMaxNumAllPassFilters> m_prevWetArrayForFeedback;
+		std::size_t m_numActiveStages = 0U; // 前回フィルタ係数を更新したステージ数
 
 	public:
 		explicit PhaserDSP(const DSPCommonInfo& info);
@@ -24,5 +25,7 @@ namespace ksmaudio::AudioEffect
 		void process(float* pData, std::size_t dataSize, bool bypass, const PhaserDSPParams& params);
 
 		void updateParams(const PhaserDSPParams& params);
+
+		bool isIdle(bool bypass, const PhaserDSPParams& params) const;
 	};
 }
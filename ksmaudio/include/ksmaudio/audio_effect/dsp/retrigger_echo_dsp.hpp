@@ -12,11 +12,18 @@ namespace ksmaudio::AudioEffect
 		detail::LinearBuffer<float> m_linearBuffer;
 		std::ptrdiff_t m_framesUntilTrigger = -1;
 
+		// allowsAllocationがfalseの場合(DSPコールバック内)は、確保済みの未使用のブロックがある場合のみ拡張する
+		void reserveDelayFrames(std::size_t numFrames, bool allowsAllocation);
+
 	public:
 		explicit RetriggerEchoDSP(const DSPCommonInfo& info);
 
 		void process(float* pData, std::size_t dataSize, bool bypass, const RetriggerEchoDSPParams& params);
 
 		void updateParams(const RetriggerEchoDSPParams& params);
+
+		bool isIdle(bool bypass, const RetriggerEchoDSPParams& params) const;
+
+		void reserveDelayTime(float maxDelaySec);
 	};
 }
@@ -22,5 +22,7 @@ namespace ksmaudio::AudioEffect
 		void process(float* pData, std::size_t dataSize, bool bypass, const SidechainDSPParams& params);
 
 		void updateParams(const SidechainDSPParams& params);
+
+		bool isIdle(bool bypass, const SidechainDSPParams& params) const;
 	};
 }
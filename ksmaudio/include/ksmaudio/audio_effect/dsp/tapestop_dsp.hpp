@@ -26,6 +26,15 @@ namespace ksmaudio::AudioEffect
 		const DSPCommonInfo m_info;
 		detail::TapeStopSpeedController m_speedController;
 		detail::TimeModulator m_timeModulator;
+		std::span<float> m_reservedBlock; // reserveDelayTime()でこのDSP専用に取得した遅延バッファ(アリーナには返却せず保持する)
+
+		// DSPコールバック内で呼ぶため、専用のブロックか確保済みの未使用のブロックがある場合のみ拡張する
+		void reserveDelayFrames(std::size_t numFrames);
+
+		void releaseDelayLine();
+
+		// 使用を終えたブロックをアリーナに返却する(専用のブロックは返却しない)
+		void releaseBlock(std::span<float> block);
 
 	public:
 		explicit TapestopDSP(const DSPCommonInfo& info);
@@ -33,5 +42,9 @@ namespace ksmaudio::AudioEffect
 		void process(float* pData, std::size_t dataSize, bool bypass, const TapestopDSPParams& params);
 
 		void updateParams(const TapestopDSPParams& params);
+
+		bool isIdle(bool bypass, const TapestopDSPParams& params) const;
+
+		void reserveDelayTime(float maxDelaySec);
 	};
 }
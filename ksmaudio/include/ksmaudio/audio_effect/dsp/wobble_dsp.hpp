@@ -11,7 +11,8 @@ namespace ksmaudio::AudioEffect
 	private:
 		const DSPCommonInfo m_info;
 		detail::DSPSimpleTriggerHandler m_triggerHandler;
-		std::array<detail::BiquadFilter<float>, 2> m_lowPassFilters;
+		detail::StereoBiquadFilter m_lowPassFilter;
+		bool m_isLowPassFilterInitialized = false; // フィルタ係数を一度でも設定したか
 
 	public:
 		explicit WobbleDSP(const DSPCommonInfo& info);
@@ -19,5 +20,7 @@ namespace ksmaudio::AudioEffect
 		void process(float* pData, std::size_t dataSize, bool bypass, const WobbleDSPParams& params);
 
 		void updateParams(const WobbleDSPParams& params);
+
+		bool isIdle(bool bypass, const WobbleDSPParams& params) const;
 	};
 }
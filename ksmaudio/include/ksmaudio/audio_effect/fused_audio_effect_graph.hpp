@@ -0,0 +1,40 @@
+﻿#pragma once
+#include <vector>
+#include "audio_effect.hpp"
+
+namespace ksmaudio::AudioEffect
+{
+	// 複数の音声エフェクトを1つのDSPコールバック内でまとめて処理するためのグラフ
+	// (エフェクト毎にBASSのDSPを登録する場合と比べて、コールバック呼び出しのオーバーヘッドを削減する)
+	class FusedAudioEffectGraph
+	{
+	private:
+		struct Node
+		{
+			IAudioEffect* pAudioEffect;
+
+			int priority;
+		};
+
+		// priorityの降順に並んだ処理順の配列
+		// (BASSのDSPと同様、priorityが大きいものから先に処理する)
+		std::vector<Node> m_nodes;
+
+	public:
+		FusedAudioEffectGraph() = default;
+
+		FusedAudioEffectGraph(const FusedAudioEffectGraph&) = delete;
+
+		FusedAudioEffectGraph& operator=(const FusedAudioEffectGraph&) = delete;
+
+		// この関数のみ他の関数とは別のスレッドから呼ばれるので注意
+		void process(float* pData, std::size_t dataSize, std::optional<std::int64_t> blockStartFrame);
+
+		// Note: add/removeはprocessと同時に実行されないよう、呼び出し側でチャンネルをロックした状態で呼ぶこと
+		void add(IAudioEffect* pAudioEffect, int priority);
+
+		void remove(IAudioEffect* pAudioEffect);
+
+		std::size_t size() const;
+	};
+}
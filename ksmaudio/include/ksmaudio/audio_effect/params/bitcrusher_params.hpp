@@ -7,6 +7,8 @@ namespace ksmaudio::AudioEffect
 	{
 		float reduction = 10.0f;
 		float mix = 1.0f;
+
+		bool operator==(const BitcrusherDSPParams&) const = default;
 	};
 
 	struct BitcrusherParams
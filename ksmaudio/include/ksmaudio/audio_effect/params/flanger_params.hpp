@@ -13,6 +13,8 @@ namespace ksmaudio::AudioEffect
 		float stereoWidth = 0.0f;
 		float vol = 0.75f;
 		float mix = 0.8f;
+
+		bool operator==(const FlangerDSPParams&) const = default;
 	};
 
 	struct FlangerParams
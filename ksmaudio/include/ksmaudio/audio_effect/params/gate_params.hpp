@@ -9,6 +9,8 @@ namespace ksmaudio::AudioEffect
 		float waveLength = 0.0f;
 		float rate = 0.5f;
 		float mix = 0.9f;
+
+		bool operator==(const GateDSPParams&) const = default;
 	};
 
 	struct GateParams
@@ -11,6 +11,8 @@ namespace ksmaudio::AudioEffect
 		float v = 0.0f;
 		float q = 5.0f;
 		float mix = 1.0f;
+
+		bool operator==(const LowPassFilterDSPParams&) const = default;
 	};
 
 	struct LowPassFilterParams
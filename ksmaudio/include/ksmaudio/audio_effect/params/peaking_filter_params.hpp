@@ -15,6 +15,8 @@ namespace ksmaudio::AudioEffect
 		float bandwidth = 1.2f;
 		float mix = 1.0f;
 		bool releaseEnabled = false;
+
+		bool operator==(const PeakingFilterDSPParams&) const = default;
 	};
 
 	struct PeakingFilterParams
@@ -15,6 +15,8 @@ namespace ksmaudio::AudioEffect
 		float feedback = 0.35f;
 		float stereoWidth = 0.0f;
 		float mix = 0.5f;
+
+		bool operator==(const PhaserDSPParams&) const = default;
 	};
 
 	struct PhaserParams
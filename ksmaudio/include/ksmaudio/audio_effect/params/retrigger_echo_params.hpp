@@ -12,6 +12,8 @@ namespace ksmaudio::AudioEffect
 		bool fadesOut = false;
 		float feedbackLevel = 1.0f;
 		float mix = 1.0f;
+
+		bool operator==(const RetriggerEchoDSPParams&) const = default;
 	};
 
 	struct RetriggerParams
@@ -10,6 +10,8 @@ namespace ksmaudio::AudioEffect
 		float holdTime = 0.05f;
 		float releaseTime = 0.125f;
 		float ratio = 1.0f;
+
+		bool operator==(const SidechainDSPParams&) const = default;
 	};
 
 	struct SidechainParams
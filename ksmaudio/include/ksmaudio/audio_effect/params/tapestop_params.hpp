@@ -9,6 +9,8 @@ namespace ksmaudio::AudioEffect
 		bool trigger = false;
 		bool reset = false; // triggerがoffからonになった瞬間のみtrueになる
 		float mix = 1.0f;
+
+		bool operator==(const TapestopDSPParams&) const = default;
 	};
 
 	struct TapestopParams
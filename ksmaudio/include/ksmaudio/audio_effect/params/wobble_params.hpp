@@ -11,6 +11,8 @@ namespace ksmaudio::AudioEffect
 		float freq2 = 20000.0f;
 		float q = 1.414f;
 		float mix = 0.5f;
+
+		bool operator==(const WobbleDSPParams&) const = default;
 	};
 
 	struct WobbleParams
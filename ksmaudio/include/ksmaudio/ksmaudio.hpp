@@ -2,6 +2,7 @@
 #include "stream.hpp"
 #include "stream_with_effects.hpp"
 #include "sample.hpp"
+#include "offline_renderer.hpp"
 #include "audio_effect/all.hpp"
 
 namespace ksmaudio
@@ -13,6 +14,10 @@ namespace ksmaudio
 
 	void Init(void* hWnd);
 
+	// 出力デバイスを使用せずに初期化する
+	// (デコード専用のストリームのみを使用する場合。OfflineRendererを参照)
+	void InitNoSound();
+
 	void Terminate();
 
 	void SetMute(bool isMute);
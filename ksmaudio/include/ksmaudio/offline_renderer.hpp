@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <optional>
+#include <functional>
+#include "stream_with_effects.hpp"
+
+namespace ksmaudio
+{
+	// オフラインレンダリング時のある時刻以降の入力
+	struct OfflineRenderInput
+	{
+		// Note: secはレンダリング中の時刻で上書きされるので指定不要
+		AudioEffect::Status status;
+
+		// 有効なFX音声エフェクト(空の場合はバイパス)
+		// Note: pOverrideParamsの指す先はレンダリングが終わるまで有効である必要がある
+		AudioEffect::ActiveAudioEffectDict activeAudioEffectsFX;
+
+		// 有効なLASER音声エフェクト(noneの場合はバイパス)
+		std::optional<std::size_t> activeAudioEffectIdxLaser;
+	};
+
+	// 時刻(秒)をキーとした入力のタイムライン
+	// (各時刻では、その時刻以前で直近の入力が使用される)
+	using OfflineRenderTimeline = std::map<float, OfflineRenderInput>;
+
+	// 出力デバイスを使用せずに、BGMのデコードと音声エフェクトの適用を実時間より高速に行う
+	// (DSPの回帰テストやベンチマーク、プレビュー音声の事前生成用。ksmaudio::InitNoSound()などでBASSを初期化した上で使用すること)
+	class OfflineRenderer
+	{
+	private:
+		StreamWithEffects m_stream;
+		AudioEffect::AudioEffectBus* const m_pAudioEffectBusFX;
+		AudioEffect::AudioEffectBus* const m_pAudioEffectBusLaser;
+
+	public:
+		// ゲーム中の更新間隔に近い既定のブロックサイズ(フレーム数)
+		static constexpr std::size_t kDefaultBlockFrames = 512U;
+
+		explicit OfflineRenderer(const std::string& filePath, bool enableCompressor = true, AudioEffectDSPMode dspMode = AudioEffectDSPMode::kFused);
+
+		OfflineRenderer(const OfflineRenderer&) = delete;
+
+		OfflineRenderer& operator=(const OfflineRenderer&) = delete;
+
+		// 音声エフェクトの登録やパラメータ変更の指定にはこれらのバスを使用する
+		AudioEffect::AudioEffectBus& audioEffectBusFX();
+
+		AudioEffect::AudioEffectBus& audioEffectBusLaser();
+
+		// 末尾までレンダリングし、エフェクト適用後の音声データ(float, インターリーブ)を返す
+		// (updateFuncはブロック毎に、そのブロックの先頭時刻を引数として呼ばれる。音声エフェクトのバスの更新はupdateFunc内で行う)
+		std::vector<float> render(const std::function<void(SecondsF)>& updateFunc, std::size_t blockFrames = kDefaultBlockFrames);
+
+		std::vector<float> render(const OfflineRenderTimeline& timeline, std::size_t blockFrames = kDefaultBlockFrames);
+
+		bool renderToWAVFile(const std::string& filePath, const OfflineRenderTimeline& timeline, std::size_t blockFrames = kDefaultBlockFrames);
+
+		Duration duration() const;
+
+		std::size_t sampleRate() const;
+
+		std::size_t numChannels() const;
+	};
+
+	// デコード済みの音声データ
+	struct DecodedAudio
+	{
+		// 音声データ(float, インターリーブ)
+		std::vector<float> data;
+
+		std::size_t sampleRate = 0U;
+
+		std::size_t numChannels = 0U;
+	};
+
+	// 音声ファイルのoffsetからduration分の範囲のみをデコードする
+	// (選曲画面のプレビュー音声の事前デコード用。音声ファイルの終端に達した場合はそこまでの音声データを返す。ロード失敗時はdataが空になる)
+	DecodedAudio DecodeRange(const std::string& filePath, SecondsF offset, Duration duration, bool enableCompressor = true);
+
+	// 音声データ(float, インターリーブ)を32bit floatのWAVファイルのバイナリに変換する
+	// (Streamのメモリ上のバイナリから作成するコンストラクタに渡せば、そのまま再生できる)
+	std::vector<char> EncodeWAV(const std::vector<float>& data, std::size_t sampleRate, std::size_t numChannels);
+
+	// 音声データ(float, インターリーブ)を32bit floatのWAVファイルとして書き出す
+	bool WriteWAVFile(const std::string& filePath, const std::vector<float>& data, std::size_t sampleRate, std::size_t numChannels);
+}
@@ -6,6 +6,7 @@
 #include "bass.h"
 #include "bass_fx.h"
 #include "ksmaudio/audio_effect/audio_effect.hpp"
+#include "ksmaudio/audio_effect/fused_audio_effect_graph.hpp"
 
 namespace ksmaudio
 {
@@ -15,13 +16,20 @@ namespace ksmaudio
 	class Stream
 	{
 	private:
-		const std::unique_ptr<std::vector<char>> m_preloadedBinary;
+		const std::shared_ptr<const std::vector<char>> m_preloadedBinary;
 		const HSTREAM m_hStream;
 		const BASS_CHANNELINFO m_info;
 		double m_volume;
 
+		void setupAttributes(double volume, bool enableCompressor) const;
+
 	public:
-		explicit Stream(const std::string& filePath, double volume = 1.0, bool enableCompressor = false, bool preload = false, bool loop = false);
+		// Note: decodeOnlyをtrueにした場合は再生はできず、readDecodedData()でエフェクト適用後の音声データを取得する用途になる
+		explicit Stream(const std::string& filePath, double volume = 1.0, bool enableCompressor = false, bool preload = false, bool loop = false, bool decodeOnly = false);
+
+		// メモリ上の音声ファイルのバイナリから作成する
+		// (binaryはストリームの破棄まで保持される。複数のストリームで同じバイナリを共有してもよい)
+		explicit Stream(std::shared_ptr<const std::vector<char>> binary, double volume = 1.0, bool enableCompressor = false, bool loop = false, bool decodeOnly = false);
 
 		~Stream();
 
@@ -41,6 +49,10 @@ namespace ksmaudio
 
 		void updateManually() const;
 
+		// デコード専用のストリームから、エフェクト適用後の音声データ(float, インターリーブ)を読み込む
+		// (読み込んだ要素数を返す。終端に達した場合やエラーの場合は0を返す)
+		std::size_t readDecodedData(float* pData, std::size_t dataSize) const;
+
 		SecondsF posSec() const;
 
 		void seekPosSec(SecondsF time) const;
@@ -51,6 +63,8 @@ namespace ksmaudio
 
 		void removeAudioEffect(HDSP hDSP) const;
 
+		HDSP addFusedAudioEffectGraph(AudioEffect::FusedAudioEffectGraph* pGraph, int priority) const;
+
 		void setFadeIn(Duration duration) const;
 
 		void setFadeIn(Duration duration, double volume);
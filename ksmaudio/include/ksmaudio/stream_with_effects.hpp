@@ -4,9 +4,26 @@
 
 namespace ksmaudio
 {
+	// 音声エフェクトをBASSのDSPとして登録する方式
+	enum class AudioEffectDSPMode
+	{
+		// エフェクト毎にDSPを登録する
+		kPerEffect,
+
+		// 全エフェクトを1つのDSPにまとめ、priorityの順に処理する
+		kFused,
+	};
+
 	class StreamWithEffects
 	{
 	private:
+		// Note: DSPコールバックから参照されるため、m_streamより先に宣言して後に破棄されるようにしている
+		const std::unique_ptr<AudioEffect::FusedAudioEffectGraph> m_fusedGraph;
+
+		// 音声エフェクトの遅延バッファの確保元
+		// Note: 同上の理由でm_streamより先に宣言している
+		const std::unique_ptr<AudioEffect::detail::DelayLineArena> m_delayLineArena;
+
 		Stream m_stream;
 
 		// Note: unique_ptr is employed here because AudioEffectBus cannot be moved (because of const members).
@@ -16,7 +33,7 @@ namespace ksmaudio
 
 	public:
 		// TODO: filePath encoding problem
-		explicit StreamWithEffects(const std::string& filePath, double volume = 1.0, bool enableCompressor = false, bool preload = false);
+		explicit StreamWithEffects(const std::string& filePath, double volume = 1.0, bool enableCompressor = false, bool preload = false, AudioEffectDSPMode dspMode = AudioEffectDSPMode::kPerEffect, bool decodeOnly = false);
 
 		StreamWithEffects(const StreamWithEffects&) = delete;
 
@@ -34,6 +51,8 @@ namespace ksmaudio
 
 		void updateManually() const;
 
+		std::size_t readDecodedData(float* pData, std::size_t dataSize) const;
+
 		SecondsF posSec() const;
 
 		void seekPosSec(SecondsF timeSec) const;
@@ -2,9 +2,11 @@
 
 namespace ksmaudio::AudioEffect
 {
-	AudioEffectBus::AudioEffectBus(bool isLaser, Stream* pStream)
+	AudioEffectBus::AudioEffectBus(bool isLaser, Stream* pStream, detail::DelayLineArena* pDelayLineArena, FusedAudioEffectGraph* pFusedGraph)
 		: m_isLaser(isLaser)
 		, m_pStream(pStream)
+		, m_pDelayLineArena(pDelayLineArena)
+		, m_pFusedGraph(pFusedGraph)
 	{
 	}
 
@@ -14,6 +16,16 @@ namespace ksmaudio::AudioEffect
 		{
 			m_pStream->removeAudioEffect(hDSP);
 		}
+
+		if (m_pFusedGraph != nullptr && !m_audioEffects.empty())
+		{
+			m_pStream->lockBegin();
+			for (const auto& audioEffect : m_audioEffects)
+			{
+				m_pFusedGraph->remove(audioEffect.get());
+			}
+			m_pStream->lockEnd();
+		}
     }
 
 	void AudioEffectBus::updateByFX(const AudioEffect::Status& status, const ActiveAudioEffectDict& activeAudioEffectDict)
@@ -112,6 +124,29 @@ namespace ksmaudio::AudioEffect
 		}
 	}
 
+	void AudioEffectBus::setStreamTimeOffset(double offsetSec)
+	{
+		m_streamTimeOffsetSec = offsetSec;
+		for (const auto& audioEffect : m_audioEffects)
+		{
+			audioEffect->setStreamTimeOffset(offsetSec);
+		}
+	}
+
+	void AudioEffectBus::reserveDelayTime(std::size_t audioEffectIdx, float maxDelaySec)
+	{
+		if (audioEffectIdx >= m_audioEffects.size())
+		{
+			assert(false && "Audio effect index out of range");
+			return;
+		}
+
+		// 遅延バッファの確保元はDSPコールバックと共有しているため、ロックした上で確保
+		m_pStream->lockBegin();
+		m_audioEffects[audioEffectIdx]->reserveDelayTime(maxDelaySec);
+		m_pStream->lockEnd();
+	}
+
 	bool AudioEffectBus::audioEffectContainsName(const std::string& name) const
 	{
 		return m_nameIdxDict.contains(name);
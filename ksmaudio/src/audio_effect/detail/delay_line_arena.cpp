@@ -0,0 +1,78 @@
+﻿#include "ksmaudio/audio_effect/detail/delay_line_arena.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace ksmaudio::AudioEffect::detail
+{
+	namespace
+	{
+		// 他の音声エフェクトで再利用しやすいよう、2の累乗に切り上げる
+		std::size_t BlockSize(std::size_t minSize)
+		{
+			return std::bit_ceil((std::max)(minSize, std::size_t{ 1U }));
+		}
+	}
+
+	std::span<float> DelayLineArena::allocate(std::size_t size)
+	{
+		auto& block = m_blocks.emplace_back(std::make_unique<float[]>(size));
+		m_totalSize += size;
+
+		// 未使用のブロックの数は確保済みのブロックの数を超えないため、ここで容量を確保しておけばrelease()でメモリ確保は発生しない
+		m_freeBlocks.reserve(m_blocks.size());
+
+		return { block.get(), size };
+	}
+
+	std::span<float> DelayLineArena::acquire(std::size_t minSize)
+	{
+		const std::span<float> block = tryAcquire(minSize);
+		if (!block.empty())
+		{
+			return block;
+		}
+		return allocate(BlockSize(minSize));
+	}
+
+	std::span<float> DelayLineArena::tryAcquire(std::size_t minSize)
+	{
+		const std::size_t size = BlockSize(minSize);
+
+		// 未使用のブロックのうち、サイズが足りる最小のものを再利用する
+		const auto itr = std::min_element(m_freeBlocks.begin(), m_freeBlocks.end(),
+			[size](const std::span<float>& a, const std::span<float>& b)
+			{
+				if ((a.size() >= size) != (b.size() >= size))
+				{
+					return a.size() >= size;
+				}
+				return a.size() < b.size();
+			});
+		if (itr != m_freeBlocks.end() && itr->size() >= size)
+		{
+			const std::span<float> block = *itr;
+			m_freeBlocks.erase(itr);
+			return block;
+		}
+		return {};
+	}
+
+	void DelayLineArena::reserve(std::size_t minSize)
+	{
+		m_freeBlocks.push_back(allocate(BlockSize(minSize)));
+	}
+
+	void DelayLineArena::release(std::span<float> block)
+	{
+		if (block.empty())
+		{
+			return;
+		}
+		m_freeBlocks.push_back(block);
+	}
+
+	std::size_t DelayLineArena::totalSize() const
+	{
+		return m_totalSize;
+	}
+}
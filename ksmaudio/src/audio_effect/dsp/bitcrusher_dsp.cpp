@@ -51,4 +51,10 @@ namespace ksmaudio::AudioEffect
 	{
 		// 特に何もしない
 	}
+
+	bool BitcrusherDSP::isIdle(bool bypass, const BitcrusherDSPParams& params) const
+	{
+		// mixが0、またはreductionが0の場合はprocess()内で何もしない
+		return m_info.isUnsupported || bypass || params.mix == 0.0f || params.reduction == 0.0f;
+	}
 }
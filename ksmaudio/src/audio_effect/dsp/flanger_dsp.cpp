@@ -2,11 +2,35 @@
 
 namespace ksmaudio::AudioEffect
 {
+	namespace
+	{
+		// ディレイタイムの最大秒数
+		constexpr std::size_t kMaxDelayTimeSec = 3U;
+	}
+
+	void FlangerDSP::reserveDelayFrames(std::size_t numFrames, bool allowsAllocation)
+	{
+		// 通常のdelay・depthであれば内部のバッファに収まるため、それを超える場合のみ遅延バッファを確保する
+		numFrames = (std::min)(numFrames, kMaxDelayTimeSec * m_info.sampleRate);
+		if (numFrames <= m_ringBuffer.numFrames() || m_info.pDelayLineArena == nullptr)
+		{
+			return;
+		}
+		const std::span<float> block = allowsAllocation
+			? m_info.pDelayLineArena->acquire(numFrames * m_info.numChannels)
+			: m_info.pDelayLineArena->tryAcquire(numFrames * m_info.numChannels);
+		if (block.empty())
+		{
+			return;
+		}
+		m_info.pDelayLineArena->release(m_ringBuffer.attach(block));
+	}
+
 	FlangerDSP::FlangerDSP(const DSPCommonInfo& info)
 		: m_info(info)
 		, m_ringBuffer(
-			static_cast<std::size_t>(info.sampleRate) * 3 * info.numChannels, // 3 seconds
-			info.numChannels)
+			detail::kDelayLineTailFrames * (std::max)(info.numChannels, std::size_t{ 1U }),
+			(std::max)(info.numChannels, std::size_t{ 1U }))
 	{
 		for (auto& filter : m_lowShelfFilters)
 		{
@@ -16,11 +40,15 @@ namespace ksmaudio::AudioEffect
 
 	void FlangerDSP::process(float* pData, std::size_t dataSize, bool bypass, const FlangerDSPParams& params)
 	{
-		if (m_info.isUnsupported || dataSize > m_ringBuffer.size())
+		if (m_info.isUnsupported)
 		{
 			return;
 		}
 
+		// 通常はreserveDelayTime()で譜面中の最大のdelay・depth分が確保済みだが、足りない場合は未使用のブロックがあればここで拡張する
+		// (DSPコールバック内のためメモリ確保は行わない。lerpedDelayで1フレーム先まで読むため余分に確保している)
+		reserveDelayFrames(static_cast<std::size_t>((params.delay + params.depth) * m_info.sampleRateScale) + 2U, false);
+
 		assert(dataSize % m_info.numChannels == 0);
 		const std::size_t numFrames = dataSize / m_info.numChannels;
 		if (bypass || params.mix == 0.0f)
@@ -57,4 +85,21 @@ namespace ksmaudio::AudioEffect
 	{
 		// 特に何もしない
 	}
+
+	bool FlangerDSP::isIdle(bool bypass, const FlangerDSPParams& params) const
+	{
+		// バイパス中もリングバッファへの書き込みが必要なため省略不可
+		return m_info.isUnsupported;
+	}
+
+	void FlangerDSP::reserveDelayTime(float maxDelaySec)
+	{
+		if (maxDelaySec <= 0.0f)
+		{
+			return;
+		}
+
+		// 有効化された時点で遅延バッファが足りるよう、事前に確保しておく
+		reserveDelayFrames(static_cast<std::size_t>(maxDelaySec * m_info.sampleRate) + 2U, true);
+	}
 }
@@ -65,4 +65,10 @@ namespace ksmaudio::AudioEffect
     {
         m_triggerHandler.setFramesUntilTrigger(params.secUntilTrigger, m_info.sampleRate);
     }
+
+    bool GateDSP::isIdle(bool bypass, const GateDSPParams& params) const
+    {
+        // バイパス中もトリガのタイミングを進める必要があるため省略不可
+        return false;
+    }
 }
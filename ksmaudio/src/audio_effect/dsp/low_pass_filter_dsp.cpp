@@ -44,27 +44,19 @@ namespace ksmaudio::AudioEffect
 		{
 			// 値が飛ぶことでノイズが入らないようvの値に対して線形のイージングを入れる
 			const bool vUpdated = m_vEasing.update(params.v);
-			if (vUpdated)
+			if (!vUpdated)
 			{
-				freq = GetLowPassFilterFreqValue(m_vEasing.value());
-				mixSkipped = isBypassed || freq > kFreqThresholdMax; // 高周波数に対しては適用しない
+				// イージングが完了していれば残りのフレームではフィルタ係数が変化しないため、まとめて処理する
+				m_lowPassFilter.processWithMix(pData, frameSize - i, m_info.numChannels, mixSkipped ? 0.0f : params.mix);
+				break;
 			}
 
-			// 各チャンネルにフィルタを適用
-			for (std::size_t ch = 0U; ch < m_info.numChannels; ++ch)
-			{
-				if (vUpdated)
-				{
-					m_lowPassFilters[ch].setLowPassFilter(freq, params.q, m_info.sampleRateFloat);
-				}
+			freq = GetLowPassFilterFreqValue(m_vEasing.value());
+			mixSkipped = isBypassed || freq > kFreqThresholdMax; // 高周波数に対しては適用しない
+			m_lowPassFilter.setLowPassFilter(freq, params.q, m_info.sampleRateFloat);
 
-				const float wet = m_lowPassFilters[ch].process(*pData);
-				if (!mixSkipped)
-				{
-					*pData = std::lerp(*pData, wet, params.mix);
-				}
-				++pData;
-			}
+			m_lowPassFilter.processWithMix(pData, 1U, m_info.numChannels, mixSkipped ? 0.0f : params.mix);
+			pData += m_info.numChannels;
 		}
 	}
 
@@ -72,4 +64,10 @@ namespace ksmaudio::AudioEffect
 	{
 		// 特に何もしない
 	}
+
+	bool LowPassFilterDSP::isIdle(bool bypass, const LowPassFilterDSPParams& params) const
+	{
+		// 切り替え時のノイズ回避のためにバイパス中もフィルタ処理が必要なため省略不可
+		return m_info.isUnsupported;
+	}
 }
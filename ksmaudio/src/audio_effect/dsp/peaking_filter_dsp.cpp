@@ -1,5 +1,6 @@
 ﻿#include "ksmaudio/audio_effect/dsp/peaking_filter_dsp.hpp"
 #include <algorithm>
+#include <utility>
 
 namespace ksmaudio::AudioEffect
 {
@@ -103,11 +104,11 @@ namespace ksmaudio::AudioEffect
 		{
 		}
 
-		void PeakingFilterRelease::update(float freq, float baseGainDb, float mix, bool mixSkipped)
+		void PeakingFilterRelease::update(float freq, float baseGainDb, float mix, bool mixSkipped, std::size_t numFrames)
 		{
 			if (mixSkipped)
 			{
-				++m_mixSkippedFrames;
+				m_mixSkippedFrames += numFrames;
 			}
 			else
 			{
@@ -166,10 +167,7 @@ namespace ksmaudio::AudioEffect
 			if (shouldUseRelease)
 			{
 				// 余韻を適用する必要がある場合はフィルタ係数を毎回更新
-				for (std::size_t ch = 0U; ch < m_info.numChannels; ++ch)
-				{
-					m_peakingFilters[ch].setPeakingFilter(m_release.freq(), params.bandwidth, m_release.baseGainDb() * params.gainRate, m_info.sampleRateFloat);
-				}
+				m_peakingFilter.setPeakingFilter(m_release.freq(), params.bandwidth, m_release.baseGainDb() * params.gainRate, m_info.sampleRateFloat);
 			}
 			else
 			{
@@ -177,28 +175,24 @@ namespace ksmaudio::AudioEffect
 				if (valueUpdated)
 				{
 					// 値が更新された場合はフィルタ係数を更新
-					for (std::size_t ch = 0U; ch < m_info.numChannels; ++ch)
-					{
-						m_peakingFilters[ch].setPeakingFilter(m_valueController.freq(), params.bandwidth, m_valueController.baseGainDb() * params.gainRate, m_info.sampleRateFloat);
-					}
+					m_peakingFilter.setPeakingFilter(m_valueController.freq(), params.bandwidth, m_valueController.baseGainDb() * params.gainRate, m_info.sampleRateFloat);
 				}
-			}
-
-			// 各チャンネルにフィルタを適用
-			for (std::size_t ch = 0U; ch < m_info.numChannels; ++ch)
-			{
-				const float wet = m_peakingFilters[ch].process(*pData);
-				if (shouldUseRelease)
+				else
 				{
-					*pData = std::lerp(*pData, wet, m_release.mix());
+					// イージングが完了していて余韻も不要であれば、残りのフレームではフィルタ係数・ミックス量が変化しないため、まとめて処理する
+					// (余韻は一度不要になると同一ブロック内で再び必要になることはない)
+					const std::size_t numRestFrames = frameSize - i;
+					m_peakingFilter.processWithMix(pData, numRestFrames, m_info.numChannels, mixSkipped ? 0.0f : params.mix);
+					m_release.update(m_valueController.freq(), m_valueController.baseGainDb(), params.mix, mixSkipped, numRestFrames);
+					break;
 				}
-				else if (!mixSkipped)
-				{
-					*pData = std::lerp(*pData, wet, params.mix);
-				}
-				++pData;
 			}
 
+			// 各チャンネルにフィルタを適用
+			const float mix = shouldUseRelease ? m_release.mix() : (mixSkipped ? 0.0f : params.mix);
+			m_peakingFilter.processWithMix(pData, 1U, m_info.numChannels, mix);
+			pData += m_info.numChannels;
+
 			m_release.update(m_valueController.freq(), m_valueController.baseGainDb(), params.mix, mixSkipped);
 		}
 	}
@@ -207,4 +201,10 @@ namespace ksmaudio::AudioEffect
 	{
 		// 特に何もしない
 	}
+
+	bool PeakingFilterDSP::isIdle(bool bypass, const PeakingFilterDSPParams& params) const
+	{
+		// 切り替え時のノイズ回避と余韻のためにバイパス中もフィルタ処理が必要なため省略不可
+		return m_info.isUnsupported;
+	}
 }
@@ -1,4 +1,5 @@
 ﻿#include "ksmaudio/audio_effect/dsp/phaser_dsp.hpp"
+#include <algorithm>
 
 namespace ksmaudio::AudioEffect
 {
@@ -35,37 +36,64 @@ namespace ksmaudio::AudioEffect
 		const float log10Freq1 = detail::Log10Freq(params.freq1);
 		const float log10Freq2 = detail::Log10Freq(params.freq2);
 		const float centerFreq = detail::InterpolateFreqInLog10ScaleWithPrecalculatedLog10(0.5f, log10Freq1, log10Freq2);
-		for (std::size_t channel = 0; channel < m_info.numChannels; ++channel)
-		{
-			m_hiCutFilters[channel].setHighShelfFilter(centerFreq, kHiCutFilterQ, kHiCutFilterGain, m_info.sampleRateFloat);
-		}
+		m_hiCutFilter.setHighShelfFilter(centerFreq, kHiCutFilterQ, kHiCutFilterGain, m_info.sampleRateFloat);
 
-		const std::size_t stage = params.mix > 0.0f ? params.stage : 0U;
+		const std::size_t stage = params.mix > 0.0f ? (std::min)(params.stage, kMaxNumAllPassFilters) : 0U;
 		if (stage > 0U)
 		{
 			for (std::size_t i = 0; i < numFrames; ++i)
 			{
-				std::array<std::array<float, 2>, kMaxNumAllPassFilters> wetArray = m_prevWetArrayForFeedback;
-				for (std::size_t channel = 0; channel < m_info.numChannels; ++channel)
+				// フィルタ係数(sin/cos/pow)の計算は負荷が高いため、制御レートで計算し間のフレームでは線形補間する
+				// (全ステージで同じ周波数を使用するため、係数はチャンネル毎に1回だけ計算する)
+				if (i % detail::kBiquadControlRateFrames == 0U)
 				{
-					const float lfoValue = detail::TriangleWithStereoWidth(m_lfoTimeRate, channel, params.stereoWidth);
-					const float freq = detail::InterpolateFreqInLog10ScaleWithPrecalculatedLog10(lfoValue, log10Freq1, log10Freq2);
-					for (std::size_t s = 0; s < kMaxNumAllPassFilters; ++s)
+					const std::size_t numSegmentFrames = (std::min)(detail::kBiquadControlRateFrames, numFrames - i);
+
+					// 区間の最後のフレームでのLFOの値を補間の目標とする
+					const float segmentEndLfoTimeRate = detail::DecimalPart(m_lfoTimeRate + lfoSpeed * static_cast<float>(numSegmentFrames - 1U));
+					for (std::size_t channel = 0; channel < m_info.numChannels; ++channel)
 					{
-						const float input = s == 0U ? (*pData + m_prevWetArrayForFeedback[kMaxNumAllPassFilters - 1U][channel] * params.feedback) : wetArray[s - 1U][channel];
-						if (s < stage)
-						{
-							m_allPassFilters[s][channel].setAllPassFilter(freq, params.q, m_info.sampleRateFloat);
-							wetArray[s][channel] = m_allPassFilters[s][channel].process(input);
-						}
-						else
+						const float lfoValue = detail::TriangleWithStereoWidth(segmentEndLfoTimeRate, channel, params.stereoWidth);
+						const float freq = detail::InterpolateFreqInLog10ScaleWithPrecalculatedLog10(lfoValue, log10Freq1, log10Freq2);
+						detail::BiquadCoefficients<float> coefs;
+						coefs.setAllPassFilter(freq, params.q, m_info.sampleRateFloat);
+						for (std::size_t s = 0; s < stage; ++s)
 						{
-							wetArray[s][channel] = input;
+							if (s < m_numActiveStages)
+							{
+								m_allPassFilters[s].rampCoefficients(channel, coefs, numSegmentFrames);
+							}
+							else
+							{
+								// 直前まで使用していなかったステージは係数が古いままなので、補間せずに設定する
+								m_allPassFilters[s].setCoefficients(channel, coefs);
+							}
 						}
 					}
+					m_numActiveStages = stage;
+				}
+
+				std::array<float, 2> input = { 0.0f, 0.0f };
+				for (std::size_t channel = 0; channel < m_info.numChannels; ++channel)
+				{
+					input[channel] = pData[channel] + m_prevWetArrayForFeedback[kMaxNumAllPassFilters - 1U][channel] * params.feedback;
+				}
+
+				// 左右チャンネルをまとめてオールパスフィルタに通す
+				std::array<std::array<float, 2>, kMaxNumAllPassFilters> wetArray;
+				for (std::size_t s = 0; s < kMaxNumAllPassFilters; ++s)
+				{
+					if (s < stage)
+					{
+						input = m_allPassFilters[s].processFrame(input);
+					}
+					wetArray[s] = input;
+				}
 
-					const float wetFiltered = m_hiCutFilters[channel].process(wetArray[kMaxNumAllPassFilters - 1U][channel]);
-					*pData = std::lerp(*pData, wetFiltered, params.mix / 2);
+				const std::array<float, 2> wetFiltered = m_hiCutFilter.processFrame(wetArray[kMaxNumAllPassFilters - 1U]);
+				for (std::size_t channel = 0; channel < m_info.numChannels; ++channel)
+				{
+					*pData = std::lerp(*pData, wetFiltered[channel], params.mix / 2);
 					++pData;
 				}
 
@@ -83,6 +111,8 @@ namespace ksmaudio::AudioEffect
 			// (それ以外の場合はisUnsupportedがtrueになるためここに来ない)
 			assert(m_info.numChannels == 1U || m_info.numChannels == 2U);
 
+			m_numActiveStages = 0U;
+
 			m_lfoTimeRate = detail::DecimalPart(m_lfoTimeRate + lfoSpeed * numFrames);
 
 			// 末尾のサンプルの値を反映
@@ -101,4 +131,10 @@ namespace ksmaudio::AudioEffect
 	{
 		// 特に何もしない
 	}
+
+	bool PhaserDSP::isIdle(bool bypass, const PhaserDSPParams& params) const
+	{
+		// バイパス中もLFOの位相を進める必要があるため省略不可
+		return m_info.isUnsupported;
+	}
 }
@@ -1,12 +1,36 @@
 ﻿#include "ksmaudio/audio_effect/dsp/retrigger_echo_dsp.hpp"
+#include <utility>
 
 namespace ksmaudio::AudioEffect
 {
+    namespace
+    {
+        // wave_lengthの最大秒数
+        constexpr std::size_t kMaxWaveLengthSec = 10U;
+    }
+
+    void RetriggerEchoDSP::reserveDelayFrames(std::size_t numFrames, bool allowsAllocation)
+    {
+        numFrames = (std::min)(numFrames, kMaxWaveLengthSec * m_info.sampleRate);
+        if (m_info.isUnsupported || numFrames <= m_linearBuffer.numFrames() || m_info.pDelayLineArena == nullptr)
+        {
+            return;
+        }
+        const std::span<float> block = allowsAllocation
+            ? m_info.pDelayLineArena->acquire(numFrames * m_info.numChannels)
+            : m_info.pDelayLineArena->tryAcquire(numFrames * m_info.numChannels);
+        if (block.empty())
+        {
+            return;
+        }
+        m_info.pDelayLineArena->release(m_linearBuffer.attach(block));
+    }
+
     RetriggerEchoDSP::RetriggerEchoDSP(const DSPCommonInfo& info)
         : m_info(info)
         , m_linearBuffer(
-            static_cast<std::size_t>(info.sampleRate) * 10 * info.numChannels, // 10 seconds
-            info.numChannels)
+            detail::kDelayLineTailFrames * (std::max)(info.numChannels, std::size_t{ 1U }),
+            (std::max)(info.numChannels, std::size_t{ 1U }))
     {
     }
 
@@ -17,6 +41,10 @@ namespace ksmaudio::AudioEffect
         const std::size_t frameSize = dataSize / m_info.numChannels;
         const std::size_t numLoopFrames = static_cast<std::size_t>(params.waveLength * m_info.sampleRate);
         const std::size_t numNonZeroFrames = static_cast<std::size_t>(numLoopFrames * params.rate);
+
+        // 通常はreserveDelayTime()で譜面中の最大のwave_length分が確保済みだが、足りない場合は未使用のブロックがあればここで拡張する
+        // (DSPコールバック内のためメモリ確保は行わない。拡張前に書き込めなかった部分は無音になる)
+        reserveDelayFrames(numLoopFrames, false);
         if (0 <= m_framesUntilTrigger && std::cmp_less(m_framesUntilTrigger, frameSize)) // m_framesUntilTrigger < frameSize
         {
             // 今回の処理フレーム中にトリガ更新タイミングが含まれている場合、トリガ更新の前後2つに分けて処理
@@ -72,4 +100,21 @@ namespace ksmaudio::AudioEffect
             m_linearBuffer.resetReadWriteCursors();
         }
     }
+
+    void RetriggerEchoDSP::reserveDelayTime(float maxDelaySec)
+    {
+        if (maxDelaySec <= 0.0f)
+        {
+            return;
+        }
+
+        // トリガ更新前から録音しておく必要があるため、有効化されてからではなく事前に確保しておく
+        reserveDelayFrames(static_cast<std::size_t>(maxDelaySec * m_info.sampleRate) + 1U, true);
+    }
+
+    bool RetriggerEchoDSP::isIdle(bool bypass, const RetriggerEchoDSPParams& params) const
+    {
+        // バイパス中もバッファへの書き込みと読み出しカーソルの更新が必要なため省略不可
+        return false;
+    }
 }
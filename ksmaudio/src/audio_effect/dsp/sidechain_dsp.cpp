@@ -77,4 +77,10 @@ namespace ksmaudio::AudioEffect
 			}
 		}
 	}
+
+	bool SidechainDSP::isIdle(bool bypass, const SidechainDSPParams& params) const
+	{
+		// バイパス中はトリガ更新までのフレーム数も進めないので、process()を省略しても変わらない
+		return m_info.isUnsupported || bypass;
+	}
 }
@@ -1,5 +1,6 @@
 ﻿#include "ksmaudio/audio_effect/dsp/tapestop_dsp.hpp"
 #include <cmath>
+#include <utility>
 
 namespace ksmaudio::AudioEffect
 {
@@ -25,8 +26,12 @@ namespace ksmaudio::AudioEffect
 			return 1.0f;
 		}
 
-		// ディレイタイムの最大秒数(リングバッファのサイズ)
+		// ディレイタイムの最大秒数(リングバッファの最大サイズ)
 		constexpr std::size_t kMaxDelayTimeSec = 10U;
+
+		// reserveDelayTime()が呼ばれていない場合に、テープストップ開始時に取得を試みるリングバッファの秒数
+		// (ディレイタイムは1フレームあたり最大1フレームずつしか伸びないため、足りなくなった時点で倍々に拡張する)
+		constexpr std::size_t kInitialDelayTimeSec = 1U;
 	}
 
 	namespace detail
@@ -57,9 +62,62 @@ namespace ksmaudio::AudioEffect
 		}
 	}
 
+	void TapestopDSP::reserveDelayFrames(std::size_t numFrames)
+	{
+		if (numFrames <= m_timeModulator.numFrames() || m_info.pDelayLineArena == nullptr)
+		{
+			return;
+		}
+
+		std::span<float> block;
+		if (numFrames * m_info.numChannels <= m_reservedBlock.size())
+		{
+			// 専用のブロックで足りる場合はそれを使う
+			block = m_reservedBlock;
+		}
+		else
+		{
+			numFrames = (std::max)(numFrames, (std::max)(m_timeModulator.numFrames() * 2U, kInitialDelayTimeSec * m_info.sampleRate));
+			numFrames = (std::min)(numFrames, kMaxDelayTimeSec * m_info.sampleRate);
+			block = m_info.pDelayLineArena->tryAcquire(numFrames * m_info.numChannels);
+			if (block.empty())
+			{
+				// 未使用のブロックがない場合は拡張しない(ディレイタイムは現在のバッファの長さで頭打ちになる)
+				return;
+			}
+		}
+
+		// ディレイタイムはテープストップ開始時に0から1フレームあたり最大1フレームずつしか伸びず、引き継いだ履歴より古い部分は読まないため、0で埋める必要はない
+		// (DSPコールバック内で大きなバッファ全体を初期化しないようにするため)
+		releaseBlock(m_timeModulator.attach(block, false));
+	}
+
+	void TapestopDSP::releaseDelayLine()
+	{
+		if (!m_timeModulator.isAttached() || m_info.pDelayLineArena == nullptr)
+		{
+			return;
+		}
+
+		// テープストップ中以外は直近の少量の入力のみを保持し、遅延バッファは他の音声エフェクトで再利用できるよう返却する
+		// (専用のブロックは次のテープストップのために保持しておく)
+		releaseBlock(m_timeModulator.detach());
+	}
+
+	void TapestopDSP::releaseBlock(std::span<float> block)
+	{
+		if (block.empty() || block.data() == m_reservedBlock.data())
+		{
+			return;
+		}
+		m_info.pDelayLineArena->release(block);
+	}
+
 	TapestopDSP::TapestopDSP(const DSPCommonInfo& info)
 		: m_info(info)
-		, m_timeModulator(kMaxDelayTimeSec * info.sampleRate * info.numChannels, info.numChannels)
+		, m_timeModulator(
+			detail::kDelayLineTailFrames * (std::max)(info.numChannels, std::size_t{ 1U }),
+			(std::max)(info.numChannels, std::size_t{ 1U }))
 	{
 	}
 
@@ -74,7 +132,11 @@ namespace ksmaudio::AudioEffect
 		
 		if (!bypass && params.trigger)
 		{
+			// ディレイタイムは1フレームあたり最大1フレームずつ伸びるため、今回の処理分を見越して確保
+			// (lerpedDelayで1フレーム先まで読むため余分に確保している)
 			const std::size_t frameSize = dataSize / m_info.numChannels;
+			reserveDelayFrames(static_cast<std::size_t>(m_timeModulator.delaySample()) + frameSize + 2U);
+
 			for (std::size_t i = 0U; i < frameSize; ++i)
 			{
 				const float playSpeed = m_speedController.nextSpeed(params, m_info.sampleRateScale);
@@ -91,6 +153,7 @@ namespace ksmaudio::AudioEffect
 		}
 		else
 		{
+			releaseDelayLine();
 			m_timeModulator.writeAndAdvanceCursor(pData, dataSize);
 		}
 	}
@@ -103,4 +166,33 @@ namespace ksmaudio::AudioEffect
 			m_speedController.reset();
 		}
 	}
+
+	bool TapestopDSP::isIdle(bool bypass, const TapestopDSPParams& params) const
+	{
+		// バイパス中もリングバッファへの書き込みが必要なため省略不可
+		return m_info.isUnsupported;
+	}
+
+	void TapestopDSP::reserveDelayTime(float maxDelaySec)
+	{
+		if (m_info.isUnsupported || maxDelaySec <= 0.0f || m_info.pDelayLineArena == nullptr)
+		{
+			return;
+		}
+
+		// テープストップ中のみ使用するため、ここではアタッチせずこのDSP専用のブロックとして取得しておき、テープストップ開始時にアタッチする
+		// (アリーナの未使用のブロックとして追加すると、テープストップ開始前に他の音声エフェクトのtryAcquire()で取得されてしまうため)
+		const std::size_t numFrames = (std::min)(static_cast<std::size_t>(maxDelaySec * m_info.sampleRate) + 2U, kMaxDelayTimeSec * m_info.sampleRate);
+		if (numFrames * m_info.numChannels <= m_reservedBlock.size())
+		{
+			return;
+		}
+		const std::span<float> prevReservedBlock = std::exchange(m_reservedBlock, m_info.pDelayLineArena->acquire(numFrames * m_info.numChannels));
+
+		// 以前の専用のブロックは、使用中でなければ返却する(テープストップ中の場合はテープストップ終了時に返却される)
+		if (m_timeModulator.buffer().data() != prevReservedBlock.data())
+		{
+			releaseBlock(prevReservedBlock);
+		}
+	}
 }
@@ -1,4 +1,5 @@
 ﻿#include "ksmaudio/audio_effect/dsp/wobble_dsp.hpp"
+#include <algorithm>
 
 namespace ksmaudio::AudioEffect
 {
@@ -36,6 +37,11 @@ namespace ksmaudio::AudioEffect
 
     void WobbleDSP::process(float* pData, std::size_t dataSize, bool bypass, const WobbleDSPParams& params)
     {
+        if (m_info.isUnsupported)
+        {
+            return;
+        }
+
         assert(dataSize % m_info.numChannels == 0);
 
         const std::size_t frameSize = dataSize / m_info.numChannels;
@@ -50,34 +56,40 @@ namespace ksmaudio::AudioEffect
             {
                 // Here, a fixed frequency is used to reduce computational costs
                 const float freq = WobbleFreq(m_triggerHandler.framesSincePrevTrigger(), numPeriodFrames, params.freq1, params.freq2);
-                for (std::size_t ch = 0U; ch < m_info.numChannels; ++ch)
-                {
-                    m_lowPassFilters[ch].setLowPassFilter(freq, params.q, m_info.sampleRateFloat);
-                }
-                for (std::size_t i = 0U; i < frameSize; ++i)
-                {
-                    for (std::size_t ch = 0U; ch < m_info.numChannels; ++ch)
-                    {
-                        m_lowPassFilters[ch].process(*pData);
-                        ++pData;
-                    }
-                }
+                m_lowPassFilter.setLowPassFilter(freq, params.q, m_info.sampleRateFloat);
+                m_isLowPassFilterInitialized = true;
+                m_lowPassFilter.processWithMix(pData, frameSize, m_info.numChannels, 0.0f);
             }
 
             return;
         }
 
         // Wobble processing main
-        for (std::size_t i = 0U; i < frameSize; ++i)
+        // The filter coefficients are calculated at control rate and linearly interpolated in between,
+        // since calculating them for every frame (sin/cos) is costly
+        for (std::size_t i = 0U; i < frameSize; i += detail::kBiquadControlRateFrames)
         {
+            const std::size_t numSegmentFrames = (std::min)(detail::kBiquadControlRateFrames, frameSize - i);
+
+            // Use the LFO value at the last frame of the segment as the interpolation target
+            m_triggerHandler.advanceBatch(numSegmentFrames - 1U);
             const float freq = WobbleFreq(m_triggerHandler.framesSincePrevTrigger(), numPeriodFrames, params.freq1, params.freq2);
-            for (std::size_t ch = 0U; ch < m_info.numChannels; ++ch)
+            m_triggerHandler.advance();
+
+            detail::BiquadCoefficients<float> coefs;
+            coefs.setLowPassFilter(freq, params.q, m_info.sampleRateFloat);
+            if (m_isLowPassFilterInitialized)
             {
-                m_lowPassFilters[ch].setLowPassFilter(freq, params.q, m_info.sampleRateFloat);
-                *pData = m_lowPassFilters[ch].process(*pData);
-                ++pData;
+                m_lowPassFilter.rampCoefficients(coefs, numSegmentFrames);
             }
-            m_triggerHandler.advance();
+            else
+            {
+                // The initial coefficients (pass-through) are not a low-pass filter, so set them without interpolation
+                m_lowPassFilter.setCoefficients(coefs);
+                m_isLowPassFilterInitialized = true;
+            }
+            m_lowPassFilter.process(pData, pData, numSegmentFrames, m_info.numChannels);
+            pData += numSegmentFrames * m_info.numChannels;
         }
     }
 
@@ -85,4 +97,10 @@ namespace ksmaudio::AudioEffect
     {
         m_triggerHandler.setFramesUntilTrigger(params.secUntilTrigger, m_info.sampleRate);
     }
+
+    bool WobbleDSP::isIdle(bool bypass, const WobbleDSPParams& params) const
+    {
+        // バイパス中もトリガのタイミングを進める必要があるため省略不可
+        return false;
+    }
 }
@@ -0,0 +1,32 @@
+﻿#include "ksmaudio/audio_effect/fused_audio_effect_graph.hpp"
+#include <algorithm>
+
+namespace ksmaudio::AudioEffect
+{
+	void FusedAudioEffectGraph::process(float* pData, std::size_t dataSize, std::optional<std::int64_t> blockStartFrame)
+	{
+		for (const Node& node : m_nodes)
+		{
+			// 処理不要な状態のエフェクトは、その状態のイベントを適用済みの区間のみ各エフェクト側でスキップされる
+			// (ゲームスレッド側の状態で判定すると、まだ再生されていないイベントの区間まで省略されてしまうため)
+			node.pAudioEffect->process(pData, dataSize, blockStartFrame);
+		}
+	}
+
+	void FusedAudioEffectGraph::add(IAudioEffect* pAudioEffect, int priority)
+	{
+		// 同じpriority同士は追加した順に処理されるよう、同じpriorityの末尾に挿入する
+		const auto itr = std::find_if(m_nodes.begin(), m_nodes.end(), [priority](const Node& node) { return node.priority < priority; });
+		m_nodes.insert(itr, Node{ .pAudioEffect = pAudioEffect, .priority = priority });
+	}
+
+	void FusedAudioEffectGraph::remove(IAudioEffect* pAudioEffect)
+	{
+		std::erase_if(m_nodes, [pAudioEffect](const Node& node) { return node.pAudioEffect == pAudioEffect; });
+	}
+
+	std::size_t FusedAudioEffectGraph::size() const
+	{
+		return m_nodes.size();
+	}
+}
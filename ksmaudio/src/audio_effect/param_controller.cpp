@@ -1,4 +1,5 @@
 ﻿#include "ksmaudio/audio_effect/param_controller.hpp"
+#include <utility>
 
 namespace ksmaudio::AudioEffect
 {
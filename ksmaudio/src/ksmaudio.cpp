@@ -1,6 +1,19 @@
 ﻿#include "ksmaudio/ksmaudio.hpp"
 #include "bass.h"
 
+namespace
+{
+	void SetConfig()
+	{
+		BASS_SetConfig(BASS_CONFIG_BUFFER, ksmaudio::kBufferSizeMs);
+		BASS_SetConfig(BASS_CONFIG_UPDATEPERIOD, ksmaudio::kUpdatePeriodMs);
+		BASS_SetConfig(BASS_CONFIG_FLOATDSP, TRUE);
+		BASS_SetConfig(BASS_CONFIG_UPDATETHREADS, ksmaudio::kUpdateThreads);
+
+		BASS_FX_GetVersion(); // bass_fx.dllをロードするために呼ぶ必要あり
+	}
+}
+
 namespace ksmaudio
 {
 	void Init(void* hWnd)
@@ -11,12 +24,13 @@ namespace ksmaudio
 		(void)hWnd;
 		BASS_Init(-1/* default device */, kSampleRate, 0, 0, nullptr);
 #endif
-		BASS_SetConfig(BASS_CONFIG_BUFFER, kBufferSizeMs);
-		BASS_SetConfig(BASS_CONFIG_UPDATEPERIOD, kUpdatePeriodMs);
-		BASS_SetConfig(BASS_CONFIG_FLOATDSP, TRUE);
-		BASS_SetConfig(BASS_CONFIG_UPDATETHREADS, kUpdateThreads);
+		SetConfig();
+	}
 
-		BASS_FX_GetVersion(); // bass_fx.dllをロードするために呼ぶ必要あり
+	void InitNoSound()
+	{
+		BASS_Init(0/* no sound */, kSampleRate, 0, 0, nullptr);
+		SetConfig();
 	}
 
 	void Terminate()
@@ -0,0 +1,212 @@
+﻿#include "ksmaudio/offline_renderer.hpp"
+#include <fstream>
+#include <cstdint>
+#include <algorithm>
+
+namespace
+{
+	constexpr std::uint16_t kWAVFormatIEEEFloat = 3U;
+
+	// WAVファイルのヘッダ部分(RIFFヘッダ・fmtチャンク・dataチャンクのヘッダ)のバイト数
+	constexpr std::size_t kWAVHeaderBytes = 44U;
+
+	// デコード時に一度に読み込むフレーム数
+	constexpr std::size_t kDecodeBlockFrames = 4096U;
+
+	// Note: リトルエンディアン環境を前提としている
+	template <typename T>
+	void WriteLE(std::vector<char>& binary, T value)
+	{
+		const char* pBytes = reinterpret_cast<const char*>(&value);
+		binary.insert(binary.end(), pBytes, pBytes + sizeof(T));
+	}
+
+	void WriteFourCC(std::vector<char>& binary, const char (&fourCC)[5])
+	{
+		binary.insert(binary.end(), fourCC, fourCC + 4);
+	}
+}
+
+namespace ksmaudio
+{
+	OfflineRenderer::OfflineRenderer(const std::string& filePath, bool enableCompressor, AudioEffectDSPMode dspMode)
+		: m_stream(filePath, 1.0, enableCompressor, false, dspMode, true)
+		, m_pAudioEffectBusFX(m_stream.emplaceAudioEffectBusFX())
+		, m_pAudioEffectBusLaser(m_stream.emplaceAudioEffectBusLaser())
+	{
+	}
+
+	AudioEffect::AudioEffectBus& OfflineRenderer::audioEffectBusFX()
+	{
+		return *m_pAudioEffectBusFX;
+	}
+
+	AudioEffect::AudioEffectBus& OfflineRenderer::audioEffectBusLaser()
+	{
+		return *m_pAudioEffectBusLaser;
+	}
+
+	std::vector<float> OfflineRenderer::render(const std::function<void(SecondsF)>& updateFunc, std::size_t blockFrames)
+	{
+		const std::size_t numChannels = m_stream.numChannels();
+		const std::size_t sampleRate = m_stream.sampleRate();
+		if (numChannels == 0U || sampleRate == 0U || blockFrames == 0U)
+		{
+			// ロード失敗時は何もしない
+			return {};
+		}
+
+		std::vector<float> result;
+		result.reserve(static_cast<std::size_t>(m_stream.duration().count() * sampleRate) * numChannels);
+
+		std::vector<float> block(blockFrames * numChannels);
+		std::size_t posFrames = 0U;
+		while (true)
+		{
+			if (updateFunc)
+			{
+				updateFunc(SecondsF{ static_cast<double>(posFrames) / sampleRate });
+			}
+
+			const std::size_t readSize = m_stream.readDecodedData(block.data(), block.size());
+			if (readSize == 0U)
+			{
+				break;
+			}
+			result.insert(result.end(), block.begin(), block.begin() + readSize);
+			posFrames += readSize / numChannels;
+		}
+		return result;
+	}
+
+	std::vector<float> OfflineRenderer::render(const OfflineRenderTimeline& timeline, std::size_t blockFrames)
+	{
+		const OfflineRenderInput defaultInput;
+		return render([this, &timeline, &defaultInput](SecondsF posSec)
+			{
+				const float sec = static_cast<float>(posSec.count());
+				auto itr = timeline.upper_bound(sec);
+				const OfflineRenderInput& input = (itr == timeline.begin()) ? defaultInput : (--itr)->second;
+
+				AudioEffect::Status status = input.status;
+				status.sec = sec;
+
+				m_pAudioEffectBusFX->setBypass(input.activeAudioEffectsFX.empty());
+				m_pAudioEffectBusFX->updateByFX(status, input.activeAudioEffectsFX);
+
+				m_pAudioEffectBusLaser->setBypass(!input.activeAudioEffectIdxLaser.has_value());
+				m_pAudioEffectBusLaser->updateByLaser(status, input.activeAudioEffectIdxLaser);
+			}, blockFrames);
+	}
+
+	bool OfflineRenderer::renderToWAVFile(const std::string& filePath, const OfflineRenderTimeline& timeline, std::size_t blockFrames)
+	{
+		const std::vector<float> data = render(timeline, blockFrames);
+		if (data.empty())
+		{
+			return false;
+		}
+		return WriteWAVFile(filePath, data, m_stream.sampleRate(), m_stream.numChannels());
+	}
+
+	Duration OfflineRenderer::duration() const
+	{
+		return m_stream.duration();
+	}
+
+	std::size_t OfflineRenderer::sampleRate() const
+	{
+		return m_stream.sampleRate();
+	}
+
+	std::size_t OfflineRenderer::numChannels() const
+	{
+		return m_stream.numChannels();
+	}
+
+	DecodedAudio DecodeRange(const std::string& filePath, SecondsF offset, Duration duration, bool enableCompressor)
+	{
+		const Stream stream(filePath, 1.0, enableCompressor, false, false, true);
+		const std::size_t sampleRate = stream.sampleRate();
+		const std::size_t numChannels = stream.numChannels();
+		if (numChannels == 0U || sampleRate == 0U || duration <= SecondsF::zero())
+		{
+			// ロード失敗時は何もしない
+			return {};
+		}
+
+		if (offset > SecondsF::zero())
+		{
+			stream.seekPosSec(offset);
+		}
+
+		const std::size_t numTotalFrames = static_cast<std::size_t>(duration.count() * sampleRate);
+		DecodedAudio result{
+			.data = std::vector<float>(numTotalFrames * numChannels),
+			.sampleRate = sampleRate,
+			.numChannels = numChannels,
+		};
+
+		// 確保済みの領域に直接読み込む
+		std::size_t numReadSamples = 0U;
+		while (numReadSamples < result.data.size())
+		{
+			const std::size_t blockSize = std::min(kDecodeBlockFrames * numChannels, result.data.size() - numReadSamples);
+			const std::size_t readSize = stream.readDecodedData(result.data.data() + numReadSamples, blockSize);
+			if (readSize == 0U)
+			{
+				break;
+			}
+			numReadSamples += readSize;
+		}
+		result.data.resize(numReadSamples - numReadSamples % numChannels);
+
+		return result;
+	}
+
+	std::vector<char> EncodeWAV(const std::vector<float>& data, std::size_t sampleRate, std::size_t numChannels)
+	{
+		const auto dataBytes = static_cast<std::uint32_t>(data.size() * sizeof(float));
+		const auto blockAlign = static_cast<std::uint16_t>(numChannels * sizeof(float));
+
+		std::vector<char> binary;
+		binary.reserve(kWAVHeaderBytes + dataBytes);
+
+		// RIFFヘッダ
+		WriteFourCC(binary, "RIFF");
+		WriteLE<std::uint32_t>(binary, 36U + dataBytes);
+		WriteFourCC(binary, "WAVE");
+
+		// fmtチャンク
+		WriteFourCC(binary, "fmt ");
+		WriteLE<std::uint32_t>(binary, 16U);
+		WriteLE<std::uint16_t>(binary, kWAVFormatIEEEFloat);
+		WriteLE<std::uint16_t>(binary, static_cast<std::uint16_t>(numChannels));
+		WriteLE<std::uint32_t>(binary, static_cast<std::uint32_t>(sampleRate));
+		WriteLE<std::uint32_t>(binary, static_cast<std::uint32_t>(sampleRate * blockAlign));
+		WriteLE<std::uint16_t>(binary, blockAlign);
+		WriteLE<std::uint16_t>(binary, static_cast<std::uint16_t>(sizeof(float) * 8));
+
+		// dataチャンク
+		WriteFourCC(binary, "data");
+		WriteLE<std::uint32_t>(binary, dataBytes);
+		const char* pData = reinterpret_cast<const char*>(data.data());
+		binary.insert(binary.end(), pData, pData + dataBytes);
+
+		return binary;
+	}
+
+	bool WriteWAVFile(const std::string& filePath, const std::vector<float>& data, std::size_t sampleRate, std::size_t numChannels)
+	{
+		std::ofstream ofs(filePath, std::ios::out | std::ios::binary);
+		if (!ofs)
+		{
+			return false;
+		}
+
+		const std::vector<char> binary = EncodeWAV(data, sampleRate, numChannels);
+		ofs.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+
+		return static_cast<bool>(ofs);
+	}
+}
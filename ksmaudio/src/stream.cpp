@@ -1,5 +1,6 @@
 ﻿#include "ksmaudio/stream.hpp"
 #include <fstream>
+#include <cmath>
 #include "ksmaudio/ksmaudio.hpp"
 
 namespace
@@ -43,41 +44,90 @@ namespace
 		return binary;
 	}
 
-	HSTREAM LoadStream(const std::string& filePath, const std::vector<char>* pPreloadedBinary, bool loop)
+	HSTREAM LoadStream(const std::string& filePath, const std::vector<char>* pPreloadedBinary, bool loop, bool decodeOnly)
 	{
 		const DWORD loopFlag = loop ? BASS_SAMPLE_LOOP : 0;
+		const DWORD decodeFlag = decodeOnly ? (BASS_STREAM_DECODE | BASS_SAMPLE_FLOAT) : 0;
 		if (pPreloadedBinary == nullptr)
 		{
-			return BASS_StreamCreateFile(FALSE, filePath.c_str(), 0, 0, BASS_STREAM_PRESCAN | loopFlag);
+			return BASS_StreamCreateFile(FALSE, filePath.c_str(), 0, 0, BASS_STREAM_PRESCAN | loopFlag | decodeFlag);
 		}
 		else
 		{
-			return BASS_StreamCreateFile(TRUE, pPreloadedBinary->data(), 0, static_cast<QWORD>(pPreloadedBinary->size()), BASS_STREAM_PRESCAN | loopFlag);
+			return BASS_StreamCreateFile(TRUE, pPreloadedBinary->data(), 0, static_cast<QWORD>(pPreloadedBinary->size()), BASS_STREAM_PRESCAN | loopFlag | decodeFlag);
 		}
 	}
 
 	BASS_CHANNELINFO GetChannelInfo(HSTREAM hStream)
 	{
-		BASS_CHANNELINFO info;
+		BASS_CHANNELINFO info{};
 		BASS_ChannelGetInfo(hStream, &info);
 		return info;
 	}
 
+	// DSPコールバック内で、処理中のブロックの先頭のストリーム上の位置(フレーム数)を取得する
+	// (DSPコールバックの時点でデコード位置は処理中のブロックの末尾まで進んでいるため、ブロックの長さ分を引く)
+	std::optional<std::int64_t> BlockStartFrame(DWORD channel, DWORD length)
+	{
+		const QWORD decodePos = BASS_ChannelGetPosition(channel, BASS_POS_BYTE | BASS_POS_DECODE);
+		if (decodePos == static_cast<QWORD>(-1))
+		{
+			return std::nullopt;
+		}
+
+		BASS_CHANNELINFO info;
+		if (!BASS_ChannelGetInfo(channel, &info) || info.chans == 0U)
+		{
+			return std::nullopt;
+		}
+
+		const double decodePosSec = BASS_ChannelBytes2Seconds(channel, decodePos);
+		if (decodePosSec < 0.0)
+		{
+			return std::nullopt;
+		}
+
+		const std::int64_t decodePosFrame = static_cast<std::int64_t>(std::llround(decodePosSec * info.freq));
+		const std::int64_t numBlockFrames = static_cast<std::int64_t>(length / sizeof(float) / info.chans);
+		return decodePosFrame - numBlockFrames;
+	}
+
 	void ProcessAudioEffect(HDSP handle, DWORD channel, void* buffer, DWORD length, void* user)
 	{
 		const auto pAudioEffect = reinterpret_cast<ksmaudio::AudioEffect::IAudioEffect*>(user);
 		const auto pData = reinterpret_cast<float*>(buffer);
-		pAudioEffect->process(pData, length / sizeof(float));
+		pAudioEffect->process(pData, length / sizeof(float), BlockStartFrame(channel, length));
+	}
+
+	void ProcessFusedAudioEffectGraph(HDSP handle, DWORD channel, void* buffer, DWORD length, void* user)
+	{
+		const auto pGraph = reinterpret_cast<ksmaudio::AudioEffect::FusedAudioEffectGraph*>(user);
+		const auto pData = reinterpret_cast<float*>(buffer);
+		pGraph->process(pData, length / sizeof(float), BlockStartFrame(channel, length));
 	}
 }
 
 namespace ksmaudio
 {
-	Stream::Stream(const std::string& filePath, double volume, bool enableCompressor, bool preload, bool loop)
+	Stream::Stream(const std::string& filePath, double volume, bool enableCompressor, bool preload, bool loop, bool decodeOnly)
 		: m_preloadedBinary(preload ? Preload(filePath) : nullptr)
-		, m_hStream(LoadStream(filePath, m_preloadedBinary.get(), loop))
+		, m_hStream(LoadStream(filePath, m_preloadedBinary.get(), loop, decodeOnly))
 		, m_info(GetChannelInfo(m_hStream))
 		, m_volume(volume)
+	{
+		setupAttributes(volume, enableCompressor);
+	}
+
+	Stream::Stream(std::shared_ptr<const std::vector<char>> binary, double volume, bool enableCompressor, bool loop, bool decodeOnly)
+		: m_preloadedBinary(std::move(binary))
+		, m_hStream(m_preloadedBinary == nullptr ? 0 : LoadStream("", m_preloadedBinary.get(), loop, decodeOnly))
+		, m_info(GetChannelInfo(m_hStream))
+		, m_volume(volume)
+	{
+		setupAttributes(volume, enableCompressor);
+	}
+
+	void Stream::setupAttributes(double volume, bool enableCompressor) const
 	{
 		// 音量を設定
 		BASS_ChannelSetAttribute(m_hStream, BASS_ATTRIB_VOL, static_cast<float>(volume));
@@ -118,6 +168,16 @@ namespace ksmaudio
 		BASS_ChannelUpdate(m_hStream, 0);
 	}
 
+	std::size_t Stream::readDecodedData(float* pData, std::size_t dataSize) const
+	{
+		const DWORD result = BASS_ChannelGetData(m_hStream, pData, static_cast<DWORD>(dataSize * sizeof(float)) | BASS_DATA_FLOAT);
+		if (result == static_cast<DWORD>(-1))
+		{
+			return 0U;
+		}
+		return static_cast<std::size_t>(result) / sizeof(float);
+	}
+
 	SecondsF Stream::posSec() const
 	{
 		return SecondsF{ BASS_ChannelBytes2Seconds(m_hStream, BASS_ChannelGetPosition(m_hStream, BASS_POS_BYTE)) };
@@ -143,6 +203,11 @@ namespace ksmaudio
 		BASS_ChannelRemoveDSP(m_hStream, hDSP);
 	}
 
+	HDSP Stream::addFusedAudioEffectGraph(AudioEffect::FusedAudioEffectGraph* pGraph, int priority) const
+	{
+		return BASS_ChannelSetDSP(m_hStream, ProcessFusedAudioEffectGraph, pGraph, priority);
+	}
+
 	void Stream::setFadeIn(Duration duration) const
 	{
 		// 音量を0からm_volumeまでdurationSec秒かけて推移させる
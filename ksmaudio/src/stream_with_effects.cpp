@@ -1,17 +1,32 @@
 ﻿#include "ksmaudio/stream_with_effects.hpp"
 
+namespace
+{
+	// 全エフェクトをまとめたDSPの優先度
+	// エフェクト毎にDSPを登録する場合、priorityが1～3のフィルタ系エフェクトはコンプレッサー前段の音量変更(kVolumeFXPriority)より後に処理される。
+	// これらはいずれも線形なフィルタであり、音量変更と順序を入れ替えても結果は変わらないため、ここでは全エフェクトを音量変更より前にまとめて処理している
+	constexpr int kFusedAudioEffectGraphPriority = 100;
+}
+
 namespace ksmaudio
 {
 	AudioEffect::AudioEffectBus* StreamWithEffects::emplaceAudioEffectBusImpl(bool isLaser)
 	{
 		// Note: It is intentional to return the internal raw pointer of unique_ptr here.
 		//       Management of the returned pointer is the responsibility of the caller.
-		return m_audioEffectBuses.emplace_back(std::make_unique<AudioEffect::AudioEffectBus>(isLaser, &m_stream)).get();
+		return m_audioEffectBuses.emplace_back(std::make_unique<AudioEffect::AudioEffectBus>(isLaser, &m_stream, m_delayLineArena.get(), m_fusedGraph.get())).get();
 	}
 
-	StreamWithEffects::StreamWithEffects(const std::string& filePath, double volume, bool enableCompressor, bool preload)
-		: m_stream(filePath, volume, enableCompressor, preload)
+	StreamWithEffects::StreamWithEffects(const std::string& filePath, double volume, bool enableCompressor, bool preload, AudioEffectDSPMode dspMode, bool decodeOnly)
+		: m_fusedGraph(dspMode == AudioEffectDSPMode::kFused ? std::make_unique<AudioEffect::FusedAudioEffectGraph>() : nullptr)
+		, m_delayLineArena(std::make_unique<AudioEffect::detail::DelayLineArena>())
+		, m_stream(filePath, volume, enableCompressor, preload, false, decodeOnly)
 	{
+		if (m_fusedGraph != nullptr)
+		{
+			// Note: DSPはBASS_StreamFreeで自動的に解除される
+			m_stream.addFusedAudioEffectGraph(m_fusedGraph.get(), kFusedAudioEffectGraphPriority);
+		}
 	}
 
 	void StreamWithEffects::play() const
@@ -34,6 +49,11 @@ namespace ksmaudio
 		m_stream.updateManually();
 	}
 
+	std::size_t StreamWithEffects::readDecodedData(float* pData, std::size_t dataSize) const
+	{
+		return m_stream.readDecodedData(pData, dataSize);
+	}
+
 	SecondsF StreamWithEffects::posSec() const
 	{
 		return m_stream.posSec();
@@ -0,0 +1,267 @@
+﻿// detail::StereoBiquadFilterのテスト
+// 最適化前のスカラー実装(係数を正規化せずサンプル毎にa0で割り、チャンネル毎に別のフィルタを使用する)と出力がビット単位で一致することを確認する
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "ksmaudio/audio_effect/detail/biquad_filter.hpp"
+#include "legacy_dsp_reference.hpp"
+#include "test_common.hpp"
+
+namespace
+{
+	using namespace ksmaudio::AudioEffect;
+	using ksmaudio::Test::Legacy::BiquadFilter;
+
+	constexpr float kSampleRate = 44100.0f;
+
+	class Random
+	{
+	private:
+		std::uint32_t m_state;
+
+	public:
+		explicit Random(std::uint32_t seed)
+			: m_state(seed)
+		{
+		}
+
+		std::uint32_t next(std::uint32_t max)
+		{
+			m_state = m_state * 1664525U + 1013904223U;
+			return (m_state >> 8) % max;
+		}
+
+		// -1～1の一様乱数
+		float nextSample()
+		{
+			return static_cast<float>(next(1U << 24)) / static_cast<float>(1U << 23) - 1.0f;
+		}
+	};
+
+	// フィルタの種類毎に、最適化前の実装と新しい実装へ同じ係数を設定する関数
+	struct FilterCase
+	{
+		std::function<void(BiquadFilter&)> setLegacy;
+
+		std::function<void(detail::BiquadCoefficients<float>&)> setCoefs;
+	};
+
+	std::vector<FilterCase> MakeFilterCases()
+	{
+		return {
+			{
+				[](BiquadFilter& f) { f.setLowPassFilter(1200.0f, 1.414f, kSampleRate); },
+				[](detail::BiquadCoefficients<float>& c) { c.setLowPassFilter(1200.0f, 1.414f, kSampleRate); },
+			},
+			{
+				[](BiquadFilter& f) { f.setHighPassFilter(800.0f, 0.707f, kSampleRate); },
+				[](detail::BiquadCoefficients<float>& c) { c.setHighPassFilter(800.0f, 0.707f, kSampleRate); },
+			},
+			{
+				[](BiquadFilter& f) { f.setHighShelfFilter(5000.0f, 1.5f, -8.0f, kSampleRate); },
+				[](detail::BiquadCoefficients<float>& c) { c.setHighShelfFilter(5000.0f, 1.5f, -8.0f, kSampleRate); },
+			},
+			{
+				[](BiquadFilter& f) { f.setPeakingFilter(3000.0f, 1.2f, 15.0f, kSampleRate); },
+				[](detail::BiquadCoefficients<float>& c) { c.setPeakingFilter(3000.0f, 1.2f, 15.0f, kSampleRate); },
+			},
+			{
+				[](BiquadFilter& f) { f.setAllPassFilter(2500.0f, 0.707f, kSampleRate); },
+				[](detail::BiquadCoefficients<float>& c) { c.setAllPassFilter(2500.0f, 0.707f, kSampleRate); },
+			},
+		};
+	}
+
+	std::vector<float> MakeNoise(std::size_t size, std::uint32_t seed)
+	{
+		Random random(seed);
+		std::vector<float> data(size);
+		for (float& v : data)
+		{
+			v = random.nextSample();
+		}
+		return data;
+	}
+
+	bool IsBitIdentical(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		return a.size() == b.size() && std::memcmp(a.data(), b.data(), sizeof(float) * a.size()) == 0;
+	}
+
+	// ステレオの処理がチャンネル毎のスカラー実装と一致すること
+	// (ランダムな長さのブロックに分けて処理し、ブロック間で状態が正しく引き継がれることも確認する)
+	void TestStereoMatchesLegacy(const FilterCase& filterCase)
+	{
+		constexpr std::size_t kNumFrames = 20000U;
+		const std::vector<float> input = MakeNoise(kNumFrames * 2U, 1U);
+
+		BiquadFilter legacyFilters[2];
+		std::vector<float> expected(input.size());
+		for (std::size_t ch = 0U; ch < 2U; ++ch)
+		{
+			filterCase.setLegacy(legacyFilters[ch]);
+			for (std::size_t i = 0U; i < kNumFrames; ++i)
+			{
+				expected[i * 2U + ch] = legacyFilters[ch].process(input[i * 2U + ch]);
+			}
+		}
+
+		detail::BiquadCoefficients<float> coefs;
+		filterCase.setCoefs(coefs);
+		detail::StereoBiquadFilter filter;
+		filter.setCoefficients(coefs);
+		std::vector<float> actual = input;
+		Random random(2U);
+		for (std::size_t frame = 0U; frame < kNumFrames;)
+		{
+			const std::size_t numBlockFrames = (std::min)(kNumFrames - frame, std::size_t{ 1U } + random.next(700U));
+			filter.process(&actual[frame * 2U], numBlockFrames);
+			frame += numBlockFrames;
+		}
+
+		KSMAUDIO_TEST_CHECK(IsBitIdentical(actual, expected));
+	}
+
+	// モノラルの処理・1フレームずつの処理・原音とのミックスの各経路がスカラー実装と一致すること
+	void TestOtherPathsMatchLegacy(const FilterCase& filterCase)
+	{
+		constexpr std::size_t kNumFrames = 5000U;
+		detail::BiquadCoefficients<float> coefs;
+		filterCase.setCoefs(coefs);
+
+		// モノラル
+		{
+			const std::vector<float> input = MakeNoise(kNumFrames, 3U);
+			BiquadFilter legacyFilter;
+			filterCase.setLegacy(legacyFilter);
+			std::vector<float> expected(input.size());
+			for (std::size_t i = 0U; i < kNumFrames; ++i)
+			{
+				expected[i] = legacyFilter.process(input[i]);
+			}
+
+			detail::StereoBiquadFilter filter;
+			filter.setCoefficients(coefs);
+			std::vector<float> actual(input.size());
+			filter.processMono(input.data(), actual.data(), kNumFrames);
+			KSMAUDIO_TEST_CHECK(IsBitIdentical(actual, expected));
+		}
+
+		// 1フレームずつの処理
+		{
+			const std::vector<float> input = MakeNoise(kNumFrames * 2U, 4U);
+			BiquadFilter legacyFilters[2];
+			filterCase.setLegacy(legacyFilters[0]);
+			filterCase.setLegacy(legacyFilters[1]);
+			std::vector<float> expected(input.size());
+			for (std::size_t i = 0U; i < kNumFrames; ++i)
+			{
+				expected[i * 2U] = legacyFilters[0].process(input[i * 2U]);
+				expected[i * 2U + 1U] = legacyFilters[1].process(input[i * 2U + 1U]);
+			}
+
+			detail::StereoBiquadFilter filter;
+			filter.setCoefficients(coefs);
+			std::vector<float> actual(input.size());
+			for (std::size_t i = 0U; i < kNumFrames; ++i)
+			{
+				const std::array<float, 2> output = filter.processFrame({ input[i * 2U], input[i * 2U + 1U] });
+				actual[i * 2U] = output[0];
+				actual[i * 2U + 1U] = output[1];
+			}
+			KSMAUDIO_TEST_CHECK(IsBitIdentical(actual, expected));
+		}
+
+		// 原音とのミックス(kMixBlockFramesをまたぐ長さで処理する)
+		{
+			constexpr float kMix = 0.3f;
+			const std::vector<float> input = MakeNoise(kNumFrames * 2U, 5U);
+			BiquadFilter legacyFilters[2];
+			filterCase.setLegacy(legacyFilters[0]);
+			filterCase.setLegacy(legacyFilters[1]);
+			std::vector<float> expected(input.size());
+			for (std::size_t i = 0U; i < input.size(); ++i)
+			{
+				expected[i] = std::lerp(input[i], legacyFilters[i % 2U].process(input[i]), kMix);
+			}
+
+			detail::StereoBiquadFilter filter;
+			filter.setCoefficients(coefs);
+			std::vector<float> actual = input;
+			filter.processWithMix(actual.data(), kNumFrames, 2U, kMix);
+			KSMAUDIO_TEST_CHECK(IsBitIdentical(actual, expected));
+
+			// mixが0の場合は原音のまま
+			std::vector<float> dry = input;
+			filter.processWithMix(dry.data(), kNumFrames, 2U, 0.0f);
+			KSMAUDIO_TEST_CHECK(IsBitIdentical(dry, input));
+		}
+	}
+
+	// 左右で異なる係数を設定した場合も、それぞれのチャンネルのスカラー実装と一致すること
+	void TestPerChannelCoefficients()
+	{
+		constexpr std::size_t kNumFrames = 5000U;
+		const std::vector<float> input = MakeNoise(kNumFrames * 2U, 6U);
+
+		BiquadFilter legacyFilters[2];
+		legacyFilters[0].setAllPassFilter(1800.0f, 0.707f, kSampleRate);
+		legacyFilters[1].setAllPassFilter(6400.0f, 0.707f, kSampleRate);
+		std::vector<float> expected(input.size());
+		for (std::size_t i = 0U; i < input.size(); ++i)
+		{
+			expected[i] = legacyFilters[i % 2U].process(input[i]);
+		}
+
+		detail::BiquadCoefficients<float> coefsL;
+		coefsL.setAllPassFilter(1800.0f, 0.707f, kSampleRate);
+		detail::BiquadCoefficients<float> coefsR;
+		coefsR.setAllPassFilter(6400.0f, 0.707f, kSampleRate);
+		detail::StereoBiquadFilter filter;
+		filter.setCoefficients(0U, coefsL);
+		filter.setCoefficients(1U, coefsR);
+		std::vector<float> actual = input;
+		filter.process(actual.data(), kNumFrames);
+		KSMAUDIO_TEST_CHECK(IsBitIdentical(actual, expected));
+	}
+
+	// スカラーのBiquadFilterも最適化前の実装と一致すること
+	void TestScalarMatchesLegacy(const FilterCase& filterCase)
+	{
+		constexpr std::size_t kNumFrames = 5000U;
+		const std::vector<float> input = MakeNoise(kNumFrames, 7U);
+
+		BiquadFilter legacyFilter;
+		filterCase.setLegacy(legacyFilter);
+		detail::BiquadCoefficients<float> coefs;
+		filterCase.setCoefs(coefs);
+		detail::BiquadFilter<float> filter;
+		filter.setCoefficients(coefs);
+
+		std::vector<float> expected(input.size());
+		std::vector<float> actual(input.size());
+		for (std::size_t i = 0U; i < kNumFrames; ++i)
+		{
+			expected[i] = legacyFilter.process(input[i]);
+			actual[i] = filter.process(input[i]);
+		}
+		KSMAUDIO_TEST_CHECK(IsBitIdentical(actual, expected));
+	}
+}
+
+int main()
+{
+	for (const FilterCase& filterCase : MakeFilterCases())
+	{
+		TestStereoMatchesLegacy(filterCase);
+		TestOtherPathsMatchLegacy(filterCase);
+		TestScalarMatchesLegacy(filterCase);
+	}
+	TestPerChannelCoefficients();
+
+	return ksmaudio::Test::Result("biquad_filter_test");
+}
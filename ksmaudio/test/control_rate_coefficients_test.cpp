@@ -0,0 +1,169 @@
+﻿// Biquadフィルタ係数の制御レートでの更新(線形補間)のテスト
+// WobbleDSP・PhaserDSPの出力が、係数をフレーム毎に計算していた最適化前の実装の出力と許容誤差内で一致することを確認する(ヌルテスト)
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "ksmaudio/audio_effect/dsp/phaser_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/wobble_dsp.hpp"
+#include "legacy_dsp_reference.hpp"
+#include "test_common.hpp"
+
+namespace
+{
+	using namespace ksmaudio::AudioEffect;
+
+	constexpr std::size_t kSampleRate = 44100U;
+
+	constexpr std::size_t kNumChannels = 2U;
+
+	// DSPのコールバック1回で処理するフレーム数
+	// (制御レートの区間がブロックの境界をまたぐ場合も確認するため、kBiquadControlRateFramesの倍数にしない)
+	constexpr std::size_t kBlockFrames = 500U;
+
+	// 白色雑音を生成する
+	std::vector<float> MakeNoise(std::size_t size)
+	{
+		std::vector<float> signal(size);
+		std::uint32_t seed = 12345U;
+		for (float& v : signal)
+		{
+			seed = seed * 1664525U + 1013904223U;
+			v = static_cast<float>(seed >> 8) / static_cast<float>(1U << 24) - 0.5f;
+		}
+		return signal;
+	}
+
+	// 参照出力に対する誤差のSN比(dB)を返す
+	double SignalToNoiseRatioDb(const std::vector<float>& expected, const std::vector<float>& actual)
+	{
+		double signalPower = 0.0;
+		double noisePower = 0.0;
+		for (std::size_t i = 0U; i < expected.size(); ++i)
+		{
+			const double diff = static_cast<double>(actual[i]) - static_cast<double>(expected[i]);
+			signalPower += static_cast<double>(expected[i]) * static_cast<double>(expected[i]);
+			noisePower += diff * diff;
+		}
+		if (noisePower == 0.0)
+		{
+			return INFINITY;
+		}
+		return 10.0 * std::log10(signalPower / noisePower);
+	}
+
+	// 入力をブロック毎にprocessBlockFuncで処理した結果を返す
+	template <typename ProcessBlockFunc>
+	std::vector<float> ProcessInBlocks(const std::vector<float>& input, ProcessBlockFunc processBlockFunc)
+	{
+		std::vector<float> output = input;
+		for (std::size_t offset = 0U; offset < output.size(); offset += kBlockFrames * kNumChannels)
+		{
+			const std::size_t blockSize = (std::min)(kBlockFrames * kNumChannels, output.size() - offset);
+			processBlockFunc(&output[offset], blockSize);
+		}
+		return output;
+	}
+
+	void TestWobbleNull()
+	{
+		struct TestCase
+		{
+			float waveLength;
+
+			double minSnrDb;
+		};
+
+		// 周期が短いほど区間内での周波数の変化が大きく補間の誤差が増えるため、周期毎に許容するSN比を変えている
+		// (0.03秒はチャート上で使われる周期よりも短い極端な例)
+		constexpr TestCase kTestCases[] = {
+			{ .waveLength = 0.03f, .minSnrDb = 25.0 },
+			{ .waveLength = 0.25f, .minSnrDb = 48.0 },
+		};
+		for (const auto& [waveLength, minSnrDb] : kTestCases)
+		{
+			const std::vector<float> input = MakeNoise(kSampleRate * 2U * kNumChannels);
+			const WobbleDSPParams params{ .secUntilTrigger = 0.0f, .waveLength = waveLength, .freq1 = 500.0f, .freq2 = 20000.0f, .q = 1.414f, .mix = 1.0f };
+
+			ksmaudio::Test::Legacy::Wobble legacyWobble(kSampleRate, kNumChannels);
+			legacyWobble.updateParams(params);
+			const std::vector<float> expected = ProcessInBlocks(input, [&](float* pData, std::size_t dataSize)
+			{
+				legacyWobble.process(pData, dataSize, params);
+			});
+
+			WobbleDSP wobble(DSPCommonInfo{ kSampleRate, kNumChannels, nullptr });
+			wobble.updateParams(params);
+			const std::vector<float> actual = ProcessInBlocks(input, [&](float* pData, std::size_t dataSize)
+			{
+				wobble.process(pData, dataSize, false, params);
+			});
+
+			const double snrDb = SignalToNoiseRatioDb(expected, actual);
+			std::printf("Wobble (waveLength=%.2f): SNR %.1f dB\n", waveLength, snrDb);
+			KSMAUDIO_TEST_CHECK(snrDb >= minSnrDb);
+		}
+	}
+
+	void TestPhaserNull()
+	{
+		for (const float stereoWidth : { 0.0f, 1.0f })
+		{
+			const std::vector<float> input = MakeNoise(kSampleRate * 2U * kNumChannels);
+			const PhaserDSPParams params{ .period = 0.5f, .stage = PhaserDSP::kMaxNumAllPassFilters, .stereoWidth = stereoWidth, .mix = 1.0f };
+
+			ksmaudio::Test::Legacy::Phaser legacyPhaser(kSampleRate, kNumChannels);
+			const std::vector<float> expected = ProcessInBlocks(input, [&](float* pData, std::size_t dataSize)
+			{
+				legacyPhaser.process(pData, dataSize, params);
+			});
+
+			PhaserDSP phaser(DSPCommonInfo{ kSampleRate, kNumChannels, nullptr });
+			const std::vector<float> actual = ProcessInBlocks(input, [&](float* pData, std::size_t dataSize)
+			{
+				phaser.process(pData, dataSize, false, params);
+			});
+
+			const double snrDb = SignalToNoiseRatioDb(expected, actual);
+			std::printf("Phaser (stereoWidth=%.1f): SNR %.1f dB\n", stereoWidth, snrDb);
+			KSMAUDIO_TEST_CHECK(snrDb >= 50.0);
+		}
+	}
+
+	// rampCoefficients()による補間が終わった後は、setCoefficients()で目標の係数を設定した場合とビット単位で一致すること
+	void TestRampEndsAtTarget()
+	{
+		detail::BiquadCoefficients<float> startCoefs;
+		startCoefs.setLowPassFilter(500.0f, 1.414f, static_cast<float>(kSampleRate));
+		detail::BiquadCoefficients<float> targetCoefs;
+		targetCoefs.setLowPassFilter(12000.0f, 1.414f, static_cast<float>(kSampleRate));
+
+		// 状態の影響を除くため、補間中は無音を入力する
+		detail::StereoBiquadFilter rampedFilter;
+		rampedFilter.setCoefficients(startCoefs);
+		rampedFilter.rampCoefficients(targetCoefs, detail::kBiquadControlRateFrames);
+		std::vector<float> silence(detail::kBiquadControlRateFrames * kNumChannels, 0.0f);
+		rampedFilter.process(silence.data(), detail::kBiquadControlRateFrames);
+
+		detail::StereoBiquadFilter filter;
+		filter.setCoefficients(targetCoefs);
+
+		const std::vector<float> input = MakeNoise(1000U * kNumChannels);
+		std::vector<float> expected = input;
+		filter.process(expected.data(), 1000U);
+		std::vector<float> actual = input;
+		rampedFilter.process(actual.data(), 1000U);
+		KSMAUDIO_TEST_CHECK(std::memcmp(actual.data(), expected.data(), sizeof(float) * actual.size()) == 0);
+	}
+}
+
+int main()
+{
+	TestWobbleNull();
+	TestPhaserNull();
+	TestRampEndsAtTarget();
+
+	return ksmaudio::Test::Result("control_rate_coefficients_test");
+}
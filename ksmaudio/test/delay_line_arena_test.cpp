@@ -0,0 +1,125 @@
+﻿// DelayLineArenaのテスト
+// DSPコールバック内で使用する処理(tryAcquire・release)ではメモリ確保が発生せず、事前に確保したブロックが使用されることを確認する
+// また、テープストップ用に事前に確保したブロックが他の音声エフェクトに取得されないことを確認する
+#include <vector>
+#include "ksmaudio/audio_effect/detail/delay_line_arena.hpp"
+#include "ksmaudio/audio_effect/dsp/tapestop_dsp.hpp"
+#include "ksmaudio/audio_effect/dsp/flanger_dsp.hpp"
+#include "test_common.hpp"
+
+namespace
+{
+	using namespace ksmaudio::AudioEffect;
+
+	void TestTryAcquireDoesNotAllocate()
+	{
+		detail::DelayLineArena arena;
+		KSMAUDIO_TEST_CHECK(arena.tryAcquire(100U).empty());
+		KSMAUDIO_TEST_CHECK(arena.totalSize() == 0U);
+
+		arena.reserve(100U);
+		const std::size_t reservedSize = arena.totalSize();
+		KSMAUDIO_TEST_CHECK(reservedSize >= 100U);
+
+		// 足りないサイズの要求ではブロックを取得できない
+		KSMAUDIO_TEST_CHECK(arena.tryAcquire(reservedSize + 1U).empty());
+
+		const auto block = arena.tryAcquire(50U);
+		KSMAUDIO_TEST_CHECK(block.size() == reservedSize);
+		KSMAUDIO_TEST_CHECK(arena.tryAcquire(50U).empty());
+
+		arena.release(block);
+		KSMAUDIO_TEST_CHECK(arena.tryAcquire(100U).data() == block.data());
+		KSMAUDIO_TEST_CHECK(arena.totalSize() == reservedSize);
+	}
+
+	void TestTapestopUsesReservedBlock()
+	{
+		// テープストップ中にDSPの処理内で新たなメモリ確保が発生しない
+		constexpr std::size_t kSampleRate = 44100U;
+		constexpr std::size_t kNumChannels = 2U;
+		constexpr std::size_t kBlockFrames = 512U;
+
+		detail::DelayLineArena arena;
+		TapestopDSP dsp(DSPCommonInfo{ kSampleRate, kNumChannels, &arena });
+		dsp.reserveDelayTime(2.0f);
+		const std::size_t reservedSize = arena.totalSize();
+		KSMAUDIO_TEST_CHECK(reservedSize >= 2U * kSampleRate * kNumChannels);
+
+		std::vector<float> block(kBlockFrames * kNumChannels, 0.5f);
+		dsp.updateParams(TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = true, .mix = 1.0f });
+		for (std::size_t i = 0U; i < kSampleRate * 2U / kBlockFrames; ++i)
+		{
+			dsp.process(block.data(), block.size(), false, TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = false, .mix = 1.0f });
+		}
+		KSMAUDIO_TEST_CHECK(arena.totalSize() == reservedSize);
+
+		// テープストップ終了後も事前に確保したブロックはアリーナに返却されず、次のテープストップで再び使用される
+		dsp.process(block.data(), block.size(), false, TapestopDSPParams{ .speed = 0.5f, .trigger = false, .reset = false, .mix = 1.0f });
+		KSMAUDIO_TEST_CHECK(arena.tryAcquire(1U).empty());
+		dsp.updateParams(TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = true, .mix = 1.0f });
+		for (std::size_t i = 0U; i < kSampleRate * 2U / kBlockFrames; ++i)
+		{
+			dsp.process(block.data(), block.size(), false, TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = false, .mix = 1.0f });
+		}
+		KSMAUDIO_TEST_CHECK(arena.totalSize() == reservedSize);
+	}
+
+	// テープストップを2秒間かけた出力を返す
+	// (pCompetitorがnullptrでない場合は、同じアリーナを共有する別の音声エフェクトとして、テープストップ開始前から毎ブロック処理する)
+	std::vector<float> ProcessTapestop(detail::DelayLineArena& arena, FlangerDSP* pCompetitor)
+	{
+		constexpr std::size_t kSampleRate = 44100U;
+		constexpr std::size_t kNumChannels = 2U;
+		constexpr std::size_t kBlockFrames = 512U;
+		constexpr std::size_t kNumBlocks = kSampleRate * 2U / kBlockFrames;
+
+		TapestopDSP dsp(DSPCommonInfo{ kSampleRate, kNumChannels, &arena });
+		dsp.reserveDelayTime(2.0f);
+
+		// 内部のバッファを超えるディレイタイムのフランジャー(DSPコールバック内で未使用のブロックの取得を試みる)
+		const FlangerDSPParams flangerParams{ .delay = 4000.0f, .depth = 4000.0f };
+		std::vector<float> competitorBlock(kBlockFrames * kNumChannels, 0.25f);
+
+		std::vector<float> output;
+		dsp.updateParams(TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = true, .mix = 1.0f });
+		for (std::size_t i = 0U; i < kNumBlocks; ++i)
+		{
+			if (pCompetitor != nullptr)
+			{
+				pCompetitor->process(competitorBlock.data(), competitorBlock.size(), false, flangerParams);
+			}
+
+			std::vector<float> block(kBlockFrames * kNumChannels);
+			for (std::size_t j = 0U; j < block.size(); ++j)
+			{
+				block[j] = static_cast<float>((i * block.size() + j) % 1000U) / 1000.0f;
+			}
+			dsp.process(block.data(), block.size(), false, TapestopDSPParams{ .speed = 0.5f, .trigger = true, .reset = false, .mix = 1.0f });
+			output.insert(output.end(), block.begin(), block.end());
+		}
+		return output;
+	}
+
+	void TestReservedBlockIsNotTakenByOtherDSP()
+	{
+		// 同じアリーナを共有する別のDSPがDSPコールバック内で未使用のブロックを取得しようとしても、
+		// テープストップ用に事前に確保したブロックは取得されず、テープストップの出力は単独の場合と変わらない
+		detail::DelayLineArena referenceArena;
+		const std::vector<float> reference = ProcessTapestop(referenceArena, nullptr);
+
+		detail::DelayLineArena sharedArena;
+		FlangerDSP flanger(DSPCommonInfo{ 44100U, 2U, &sharedArena });
+		const std::vector<float> output = ProcessTapestop(sharedArena, &flanger);
+		KSMAUDIO_TEST_CHECK(output == reference);
+		KSMAUDIO_TEST_CHECK(sharedArena.totalSize() == referenceArena.totalSize());
+	}
+}
+
+int main()
+{
+	TestTryAcquireDoesNotAllocate();
+	TestTapestopUsesReservedBlock();
+	TestReservedBlockIsNotTakenByOtherDSP();
+	return ksmaudio::Test::Result("delay_line_arena_test");
+}
@@ -0,0 +1,316 @@
+﻿// DSPParamsHandoffのテスト
+// - パラメータの変更が、譜面上の時間にBGMのオフセットを加えたストリーム上の位置でサンプル単位で適用されること
+// - 値が変化しない間やエフェクトが処理不要な間はキューが溢れず、トリガ更新の位置がずれないこと
+// - エフェクトごとにDSPを登録する場合(process()が毎ブロック呼ばれる場合)に、処理不要な状態へ切り替わった後は原音に戻ること
+// - 処理不要な状態への切り替えはイベントの位置で行われ、FusedAudioEffectGraphでもそれより前の区間は処理されること
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+#include "ksmaudio/audio_effect/detail/dsp_params_handoff.hpp"
+#include "ksmaudio/audio_effect/dsp/bitcrusher_dsp.hpp"
+#include "ksmaudio/audio_effect/fused_audio_effect_graph.hpp"
+#include "test_common.hpp"
+
+namespace
+{
+	using ksmaudio::AudioEffect::detail::DSPParamsHandoff;
+
+	constexpr std::size_t kSampleRate = 1000U;
+
+	constexpr std::size_t kBlockFrames = 64U;
+
+	struct TestDSPParams
+	{
+		float value = 0.0f;
+
+		bool operator==(const TestDSPParams&) const = default;
+	};
+
+	struct TestTriggerDSPParams
+	{
+		float secUntilTrigger = -1.0f;
+
+		float value = 0.0f;
+
+		bool operator==(const TestTriggerDSPParams&) const = default;
+	};
+
+	// 処理したサンプルをそのフレームで使用されていたパラメータ値で上書きするDSP
+	struct TestDSP
+	{
+		int numUpdateParams = 0;
+
+		void updateParams(const TestDSPParams&)
+		{
+			++numUpdateParams;
+		}
+
+		void process(float* pData, std::size_t dataSize, bool bypass, const TestDSPParams& params)
+		{
+			for (std::size_t i = 0U; i < dataSize; ++i)
+			{
+				pData[i] = bypass ? -1.0f : params.value;
+			}
+		}
+	};
+
+	// updateParams()で受け取ったトリガ更新のストリーム上の位置を記録するDSP
+	struct TestTriggerDSP
+	{
+		std::int64_t frame = 0; // 次にprocess()で処理するストリーム上の位置
+
+		std::vector<std::int64_t> triggerFrames;
+
+		void updateParams(const TestTriggerDSPParams& params)
+		{
+			if (params.secUntilTrigger >= 0.0f)
+			{
+				triggerFrames.push_back(frame + std::llround(params.secUntilTrigger * static_cast<float>(kSampleRate)));
+			}
+		}
+
+		void process(float* pData, std::size_t dataSize, bool bypass, const TestTriggerDSPParams& params)
+		{
+			for (std::size_t i = 0U; i < dataSize; ++i)
+			{
+				pData[i] = bypass ? -1.0f : params.value;
+			}
+			frame += static_cast<std::int64_t>(dataSize);
+		}
+	};
+
+	// ストリーム上の位置streamStartFrameからnumFrames分を処理し、各フレームで使用された値を返す
+	template <typename DSPParams, typename DSP>
+	std::vector<float> ProcessFrames(DSPParamsHandoff<DSPParams>& handoff, DSP& dsp, std::int64_t streamStartFrame, std::size_t numFrames)
+	{
+		std::vector<float> output(numFrames);
+		for (std::size_t cursor = 0U; cursor < numFrames; cursor += kBlockFrames)
+		{
+			const std::size_t blockFrames = (std::min)(kBlockFrames, numFrames - cursor);
+			handoff.process(dsp, output.data() + cursor, blockFrames, streamStartFrame + static_cast<std::int64_t>(cursor));
+		}
+		return output;
+	}
+
+	// 譜面上の時間chartSecで値を1に変更した場合に、ストリーム上のどのフレームから値が切り替わるかを返す
+	std::optional<std::int64_t> FindSwitchFrame(double offsetSec, float chartSec, std::int64_t streamStartFrame, std::size_t numFrames)
+	{
+		DSPParamsHandoff<TestDSPParams> handoff(kSampleRate, 1U);
+		TestDSP dsp;
+		handoff.setStreamTimeOffset(offsetSec);
+		handoff.publish(TestDSPParams{ .value = 0.0f }, false, chartSec - 0.5f, false);
+		handoff.publish(TestDSPParams{ .value = 1.0f }, false, chartSec, false);
+
+		const std::vector<float> output = ProcessFrames(handoff, dsp, streamStartFrame, numFrames);
+		for (std::size_t i = 0U; i < output.size(); ++i)
+		{
+			if (output[i] == 1.0f)
+			{
+				return streamStartFrame + static_cast<std::int64_t>(i);
+			}
+		}
+		return std::nullopt;
+	}
+
+	void TestZeroOffset()
+	{
+		// 譜面上の1.0秒 = ストリーム上の1000フレーム目
+		KSMAUDIO_TEST_CHECK(FindSwitchFrame(0.0, 1.0f, 900, 400) == 1000);
+	}
+
+	void TestPositiveOffset()
+	{
+		// BGMのオフセットが+0.3秒の場合、譜面上の1.0秒 = ストリーム上の1300フレーム目
+		// (オフセットを考慮しないと、ストリーム上の位置1200からの処理では既に過ぎたイベントとしてブロック先頭で適用されてしまう)
+		KSMAUDIO_TEST_CHECK(FindSwitchFrame(0.3, 1.0f, 1200, 400) == 1300);
+	}
+
+	void TestNegativeOffset()
+	{
+		// BGMのオフセットが-0.25秒の場合、譜面上の1.0秒 = ストリーム上の750フレーム目
+		// (オフセットを考慮しないと、0.25秒遅れて1000フレーム目で切り替わってしまう)
+		KSMAUDIO_TEST_CHECK(FindSwitchFrame(-0.25, 1.0f, 600, 600) == 750);
+	}
+
+	void TestBypassFollowsLastPublish()
+	{
+		// バイパス状態の変更は直前のpublish()と同じストリーム上の位置で適用される
+		DSPParamsHandoff<TestDSPParams> handoff(kSampleRate, 1U);
+		TestDSP dsp;
+		handoff.setStreamTimeOffset(0.5);
+		handoff.publish(TestDSPParams{ .value = 1.0f }, false, 0.0f, false);
+		handoff.publishBypass(TestDSPParams{ .value = 1.0f }, true, false);
+
+		const std::vector<float> output = ProcessFrames(handoff, dsp, 450, 100);
+		KSMAUDIO_TEST_CHECK(output[49] == 0.0f);
+		KSMAUDIO_TEST_CHECK(output[50] == -1.0f);
+		KSMAUDIO_TEST_CHECK(dsp.numUpdateParams == 1);
+	}
+
+	void TestUnchangedParamsDoNotOverflow()
+	{
+		// ゲームスレッドの更新間隔(1ms)で同じ値を送り続けても、キューには値の変化のみが入る
+		DSPParamsHandoff<TestDSPParams> handoff(kSampleRate, 1U);
+		TestDSP dsp;
+		for (int i = 0; i < 2000; ++i)
+		{
+			handoff.publish(TestDSPParams{ .value = 0.0f }, false, static_cast<float>(i) / 1000.0f, false);
+		}
+		handoff.publish(TestDSPParams{ .value = 1.0f }, false, 2.0f, false);
+
+		const std::vector<float> output = ProcessFrames(handoff, dsp, 1900, 200);
+		KSMAUDIO_TEST_CHECK(output[99] == 0.0f);
+		KSMAUDIO_TEST_CHECK(output[100] == 1.0f);
+		KSMAUDIO_TEST_CHECK(dsp.numUpdateParams <= 3);
+	}
+
+	void TestIdleDoesNotFillQueue()
+	{
+		// 処理不要な状態の間はDSPのprocess()が呼ばれないが、その間に変化した値でキューが溢れることはない
+		// (処理不要な状態から戻った際には、保留していた最新の値を経てから新しい値が適用される)
+		DSPParamsHandoff<TestDSPParams> handoff(kSampleRate, 1U);
+		TestDSP dsp;
+		for (int i = 0; i < 2000; ++i)
+		{
+			handoff.publish(TestDSPParams{ .value = static_cast<float>(i) }, true, static_cast<float>(i) / 1000.0f, true);
+		}
+		handoff.publish(TestDSPParams{ .value = 5000.0f }, false, 2.0f, false);
+
+		const std::vector<float> output = ProcessFrames(handoff, dsp, 1990, 20);
+		KSMAUDIO_TEST_CHECK(output[9] == 0.0f);
+		KSMAUDIO_TEST_CHECK(output[10] == 5000.0f);
+		// (キューに入るのは処理不要な状態へ切り替わった最初の値、保留していた最新の値、新しい値のみ)
+		KSMAUDIO_TEST_CHECK(dsp.numUpdateParams == 3);
+	}
+
+	void TestIdleTransitionIsApplied()
+	{
+		// エフェクトごとにDSPを登録する場合は処理不要な状態でもprocess()が呼ばれるため、処理不要な状態へ切り替わるイベントは適用される
+		DSPParamsHandoff<TestDSPParams> handoff(kSampleRate, 1U);
+		TestDSP dsp;
+		handoff.publish(TestDSPParams{ .value = 1.0f }, false, 1.0f, false);
+		for (int i = 100; i < 500; ++i)
+		{
+			const float sec = 1.0f + static_cast<float>(i) / 1000.0f;
+			handoff.publish(TestDSPParams{ .value = static_cast<float>(i) }, true, sec, true);
+		}
+
+		// (処理不要な区間はDSPが呼ばれず、入力の値(0)のまま)
+		const std::vector<float> output = ProcessFrames(handoff, dsp, 1000, 300);
+		KSMAUDIO_TEST_CHECK(output[99] == 1.0f);
+		KSMAUDIO_TEST_CHECK(output[100] == 0.0f);
+		KSMAUDIO_TEST_CHECK(output[299] == 0.0f);
+	}
+
+	// 0.1秒～0.2秒の間だけかけたBitcrusherの処理結果が、その区間のみ原音と異なることを確認する
+	// (イベントはすべて処理前に送っておき、useFusedGraphがfalseの場合はエフェクトごとにDSPを登録する場合と同様にprocess()を毎ブロック呼ぶ)
+	void CheckBitcrusherOnlyWhileActive(bool useFusedGraph)
+	{
+		using namespace ksmaudio::AudioEffect;
+		constexpr std::size_t kEffectSampleRate = 44100U;
+		constexpr std::size_t kEffectBlockFrames = 512U;
+		BasicAudioEffect<BitcrusherParams, BitcrusherDSP, BitcrusherDSPParams, 20> bitcrusher(kEffectSampleRate, 1U, false, nullptr);
+		bitcrusher.setParamValueSet(ParamID::kReduction, StrToValueSet(Type::kSample, "10samples"));
+		bitcrusher.updateStatusByFX(Status{ .sec = 0.1f }, 0U);
+		for (int i = 0; i <= 100; ++i)
+		{
+			bitcrusher.updateStatusByFX(Status{ .sec = 0.2f + static_cast<float>(i) / 1000.0f }, std::nullopt);
+		}
+
+		FusedAudioEffectGraph graph;
+		graph.add(&bitcrusher, 20);
+
+		std::vector<float> dry(kEffectSampleRate * 3U / 10U);
+		for (std::size_t i = 0U; i < dry.size(); ++i)
+		{
+			dry[i] = std::sin(static_cast<float>(i) * 0.05f);
+		}
+		std::vector<float> output = dry;
+		for (std::size_t cursor = 0U; cursor < output.size(); cursor += kEffectBlockFrames)
+		{
+			const std::size_t blockFrames = (std::min)(kEffectBlockFrames, output.size() - cursor);
+			if (useFusedGraph)
+			{
+				graph.process(output.data() + cursor, blockFrames, static_cast<std::int64_t>(cursor));
+			}
+			else
+			{
+				bitcrusher.process(output.data() + cursor, blockFrames, static_cast<std::int64_t>(cursor));
+			}
+		}
+
+		const std::size_t activeStart = kEffectSampleRate / 10U;
+		const std::size_t activeEnd = kEffectSampleRate / 5U;
+		KSMAUDIO_TEST_CHECK(std::equal(output.begin(), output.begin() + activeStart, dry.begin()));
+		KSMAUDIO_TEST_CHECK(!std::equal(output.begin() + activeStart, output.begin() + activeEnd, dry.begin() + activeStart));
+		KSMAUDIO_TEST_CHECK(std::equal(output.begin() + activeEnd, output.end(), dry.begin() + activeEnd));
+	}
+
+	void TestPerEffectBitcrusherReturnsToDry()
+	{
+		// エフェクトごとにDSPを登録する場合は、エフェクトの終了後に原音に戻る
+		CheckBitcrusherOnlyWhileActive(false);
+	}
+
+	void TestFusedGraphKeepsEffectUntilIdleEvent()
+	{
+		// ゲームスレッドが既に処理不要な状態のイベントを送っていても、FusedAudioEffectGraphはその位置までエフェクトを処理する
+		CheckBitcrusherOnlyWhileActive(true);
+	}
+
+	void TestTriggerPositionIsKept()
+	{
+		// トリガ更新までの時間が減っていくだけの更新はキューに入らず、遅れて適用されてもトリガ更新の位置はずれない
+		DSPParamsHandoff<TestTriggerDSPParams> handoff(kSampleRate, 1U);
+		TestTriggerDSP dsp;
+		for (int i = 0; i < 100; ++i)
+		{
+			const float sec = 1.0f + static_cast<float>(i) / 1000.0f;
+			handoff.publish(TestTriggerDSPParams{ .secUntilTrigger = 1.2f - sec }, false, sec, false);
+		}
+
+		// ストリーム上の1050フレーム目から処理する(1000フレーム目のイベントは50フレーム遅れて適用される)
+		dsp.frame = 1050;
+		ProcessFrames(handoff, dsp, 1050, 200);
+		KSMAUDIO_TEST_CHECK(dsp.triggerFrames.size() == 1U);
+		KSMAUDIO_TEST_CHECK(!dsp.triggerFrames.empty() && std::llabs(dsp.triggerFrames.front() - 1200) <= 1);
+	}
+
+	void TestPassedTriggerIsIgnoredAfterIdle()
+	{
+		// 処理不要な状態の間に過ぎたトリガ更新は、処理不要な状態から戻った際に適用されない
+		DSPParamsHandoff<TestTriggerDSPParams> handoff(kSampleRate, 1U);
+		TestTriggerDSP dsp;
+		handoff.publish(TestTriggerDSPParams{ .secUntilTrigger = 0.1f, .value = 1.0f }, false, 1.0f, false);
+		for (int i = 1; i < 1000; ++i)
+		{
+			const float sec = 1.0f + static_cast<float>(i) / 1000.0f;
+			handoff.publish(TestTriggerDSPParams{ .secUntilTrigger = -1.0f, .value = 1.0f }, true, sec, true);
+		}
+		handoff.publish(TestTriggerDSPParams{ .secUntilTrigger = 0.5f, .value = 1.0f }, false, 2.0f, false);
+
+		dsp.frame = 2000;
+		ProcessFrames(handoff, dsp, 2000, 100);
+		KSMAUDIO_TEST_CHECK(dsp.triggerFrames.size() == 1U);
+		KSMAUDIO_TEST_CHECK(!dsp.triggerFrames.empty() && std::llabs(dsp.triggerFrames.front() - 2500) <= 1);
+	}
+}
+
+int main()
+{
+	TestZeroOffset();
+	TestPositiveOffset();
+	TestNegativeOffset();
+	TestBypassFollowsLastPublish();
+	TestUnchangedParamsDoNotOverflow();
+	TestIdleDoesNotFillQueue();
+	TestIdleTransitionIsApplied();
+	TestPerEffectBitcrusherReturnsToDry();
+	TestFusedGraphKeepsEffectUntilIdleEvent();
+	TestTriggerPositionIsKept();
+	TestPassedTriggerIsIgnoredAfterIdle();
+	return ksmaudio::Test::Result("dsp_params_handoff_test");
+}
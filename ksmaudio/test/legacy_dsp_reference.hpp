@@ -0,0 +1,252 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include "ksmaudio/audio_effect/detail/biquad_filter.hpp"
+#include "ksmaudio/audio_effect/detail/dsp_simple_trigger_handler.hpp"
+#include "ksmaudio/audio_effect/detail/math_utils.hpp"
+#include "ksmaudio/audio_effect/params/phaser_params.hpp"
+#include "ksmaudio/audio_effect/params/wobble_params.hpp"
+
+// 最適化前の音声エフェクトの処理を再現した参照実装
+// (テストでの出力の比較と、ベンチマークでの処理時間の比較に使用する)
+namespace ksmaudio::Test::Legacy
+{
+	// 係数を正規化せず、サンプル毎にa0で割るBiquadフィルタ
+	// (detail::BiquadCoefficientsの導入前のdetail::BiquadFilterと同じ演算順序)
+	class BiquadFilter
+	{
+	private:
+		float m_a0 = 1.0f;
+		float m_a1 = 0.0f;
+		float m_a2 = 0.0f;
+		float m_b0 = 1.0f;
+		float m_b1 = 0.0f;
+		float m_b2 = 0.0f;
+		float m_input1 = 0.0f;
+		float m_input2 = 0.0f;
+		float m_output1 = 0.0f;
+		float m_output2 = 0.0f;
+
+		void set(float a0, float a1, float a2, float b0, float b1, float b2)
+		{
+			m_a0 = a0;
+			m_a1 = a1;
+			m_a2 = a2;
+			m_b0 = b0;
+			m_b1 = b1;
+			m_b2 = b2;
+		}
+
+	public:
+		float process(float input)
+		{
+			const float output
+				= m_b0 / m_a0 * input
+				+ m_b1 / m_a0 * m_input1
+				+ m_b2 / m_a0 * m_input2
+				- m_a1 / m_a0 * m_output1
+				- m_a2 / m_a0 * m_output2;
+
+			m_input2 = m_input1;
+			m_input1 = input;
+			m_output2 = m_output1;
+			m_output1 = output;
+
+			return output;
+		}
+
+		void setLowPassFilter(float freq, float q, float sampleRate)
+		{
+			const float omega = std::numbers::pi_v<float> * 2 * freq / sampleRate;
+			const float alpha = std::sin(omega) / (q * 2);
+
+			const float cosOmega = std::cos(omega);
+			set(1.0f + alpha, -2.0f * cosOmega, 1.0f - alpha, (1.0f - cosOmega) / 2, 1.0f - cosOmega, (1.0f - cosOmega) / 2);
+		}
+
+		void setHighPassFilter(float freq, float q, float sampleRate)
+		{
+			const float omega = std::numbers::pi_v<float> * 2 * freq / sampleRate;
+			const float alpha = std::sin(omega) / (q * 2);
+
+			const float cosOmega = std::cos(omega);
+			set(1.0f + alpha, -2.0f * cosOmega, 1.0f - alpha, (1.0f + cosOmega) / 2, -1.0f - cosOmega, (1.0f + cosOmega) / 2);
+		}
+
+		void setHighShelfFilter(float freq, float q, float gainDb, float sampleRate)
+		{
+			const float omega = std::numbers::pi_v<float> * 2 * freq / sampleRate;
+			const float A = std::pow(10.0f, gainDb / 40);
+			const float beta = std::sqrt(A) / q;
+
+			const float sinOmega = std::sin(omega);
+			const float cosOmega = std::cos(omega);
+			set(
+				(A + 1.0f) - (A - 1.0f) * cosOmega + beta * sinOmega,
+				2.0f * ((A - 1.0f) - (A + 1.0f) * cosOmega),
+				(A + 1.0f) - (A - 1.0f) * cosOmega - beta * sinOmega,
+				A * ((A + 1.0f) + (A - 1.0f) * cosOmega + beta * sinOmega),
+				-2.0f * A * ((A - 1.0f) + (A + 1.0f) * cosOmega),
+				A * ((A + 1.0f) + (A - 1.0f) * cosOmega - beta * sinOmega));
+		}
+
+		void setPeakingFilter(float freq, float bandwidth, float gainDb, float sampleRate)
+		{
+			const float omega = std::numbers::pi_v<float> * 2 * freq / sampleRate;
+			const float alpha = std::sin(omega) * std::sinh(std::log(2.0f) / 2 * bandwidth * omega / std::sin(omega));
+			const float A = std::pow(10.0f, gainDb / 40);
+
+			const float cosOmega = std::cos(omega);
+			set(1.0f + alpha / A, -2.0f * cosOmega, 1.0f - alpha / A, 1.0f + alpha * A, -2.0f * cosOmega, 1.0f - alpha * A);
+		}
+
+		void setAllPassFilter(float freq, float q, float sampleRate)
+		{
+			const float omega = std::numbers::pi_v<float> * 2 * freq / sampleRate;
+			const float alpha = std::sin(omega) / (q * 2);
+
+			const float cosOmega = std::cos(omega);
+			set(1.0f + alpha, -2.0f * cosOmega, 1.0f - alpha, 1.0f - alpha, -2.0f * cosOmega, 1.0f + alpha);
+		}
+	};
+
+	// フィルタ係数をフレーム毎に計算するWobble
+	// (制御レートでの係数の更新を導入する前のWobbleDSP::process()のうち、バイパスしていない場合の処理)
+	class Wobble
+	{
+	private:
+		static constexpr float kSinPi_2_25 = 0.9848077893f;
+
+		const float m_sampleRate;
+		const std::size_t m_numChannels;
+		AudioEffect::detail::DSPSimpleTriggerHandler m_triggerHandler;
+		AudioEffect::detail::StereoBiquadFilter m_lowPassFilter;
+
+		static float WobbleFreq(std::size_t framesSincePrevTrigger, std::size_t numPeriodFrames, float loFreq, float hiFreq)
+		{
+			if (numPeriodFrames == 0U)
+			{
+				return hiFreq;
+			}
+
+			float value = static_cast<float>(framesSincePrevTrigger % numPeriodFrames) / numPeriodFrames;
+			value = ((value > 0.5f) ? (1.0f - value) : value) * 2;
+			value = std::sin(value * std::numbers::pi_v<float> / 2);
+			value = std::sin(value * std::numbers::pi_v<float> / 2.25f) / kSinPi_2_25;
+			return std::lerp(hiFreq, loFreq, value);
+		}
+
+	public:
+		Wobble(std::size_t sampleRate, std::size_t numChannels)
+			: m_sampleRate(static_cast<float>(sampleRate))
+			, m_numChannels(numChannels)
+		{
+		}
+
+		void process(float* pData, std::size_t dataSize, const AudioEffect::WobbleDSPParams& params)
+		{
+			const std::size_t frameSize = dataSize / m_numChannels;
+			const std::size_t numPeriodFrames = static_cast<std::size_t>(params.waveLength * m_sampleRate);
+			for (std::size_t i = 0U; i < frameSize; ++i)
+			{
+				const float freq = WobbleFreq(m_triggerHandler.framesSincePrevTrigger(), numPeriodFrames, params.freq1, params.freq2);
+				m_lowPassFilter.setLowPassFilter(freq, params.q, m_sampleRate);
+				m_lowPassFilter.process(pData, pData, 1U, m_numChannels);
+				pData += m_numChannels;
+				m_triggerHandler.advance();
+			}
+		}
+
+		void updateParams(const AudioEffect::WobbleDSPParams& params)
+		{
+			m_triggerHandler.setFramesUntilTrigger(params.secUntilTrigger, static_cast<std::size_t>(m_sampleRate));
+		}
+	};
+
+	// オールパスフィルタの係数をフレーム毎に計算するPhaser
+	// (制御レートでの係数の更新を導入する前のPhaserDSP::process()のうち、ステージ数が1以上の場合の処理)
+	class Phaser
+	{
+	public:
+		static constexpr std::size_t kMaxNumAllPassFilters = 12U;
+
+	private:
+		static constexpr float kHiCutFilterQ = 1.5f;
+		static constexpr float kHiCutFilterGain = -8.0f;
+
+		const float m_sampleRate;
+		const std::size_t m_numChannels;
+		float m_lfoTimeRate = 0.0f;
+		std::array<AudioEffect::detail::StereoBiquadFilter, kMaxNumAllPassFilters> m_allPassFilters;
+		AudioEffect::detail::StereoBiquadFilter m_hiCutFilter;
+		std::array<std::array<float, 2>, kMaxNumAllPassFilters> m_prevWetArrayForFeedback = {};
+
+	public:
+		Phaser(std::size_t sampleRate, std::size_t numChannels)
+			: m_sampleRate(static_cast<float>(sampleRate))
+			, m_numChannels(numChannels)
+		{
+		}
+
+		void process(float* pData, std::size_t dataSize, const AudioEffect::PhaserDSPParams& params)
+		{
+			using namespace AudioEffect;
+
+			assert(params.mix > 0.0f && params.stage > 0U);
+			const std::size_t numFrames = dataSize / m_numChannels;
+			const float periodSamples = params.period * m_sampleRate;
+			const float lfoSpeed = periodSamples == 0.0f ? 0.0f : (1.0f / periodSamples);
+			const float log10Freq1 = detail::Log10Freq(params.freq1);
+			const float log10Freq2 = detail::Log10Freq(params.freq2);
+			const float centerFreq = detail::InterpolateFreqInLog10ScaleWithPrecalculatedLog10(0.5f, log10Freq1, log10Freq2);
+			m_hiCutFilter.setHighShelfFilter(centerFreq, kHiCutFilterQ, kHiCutFilterGain, m_sampleRate);
+
+			const std::size_t stage = (std::min)(params.stage, kMaxNumAllPassFilters);
+			for (std::size_t i = 0; i < numFrames; ++i)
+			{
+				std::array<float, 2> input = { 0.0f, 0.0f };
+				for (std::size_t channel = 0; channel < m_numChannels; ++channel)
+				{
+					const float lfoValue = detail::TriangleWithStereoWidth(m_lfoTimeRate, channel, params.stereoWidth);
+					const float freq = detail::InterpolateFreqInLog10ScaleWithPrecalculatedLog10(lfoValue, log10Freq1, log10Freq2);
+					detail::BiquadCoefficients<float> coefs;
+					coefs.setAllPassFilter(freq, params.q, m_sampleRate);
+					for (std::size_t s = 0; s < stage; ++s)
+					{
+						m_allPassFilters[s].setCoefficients(channel, coefs);
+					}
+
+					input[channel] = pData[channel] + m_prevWetArrayForFeedback[kMaxNumAllPassFilters - 1U][channel] * params.feedback;
+				}
+
+				std::array<std::array<float, 2>, kMaxNumAllPassFilters> wetArray;
+				for (std::size_t s = 0; s < kMaxNumAllPassFilters; ++s)
+				{
+					if (s < stage)
+					{
+						input = m_allPassFilters[s].processFrame(input);
+					}
+					wetArray[s] = input;
+				}
+
+				const std::array<float, 2> wetFiltered = m_hiCutFilter.processFrame(wetArray[kMaxNumAllPassFilters - 1U]);
+				for (std::size_t channel = 0; channel < m_numChannels; ++channel)
+				{
+					*pData = std::lerp(*pData, wetFiltered[channel], params.mix / 2);
+					++pData;
+				}
+
+				m_lfoTimeRate += lfoSpeed;
+				if (m_lfoTimeRate > 1.0f)
+				{
+					m_lfoTimeRate = detail::DecimalPart(m_lfoTimeRate);
+				}
+				m_prevWetArrayForFeedback = wetArray;
+			}
+		}
+	};
+}
@@ -0,0 +1,36 @@
+﻿#pragma once
+#include <cstdio>
+
+// ksmaudioのテスト用の簡易的なチェック機構
+// (外部のテストフレームワークに依存しないよう、失敗したチェックを標準エラー出力に表示して件数を数えるだけにしている)
+namespace ksmaudio::Test
+{
+	inline int& FailureCount()
+	{
+		static int count = 0;
+		return count;
+	}
+
+	inline void Check(bool condition, const char* expr, const char* file, int line)
+	{
+		if (!condition)
+		{
+			std::fprintf(stderr, "%s:%d: Check failed: %s\n", file, line, expr);
+			++FailureCount();
+		}
+	}
+
+	// 失敗したチェックがあれば1を返す(main()の戻り値に使用する)
+	inline int Result(const char* testName)
+	{
+		if (FailureCount() > 0)
+		{
+			std::fprintf(stderr, "%s: %d check(s) failed\n", testName, FailureCount());
+			return 1;
+		}
+		std::printf("%s: OK\n", testName);
+		return 0;
+	}
+}
+
+#define KSMAUDIO_TEST_CHECK(expr) ::ksmaudio::Test::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)